@@ -28,6 +28,59 @@ BiGraph::BiGraph(int node1_num,
   mNode2Num{node2_num},
   mEdgeList{edge_list}
 {
+  check_range(0);
+}
+
+// @brief コンストラクタ
+// @param[in] node1_num 頂点集合1の要素数
+// @param[in] node2_num 頂点集合2の要素数
+// @param[in] edge_list 枝のリスト
+BiGraph::BiGraph(int node1_num,
+		 int node2_num,
+		 vector<Edge>&& edge_list) :
+  mNode1Num{node1_num},
+  mNode2Num{node2_num},
+  mEdgeList{std::move(edge_list)}
+{
+  check_range(0);
+}
+
+// @brief 枝をまとめて追加する．
+// @param[in] edge_array 枝の配列の先頭
+// @param[in] num 枝数
+void
+BiGraph::add_edges(const Edge* edge_array,
+		   SizeType num)
+{
+  SizeType begin = mEdgeList.size();
+  mEdgeList.insert(mEdgeList.end(), edge_array, edge_array + num);
+  check_range(begin);
+}
+
+// @brief begin 番目以降の枝のノード番号の範囲チェックを行う．
+// @param[in] begin 開始位置
+//
+// 最小値と最大値を求めて最後に1回だけ比較する．
+void
+BiGraph::check_range(SizeType begin) const
+{
+  SizeType end = mEdgeList.size();
+  if ( begin >= end ) {
+    return;
+  }
+  auto edge_array = mEdgeList.data();
+  int min_id = std::numeric_limits<int>::max();
+  int max_id1 = std::numeric_limits<int>::min();
+  int max_id2 = std::numeric_limits<int>::min();
+  for ( SizeType i = begin; i < end; ++ i ) {
+    int id1 = edge_array[i].id1;
+    int id2 = edge_array[i].id2;
+    min_id = std::min(min_id, std::min(id1, id2));
+    max_id1 = std::max(max_id1, id1);
+    max_id2 = std::max(max_id2, id2);
+  }
+  ASSERT_COND( 0 <= min_id );
+  ASSERT_COND( max_id1 < node1_num() && max_id2 < node2_num() );
 }
 
 BEGIN_NONAMESPACE
@@ -0,0 +1,386 @@
+
+/// @file BiMatcher.cc
+/// @brief BiMatcher の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/BiMatcher.h"
+#include "MgWork.h"
+#include "MatchInit.h"
+
+
+BEGIN_NAMESPACE_YM_BIGRAPH
+
+//////////////////////////////////////////////////////////////////////
+// クラス BiMatcher
+//////////////////////////////////////////////////////////////////////
+
+// @brief 空のコンストラクタ
+BiMatcher::BiMatcher() :
+  mWork{new MgWork}
+{
+}
+
+// @brief コンストラクタ
+// @param[in] graph 対象のグラフ
+BiMatcher::BiMatcher(const BiGraph& graph) :
+  mWork{new MgWork}
+{
+  set_graph(graph);
+}
+
+// @brief デストラクタ
+BiMatcher::~BiMatcher()
+{
+}
+
+// @brief グラフを設定する．
+// @param[in] graph 対象のグラフ
+void
+BiMatcher::set_graph(const BiGraph& graph)
+{
+  mNode1Num = graph.node1_num();
+  mNode2Num = graph.node2_num();
+  mEdgeList = graph.edge_list();
+  mRemovedArray.clear();
+  mRemovedArray.resize(mEdgeList.size(), false);
+  mFirst = true;
+  mNeedRebuild = true;
+  mDirtyList.clear();
+  mPotential.clear();
+  mPotential.resize(mNode1Num + mNode2Num + 2, 0);
+}
+
+// @brief 枝を追加する．
+// @param[in] id1, id2 枝の両端のノード番号
+// @param[in] weight 枝の重み
+// @return 追加した枝の番号を返す．
+int
+BiMatcher::add_edge(int id1,
+		    int id2,
+		    int weight)
+{
+  ASSERT_COND( 0 <= id1 && id1 < node1_num() );
+  ASSERT_COND( 0 <= id2 && id2 < node2_num() );
+
+  int idx = mEdgeList.size();
+  mEdgeList.push_back({id1, id2, weight});
+  mRemovedArray.push_back(false);
+  mNeedRebuild = true;
+  mDirtyList.push_back(idx);
+  return idx;
+}
+
+// @brief 枝を削除する．
+// @param[in] idx 枝番号 ( 0 <= idx < edge_num() )
+void
+BiMatcher::remove_edge(int idx)
+{
+  ASSERT_COND( 0 <= idx && idx < edge_num() );
+
+  if ( !mRemovedArray[idx] ) {
+    mRemovedArray[idx] = true;
+    mNeedRebuild = true;
+  }
+}
+
+// @brief 枝の重みを変える．
+// @param[in] idx 枝番号 ( 0 <= idx < edge_num() )
+// @param[in] weight 新しい重み
+void
+BiMatcher::set_weight(int idx,
+		      int weight)
+{
+  ASSERT_COND( 0 <= idx && idx < edge_num() );
+  ASSERT_COND( !mRemovedArray[idx] );
+
+  mEdgeList[idx].weight = weight;
+  if ( !mNeedRebuild ) {
+    // 作業領域の枝はそのまま書き換えられる．
+    mWork->edge(idx)->weight = weight;
+  }
+  mDirtyList.push_back(idx);
+}
+
+// @brief 変更を反映させた最大重みマッチングを求める．
+// @return マッチング結果の枝番号のリストを昇順に返す．
+vector<int>
+BiMatcher::max_matching()
+{
+  if ( mFirst ) {
+    // BiGraph::max_matching() と同じく重みの降順に貪欲に選ぶ．
+    mWork->set_graph(mNode1Num, mNode2Num, mEdgeList, mRemovedArray);
+    mWork->sort_edges();
+    greedy_matching(*mWork);
+    mFirst = false;
+    mNeedRebuild = false;
+  }
+  else {
+    if ( mNeedRebuild ) {
+      rebuild();
+    }
+    // 追加された枝と重みの変わった枝を重みの降順に調べる．
+    sort(mDirtyList.begin(), mDirtyList.end(),
+	 [&](int idx1, int idx2) {
+	   return mEdgeList[idx1].weight > mEdgeList[idx2].weight;
+	 });
+    for ( auto idx: mDirtyList ) {
+      if ( !mRemovedArray[idx] ) {
+	improve(idx);
+      }
+    }
+  }
+  mDirtyList.clear();
+
+  mWork->augment();
+
+  // 増加路だけでは最適とは限らないので，ポテンシャルが実行可能に
+  // なるまで重みの和を増やす交互閉路を反転させる．
+  while ( cancel_cycle() ) {
+    ;
+  }
+
+  // 答のリストを作る．
+  vector<int> ans;
+  for ( int i = 0; i < mNode1Num; ++ i ) {
+    auto edge = mWork->node1(i)->mate;
+    if ( edge != nullptr ) {
+      ans.push_back(edge->id);
+    }
+  }
+  sort(ans.begin(), ans.end());
+  return ans;
+}
+
+// @brief 枝の追加・削除を作業領域に反映させる．
+void
+BiMatcher::rebuild()
+{
+  mSelectedList.clear();
+  for ( int i = 0; i < mNode1Num; ++ i ) {
+    auto edge = mWork->node1(i)->mate;
+    if ( edge != nullptr && !mRemovedArray[edge->id] ) {
+      mSelectedList.push_back(edge->id);
+    }
+  }
+
+  mWork->set_graph(mNode1Num, mNode2Num, mEdgeList, mRemovedArray);
+  for ( auto idx: mSelectedList ) {
+    mWork->select_edge(mWork->edge(idx));
+  }
+  mNeedRebuild = false;
+}
+
+// @brief 枝の周辺で選び直す．
+// @param[in] idx 枝番号
+//
+// マッチングの要素数を減らさずに重みの和が増える場合だけ選び直す．
+void
+BiMatcher::improve(int idx)
+{
+  auto edge = mWork->edge(idx);
+  auto node1 = edge->node1;
+  auto node2 = edge->node2;
+
+  if ( edge->selected ) {
+    // 重みが減った場合は相手がオープンなより重い枝に付け替える．
+    MgEdge* best = edge;
+    for ( auto edge1: node1->edge_list() ) {
+      if ( edge1->node2->mate == nullptr && best->weight < edge1->weight ) {
+	best = edge1;
+      }
+    }
+    for ( auto edge1: node2->edge_list() ) {
+      if ( edge1->node1->mate == nullptr && best->weight < edge1->weight ) {
+	best = edge1;
+      }
+    }
+    if ( best != edge ) {
+      mWork->unselect_edge(edge);
+      mWork->select_edge(best);
+    }
+    return;
+  }
+
+  auto mate1 = node1->mate;
+  auto mate2 = node2->mate;
+  if ( mate1 == nullptr && mate2 == nullptr ) {
+    mWork->select_edge(edge);
+  }
+  else if ( mate1 == mate2 ) {
+    // 同じ両端を持つ選択枝と入れ替える．
+    if ( mate1->weight < edge->weight ) {
+      mWork->unselect_edge(mate1);
+      mWork->select_edge(edge);
+    }
+  }
+  else if ( mate2 == nullptr ) {
+    // node2 はオープンなので mate1 と入れ替える．
+    if ( mate1->weight < edge->weight ) {
+      mWork->unselect_edge(mate1);
+      mWork->select_edge(edge);
+    }
+  }
+  else if ( mate1 == nullptr ) {
+    // node1 はオープンなので mate2 と入れ替える．
+    if ( mate2->weight < edge->weight ) {
+      mWork->unselect_edge(mate2);
+      mWork->select_edge(edge);
+    }
+  }
+  else {
+    // mate1 と mate2 の残りの端点を結ぶ枝があれば
+    // 長さ4の交互閉路に沿って入れ替える．
+    auto node3 = mate2->node1;
+    auto node4 = mate1->node2;
+    MgEdge* alt_edge = nullptr;
+    for ( auto edge1: node3->edge_list() ) {
+      if ( edge1->node2 == node4 &&
+	   (alt_edge == nullptr || alt_edge->weight < edge1->weight) ) {
+	alt_edge = edge1;
+      }
+    }
+    if ( alt_edge != nullptr &&
+	 mate1->weight + mate2->weight < edge->weight + alt_edge->weight ) {
+      mWork->unselect_edge(mate1);
+      mWork->unselect_edge(mate2);
+      mWork->select_edge(edge);
+      mWork->select_edge(alt_edge);
+    }
+  }
+}
+
+// @brief 重みの和を増やす交互閉路を一つ見つけて反転させる．
+// @return 見つからなかった時(最適な時) false を返す．
+//
+// 始点 s から左側のノード，左側から右側，右側から終点 t を通って
+// s に戻る流れとして，残余グラフの負閉路を Bellman-Ford 法で探す．
+// - 選択されていない枝 u -> v の費用は -weight，選択された枝は
+//   逆向き v -> u で費用は weight となる．
+// - s -> u は u がオープンな時，u -> s は u が選択枝を持つ時にある．
+//   右側と t の間も同様である．
+// - t -> s は常に，s -> t は選択枝がある時にある．
+// 負閉路がなければ mPotential が最適性の証明(双対変数)となる．
+bool
+BiMatcher::cancel_cycle()
+{
+  int n1 = mNode1Num;
+  int n2 = mNode2Num;
+  int s = n1 + n2;
+  int t = s + 1;
+  int nv = t + 1;
+  auto& dist = mPotential;
+  mParentArray.clear();
+  mParentArray.resize(nv, -1);
+  mParentEdgeArray.clear();
+  mParentEdgeArray.resize(nv, -1);
+
+  bool has_match = false;
+  for ( int i = 0; i < n1; ++ i ) {
+    if ( mWork->node1(i)->mate != nullptr ) {
+      has_match = true;
+      break;
+    }
+  }
+
+  bool updated = false;
+  auto relax = [&](int from,
+		   int to,
+		   std::int64_t cost,
+		   int edge_id) {
+    if ( dist[from] + cost < dist[to] ) {
+      dist[to] = dist[from] + cost;
+      mParentArray[to] = from;
+      mParentEdgeArray[to] = edge_id;
+      updated = true;
+    }
+  };
+
+  // 親の列をたどって閉路上のノードを探す．
+  // 親の列にできた閉路は必ず負閉路となる．
+  auto find_cycle = [&]() {
+    mMarkArray.clear();
+    mMarkArray.resize(nv, -1);
+    for ( int start = 0; start < nv; ++ start ) {
+      int x = start;
+      while ( x != -1 && mMarkArray[x] == -1 ) {
+	mMarkArray[x] = start;
+	x = mParentArray[x];
+      }
+      if ( x != -1 && mMarkArray[x] == start ) {
+	return x;
+      }
+    }
+    return -1;
+  };
+
+  int x = -1;
+  for ( ; ; ) {
+    updated = false;
+    for ( int i = 0; i < n1; ++ i ) {
+      auto node = mWork->node1(i);
+      for ( auto edge: node->edge_list() ) {
+	int j = n1 + edge->node2->id;
+	if ( edge->selected ) {
+	  relax(j, i, edge->weight, edge->id);
+	}
+	else {
+	  relax(i, j, -edge->weight, edge->id);
+	}
+      }
+      if ( node->mate == nullptr ) {
+	relax(s, i, 0, -1);
+      }
+      else {
+	relax(i, s, 0, -1);
+      }
+    }
+    for ( int j = 0; j < n2; ++ j ) {
+      if ( mWork->node2(j)->mate == nullptr ) {
+	relax(n1 + j, t, 0, -1);
+      }
+      else {
+	relax(t, n1 + j, 0, -1);
+      }
+    }
+    relax(t, s, 0, -1);
+    if ( has_match ) {
+      relax(s, t, 0, -1);
+    }
+    if ( !updated ) {
+      // ポテンシャルが実行可能なので最適である．
+      return false;
+    }
+    x = find_cycle();
+    if ( x != -1 ) {
+      break;
+    }
+  }
+
+  // 閉路上の枝の選択状態を反転させる．
+  // 選択を外す枝を先に処理する．
+  mSelectedList.clear();
+  int y = x;
+  do {
+    int id = mParentEdgeArray[y];
+    if ( id >= 0 ) {
+      auto edge = mWork->edge(id);
+      if ( edge->selected ) {
+	mWork->unselect_edge(edge);
+      }
+      else {
+	mSelectedList.push_back(id);
+      }
+    }
+    y = mParentArray[y];
+  } while ( y != x );
+  for ( auto id: mSelectedList ) {
+    mWork->select_edge(mWork->edge(id));
+  }
+  return true;
+}
+
+END_NAMESPACE_YM_BIGRAPH
@@ -0,0 +1,241 @@
+
+/// @file MgWork.cc
+/// @brief MgWork の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "MgWork.h"
+
+
+BEGIN_NAMESPACE_YM_BIGRAPH
+
+//////////////////////////////////////////////////////////////////////
+// クラス MgWork
+//////////////////////////////////////////////////////////////////////
+
+// @brief 削除された枝を除いてグラフの内容を設定する．
+// @param[in] node1_num 頂点集合1の要素数
+// @param[in] node2_num 頂点集合2の要素数
+// @param[in] edge_list 枝のリスト
+// @param[in] removed_array 削除された枝の印
+void
+MgWork::set_graph(int node1_num,
+		  int node2_num,
+		  const vector<BiGraph::Edge>& edge_list,
+		  const vector<bool>& removed_array)
+{
+  int n1 = node1_num;
+  int n2 = node2_num;
+  int m = edge_list.size();
+
+  // 削除された枝か調べる．
+  auto is_removed = [&](int id) {
+    return !removed_array.empty() && removed_array[id];
+  };
+
+  // 配列の大きさを先に決めておく．
+  // 以降はポインタを取るので再確保してはいけない．
+  mNode1Num = n1;
+  mNodeArray.resize(n1 + n2);
+  mEdgeArray.resize(m);
+  mAdjArray.resize(m * 2);
+  mEdgeList.clear();
+  mEdgeList.reserve(m);
+  mQueue1.reserve(n1);
+  mQueue2.reserve(n1);
+  mPath.reserve(n1 + n2);
+  mVisitedArray.resize(n1);
+  mInQueueArray.resize(n1);
+  clear_visited();
+
+  for ( int i = 0; i < n1; ++ i ) {
+    auto node = node1(i);
+    node->id = i;
+    node->edge_num = 0;
+    node->mate = nullptr;
+  }
+  for ( int i = 0; i < n2; ++ i ) {
+    auto node = node2(i);
+    node->id = i;
+    node->edge_num = 0;
+    node->mate = nullptr;
+  }
+  for ( int i = 0; i < m; ++ i ) {
+    if ( !is_removed(i) ) {
+      const auto& edge = edge_list[i];
+      ++ node1(edge.id1)->edge_num;
+      ++ node2(edge.id2)->edge_num;
+    }
+  }
+  auto top = mAdjArray.data();
+  for ( auto& node: mNodeArray ) {
+    node.edge_top = top;
+    top += node.edge_num;
+    node.edge_num = 0;
+  }
+
+  for ( int i = 0; i < m; ++ i ) {
+    const auto& src_edge = edge_list[i];
+    auto n1 = node1(src_edge.id1);
+    auto n2 = node2(src_edge.id2);
+    auto edge = &mEdgeArray[i];
+    *edge = MgEdge{i, n1, n2, src_edge.weight};
+    if ( is_removed(i) ) {
+      continue;
+    }
+    mEdgeList.push_back(edge);
+    n1->edge_top[n1->edge_num] = edge;
+    ++ n1->edge_num;
+    n2->edge_top[n2->edge_num] = edge;
+    ++ n2->edge_num;
+  }
+}
+
+// @brief 増加路がなくなるまでマッチングを改善する．
+// @return 増加路に沿って反転させた回数を返す．
+int
+MgWork::augment()
+{
+  int n = 0;
+  // 選択されていない頂点から始まる交互路を見つける．
+  // 増加路がなければ今の状態が最大
+  while ( find_path() ) {
+    // mPath に従って選択情報を更新する．
+    flip_path();
+    ++ n;
+  }
+  return n;
+}
+
+// @brief 重み最大の交互路を見つける．
+// @return 見つかった時 true を返す．
+bool
+MgWork::find_path()
+{
+  mPath.clear();
+
+  // 両端がオープンな枝は初期解で選ばれているものとする．
+  // 以降は必ず選択枝を含む奇数長の経路となる．
+
+  for ( int i = 0; i < mNode1Num; ++ i ) {
+    auto node = node1(i);
+    node->value = - numeric_limits<int>::max();
+    node->alt_edge = nullptr;
+  }
+
+  // 一度キューに積まれたノードの印
+  // 以前の段で値の決まったノードの alt_edge を書き換えると
+  // make_path() で閉路ができてしまうので，同じ段の中でのみ更新する．
+  clear_visited();
+  mQueue1.clear();
+  for ( int i = 0; i < mNode1Num; ++ i ) {
+    // 選択された枝を持たないノードをキューに積む．
+    auto node = node1(i);
+    if ( node->mate == nullptr ) {
+      node->value = 0;
+      node->alt_edge = nullptr;
+      mQueue1.push_back(node);
+      set_visited(node);
+    }
+  }
+
+  int max_value = 0;
+  MgEdge* max_edge = nullptr;
+  MgNode* max_node = nullptr;
+  bool found = false;
+  while ( !found && mQueue1.size() > 0 ) {
+    mQueue2.clear();
+    clear_in_queue();
+    for ( auto node1: mQueue1 ) {
+      int value1 = node1->value;
+      for ( auto edge1: node1->edge_list() ) {
+	if ( edge1->selected ) {
+	  continue;
+	}
+	int value2 = value1 + edge1->weight;
+	auto node2 = edge1->node2;
+	auto edge2 = node2->mate;
+	if ( edge2 == nullptr ) {
+	  if ( max_value < value2 ) {
+	    max_value = value2;
+	    max_edge = edge1;
+	    max_node = node1;
+	    found = true;
+	  }
+	}
+	else {
+	  auto node3 = edge2->node1;
+	  int value3 = value2 - edge2->weight;
+	  if ( check_in_queue(node3) ) {
+	    if ( node3->value < value3 ) {
+	      node3->value = value3;
+	      node3->alt_edge = edge1;
+	    }
+	  }
+	  else if ( !check_visited(node3) ) {
+	    node3->value = value3;
+	    node3->alt_edge = edge1;
+	    mQueue2.push_back(node3);
+	    set_in_queue(node3);
+	    set_visited(node3);
+	  }
+	}
+      }
+    }
+    mQueue1.swap(mQueue2);
+  }
+  if ( max_edge == nullptr ) {
+    return false;
+  }
+  make_path(max_edge, max_node);
+  return true;
+}
+
+// @brief パスを復元する．
+// @param[in] edge1 増加路の最後の枝
+// @param[in] node1 edge1 の左側のノード
+//
+// mPath に入る枝の順番は意味を持たない．
+void
+MgWork::make_path(MgEdge* edge1,
+		  MgNode* node1)
+{
+  for ( ; ; ) {
+    mPath.push_back(edge1);
+    auto edge2 = node1->mate;
+    if ( edge2 == nullptr ) {
+      break;
+    }
+    mPath.push_back(edge2);
+    edge1 = node1->alt_edge;
+    node1 = edge1->node1;
+  }
+}
+
+// @brief 増加路(mPath)上の枝の選択状態を反転させる．
+void
+MgWork::flip_path()
+{
+  // 選択を外す枝の mate を先に消しておく．
+  for ( auto edge: mPath ) {
+    if ( edge->selected ) {
+      edge->selected = false;
+      edge->node1->mate = nullptr;
+      edge->node2->mate = nullptr;
+    }
+    else {
+      edge->selected = true;
+    }
+  }
+  for ( auto edge: mPath ) {
+    if ( edge->selected ) {
+      edge->node1->mate = edge;
+      edge->node2->mate = edge;
+    }
+  }
+}
+
+END_NAMESPACE_YM_BIGRAPH
@@ -0,0 +1,346 @@
+#ifndef BIGRAPH_MGWORK_H
+#define BIGRAPH_MGWORK_H
+
+/// @file MgWork.h
+/// @brief MgWork のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BiGraph.h"
+#include "MgNode.h"
+#include "MgEdge.h"
+
+
+BEGIN_NAMESPACE_YM_BIGRAPH
+
+//////////////////////////////////////////////////////////////////////
+/// @class MgWork MgWork.h "MgWork.h"
+/// @brief 2部グラフの最大マッチング用の作業領域を表すクラス
+///
+/// - 両側のノード，枝，隣接リストをそれぞれ一つの配列(アリーナ)に
+///   まとめて持つ．
+/// - 初期解は MatchInit.h の関数で作る．
+/// - 探索用のキューや印の配列もここで持つ．
+/// - set_graph() は既存の領域を再利用するので，同程度の大きさのグラフを
+///   繰り返し解く場合には新たなメモリ確保は起こらない．
+/// - 現在のマッチングは各ノードの mate と各枝の selected で表される．
+///   set_graph() を呼ばない限り保持されるので，枝の重みを変えたり
+///   枝を選び直してから augment() を呼ぶことで続きから解くことができる．
+//////////////////////////////////////////////////////////////////////
+class MgWork
+{
+public:
+
+  /// @brief ノードの型
+  using Node = MgNode;
+
+  /// @brief 枝の型
+  using Edge = MgEdge;
+
+  /// @brief コンストラクタ
+  MgWork() = default;
+
+  /// @brief デストラクタ
+  ~MgWork() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief グラフの内容を設定する．
+  /// @param[in] graph 対象のグラフ
+  ///
+  /// - 以前の内容は破棄される．
+  /// - edge_list() は重みの降順に並べられる．
+  void
+  set_graph(const BiGraph& graph);
+
+  /// @brief 削除された枝を除いてグラフの内容を設定する．
+  /// @param[in] node1_num 頂点集合1の要素数
+  /// @param[in] node2_num 頂点集合2の要素数
+  /// @param[in] edge_list 枝のリスト
+  /// @param[in] removed_array 削除された枝の印
+  ///
+  /// - 以前の内容は破棄される．
+  /// - 削除された枝も番号は持つが，隣接リストと edge_list() には含まれない．
+  /// - edge_list() は並べ替えない．
+  void
+  set_graph(int node1_num,
+	    int node2_num,
+	    const vector<BiGraph::Edge>& edge_list,
+	    const vector<bool>& removed_array);
+
+  /// @brief edge_list() を重みの降順に並べ替える．
+  void
+  sort_edges()
+  {
+    sort(mEdgeList.begin(), mEdgeList.end(), EdgeLt());
+  }
+
+  /// @brief 全ノード数を返す．
+  int
+  node_num() const
+  {
+    return mNodeArray.size();
+  }
+
+  /// @brief ノードを返す．
+  /// @param[in] pos 位置番号 ( 0 <= pos < node_num() )
+  ///
+  /// 左側のノードの後に右側のノードが並ぶ．
+  MgNode*
+  node(int pos)
+  {
+    return &mNodeArray[pos];
+  }
+
+  /// @brief ノードの位置番号を返す．
+  /// @param[in] node 対象のノード
+  int
+  node_index(const MgNode* node) const
+  {
+    return node - mNodeArray.data();
+  }
+
+  /// @brief 左側のノードを返す．
+  /// @param[in] id ノード番号
+  MgNode*
+  node1(int id)
+  {
+    return &mNodeArray[id];
+  }
+
+  /// @brief 右側のノードを返す．
+  /// @param[in] id ノード番号
+  MgNode*
+  node2(int id)
+  {
+    return &mNodeArray[mNode1Num + id];
+  }
+
+  /// @brief 枝を返す．
+  /// @param[in] id 枝番号
+  MgEdge*
+  edge(int id)
+  {
+    return &mEdgeArray[id];
+  }
+
+  /// @brief 枝のリストを返す．
+  const vector<MgEdge*>&
+  edge_list() const
+  {
+    return mEdgeList;
+  }
+
+  /// @brief 枝を選択する．
+  /// @param[in] edge 対象の枝
+  ///
+  /// edge の両端は選択されていなければならない．
+  void
+  select_edge(MgEdge* edge);
+
+  /// @brief 枝の選択を外す．
+  /// @param[in] edge 対象の枝
+  ///
+  /// edge は選択されていなければならない．
+  void
+  unselect_edge(MgEdge* edge);
+
+  /// @brief 増加路がなくなるまでマッチングを改善する．
+  /// @return 増加路に沿って反転させた回数を返す．
+  int
+  augment();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 重み最大の交互路を見つける．
+  /// @return 見つかった時 true を返す．
+  ///
+  /// 見つかった交互路は mPath に入る．
+  bool
+  find_path();
+
+  /// @brief パスを復元する．
+  /// @param[in] edge1 増加路の最後の枝
+  /// @param[in] node1 edge1 の左側のノード
+  ///
+  /// 結果は mPath に入る．
+  void
+  make_path(MgEdge* edge1,
+	    MgNode* node1);
+
+  /// @brief 増加路(mPath)上の枝の選択状態を反転させる．
+  void
+  flip_path();
+
+  /// @brief 探索済みの印を全て消す．
+  ///
+  /// キューに積まれた印も消える．
+  void
+  clear_visited()
+  {
+    mCurVisited = new_mark(mVisitedArray, mCurVisited);
+    clear_in_queue();
+  }
+
+  /// @brief キューに積まれた印を全て消す．
+  void
+  clear_in_queue()
+  {
+    mCurInQueue = new_mark(mInQueueArray, mCurInQueue);
+  }
+
+  /// @brief 探索済みの印を付ける．
+  void
+  set_visited(const MgNode* node)
+  {
+    mVisitedArray[node->id] = mCurVisited;
+  }
+
+  /// @brief 探索済みの時 true を返す．
+  bool
+  check_visited(const MgNode* node) const
+  {
+    return mVisitedArray[node->id] == mCurVisited;
+  }
+
+  /// @brief キューに積まれた印を付ける．
+  void
+  set_in_queue(const MgNode* node)
+  {
+    mInQueueArray[node->id] = mCurInQueue;
+  }
+
+  /// @brief キューに積まれている時 true を返す．
+  bool
+  check_in_queue(const MgNode* node) const
+  {
+    return mInQueueArray[node->id] == mCurInQueue;
+  }
+
+  /// @brief 新しい印の値を返す．
+  /// @param[in] mark_array 印の配列
+  /// @param[in] cur_mark 現在の印の値
+  static
+  int
+  new_mark(vector<int>& mark_array,
+	   int cur_mark);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 左側のノード数
+  int mNode1Num{0};
+
+  // ノードの配列
+  //
+  // 左側のノードの後に右側のノードが並ぶ．
+  vector<MgNode> mNodeArray;
+
+  // 枝の配列
+  vector<MgEdge> mEdgeArray;
+
+  // 全ノードの枝のリストを詰めた配列
+  vector<MgEdge*> mAdjArray;
+
+  // 削除された枝を除いた枝のリスト
+  vector<MgEdge*> mEdgeList;
+
+  // キュー
+  vector<MgNode*> mQueue1;
+  vector<MgNode*> mQueue2;
+
+  // 増加路
+  vector<MgEdge*> mPath;
+
+  // 探索済みの印の配列(左側のノードのみ)
+  //
+  // mCurVisited と等しい時に印が付いているとみなす．
+  vector<int> mVisitedArray;
+
+  // 現在の探索済みの印の値
+  int mCurVisited{0};
+
+  // キューに積まれた印の配列(左側のノードのみ)
+  //
+  // mCurInQueue と等しい時に印が付いているとみなす．
+  vector<int> mInQueueArray;
+
+  // 現在のキューに積まれた印の値
+  int mCurInQueue{0};
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief グラフの内容を設定する．
+// @param[in] graph 対象のグラフ
+inline
+void
+MgWork::set_graph(const BiGraph& graph)
+{
+  set_graph(graph.node1_num(), graph.node2_num(), graph.edge_list(),
+	    vector<bool>{});
+  sort_edges();
+}
+
+// @brief 枝を選択する．
+// @param[in] edge 対象の枝
+inline
+void
+MgWork::select_edge(MgEdge* edge)
+{
+  ASSERT_COND( edge->node1->mate == nullptr );
+  ASSERT_COND( edge->node2->mate == nullptr );
+  edge->selected = true;
+  edge->node1->mate = edge;
+  edge->node2->mate = edge;
+}
+
+// @brief 枝の選択を外す．
+// @param[in] edge 対象の枝
+inline
+void
+MgWork::unselect_edge(MgEdge* edge)
+{
+  ASSERT_COND( edge->selected );
+  edge->selected = false;
+  edge->node1->mate = nullptr;
+  edge->node2->mate = nullptr;
+}
+
+// @brief 新しい印の値を返す．
+// @param[in] mark_array 印の配列
+// @param[in] cur_mark 現在の印の値
+inline
+int
+MgWork::new_mark(vector<int>& mark_array,
+		 int cur_mark)
+{
+  ++ cur_mark;
+  if ( cur_mark == numeric_limits<int>::max() ) {
+    // 一巡したら配列を初期化する．
+    std::fill(mark_array.begin(), mark_array.end(), 0);
+    cur_mark = 1;
+  }
+  return cur_mark;
+}
+
+END_NAMESPACE_YM_BIGRAPH
+
+#endif // BIGRAPH_MGWORK_H
@@ -0,0 +1,52 @@
+
+/// @file ColControl.cc
+/// @brief ColControl の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ColControl.h"
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+//////////////////////////////////////////////////////////////////////
+// クラス ColControl
+//////////////////////////////////////////////////////////////////////
+
+// @brief 解を登録する．
+// @param[in] k 彩色数
+// @param[in] color_map 彩色結果
+// @param[in] solver 解を見つけたアルゴリズム名
+// @retval true 最良解が更新された．
+// @retval false 最良解は更新されなかった．
+bool
+ColControl::update(int k,
+		   const vector<int>& color_map,
+		   const string& solver)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+
+  int best_num = mBestNum.load(std::memory_order_relaxed);
+  if ( best_num > 0 && best_num <= k ) {
+    return false;
+  }
+
+  mBestMap = color_map;
+  mBestSolver = solver;
+  mBestNum.store(k, std::memory_order_release);
+  if ( mOptions.callback ) {
+    // コールバックは mMutex を保持したまま呼ぶので
+    // 呼び出し順と彩色数の減少順が一致する．
+    mOptions.callback(k, mBestMap);
+  }
+  if ( k <= mLowerBound ) {
+    // 最適解であることが分かったので残りの探索を打ち切る．
+    cancel();
+  }
+  return true;
+}
+
+END_NAMESPACE_YM_UDGRAPH
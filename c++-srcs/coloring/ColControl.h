@@ -0,0 +1,243 @@
+#ifndef COLCONTROL_H
+#define COLCONTROL_H
+
+/// @file ColControl.h
+/// @brief ColControl のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/UdGraph.h"
+#include "SearchLimit.h"
+#include "PerfCounter.h"
+#include <mutex>
+#include <atomic>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+//////////////////////////////////////////////////////////////////////
+/// @class ColControl ColControl.h "ColControl.h"
+/// @brief 彩色アルゴリズムの実行を制御するクラス
+///
+/// - UdGraph::ColoringOptions の内容を保持する．
+/// - 打ち切り条件は SearchLimit として下位のクラスに渡す．
+/// - それまでに見つかった最良解を保持し，改善されるたびに
+///   コールバック関数を呼び出す．
+/// - 最良解の彩色数はアトミック変数に持つので，他のスレッドから
+///   ロックなしで参照できる．
+/// - 下界が設定されている場合，最良解の彩色数が下界に達したら
+///   cancel() を呼んで全ての探索を打ち切らせる．
+//////////////////////////////////////////////////////////////////////
+class ColControl :
+  public SearchLimit
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] options オプション
+  ColControl(const UdGraph::ColoringOptions& options);
+
+  /// @brief デストラクタ
+  ~ColControl() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief オプションを返す．
+  const UdGraph::ColoringOptions&
+  options() const;
+
+  /// @brief 局所探索1回あたりの繰り返し回数の上限を返す．
+  /// @param[in] default_limit オプションで指定されていない場合の値
+  int
+  iter_limit(int default_limit) const;
+
+  /// @brief 彩色数の下界を設定する．
+  /// @param[in] lb 下界
+  void
+  set_lower_bound(int lb);
+
+  /// @brief 彩色数の下界を返す．
+  ///
+  /// 設定されていない場合は 0 を返す．
+  int
+  lower_bound() const;
+
+  /// @brief 解を登録する．
+  /// @param[in] k 彩色数
+  /// @param[in] color_map 彩色結果
+  /// @param[in] solver 解を見つけたアルゴリズム名
+  /// @retval true 最良解が更新された．
+  /// @retval false 最良解は更新されなかった．
+  ///
+  /// - 更新された場合にはコールバック関数を呼ぶ．
+  /// - k が下界に達した場合には cancel() を呼ぶ．
+  /// - 複数のスレッドから呼んでも良い．
+  bool
+  update(int k,
+	 const vector<int>& color_map,
+	 const string& solver);
+
+  /// @brief 最良解の彩色数を返す．
+  ///
+  /// - 解が登録されていない場合は 0 を返す．
+  /// - 探索中に他のスレッドから呼んでも良い．
+  int
+  best_num() const;
+
+  /// @brief 最良解を返す．
+  ///
+  /// 全ての探索が終わってから呼ぶこと．
+  const vector<int>&
+  best_map() const;
+
+  /// @brief 最良解を見つけたアルゴリズム名を返す．
+  ///
+  /// 全ての探索が終わってから呼ぶこと．
+  const string&
+  best_solver() const;
+
+  /// @brief アルゴリズムの性能計測用のカウンタを加える．
+  /// @param[in] perf 加えるカウンタ
+  ///
+  /// 複数のスレッドから呼んでも良い．
+  void
+  add_perf(const PerfCounter& perf);
+
+  /// @brief 性能計測用のカウンタを返す．
+  ///
+  /// 全ての探索が終わってから呼ぶこと．
+  const PerfCounter&
+  perf() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // オプション
+  const UdGraph::ColoringOptions& mOptions;
+
+  // 彩色数の下界
+  int mLowerBound{0};
+
+  // mBestNum, mBestMap, mBestSolver の更新を保護する mutex
+  std::mutex mMutex;
+
+  // 最良解の彩色数
+  std::atomic<int> mBestNum{0};
+
+  // 最良解
+  vector<int> mBestMap;
+
+  // 最良解を見つけたアルゴリズム名
+  string mBestSolver;
+
+  // mPerf の更新を保護する mutex
+  std::mutex mPerfMutex;
+
+  // 性能計測用のカウンタ
+  PerfCounter mPerf;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] options オプション
+inline
+ColControl::ColControl(const UdGraph::ColoringOptions& options) :
+  SearchLimit(options.time_limit),
+  mOptions(options)
+{
+}
+
+// @brief オプションを返す．
+inline
+const UdGraph::ColoringOptions&
+ColControl::options() const
+{
+  return mOptions;
+}
+
+// @brief 局所探索1回あたりの繰り返し回数の上限を返す．
+// @param[in] default_limit オプションで指定されていない場合の値
+inline
+int
+ColControl::iter_limit(int default_limit) const
+{
+  return mOptions.iter_limit > 0 ? mOptions.iter_limit : default_limit;
+}
+
+// @brief 彩色数の下界を設定する．
+// @param[in] lb 下界
+inline
+void
+ColControl::set_lower_bound(int lb)
+{
+  mLowerBound = lb;
+}
+
+// @brief 彩色数の下界を返す．
+inline
+int
+ColControl::lower_bound() const
+{
+  return mLowerBound;
+}
+
+// @brief 最良解の彩色数を返す．
+inline
+int
+ColControl::best_num() const
+{
+  return mBestNum.load(std::memory_order_acquire);
+}
+
+// @brief 最良解を返す．
+inline
+const vector<int>&
+ColControl::best_map() const
+{
+  return mBestMap;
+}
+
+// @brief 最良解を見つけたアルゴリズム名を返す．
+inline
+const string&
+ColControl::best_solver() const
+{
+  return mBestSolver;
+}
+
+// @brief アルゴリズムの性能計測用のカウンタを加える．
+// @param[in] perf 加えるカウンタ
+inline
+void
+ColControl::add_perf(const PerfCounter& perf)
+{
+  std::unique_lock<std::mutex> lock(mPerfMutex);
+  mPerf.merge(perf);
+}
+
+// @brief 性能計測用のカウンタを返す．
+inline
+const PerfCounter&
+ColControl::perf() const
+{
+  return mPerf;
+}
+
+END_NAMESPACE_YM_UDGRAPH
+
+#endif // COLCONTROL_H
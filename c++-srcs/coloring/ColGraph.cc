@@ -20,9 +20,10 @@ BEGIN_NAMESPACE_YM_UDGRAPH
 
 // @brief コンストラクタ
 // @param[in] graph 対象のグラフ
-ColGraph::ColGraph(const UdGraph& graph)
+ColGraph::ColGraph(const UdGraph& graph) :
+  mAdjIndex{new AdjIndex(graph)}
 {
-  init(graph, vector<int>(graph.node_num(), 0));
+  init(vector<int>(graph.node_num(), 0));
 }
 
 // @brief コンストラクタ
@@ -31,13 +32,29 @@ ColGraph::ColGraph(const UdGraph& graph)
 ColGraph::ColGraph(const UdGraph& graph,
 		   const vector<int>& color_map)
 {
-  init(graph, color_map);
+  // すでに彩色済みのノード間の枝は無視する．
+  ASSERT_COND( color_map.size() == graph.node_num() );
+  vector<bool> fixed_mark(graph.node_num(), false);
+  for ( auto node_id: Range(graph.node_num()) ) {
+    fixed_mark[node_id] = color_map[node_id] > 0;
+  }
+  mAdjIndex.reset(new AdjIndex(graph, fixed_mark));
+
+  init(color_map);
+}
+
+// @brief 隣接リストを共有するコンストラクタ
+// @param[in] adj_index 隣接リスト
+ColGraph::ColGraph(const shared_ptr<const AdjIndex>& adj_index) :
+  mAdjIndex{adj_index}
+{
+  init(vector<int>(adj_index->node_num(), 0));
 }
 
 // @brief デストラクタ
 ColGraph::~ColGraph()
 {
-  delete [] mAdjListArray;
+  delete [] mNodeList;
   delete [] mColorMap;
 }
 
@@ -85,15 +102,12 @@ ColGraph::verify() const
   return true;
 }
 
-// @brief 内容をセットする．
-// @param[in] graph 対象のグラフ
+// @brief 彩色結果を初期化する．
 // @param[in] color_map 部分的な彩色結果
 void
-ColGraph::init(const UdGraph& graph,
-	       const vector<int>& color_map)
+ColGraph::init(const vector<int>& color_map)
 {
-  mNodeNum = graph.node_num();
-  mAdjListArray = new AdjList[mNodeNum];
+  mNodeNum = mAdjIndex->node_num();
   mColorMap = new int[mNodeNum];
 
   // mColorMap の初期化を行う．
@@ -125,50 +139,6 @@ ColGraph::init(const UdGraph& graph,
     }
   }
   ASSERT_COND( wpos == mNodeNum1 );
-
-  // 各ノードに接続する枝数を数える．
-  mEdgeNum = 0;
-  for ( auto edge: graph.edge_list() ) {
-    int id1 = edge.id1;
-    int id2 = edge.id2;
-    if ( id1 == id2 ) {
-      // そもそもセルフループは彩色不可なので無視する．
-      continue;
-    }
-    if ( mColorMap[id1] > 0 && mColorMap[id2] > 0 ) {
-      // すでに彩色済みのノードに関する枝も無視する．
-      continue;
-    }
-    ++ mEdgeNum;
-    ++ mAdjListArray[id1].mNum;
-    ++ mAdjListArray[id2].mNum;
-  }
-
-  // 隣接リストの領域を確保する．
-  for ( auto i: Range(mNodeNum) ) {
-    AdjList& adj_list = mAdjListArray[i];
-    adj_list.mBody = new int[adj_list.mNum];
-    // ちょっとしたギミックで mNum を 0 に戻す．
-    adj_list.mNum = 0;
-  }
-
-  // 隣接リストの設定を行う．
-  for ( auto edge: graph.edge_list() ) {
-    int id1 = edge.id1;
-    int id2 = edge.id2;
-    if ( id1 == id2 ) {
-      // そもそもセルフループは彩色不可なので無視する．
-      continue;
-    }
-    if ( mColorMap[id1] > 0 && mColorMap[id2] > 0 ) {
-      // すでに彩色済みのノードに関する枝も無視する．
-      continue;
-    }
-    AdjList& adj_list1 = mAdjListArray[id1];
-    AdjList& adj_list2 = mAdjListArray[id2];
-    adj_list1.mBody[adj_list1.mNum] = id2; ++ adj_list1.mNum;
-    adj_list2.mBody[adj_list2.mNum] = id1; ++ adj_list2.mNum;
-  }
 }
 
 END_NAMESPACE_YM_UDGRAPH
@@ -10,6 +10,8 @@
 
 #include "ym/UdGraph.h"
 #include "ym/Array.h"
+#include "AdjIndex.h"
+#include "PerfCounter.h"
 
 
 BEGIN_NAMESPACE_YM_UDGRAPH
@@ -17,6 +19,9 @@ BEGIN_NAMESPACE_YM_UDGRAPH
 //////////////////////////////////////////////////////////////////////
 /// @class ColGraph ColGraph.h "ColGraph.h"
 /// @brief coloring 用のグラフを表すクラス
+///
+/// 隣接リストは AdjIndex で表す．
+/// 同じグラフを対象とする複数のインスタンスで AdjIndex を共有することができる．
 //////////////////////////////////////////////////////////////////////
 class ColGraph
 {
@@ -32,6 +37,10 @@ public:
   ColGraph(const UdGraph& graph,
 	    const vector<int>& color_map);
 
+  /// @brief 隣接リストを共有するコンストラクタ
+  /// @param[in] adj_index 隣接リスト
+  ColGraph(const shared_ptr<const AdjIndex>& adj_index);
+
   /// @brief デストラクタ
   ~ColGraph();
 
@@ -60,6 +69,10 @@ public:
   Array<int>
   adj_list(int node_id) const;
 
+  /// @brief 隣接リストを返す．
+  const shared_ptr<const AdjIndex>&
+  adj_index() const;
+
   /// @brief 現在使用中の色数を返す．
   int
   color_num() const;
@@ -106,21 +119,27 @@ public:
   bool
   verify() const;
 
+  /// @brief 性能計測用のカウンタを返す．
+  PerfCounter&
+  perf();
+
+  /// @brief 性能計測用のカウンタを返す．
+  const PerfCounter&
+  perf() const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief 内容をセットする．
-  /// @param[in] graph 対象のグラフ
+  /// @brief 彩色結果を初期化する．
   /// @param[in] color_map 部分的な彩色結果
   ///
   /// コンストラクタのみから使われると仮定しているので
   /// 古い内容の破棄は行わない．
   void
-  init(const UdGraph& graph,
-       const vector<int>& color_map);
+  init(const vector<int>& color_map);
 
 
 private:
@@ -128,29 +147,11 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 隣接リストを表す構造体
-  struct AdjList
-  {
-    AdjList();
-
-    ~AdjList();
-
-    // 要素数
-    int mNum;
-
-    // 実体の配列
-    int* mBody;
-  };
-
   // ノード数
   int mNodeNum;
 
-  // 枝数
-  int mEdgeNum;
-
-  // ノードの隣接リストの配列
-  // サイズは mNodeNum;
-  AdjList* mAdjListArray;
+  // 隣接リスト
+  shared_ptr<const AdjIndex> mAdjIndex;
 
   // 未彩色のノード数
   int mNodeNum1;
@@ -165,6 +166,9 @@ private:
   // 彩色結果の配列
   int* mColorMap;
 
+  // 性能計測用のカウンタ
+  PerfCounter mPerf;
+
 };
 
 
@@ -185,7 +189,7 @@ inline
 int
 ColGraph::edge_num() const
 {
-  return mEdgeNum;
+  return mAdjIndex->edge_num();
 }
 
 // @brief ノード番号のリストを返す．
@@ -206,8 +210,31 @@ ColGraph::adj_list(int node_id) const
 {
   ASSERT_COND( node_id >= 0 && node_id < node_num() );
 
-  const AdjList& adj_list = mAdjListArray[node_id];
-  return Array<int>(adj_list.mBody, 0, adj_list.mNum);
+  return mAdjIndex->adj_list(node_id);
+}
+
+// @brief 隣接リストを返す．
+inline
+const shared_ptr<const AdjIndex>&
+ColGraph::adj_index() const
+{
+  return mAdjIndex;
+}
+
+// @brief 性能計測用のカウンタを返す．
+inline
+PerfCounter&
+ColGraph::perf()
+{
+  return mPerf;
+}
+
+// @brief 性能計測用のカウンタを返す．
+inline
+const PerfCounter&
+ColGraph::perf() const
+{
+  return mPerf;
 }
 
 // @brief 現在使用中の色数を返す．
@@ -266,19 +293,6 @@ ColGraph::set_color(const vector<int>& node_id_list,
   }
 }
 
-inline
-ColGraph::AdjList::AdjList() :
-  mNum(0),
-  mBody(nullptr)
-{
-}
-
-inline
-ColGraph::AdjList::~AdjList()
-{
-  delete [] mBody;
-}
-
 END_NAMESPACE_YM_UDGRAPH
 
 #endif // COLGRAPH_H
@@ -0,0 +1,232 @@
+
+/// @file ColLowerBound.cc
+/// @brief ColLowerBound の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ColLowerBound.h"
+#include "CoreDecomp.h"
+#include "ym/Range.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+//////////////////////////////////////////////////////////////////////
+// クラス ColLowerBound
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] graph 対象のグラフ
+// @param[in] adj_index graph の隣接リスト
+ColLowerBound::ColLowerBound(const UdGraph& graph,
+			     const shared_ptr<const AdjIndex>& adj_index) :
+  mGraph(graph),
+  mAdjIndex{adj_index},
+  mMark(adj_index->node_num(), 0)
+{
+  calc_degree();
+}
+
+// @brief 全ての下界の最大値を返す．
+int
+ColLowerBound::lower_bound()
+{
+  int lb = clique_bound();
+  lb = std::max(lb, cover_bound());
+  lb = std::max(lb, density_bound());
+  return lb;
+}
+
+// @brief クリークによる下界を返す．
+int
+ColLowerBound::clique_bound()
+{
+  int n = mAdjIndex->node_num();
+
+  // まず MclqSolver::greedy の結果を用いる．
+  mClique = mGraph.max_clique("greedy");
+
+  // コア数の大きい順(同じ場合は次数の大きい順)に各ノードを起点として
+  // greedy にクリークを作る．
+  // ノードを含むクリークの要素数はコア数 + 1 以下なので，
+  // 縮退度 + 1 に達したらそれが最大となる．
+  // 手間が枝数の定数倍を超えたら打ち切る．
+  CoreDecomp core_decomp(*mAdjIndex);
+  if ( mClique.size() > core_decomp.degeneracy() ) {
+    return mClique.size();
+  }
+  vector<int> order(n);
+  for ( auto i: Range(n) ) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(),
+	    [&](int a, int b) {
+	      int c_a = core_decomp.core_num(a);
+	      int c_b = core_decomp.core_num(b);
+	      if ( c_a != c_b ) {
+		return c_a > c_b;
+	      }
+	      return mDegree[a] > mDegree[b];
+	    });
+  ymuint64 work_limit = 20 * (mEdgeNum * 2 + n);
+  ymuint64 work = 0;
+  vector<int> cand_list;
+  vector<int> clique;
+  for ( auto node_id: order ) {
+    if ( core_decomp.core_num(node_id) + 1 <= mClique.size() ) {
+      // これ以降のノードからは大きなクリークは作れない．
+      break;
+    }
+    if ( mDegree[node_id] + 1 <= mClique.size() ) {
+      continue;
+    }
+    if ( work > work_limit ) {
+      break;
+    }
+    ++ mStamp;
+    mMark[node_id] = mStamp;
+    cand_list.clear();
+    for ( auto node1_id: mAdjIndex->adj_list(node_id) ) {
+      if ( mMark[node1_id] != mStamp ) {
+	mMark[node1_id] = mStamp;
+	cand_list.push_back(node1_id);
+      }
+    }
+    work += mAdjIndex->degree(node_id);
+    clique.clear();
+    clique.push_back(node_id);
+    work += extend_clique(cand_list, clique);
+    if ( clique.size() > mClique.size() ) {
+      mClique = clique;
+    }
+  }
+
+  return mClique.size();
+}
+
+// @brief クリーク分割による分数彩色数の下界を返す．
+//
+// 独立集合はクリーク分割の各クリークから高々1つしか要素を含まないので
+// α(G) <= クリーク分割の個数となる．
+int
+ColLowerBound::cover_bound()
+{
+  int n = mAdjIndex->node_num();
+  if ( n == 0 ) {
+    return 0;
+  }
+
+  vector<int> order(n);
+  for ( auto i: Range(n) ) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(),
+	    [&](int a, int b) { return mDegree[a] > mDegree[b]; });
+  vector<bool> covered(n, false);
+  int cover_num = 0;
+  vector<int> cand_list;
+  vector<int> clique;
+  for ( auto node_id: order ) {
+    if ( covered[node_id] ) {
+      continue;
+    }
+    ++ cover_num;
+    ++ mStamp;
+    mMark[node_id] = mStamp;
+    cand_list.clear();
+    for ( auto node1_id: mAdjIndex->adj_list(node_id) ) {
+      if ( !covered[node1_id] && mMark[node1_id] != mStamp ) {
+	mMark[node1_id] = mStamp;
+	cand_list.push_back(node1_id);
+      }
+    }
+    clique.clear();
+    clique.push_back(node_id);
+    extend_clique(cand_list, clique);
+    for ( auto node1_id: clique ) {
+      covered[node1_id] = true;
+    }
+  }
+
+  return (n + cover_num - 1) / cover_num;
+}
+
+// @brief 枝密度による下界を返す．
+//
+// Turán の定理より m <= (1 - 1/χ) n^2 / 2 なので
+// χ >= n^2 / (n^2 - 2m) となる．
+int
+ColLowerBound::density_bound()
+{
+  ymuint64 n = mAdjIndex->node_num();
+  if ( n == 0 ) {
+    return 0;
+  }
+  ymuint64 nn = n * n;
+  ymuint64 d = nn - mEdgeNum * 2;
+  return (nn + d - 1) / d;
+}
+
+// @brief 重複を除いた隣接ノード数を求める．
+void
+ColLowerBound::calc_degree()
+{
+  int n = mAdjIndex->node_num();
+  mDegree.clear();
+  mDegree.resize(n, 0);
+  ymuint64 sum = 0;
+  for ( auto node_id: Range(n) ) {
+    ++ mStamp;
+    for ( auto node1_id: mAdjIndex->adj_list(node_id) ) {
+      if ( mMark[node1_id] != mStamp ) {
+	mMark[node1_id] = mStamp;
+	++ mDegree[node_id];
+      }
+    }
+    sum += mDegree[node_id];
+  }
+  mEdgeNum = sum / 2;
+}
+
+// @brief 候補のノードから greedy にクリークを作る．
+// @param[inout] cand_list 候補のノードのリスト
+// @param[inout] clique 作成中のクリーク
+// @return 処理に要した手間(調べた隣接ノード数)を返す．
+ymuint64
+ColLowerBound::extend_clique(vector<int>& cand_list,
+			     vector<int>& clique)
+{
+  ymuint64 work = 0;
+  while ( !cand_list.empty() ) {
+    // 次数最大のノードを選ぶ．
+    int best_id = cand_list[0];
+    for ( auto node_id: cand_list ) {
+      if ( mDegree[best_id] < mDegree[node_id] ) {
+	best_id = node_id;
+      }
+    }
+    clique.push_back(best_id);
+
+    // best_id に隣接しているものだけを候補に残す．
+    ++ mStamp;
+    for ( auto node_id: mAdjIndex->adj_list(best_id) ) {
+      mMark[node_id] = mStamp;
+    }
+    int wpos = 0;
+    for ( auto node_id: cand_list ) {
+      if ( node_id != best_id && mMark[node_id] == mStamp ) {
+	cand_list[wpos] = node_id;
+	++ wpos;
+      }
+    }
+    work += mAdjIndex->degree(best_id) + cand_list.size();
+    cand_list.resize(wpos);
+  }
+  return work;
+}
+
+END_NAMESPACE_YM_UDGRAPH
@@ -0,0 +1,138 @@
+#ifndef COLLOWERBOUND_H
+#define COLLOWERBOUND_H
+
+/// @file ColLowerBound.h
+/// @brief ColLowerBound のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/UdGraph.h"
+#include "AdjIndex.h"
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+//////////////////////////////////////////////////////////////////////
+/// @class ColLowerBound ColLowerBound.h "ColLowerBound.h"
+/// @brief 彩色数の下界を求めるクラス
+///
+/// 以下の下界の最大値を返す．いずれも O(枝数) 程度の手間で求まる．
+/// - クリークの要素数(ω(G) <= χ(G))
+///   MclqSolver::greedy の結果と，各ノードを起点とした greedy の
+///   結果のうち大きい方を用いる．起点はコア数の大きい順に選び，
+///   コア数で枝刈りする．
+/// - 分数彩色数の下界(n / α(G) <= χ_f(G) <= χ(G))
+///   α(G) の上界として greedy に求めたクリーク分割の個数を用いる．
+/// - 枝密度による下界(n^2 / (n^2 - 2m) <= χ(G))
+///
+/// 固有値を用いる下界(Hoffman の下界など)は近似計算では
+/// 正しい下界にならないので用いない．
+//////////////////////////////////////////////////////////////////////
+class ColLowerBound
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] graph 対象のグラフ
+  /// @param[in] adj_index graph の隣接リスト
+  ColLowerBound(const UdGraph& graph,
+		const shared_ptr<const AdjIndex>& adj_index);
+
+  /// @brief デストラクタ
+  ~ColLowerBound() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 全ての下界の最大値を返す．
+  int
+  lower_bound();
+
+  /// @brief クリークによる下界を返す．
+  int
+  clique_bound();
+
+  /// @brief クリーク分割による分数彩色数の下界を返す．
+  int
+  cover_bound();
+
+  /// @brief 枝密度による下界を返す．
+  int
+  density_bound();
+
+  /// @brief clique_bound() で見つかったクリークを返す．
+  const vector<int>&
+  clique() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 重複を除いた隣接ノード数を求める．
+  void
+  calc_degree();
+
+  /// @brief 候補のノードから greedy にクリークを作る．
+  /// @param[inout] cand_list 候補のノードのリスト
+  /// @param[inout] clique 作成中のクリーク
+  /// @return 処理に要した手間(調べた隣接ノード数)を返す．
+  ///
+  /// - cand_list の要素は clique の全ての要素に隣接していなければならない．
+  /// - cand_list は破壊される．
+  ymuint64
+  extend_clique(vector<int>& cand_list,
+		vector<int>& clique);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のグラフ
+  const UdGraph& mGraph;
+
+  // 隣接リスト
+  shared_ptr<const AdjIndex> mAdjIndex;
+
+  // 重複を除いた隣接ノード数
+  vector<int> mDegree;
+
+  // 重複を除いた枝数
+  ymuint64 mEdgeNum{0};
+
+  // 作業用の印
+  vector<int> mMark;
+
+  // mMark に用いる値
+  int mStamp{0};
+
+  // clique_bound() で見つかったクリーク
+  vector<int> mClique;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief clique_bound() で見つかったクリークを返す．
+inline
+const vector<int>&
+ColLowerBound::clique() const
+{
+  return mClique;
+}
+
+END_NAMESPACE_YM_UDGRAPH
+
+#endif // COLLOWERBOUND_H
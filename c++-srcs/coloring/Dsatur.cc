@@ -10,6 +10,7 @@
 #include "Dsatur.h"
 #include "DsatNode.h"
 #include "NodeHeap.h"
+#include "ym/GraphLogger.h"
 #include "ym/Range.h"
 
 
@@ -17,37 +18,28 @@ BEGIN_NAMESPACE_YM_UDGRAPH
 
 BEGIN_NONAMESPACE
 
-// @brief Dsatur 用の比較関数
-class DsatComp
+// @brief Dsatur 用のキー関数
+//
+// saturation degree の大きい順，同じなら隣接ノード数の大きい順に
+// 取り出されるように両者を一つの整数にまとめて符号を反転させる．
+class DsatKey
 {
 public:
 
-  /// @brief ノードの比較関数
-  int
-  operator()(DsatNode* node1,
-	     DsatNode* node2);
+  /// @brief ノードのキーを返す．
+  std::int64_t
+  operator()(const DsatNode* node)
+  {
+    auto key = (static_cast<std::int64_t>(node->sat_degree()) << 32) | node->adj_degree();
+    return -key;
+  }
 
 };
 
-// @brief ノードの比較関数
-int
-DsatComp::operator()(DsatNode* node1,
-		     DsatNode* node2)
-{
-  if ( node1->sat_degree() < node2->sat_degree() ) {
-    return 1;
-  }
-  if ( node1->sat_degree() > node2->sat_degree() ) {
-    return -1;
-  }
-  if ( node1->adj_degree() < node2->adj_degree() ) {
-    return 1;
-  }
-  if ( node1->adj_degree() > node2->adj_degree() ) {
-    return -1;
-  }
-  return 0;
-}
+// @brief Dsatur 用のヒープ
+//
+// 比較の際にノードを参照しない KeyHeap が最も速い(heap_bench を参照)．
+using DsatHeap = KeyHeap<DsatNode, DsatKey, 4>;
 
 
 // @brief ノードに彩色して情報を更新する．
@@ -55,7 +47,7 @@ void
 update_sat_degree(DsatNode* node,
 		  ColGraph& graph,
 		  DsatNode* node_array,
-		  NodeHeap<DsatNode, DsatComp>& node_heap)
+		  DsatHeap& node_heap)
 {
   // node に隣接するノードの SAT degree を更新する．
   int color = graph.color(node->id());
@@ -69,6 +61,7 @@ update_sat_degree(DsatNode* node,
 
 	// SAT degree が変わったのでヒープ上の位置も更新する．
 	node_heap.update(node1);
+	graph.perf().count_heap_update();
       }
     }
   }
@@ -99,6 +92,14 @@ Dsatur::Dsatur(const UdGraph& graph,
   init();
 }
 
+// @brief 隣接リストを共有するコンストラクタ
+// @param[in] adj_index 隣接リスト
+Dsatur::Dsatur(const shared_ptr<const AdjIndex>& adj_index) :
+  ColGraph(adj_index)
+{
+  init();
+}
+
 // @brief 初期化する．
 void
 Dsatur::init()
@@ -145,10 +146,21 @@ Dsatur::coloring(vector<int>& color_map)
 {
   // dsatur アルゴリズムを用いる．
 
-  NodeHeap<DsatNode, DsatComp>  node_heap(node_num());
+  perf().start();
+  DsatHeap node_heap(node_num());
 
+  vector<DsatNode*> heap_node_list;
+  heap_node_list.reserve(node_list().num());
   for ( auto node_id: node_list() ) {
-    node_heap.put_node(&mNodeArray[node_id]);
+    heap_node_list.push_back(&mNodeArray[node_id]);
+  }
+  node_heap.bulk_build(heap_node_list);
+  perf().count_heap_update(node_list().num());
+  perf().end_setup();
+
+  if ( node_heap.empty() ) {
+    // 全てのノードが彩色済みだった．
+    return get_color_map(color_map);
   }
 
   // 1: 隣接するノード数が最大のノードを選び彩色する．
@@ -159,6 +171,7 @@ Dsatur::coloring(vector<int>& color_map)
 
   // 2: saturation degree が最大の未彩色ノードを選び最小の色番号で彩色する．
   while ( !node_heap.empty() ) {
+    perf().count_iteration();
     DsatNode* max_node = node_heap.get_min();
     // max_node につけることのできる最小の色番号を求める．
     int cnum = 0;
@@ -210,9 +223,12 @@ Dsatur::coloring(vector<int>& color_map)
     ASSERT_COND( verify() );
   }
   if ( !is_colored() || !verify() ) {
-    cout << "Error" << endl;
+    GraphLogger::log(GraphLogger::Level::Error, "dsatur",
+		     "invalid coloring");
   }
 
+  perf().end_search();
+
   // 結果を color_map に入れる．
   return get_color_map(color_map);
 }
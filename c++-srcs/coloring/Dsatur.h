@@ -36,6 +36,10 @@ public:
   Dsatur(const UdGraph& graph,
 	 const vector<int>& color_map);
 
+  /// @brief 隣接リストを共有するコンストラクタ
+  /// @param[in] adj_index 隣接リスト
+  Dsatur(const shared_ptr<const AdjIndex>& adj_index);
+
   /// @brief デストラクタ
   ~Dsatur();
 
@@ -0,0 +1,255 @@
+
+/// @file Hea.cc
+/// @brief Hea の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "Hea.h"
+#include "TabuCol.h"
+#include "ThreadPool.h"
+#include "ym/Range.h"
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+//////////////////////////////////////////////////////////////////////
+// クラス Hea
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] graph 対象のグラフ
+Hea::Hea(const UdGraph& graph) :
+  mAdjIndex{new AdjIndex(graph)}
+{
+}
+
+// @brief 隣接リストを共有するコンストラクタ
+// @param[in] adj_index 隣接リスト
+Hea::Hea(const shared_ptr<const AdjIndex>& adj_index) :
+  mAdjIndex{adj_index}
+{
+}
+
+// @brief デストラクタ
+Hea::~Hea()
+{
+}
+
+// @brief k 彩色を探す．
+// @param[in] k 彩色数
+// @param[out] color_map 彩色結果を収める配列
+// @retval true k 彩色が見つかった．
+// @retval false 制限内に k 彩色が見つからなかった．
+bool
+Hea::k_coloring(int k,
+		vector<int>& color_map)
+{
+  mPerf.start();
+  ThreadPool pool(mThreadNum);
+
+  // 各タスクが専有する局所探索器と乱数生成器
+  // タスク番号は集団中の位置と同じ範囲をとる．
+  vector<unique_ptr<TabuCol>> tabu_list(mPopSize);
+  vector<std::mt19937> rand_list(mPopSize);
+  for ( auto i: Range(mPopSize) ) {
+    rand_list[i].seed(mRandGen());
+  }
+
+  // 局所探索器のカウンタを集計して終わる．
+  auto finish = [&](bool found) {
+    for ( const auto& tabu: tabu_list ) {
+      mPerf.merge(tabu->perf());
+    }
+    mPerf.end_search();
+    return found;
+  };
+
+  // 初期集団を作る．
+  vector<vector<int>> pop_list(mPopSize);
+  vector<int> nc_list(mPopSize);
+  pool.parallel_for(mPopSize, [&](int i) {
+    tabu_list[i].reset(new TabuCol(mAdjIndex, k));
+    tabu_list[i]->set_seed(rand_list[i]());
+    tabu_list[i]->set_limit(mLimit);
+    vector<int> init_map;
+    random_greedy(k, rand_list[i], init_map);
+    nc_list[i] = tabu_list[i]->improve(init_map, mTabuIterLimit,
+				       mTabuL, mTabuAlpha, pop_list[i]);
+  });
+  mPerf.end_setup();
+  for ( auto i: Range(mPopSize) ) {
+    if ( nc_list[i] == 0 ) {
+      color_map.swap(pop_list[i]);
+      return finish(true);
+    }
+  }
+
+  // 1世代で作る子供の数
+  int child_num = std::min(pool.thread_num(), mPopSize);
+  vector<vector<int>> child_list(child_num);
+  vector<int> child_nc_list(child_num);
+  vector<pair<int, int>> parent_list(child_num);
+  std::uniform_int_distribution<int> rd_pop(0, mPopSize - 1);
+  for ( int gen = 0; gen < mGenLimit && !is_expired(); ++ gen ) {
+    mPerf.count_iteration();
+
+    // 親の組を選ぶ．
+    for ( auto i: Range(child_num) ) {
+      int p1 = rd_pop(mRandGen);
+      int p2 = rd_pop(mRandGen);
+      while ( p2 == p1 ) {
+	p2 = rd_pop(mRandGen);
+      }
+      parent_list[i] = make_pair(p1, p2);
+    }
+
+    // 子供を作って局所探索で改善する．
+    pool.parallel_for(child_num, [&](int i) {
+      int p1 = parent_list[i].first;
+      int p2 = parent_list[i].second;
+      vector<int> init_map;
+      gpx(k, pop_list[p1], pop_list[p2], rand_list[i], init_map);
+      child_nc_list[i] = tabu_list[i]->improve(init_map, mTabuIterLimit,
+					       mTabuL, mTabuAlpha,
+					       child_list[i]);
+    });
+
+    // 子供で集団の最悪の要素を置き換える．
+    for ( auto i: Range(child_num) ) {
+      int nc = child_nc_list[i];
+      if ( nc == 0 ) {
+	color_map.swap(child_list[i]);
+	return finish(true);
+      }
+      int worst = 0;
+      for ( auto j: Range(1, mPopSize) ) {
+	if ( nc_list[worst] < nc_list[j] ) {
+	  worst = j;
+	}
+      }
+      if ( nc <= nc_list[worst] ) {
+	pop_list[worst].swap(child_list[i]);
+	nc_list[worst] = nc;
+      }
+    }
+  }
+
+  return finish(false);
+}
+
+// @brief 乱択 greedy で k 色の初期解を作る．
+// @param[in] k 彩色数
+// @param[in] rand_gen 乱数生成器
+// @param[out] color_map 結果を収める配列
+//
+// 彩色できなかったノードの色は 0 となる．
+void
+Hea::random_greedy(int k,
+		   std::mt19937& rand_gen,
+		   vector<int>& color_map)
+{
+  int n = mAdjIndex->node_num();
+  vector<int> order(n);
+  for ( auto i: Range(n) ) {
+    order[i] = i;
+  }
+  std::shuffle(order.begin(), order.end(), rand_gen);
+
+  color_map.clear();
+  color_map.resize(n, 0);
+  // used[c] == node_id なら色 c は node_id の隣接ノードで使われている．
+  vector<int> used(k + 1, -1);
+  for ( auto node_id: order ) {
+    for ( auto node1_id: mAdjIndex->adj_list(node_id) ) {
+      used[color_map[node1_id]] = node_id;
+    }
+    for ( auto c: Range(1, k + 1) ) {
+      if ( used[c] != node_id ) {
+	color_map[node_id] = c;
+	break;
+      }
+    }
+  }
+}
+
+// @brief greedy partition crossover を行う．
+// @param[in] k 彩色数
+// @param[in] parent1, parent2 親の彩色結果
+// @param[in] rand_gen 乱数生成器
+// @param[out] child 子供の彩色結果
+//
+// どちらの親からも色を受け継がなかったノードの色は 0 となる．
+void
+Hea::gpx(int k,
+	 const vector<int>& parent1,
+	 const vector<int>& parent2,
+	 std::mt19937& rand_gen,
+	 vector<int>& child)
+{
+  int n = mAdjIndex->node_num();
+  const vector<int>* parent_array[2] = { &parent1, &parent2 };
+
+  // 親ごとの色クラスの要素と，まだ子供に受け継がれていない要素数
+  vector<vector<int>> class_list[2];
+  vector<int> count_list[2];
+  for ( auto p: Range(2) ) {
+    class_list[p].resize(k + 1);
+    count_list[p].resize(k + 1, 0);
+    const vector<int>& parent = *parent_array[p];
+    for ( auto node_id: Range(n) ) {
+      int c = parent[node_id];
+      ASSERT_COND( c >= 1 && c <= k );
+      class_list[p][c].push_back(node_id);
+      ++ count_list[p][c];
+    }
+  }
+
+  child.clear();
+  child.resize(n, 0);
+  for ( auto c: Range(1, k + 1) ) {
+    // 2つの親から交互に色クラスを受け継ぐ．
+    int p = (c - 1) % 2;
+
+    // 残りの要素数が最大の色クラスを選ぶ．
+    // 同点のものからは一様に選ぶ．
+    int max_c = 0;
+    int max_count = 0;
+    int tie_num = 0;
+    for ( auto c1: Range(1, k + 1) ) {
+      int count = count_list[p][c1];
+      if ( count == 0 || count < max_count ) {
+	continue;
+      }
+      if ( count > max_count ) {
+	max_count = count;
+	max_c = c1;
+	tie_num = 1;
+      }
+      else {
+	++ tie_num;
+	std::uniform_int_distribution<int> rd(0, tie_num - 1);
+	if ( rd(rand_gen) == 0 ) {
+	  max_c = c1;
+	}
+      }
+    }
+    if ( max_c == 0 ) {
+      // 全てのノードが受け継がれた．
+      break;
+    }
+
+    for ( auto node_id: class_list[p][max_c] ) {
+      if ( child[node_id] != 0 ) {
+	continue;
+      }
+      child[node_id] = c;
+      -- count_list[0][parent1[node_id]];
+      -- count_list[1][parent2[node_id]];
+    }
+  }
+}
+
+END_NAMESPACE_YM_UDGRAPH
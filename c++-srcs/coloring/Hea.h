@@ -0,0 +1,262 @@
+#ifndef HEA_H
+#define HEA_H
+
+/// @file Hea.h
+/// @brief Hea のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/UdGraph.h"
+#include "AdjIndex.h"
+#include "SearchLimit.h"
+#include "PerfCounter.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+class TabuCol;
+
+//////////////////////////////////////////////////////////////////////
+/// @class Hea Hea.h "Hea.h"
+/// @brief hybrid evolutionary algorithm による彩色を行うクラス
+///
+/// Galinier and Hao の HEA の実装
+/// - k 彩色の候補(衝突を含んでもよい)の集団を持つ．
+/// - 2つの親から greedy partition crossover (GPX) で子供を作る．
+/// - 子供は TabuCol による局所探索で改善してから集団に戻す．
+/// - 子供の生成と改善はスレッドプール上で並列に行う．
+/// - 各局所探索器は一つの AdjIndex を共有する．
+//////////////////////////////////////////////////////////////////////
+class Hea
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] graph 対象のグラフ
+  Hea(const UdGraph& graph);
+
+  /// @brief 隣接リストを共有するコンストラクタ
+  /// @param[in] adj_index 隣接リスト
+  Hea(const shared_ptr<const AdjIndex>& adj_index);
+
+  /// @brief デストラクタ
+  ~Hea();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // パラメータを設定する関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 集団のサイズを設定する．
+  /// @param[in] size 集団のサイズ ( size >= 2 )
+  void
+  set_population_size(int size);
+
+  /// @brief 世代数の上限を設定する．
+  /// @param[in] limit 世代数の上限
+  void
+  set_generation_limit(int limit);
+
+  /// @brief 局所探索のパラメータを設定する．
+  /// @param[in] iter_limit TabuCol の最大繰り返し回数
+  /// @param[in] L タブー期間の基本パラメータ
+  /// @param[in] alpha タブ期間の節点数依存パラメータ
+  void
+  set_tabu_param(int iter_limit,
+		 int L,
+		 double alpha);
+
+  /// @brief スレッド数を設定する．
+  /// @param[in] thread_num スレッド数 ( 0 の場合はハードウェアの並列度 )
+  void
+  set_thread_num(int thread_num);
+
+  /// @brief 乱数の種を設定する．
+  /// @param[in] seed 乱数の種
+  void
+  set_seed(int seed);
+
+  /// @brief 打ち切り条件を設定する．
+  /// @param[in] limit 打ち切り条件
+  ///
+  /// limit が満たされたら世代数の上限に達していなくても探索を終える．
+  void
+  set_limit(const SearchLimit* limit);
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief k 彩色を探す．
+  /// @param[in] k 彩色数
+  /// @param[out] color_map 彩色結果を収める配列
+  /// @retval true k 彩色が見つかった．
+  /// @retval false 制限内に k 彩色が見つからなかった．
+  bool
+  k_coloring(int k,
+	     vector<int>& color_map);
+
+  /// @brief 性能計測用のカウンタを返す．
+  ///
+  /// 内部で用いた TabuCol のカウンタも含む．
+  const PerfCounter&
+  perf() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 乱択 greedy で k 色の初期解を作る．
+  /// @param[in] k 彩色数
+  /// @param[in] rand_gen 乱数生成器
+  /// @param[out] color_map 結果を収める配列
+  ///
+  /// 彩色できなかったノードの色は 0 となる．
+  void
+  random_greedy(int k,
+		std::mt19937& rand_gen,
+		vector<int>& color_map);
+
+  /// @brief greedy partition crossover を行う．
+  /// @param[in] k 彩色数
+  /// @param[in] parent1, parent2 親の彩色結果
+  /// @param[in] rand_gen 乱数生成器
+  /// @param[out] child 子供の彩色結果
+  ///
+  /// どちらの親からも色を受け継がなかったノードの色は 0 となる．
+  void
+  gpx(int k,
+      const vector<int>& parent1,
+      const vector<int>& parent2,
+      std::mt19937& rand_gen,
+      vector<int>& child);
+
+  /// @brief 打ち切り条件が満たされていたら true を返す．
+  bool
+  is_expired() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 隣接リスト
+  shared_ptr<const AdjIndex> mAdjIndex;
+
+  // 集団のサイズ
+  int mPopSize{10};
+
+  // 世代数の上限
+  int mGenLimit{200};
+
+  // TabuCol の最大繰り返し回数
+  int mTabuIterLimit{2000};
+
+  // タブー期間の基本パラメータ
+  int mTabuL{9};
+
+  // タブ期間の節点数依存パラメータ
+  double mTabuAlpha{0.6};
+
+  // スレッド数
+  int mThreadNum{0};
+
+  // 乱数生成器
+  std::mt19937 mRandGen;
+
+  // 打ち切り条件
+  const SearchLimit* mLimit{nullptr};
+
+  // 性能計測用のカウンタ
+  PerfCounter mPerf;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 集団のサイズを設定する．
+inline
+void
+Hea::set_population_size(int size)
+{
+  ASSERT_COND( size >= 2 );
+
+  mPopSize = size;
+}
+
+// @brief 世代数の上限を設定する．
+inline
+void
+Hea::set_generation_limit(int limit)
+{
+  mGenLimit = limit;
+}
+
+// @brief 局所探索のパラメータを設定する．
+inline
+void
+Hea::set_tabu_param(int iter_limit,
+		    int L,
+		    double alpha)
+{
+  mTabuIterLimit = iter_limit;
+  mTabuL = L;
+  mTabuAlpha = alpha;
+}
+
+// @brief スレッド数を設定する．
+inline
+void
+Hea::set_thread_num(int thread_num)
+{
+  mThreadNum = thread_num;
+}
+
+// @brief 乱数の種を設定する．
+inline
+void
+Hea::set_seed(int seed)
+{
+  mRandGen.seed(seed);
+}
+
+// @brief 打ち切り条件を設定する．
+inline
+void
+Hea::set_limit(const SearchLimit* limit)
+{
+  mLimit = limit;
+}
+
+// @brief 打ち切り条件が満たされていたら true を返す．
+inline
+bool
+Hea::is_expired() const
+{
+  return mLimit != nullptr && mLimit->is_expired();
+}
+
+// @brief 性能計測用のカウンタを返す．
+inline
+const PerfCounter&
+Hea::perf() const
+{
+  return mPerf;
+}
+
+END_NAMESPACE_YM_UDGRAPH
+
+#endif // HEA_H
@@ -24,6 +24,13 @@ IsCov::IsCov(const UdGraph& graph) :
 {
 }
 
+// @brief 隣接リストを共有するコンストラクタ
+// @param[in] adj_index 隣接リスト
+IsCov::IsCov(const shared_ptr<const AdjIndex>& adj_index) :
+  mGraph(adj_index)
+{
+}
+
 // @brief デストラクタ
 IsCov::~IsCov()
 {
@@ -34,25 +41,23 @@ int
 IsCov::covering(int limit,
 		vector<int>& color_map)
 {
+  auto& perf = mGraph.perf();
+  perf.start();
+  perf.end_setup();
   int remain_num = mGraph.node_num();
+  vector<int> iset;
   while ( remain_num > limit ) {
-    vector<int> cand_list;
-    cand_list.reserve(remain_num);
-    for ( auto node_id: Range(mGraph.node_num()) ) {
-      if ( mGraph.color(node_id) == 0 ) {
-	cand_list.push_back(node_id);
-      }
+    if ( mLimit != nullptr && mLimit->is_expired() ) {
+      // 時間切れ
+      break;
     }
-    vector<bool> cur_mark(mGraph.node_num(), false);
-    vector<int> iset;
-    for ( ; ; ) {
-      int node_id = select_node(cand_list, cur_mark);
-      if ( node_id == -1 ) {
-	break;
-      }
-      cur_mark[node_id] = true;
+    perf.count_iteration();
+    init_cand_queue();
+    iset.clear();
+    while ( !mCandQueue.empty() ) {
+      int node_id = select_node();
       iset.push_back(node_id);
-      update_cand_list(cand_list, node_id);
+      update_cand_queue(node_id);
     }
     int num = iset.size();
     ASSERT_COND( num > 0 );
@@ -65,74 +70,59 @@ IsCov::covering(int limit,
     }
     remain_num -= num;
   }
+  perf.end_search();
 
   return mGraph.get_color_map(color_map);
 }
 
-// @brief 候補集合に加えるノードを選ぶ．
-// @param[in] cur_mark 現在の候補集合を表す配列
+// @brief 未彩色のノードを候補にする．
 //
-// - cur_mark[node_id] = true のノードが候補集合の要素
-// - 現在の候補集合に隣接していないノードの内，隣接ノード数の少ないものを選ぶ．
-// - 追加できるノードがない場合は -1 を返す．
-int
-IsCov::select_node(const vector<int>& cand_list,
-		   const vector<bool>& cur_mark)
+// キーは隣接ノード数とする．
+void
+IsCov::init_cand_queue()
 {
-  vector<int> min_list;
-  int min_num = mGraph.node_num();
-  for ( auto node_id: cand_list ) {
-    int c = mGraph.adj_list(node_id).num();
-    if ( min_num >= c ) {
-      if ( min_num > c ) {
-	min_num = c;
-	min_list.clear();
-      }
-      min_list.push_back(node_id);
+  int n = mGraph.node_num();
+  int max_degree = 0;
+  for ( auto node_id: Range(n) ) {
+    max_degree = std::max(max_degree, mGraph.adj_list(node_id).num());
+  }
+  mCandQueue.init(n, max_degree);
+  for ( auto node_id: Range(n) ) {
+    if ( mGraph.color(node_id) == 0 ) {
+      mCandQueue.put(node_id, mGraph.adj_list(node_id).num());
     }
   }
+}
+
+// @brief 集合に加えるノードを選ぶ．
+//
+// 候補の内，隣接ノード数の最も少ないものからランダムに選ぶ．
+int
+IsCov::select_node()
+{
+  const auto& min_list = mCandQueue.min_bucket();
   int n = min_list.size();
-  if ( n == 0 ) {
-    // 追加できるノードがない．
-    return -1;
-  }
-  else if ( n == 1 ) {
+  if ( n == 1 ) {
     return min_list[0];
   }
-  else {
-    std::uniform_int_distribution<int> rd(0, n - 1);
-    int r = rd(mRandGen);
-    return min_list[r];
-  }
+  std::uniform_int_distribution<int> rd(0, n - 1);
+  int r = rd(mRandGen);
+  return min_list[r];
 }
 
-// @brief 候補リストを更新する．
-// @param[inout] cand_list 候補リスト
+// @brief 候補を更新する．
 // @param[in] node_id 新たに加わったノード
+//
+// node_id とその隣接ノードを候補から外す．
 void
-IsCov::update_cand_list(vector<int>& cand_list,
-			int node_id)
+IsCov::update_cand_queue(int node_id)
 {
-  // node_id に隣接するノードに印を付ける．
-  vector<bool> mark(mGraph.node_num(), false);
-  mark[node_id] = true;
+  mCandQueue.erase(node_id);
   for ( auto node1_id: mGraph.adj_list(node_id) ) {
-    mark[node1_id] = true;
-  }
-
-  int n = cand_list.size();
-  int rpos = 0;
-  int wpos = 0;
-  for ( rpos = 0; rpos < n; ++ rpos ) {
-    int node1_id = cand_list[rpos];
-    if ( !mark[node1_id] ) {
-      cand_list[wpos] = node1_id;
-      ++ wpos;
+    if ( mCandQueue.contains(node1_id) ) {
+      mCandQueue.erase(node1_id);
     }
   }
-  if ( wpos < n ) {
-    cand_list.erase(cand_list.begin() + wpos, cand_list.end());
-  }
 }
 
 END_NAMESPACE_YM_UDGRAPH
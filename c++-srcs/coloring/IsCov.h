@@ -11,6 +11,8 @@
 
 #include "ym/UdGraph.h"
 #include "ColGraph.h"
+#include "SearchLimit.h"
+#include "PeelQueue.h"
 #include <random>
 
 
@@ -28,6 +30,10 @@ public:
   /// @param[in] graph 対象のグラフ
   IsCov(const UdGraph& graph);
 
+  /// @brief 隣接リストを共有するコンストラクタ
+  /// @param[in] adj_index 隣接リスト
+  IsCov(const shared_ptr<const AdjIndex>& adj_index);
+
   /// @brief デストラクタ
   ~IsCov();
 
@@ -37,34 +43,48 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 乱数の種を設定する．
+  /// @param[in] seed 乱数の種
+  void
+  set_seed(int seed);
+
+  /// @brief 打ち切り条件を設定する．
+  /// @param[in] limit 打ち切り条件
+  ///
+  /// limit が満たされたら残りのノード数に関わらず処理をやめる．
+  void
+  set_limit(const SearchLimit* limit);
+
   /// @brief independent set cover を行う．
   int
   covering(int limit,
 	   vector<int>& color_map);
 
+  /// @brief 性能計測用のカウンタを返す．
+  const PerfCounter&
+  perf() const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 未彩色のノードを候補にする．
+  void
+  init_cand_queue();
+
   /// @brief 集合に加えるノードを選ぶ．
-  /// @param[in] cand_list 候補となるノードのリスト
-  /// @param[in] cur_mark 現在の候補集合を表す配列
   ///
-  /// - cur_mark[node_id] = true のノードが候補集合の要素
-  /// - 現在の集合に隣接していないノードの内，隣接ノード数の少ないものを選ぶ．
-  /// - 追加できるノードがない場合は -1 を返す．
+  /// 候補の内，隣接ノード数の最も少ないものからランダムに選ぶ．
+  /// 候補は空であってはならない．
   int
-  select_node(const vector<int>& cand_list,
-	      const vector<bool>& cur_mark);
+  select_node();
 
-  /// @brief 候補リストを更新する．
-  /// @param[inout] cand_list 候補リスト
+  /// @brief 候補を更新する．
   /// @param[in] node_id 新たに加わったノード
   void
-  update_cand_list(vector<int>& cand_list,
-		   int node_id);
+  update_cand_queue(int node_id);
 
 
 private:
@@ -75,9 +95,15 @@ private:
   // 対象のグラフ
   ColGraph mGraph;
 
+  // 候補ノードを隣接ノード数で分けたもの
+  PeelQueue mCandQueue;
+
   // 乱数生成器
   std::mt19937 mRandGen;
 
+  // 打ち切り条件
+  const SearchLimit* mLimit{nullptr};
+
 };
 
 
@@ -85,6 +111,32 @@ private:
 // インライン関数の定義
 //////////////////////////////////////////////////////////////////////
 
+// @brief 乱数の種を設定する．
+// @param[in] seed 乱数の種
+inline
+void
+IsCov::set_seed(int seed)
+{
+  mRandGen.seed(seed);
+}
+
+// @brief 打ち切り条件を設定する．
+// @param[in] limit 打ち切り条件
+inline
+void
+IsCov::set_limit(const SearchLimit* limit)
+{
+  mLimit = limit;
+}
+
+// @brief 性能計測用のカウンタを返す．
+inline
+const PerfCounter&
+IsCov::perf() const
+{
+  return mGraph.perf();
+}
+
 END_NAMESPACE_YM_UDGRAPH
 
 #endif // ISCOV_H
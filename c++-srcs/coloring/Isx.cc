@@ -21,11 +21,19 @@ BEGIN_NAMESPACE_YM_UDGRAPH
 // @param[in] graph 対象のグラフ
 Isx::Isx(const UdGraph& graph) :
   ColGraph(graph),
-  mCandMark(node_num(), false),
-  mAdjCount(node_num(), 0)
+  mDecCount(node_num(), 0),
+  mTmpList(node_num() + 1)
+{
+  mIndepSet.reserve(node_num());
+}
+
+// @brief 隣接リストを共有するコンストラクタ
+// @param[in] adj_index 隣接リスト
+Isx::Isx(const shared_ptr<const AdjIndex>& adj_index) :
+  ColGraph(adj_index),
+  mDecCount(node_num(), 0),
+  mTmpList(node_num() + 1)
 {
-  mCandList.reserve(node_num());
-  mTmpList.reserve(node_num());
   mIndepSet.reserve(node_num());
 }
 
@@ -44,8 +52,15 @@ int
 Isx::coloring(int limit,
 	      vector<int>& color_map)
 {
+  perf().start();
+  perf().end_setup();
   int remain_num = node_num();
   while ( remain_num > limit ) {
+    if ( mLimit != nullptr && mLimit->is_expired() ) {
+      // 時間切れ
+      break;
+    }
+    perf().count_iteration();
     get_indep_set();
 
     // mIndepSet の各ノードに新しい色を割り当てる．
@@ -53,6 +68,7 @@ Isx::coloring(int limit,
 
     remain_num -= mIndepSet.size();
   }
+  perf().end_search();
 
   return get_color_map(color_map);
 }
@@ -64,12 +80,14 @@ Isx::coloring(int limit,
 void
 Isx::get_indep_set()
 {
-  // 未彩色のノードを cand_list に入れる．
+  // 未彩色のノードを mCandQueue に入れる．
   init_cand_list();
 
   // ノードを一つづつ選択し mIndepSet に入れる．
+  // 最初のノードは候補全体からランダムに選ぶ．
   mIndepSet.clear();
-  int node_id = random_select(mCandList);
+  std::uniform_int_distribution<int> rd(0, mCandQueue.size() - 1);
+  int node_id = mCandQueue.node(rd(mRandGen));
   while ( node_id != -1 ) {
     mIndepSet.push_back(node_id);
 
@@ -81,21 +99,26 @@ Isx::get_indep_set()
   //sort(mIndepSet.begin(), mIndepSet.end());
 }
 
-// @brief mCandList, mCandMark を初期化する．
+// @brief mCandQueue を初期化する．
+//
+// キーは未彩色の隣接ノード数とする．
 void
 Isx::init_cand_list()
 {
+  int max_degree = 0;
   for ( auto node_id: Range(node_num()) ) {
-    if ( color(node_id) == 0 ) {
-      mCandList.push_back(node_id);
-      mCandMark[node_id] = true;
-      mAdjCount[node_id] = 0;
-    }
+    max_degree = std::max(max_degree, adj_list(node_id).num());
   }
-
-  for ( auto node_id: mCandList ) {
-    for ( auto node1_id: adj_list(node_id) ) {
-      ++ mAdjCount[node1_id];
+  mCandQueue.init(node_num(), max_degree);
+  for ( auto node_id: Range(node_num()) ) {
+    if ( color(node_id) == 0 ) {
+      int c = 0;
+      for ( auto node1_id: adj_list(node_id) ) {
+	if ( color(node1_id) == 0 ) {
+	  ++ c;
+	}
+      }
+      mCandQueue.put(node_id, c);
     }
   }
 }
@@ -107,27 +130,11 @@ Isx::init_cand_list()
 int
 Isx::select_node()
 {
-  ASSERT_COND( mCandList.size() > 0 );
-
-  mTmpList.clear();
-  int min_num = node_num();
-  for ( auto node_id: mCandList ) {
-    int c = mAdjCount[node_id];
-    if ( min_num >= c ) {
-      if ( min_num > c ) {
-	min_num = c;
-	mTmpList.clear();
-      }
-      mTmpList.push_back(node_id);
-    }
-  }
-
-  int n = mTmpList.size();
-  if ( n == 0 ) {
+  if ( mCandQueue.empty() ) {
     return -1;
   }
 
-  return random_select(mTmpList);
+  return random_select(mCandQueue.min_bucket());
 }
 
 // @brief 候補リストを更新する．
@@ -135,35 +142,29 @@ Isx::select_node()
 void
 Isx::update_cand_list(int node_id)
 {
-  // node_id と隣接するノードの cand_mark をはずす．
-  mCandMark[node_id] = false;
+  // node_id と隣接するノードを候補から外し，
+  // その隣接ノードのキーを減らす．
+  // 減らす値は mDecCount に数えておいて最後にまとめて減らす．
+  // 密なグラフではこのループが大半を占めるので分岐を用いずに
+  // mTmpList に追加する．
+  mCandQueue.erase(node_id);
+  int tmp_num = 0;
   for ( auto node1_id: adj_list(node_id) ) {
-    if ( mCandMark[node1_id] ) {
-      mCandMark[node1_id] = false;
+    if ( mCandQueue.contains(node1_id) ) {
+      mCandQueue.erase(node1_id);
       for ( auto node2_id: adj_list(node1_id) ) {
-	-- mAdjCount[node2_id];
+	mTmpList[tmp_num] = node2_id;
+	tmp_num += (mDecCount[node2_id] == 0);
+	++ mDecCount[node2_id];
       }
     }
   }
-
-  int rpos = 0;
-  int wpos = 0;
-  int n = mCandList.size();
-  for ( ; rpos < n; ++ rpos ) {
-    auto node1_id = mCandList[rpos];
-    if ( mCandMark[node1_id] ) {
-      if ( mAdjCount[node1_id] == 0 ) {
-	mCandMark[node1_id] = false;
-	mIndepSet.push_back(node1_id);
-      }
-      else {
-	mCandList[wpos] = node1_id;
-	++ wpos;
-      }
+  for ( int i = 0; i < tmp_num; ++ i ) {
+    int node2_id = mTmpList[i];
+    if ( mCandQueue.contains(node2_id) ) {
+      mCandQueue.dec_key(node2_id, mDecCount[node2_id]);
     }
-  }
-  if ( wpos < n ) {
-    mCandList.erase(mCandList.begin() + wpos, mCandList.end());
+    mDecCount[node2_id] = 0;
   }
 }
 
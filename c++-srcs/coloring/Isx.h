@@ -11,6 +11,8 @@
 
 #include "ym/UdGraph.h"
 #include "ColGraph.h"
+#include "SearchLimit.h"
+#include "PeelQueue.h"
 #include <random>
 
 
@@ -29,6 +31,10 @@ public:
   /// @param[in] graph 対象のグラフ
   Isx(const UdGraph& graph);
 
+  /// @brief 隣接リストを共有するコンストラクタ
+  /// @param[in] adj_index 隣接リスト
+  Isx(const shared_ptr<const AdjIndex>& adj_index);
+
   /// @brief デストラクタ
   ~Isx();
 
@@ -38,6 +44,18 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 乱数の種を設定する．
+  /// @param[in] seed 乱数の種
+  void
+  set_seed(int seed);
+
+  /// @brief 打ち切り条件を設定する．
+  /// @param[in] limit 打ち切り条件
+  ///
+  /// limit が満たされたら残りのノード数に関わらず処理をやめる．
+  void
+  set_limit(const SearchLimit* limit);
+
   /// @brief independent set extraction を用いた coloring を行う．
   /// @param[in] limit 残りのノード数がこの値を下回ったら処理をやめる．
   /// @param[out] color_map 彩色結果を収める配列
@@ -61,7 +79,7 @@ private:
   void
   get_indep_set();
 
-  /// @brief mCandList, mCandMark を初期化する．
+  /// @brief mCandQueue を初期化する．
   void
   init_cand_list();
 
@@ -87,18 +105,15 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 候補ノードのリスト
-  vector<int> mCandList;
+  // 候補ノードを候補の隣接ノード数で分けたもの
+  PeelQueue mCandQueue;
 
-  // 候補ノードの印
+  // update_cand_list() でキーを減らす値
   // サイズは node_num()
-  vector<bool> mCandMark;
+  vector<int> mDecCount;
 
-  // 候補ノードの隣接数
-  // サイズは node_num()
-  vector<int> mAdjCount;
-
-  // select_node() で用いる作業用リスト
+  // update_cand_list() でキーを減らすノードのリスト
+  // サイズは node_num() + 1
   vector<int> mTmpList;
 
   // 現在の独立集合
@@ -107,6 +122,9 @@ private:
   // 乱数生成器
   std::mt19937 mRandGen;
 
+  // 打ち切り条件
+  const SearchLimit* mLimit{nullptr};
+
 };
 
 
@@ -114,6 +132,24 @@ private:
 // インライン関数の定義
 //////////////////////////////////////////////////////////////////////
 
+// @brief 乱数の種を設定する．
+// @param[in] seed 乱数の種
+inline
+void
+Isx::set_seed(int seed)
+{
+  mRandGen.seed(seed);
+}
+
+// @brief 打ち切り条件を設定する．
+// @param[in] limit 打ち切り条件
+inline
+void
+Isx::set_limit(const SearchLimit* limit)
+{
+  mLimit = limit;
+}
+
 END_NAMESPACE_YM_UDGRAPH
 
 #endif // ISX_H
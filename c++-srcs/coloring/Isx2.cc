@@ -8,6 +8,7 @@
 
 
 #include "Isx2.h"
+#include "ym/GraphLogger.h"
 #include "ym/Range.h"
 
 
@@ -53,11 +54,21 @@ END_NONAMESPACE
 // @param[in] graph 対象のグラフ
 Isx2::Isx2(const UdGraph& graph) :
   ColGraph(graph),
-  mCandMark(node_num(), false),
-  mAdjCount(node_num(), 0)
+  mDecCount(node_num(), 0),
+  mTmpList(node_num() + 1)
+{
+  mIndepSet.reserve(node_num());
+
+  mRandRatio = 0.5;
+}
+
+// @brief 隣接リストを共有するコンストラクタ
+// @param[in] adj_index 隣接リスト
+Isx2::Isx2(const shared_ptr<const AdjIndex>& adj_index) :
+  ColGraph(adj_index),
+  mDecCount(node_num(), 0),
+  mTmpList(node_num() + 1)
 {
-  mCandList.reserve(node_num());
-  mTmpList.reserve(node_num());
   mIndepSet.reserve(node_num());
 
   mRandRatio = 0.5;
@@ -78,13 +89,25 @@ int
 Isx2::coloring(int limit,
 	      vector<int>& color_map)
 {
+  perf().start();
   int remain_num = node_num();
   int dlimit = 100;
   int slimit = static_cast<int>(edge_num() * 2.0 / (node_num() - 1.0));
+  if ( slimit < 1 ) {
+    slimit = 1;
+  }
+  perf().end_setup();
 
   while ( remain_num > limit ) {
-    {
-      cout << "# of remaining nodes: " << remain_num << endl;
+    if ( mLimit != nullptr && mLimit->is_expired() ) {
+      // 時間切れ
+      break;
+    }
+    perf().count_iteration();
+    if ( GraphLogger::enabled(GraphLogger::Level::Debug) ) {
+      ostringstream buf;
+      buf << "# of remaining nodes: " << remain_num;
+      GraphLogger::log(GraphLogger::Level::Debug, "isx2", buf.str());
     }
 
     int dcount = 0;
@@ -120,8 +143,10 @@ Isx2::coloring(int limit,
       }
     }
 
-    {
-      cout << "choose " << max_iset.size() << " disjoint sets" << endl;
+    if ( GraphLogger::enabled(GraphLogger::Level::Debug) ) {
+      ostringstream buf;
+      buf << "choose " << max_iset.size() << " disjoint sets";
+      GraphLogger::log(GraphLogger::Level::Debug, "isx2", buf.str());
     }
 
     // 選ばれた独立集合に基づいて彩色を行う．
@@ -130,6 +155,7 @@ Isx2::coloring(int limit,
       remain_num -= mIndepSetList[i].size();
     }
   }
+  perf().end_search();
 
   return get_color_map(color_map);
 }
@@ -141,18 +167,19 @@ Isx2::coloring(int limit,
 void
 Isx2::get_indep_set()
 {
-  // 未彩色のノードを cand_list に入れる．
+  // 未彩色のノードを mCandQueue に入れる．
   init_cand_list();
 
   // ノードを一つづつ選択し mIndepSet に入れる．
   mIndepSet.clear();
   {
-    std::uniform_int_distribution<int> rd(0, mCandList.size() - 1);
+    std::uniform_int_distribution<int> rd(0, mCandQueue.size() - 1);
     int r = rd(mRandGen);
-    int node0 = mCandList[r];
+    int node0 = mCandQueue.node(r);
     mIndepSet.push_back(node0);
+    update_cand_list(node0);
   }
-  while ( !mCandList.empty() ) {
+  while ( !mCandQueue.empty() ) {
     int node_id = select_node();
     ASSERT_COND( node_id != -1 );
 
@@ -254,7 +281,8 @@ Isx2::get_max_disjoint_set(vector<int>& max_iset)
   while ( cand_list.size() > 0 ) {
     int n0 = mIndepSetList[cand_list[0]].size();
     int end = 0;
-    for ( ; mIndepSetList[cand_list[end]].size() == n0; ++ end ) { }
+    int nc = cand_list.size();
+    for ( ; end < nc && mIndepSetList[cand_list[end]].size() == n0; ++ end ) { }
     std::uniform_int_distribution<int> rd(0, end - 1);
     int r = rd(mRandGen);
     int i1 = cand_list[r];
@@ -288,23 +316,26 @@ Isx2::get_max_disjoint_set(vector<int>& max_iset)
   }
 }
 
-// @brief mCandList, mCandMark を初期化する．
+// @brief mCandQueue を初期化する．
+//
+// キーは未彩色の隣接ノード数とする．
 void
 Isx2::init_cand_list()
 {
+  int max_degree = 0;
   for ( auto node_id: Range(node_num()) ) {
-    if ( color(node_id) == 0 ) {
-      mCandList.push_back(node_id);
-      mCandMark[node_id] = true;
-    }
+    max_degree = std::max(max_degree, adj_list(node_id).num());
   }
-
-  for ( auto node_id: mCandList ) {
-    mAdjCount[node_id] = 0;
-  }
-  for ( auto node_id: mCandList ) {
-    for ( auto node1_id: adj_list(node_id) ) {
-      ++ mAdjCount[node1_id];
+  mCandQueue.init(node_num(), max_degree);
+  for ( auto node_id: Range(node_num()) ) {
+    if ( color(node_id) == 0 ) {
+      int c = 0;
+      for ( auto node1_id: adj_list(node_id) ) {
+	if ( color(node1_id) == 0 ) {
+	  ++ c;
+	}
+      }
+      mCandQueue.put(node_id, c);
     }
   }
 }
@@ -316,34 +347,23 @@ Isx2::init_cand_list()
 int
 Isx2::select_node()
 {
-  ASSERT_COND( mCandList.size() > 0 );
+  ASSERT_COND( !mCandQueue.empty() );
 
   std::uniform_real_distribution<double> rd_real(0, 1.0);
   if ( rd_real(mRandGen) < mRandRatio ) {
     // 一定の確率でランダムに選ぶ．
-    std::uniform_int_distribution<int> rd_int(0, mCandList.size() - 1);
+    std::uniform_int_distribution<int> rd_int(0, mCandQueue.size() - 1);
     int r = rd_int(mRandGen);
-    return mCandList[r];
+    return mCandQueue.node(r);
   }
   else {
-    mTmpList.clear();
-    int min_num = node_num();
-    for ( auto node_id: mCandList ) {
-      int c = mAdjCount[node_id];
-      if ( min_num >= c ) {
-	if ( min_num > c ) {
-	  min_num = c;
-	  mTmpList.clear();
-	}
-	mTmpList.push_back(node_id);
-      }
-    }
-    int n = mTmpList.size();
+    const auto& min_list = mCandQueue.min_bucket();
+    int n = min_list.size();
     ASSERT_COND( n > 0 );
 
     std::uniform_int_distribution<int> rd_int(0, n - 1);
     int r = rd_int(mRandGen);
-    return mTmpList[r];
+    return min_list[r];
   }
 }
 
@@ -352,30 +372,29 @@ Isx2::select_node()
 void
 Isx2::update_cand_list(int node_id)
 {
-  // node_id と隣接するノードの cand_mark をはずす．
-  mCandMark[node_id] = false;
+  // node_id と隣接するノードを候補から外し，
+  // その隣接ノードのキーを減らす．
+  // 減らす値は mDecCount に数えておいて最後にまとめて減らす．
+  // 密なグラフではこのループが大半を占めるので分岐を用いずに
+  // mTmpList に追加する．
+  mCandQueue.erase(node_id);
+  int tmp_num = 0;
   for ( auto node1_id: adj_list(node_id) ) {
-    if ( mCandMark[node1_id] ) {
-      mCandMark[node1_id] = false;
+    if ( mCandQueue.contains(node1_id) ) {
+      mCandQueue.erase(node1_id);
       for ( auto node2_id: adj_list(node1_id) ) {
-	-- mAdjCount[node2_id];
+	mTmpList[tmp_num] = node2_id;
+	tmp_num += (mDecCount[node2_id] == 0);
+	++ mDecCount[node2_id];
       }
     }
   }
-
-  // cand_mark に従って cand_list を更新する．
-  int n = mCandList.size();
-  int rpos = 0;
-  int wpos = 0;
-  for ( rpos = 0; rpos < n; ++ rpos ) {
-    int node1_id = mCandList[rpos];
-    if ( mCandMark[node1_id] ) {
-      mCandList[wpos] = node1_id;
-      ++ wpos;
+  for ( int i = 0; i < tmp_num; ++ i ) {
+    int node2_id = mTmpList[i];
+    if ( mCandQueue.contains(node2_id) ) {
+      mCandQueue.dec_key(node2_id, mDecCount[node2_id]);
     }
-  }
-  if ( wpos < n ) {
-    mCandList.erase(mCandList.begin() + wpos, mCandList.end());
+    mDecCount[node2_id] = 0;
   }
 }
 
@@ -11,6 +11,8 @@
 
 #include "ym/UdGraph.h"
 #include "ColGraph.h"
+#include "SearchLimit.h"
+#include "PeelQueue.h"
 #include <random>
 
 
@@ -29,6 +31,10 @@ public:
   /// @param[in] graph 対象のグラフ
   Isx2(const UdGraph& graph);
 
+  /// @brief 隣接リストを共有するコンストラクタ
+  /// @param[in] adj_index 隣接リスト
+  Isx2(const shared_ptr<const AdjIndex>& adj_index);
+
   /// @brief デストラクタ
   ~Isx2();
 
@@ -38,6 +44,18 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 乱数の種を設定する．
+  /// @param[in] seed 乱数の種
+  void
+  set_seed(int seed);
+
+  /// @brief 打ち切り条件を設定する．
+  /// @param[in] limit 打ち切り条件
+  ///
+  /// limit が満たされたら残りのノード数に関わらず処理をやめる．
+  void
+  set_limit(const SearchLimit* limit);
+
   /// @brief independent set extraction を用いた coloring を行う．
   /// @param[in] limit 残りのノード数がこの値を下回ったら処理をやめる．
   /// @param[out] color_map 彩色結果を収める配列
@@ -73,7 +91,7 @@ private:
   void
   get_max_disjoint_set(vector<int>& max_iset);
 
-  /// @brief mCandList, mCandMark を初期化する．
+  /// @brief mCandQueue を初期化する．
   void
   init_cand_list();
 
@@ -95,18 +113,15 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 候補ノードのリスト
-  vector<int> mCandList;
+  // 候補ノードを候補の隣接ノード数で分けたもの
+  PeelQueue mCandQueue;
 
-  // 候補ノードの印
+  // update_cand_list() でキーを減らす値
   // サイズは node_num()
-  vector<bool> mCandMark;
+  vector<int> mDecCount;
 
-  // 候補ノードの隣接数
-  // サイズは node_num()
-  vector<int> mAdjCount;
-
-  // select_node() で用いる作業用リスト
+  // update_cand_list() でキーを減らすノードのリスト
+  // サイズは node_num() + 1
   vector<int> mTmpList;
 
   // 現在の独立集合
@@ -118,6 +133,9 @@ private:
   // 乱数生成器
   std::mt19937 mRandGen;
 
+  // 打ち切り条件
+  const SearchLimit* mLimit{nullptr};
+
   // 完全なランダム選択をする確率
   double mRandRatio;
 
@@ -128,6 +146,24 @@ private:
 // インライン関数の定義
 //////////////////////////////////////////////////////////////////////
 
+// @brief 乱数の種を設定する．
+// @param[in] seed 乱数の種
+inline
+void
+Isx2::set_seed(int seed)
+{
+  mRandGen.seed(seed);
+}
+
+// @brief 打ち切り条件を設定する．
+// @param[in] limit 打ち切り条件
+inline
+void
+Isx2::set_limit(const SearchLimit* limit)
+{
+  mLimit = limit;
+}
+
 END_NAMESPACE_YM_UDGRAPH
 
 #endif // ISX2_H
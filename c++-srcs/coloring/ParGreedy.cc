@@ -0,0 +1,329 @@
+
+/// @file ParGreedy.cc
+/// @brief ParGreedy の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ParGreedy.h"
+#include "CoreDecomp.h"
+#include "ym/Range.h"
+#include <atomic>
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+BEGIN_NONAMESPACE
+
+// 1スレッドあたりの最小の要素数
+const int MIN_CHUNK = 1 << 12;
+
+// 64ビットの値をかき混ぜる(splitmix64)．
+std::uint64_t
+mix64(std::uint64_t x)
+{
+  x += 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス ParGreedy
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] adj_index 隣接リスト
+ParGreedy::ParGreedy(const shared_ptr<const AdjIndex>& adj_index) :
+  mAdjIndex{adj_index}
+{
+}
+
+// @brief 乱数の種を設定する．
+// @param[in] seed 乱数の種
+void
+ParGreedy::set_seed(int seed)
+{
+  mSeed = seed;
+}
+
+// @brief スレッド数を設定する．
+// @param[in] thread_num スレッド数(0 以下の場合はハードウェアの並列度)
+void
+ParGreedy::set_thread_num(int thread_num)
+{
+  mThreadNum = thread_num;
+}
+
+// @brief 優先度の種類を設定する．
+// @param[in] priority 優先度の種類
+void
+ParGreedy::set_priority(const string& priority)
+{
+  if ( priority == "random" || priority == "sl" ) {
+    mPriorityType = priority;
+  }
+  else {
+    // デフォルトフォールバック
+    mPriorityType = "ldf";
+  }
+}
+
+// @brief Jones-Plassmann 法で彩色する．
+// @param[out] color_map ノードに対する彩色結果(=int)を収める配列
+// @return 彩色数を返す．
+int
+ParGreedy::jones_plassmann(vector<int>& color_map)
+{
+  mPerf.start();
+  make_pool();
+  calc_priority();
+
+  int n = mAdjIndex->node_num();
+  // 優先度の高い隣接ノードのうちまだ彩色されていないものの数
+  vector<std::atomic<int>> count_array(n);
+  for_chunks(n, [&](int, int begin, int end) {
+    for ( int id = begin; id < end; ++ id ) {
+      int count = 0;
+      for ( auto id1: mAdjIndex->adj_list(id) ) {
+	if ( is_higher(id1, id) ) {
+	  ++ count;
+	}
+      }
+      count_array[id].store(count, std::memory_order_relaxed);
+    }
+  });
+  mPerf.end_setup();
+
+  // 彩色されるノードは優先度の高い隣接ノードが全て彩色済みで，
+  // 優先度の低い隣接ノードは未彩色のまま書き換えられないので，
+  // color_map を排他制御なしに読み書きしてよい．
+  color_map.clear();
+  color_map.resize(n, 0);
+  vector<int> root_list;
+  for ( auto id: Range(n) ) {
+    if ( count_array[id].load(std::memory_order_relaxed) == 0 ) {
+      root_list.push_back(id);
+    }
+  }
+  int nt = ThreadPool::default_thread_num(mThreadNum);
+  vector<vector<int>> next_list(nt);
+  vector<vector<int>> mark_list(nt, vector<int>(mMaxDegree + 2, 0));
+  vector<int> stamp_list(nt, 0);
+  while ( !root_list.empty() ) {
+    mPerf.count_iteration();
+    int nr = root_list.size();
+    for_chunks(nr, [&](int t, int begin, int end) {
+      auto& next = next_list[t];
+      for ( int i = begin; i < end; ++ i ) {
+	int id = root_list[i];
+	color_map[id] = first_fit(id, [&](int id1) { return color_map[id1]; },
+				  mark_list[t], stamp_list[t]);
+	for ( auto id1: mAdjIndex->adj_list(id) ) {
+	  if ( is_higher(id, id1) &&
+	       count_array[id1].fetch_sub(1, std::memory_order_acq_rel) == 1 ) {
+	    next.push_back(id1);
+	  }
+	}
+      }
+    });
+    root_list.clear();
+    for ( auto& next: next_list ) {
+      root_list.insert(root_list.end(), next.begin(), next.end());
+      next.clear();
+    }
+  }
+
+  int nc = compact(color_map);
+  mPool.reset();
+  mPerf.end_search();
+  return nc;
+}
+
+// @brief 投機的に彩色して衝突を解消する．
+// @param[out] color_map ノードに対する彩色結果(=int)を収める配列
+// @return 彩色数を返す．
+int
+ParGreedy::speculative(vector<int>& color_map)
+{
+  mPerf.start();
+  make_pool();
+  calc_priority();
+
+  // 優先度の高い順に並べたノードのリスト
+  int n = mAdjIndex->node_num();
+  vector<int> work_list(n);
+  for ( auto id: Range(n) ) {
+    work_list[id] = id;
+  }
+  sort(work_list.begin(), work_list.end(),
+       [&](int id1, int id2) { return is_higher(id1, id2); });
+  mPerf.end_setup();
+
+  // 他のスレッドが書き換えている色を読むことがあるので atomic で持つ．
+  vector<std::atomic<int>> color_array(n);
+  for ( auto& c: color_array ) {
+    c.store(0, std::memory_order_relaxed);
+  }
+  auto get_color = [&](int id) {
+    return color_array[id].load(std::memory_order_relaxed);
+  };
+
+  int nt = ThreadPool::default_thread_num(mThreadNum);
+  vector<vector<int>> conflict_list(nt);
+  vector<vector<int>> mark_list(nt, vector<int>(mMaxDegree + 2, 0));
+  vector<int> stamp_list(nt, 0);
+  while ( !work_list.empty() ) {
+    mPerf.count_iteration();
+    int nw = work_list.size();
+    // 仮に彩色する．
+    for_chunks(nw, [&](int t, int begin, int end) {
+      for ( int i = begin; i < end; ++ i ) {
+	int id = work_list[i];
+	int c = first_fit(id, get_color, mark_list[t], stamp_list[t]);
+	color_array[id].store(c, std::memory_order_relaxed);
+      }
+    });
+    // 優先度の高い隣接ノードと同じ色になったノードを集める．
+    for_chunks(nw, [&](int t, int begin, int end) {
+      auto& conflict = conflict_list[t];
+      for ( int i = begin; i < end; ++ i ) {
+	int id = work_list[i];
+	int c = get_color(id);
+	for ( auto id1: mAdjIndex->adj_list(id) ) {
+	  if ( get_color(id1) == c && is_higher(id1, id) ) {
+	    conflict.push_back(id);
+	    break;
+	  }
+	}
+      }
+    });
+    // チャンクの順に連結するので優先度の順は保たれる．
+    work_list.clear();
+    for ( auto& conflict: conflict_list ) {
+      work_list.insert(work_list.end(), conflict.begin(), conflict.end());
+      conflict.clear();
+    }
+  }
+
+  color_map.clear();
+  color_map.resize(n);
+  for ( auto id: Range(n) ) {
+    color_map[id] = get_color(id);
+  }
+  int nc = compact(color_map);
+  mPool.reset();
+  mPerf.end_search();
+  return nc;
+}
+
+// @brief 優先度を求める．
+void
+ParGreedy::calc_priority()
+{
+  int n = mAdjIndex->node_num();
+  mPriority.clear();
+  mPriority.resize(n);
+  mMaxDegree = 0;
+  for ( auto id: Range(n) ) {
+    mMaxDegree = std::max(mMaxDegree, mAdjIndex->degree(id));
+  }
+
+  // 上位32ビットを主キー，下位32ビットを乱数とする．
+  auto rand32 = [&](int id) {
+    auto x = mix64((static_cast<std::uint64_t>(mSeed) << 32) ^
+		   static_cast<std::uint32_t>(id));
+    return x & 0xFFFFFFFFULL;
+  };
+  if ( mPriorityType == "sl" ) {
+    // 後から取り除かれたノードほど先に彩色する．
+    CoreDecomp core_decomp(*mAdjIndex);
+    const auto& order = core_decomp.order();
+    for ( auto i: Range(n) ) {
+      auto id = order[i];
+      mPriority[id] = (static_cast<std::uint64_t>(i) << 32) | rand32(id);
+    }
+  }
+  else if ( mPriorityType == "random" ) {
+    for ( auto id: Range(n) ) {
+      mPriority[id] = rand32(id);
+    }
+  }
+  else {
+    for ( auto id: Range(n) ) {
+      auto deg = mAdjIndex->degree(id);
+      mPriority[id] = (static_cast<std::uint64_t>(deg) << 32) | rand32(id);
+    }
+  }
+}
+
+// @brief スレッドプールを用意する．
+void
+ParGreedy::make_pool()
+{
+  int n = mAdjIndex->node_num();
+  int nt = ThreadPool::default_thread_num(mThreadNum);
+  nt = std::min(nt, (n + MIN_CHUNK - 1) / MIN_CHUNK);
+  if ( nt > 1 ) {
+    mPool.reset(new ThreadPool(nt));
+  }
+  else {
+    mPool.reset();
+  }
+}
+
+// @brief 0 から n - 1 までをチャンクに分けて func を適用する．
+// @param[in] n 要素数
+// @param[in] func 適用する関数(引数はチャンク番号と範囲)
+//
+// チャンク数は make_pool() で決めたスレッド数を超えない．
+void
+ParGreedy::for_chunks(int n,
+		      const std::function<void(int, int, int)>& func)
+{
+  int nt = ThreadPool::default_thread_num(mThreadNum);
+  nt = std::min(nt, (n + MIN_CHUNK - 1) / MIN_CHUNK);
+  if ( mPool == nullptr || nt <= 1 ) {
+    func(0, 0, n);
+    return;
+  }
+  mPool->parallel_for(nt, [&](int t) {
+    func(t,
+	 static_cast<std::int64_t>(n) * t / nt,
+	 static_cast<std::int64_t>(n) * (t + 1) / nt);
+  });
+}
+
+// @brief 使われていない色を詰める．
+// @param[inout] color_map 彩色結果
+// @return 彩色数を返す．
+int
+ParGreedy::compact(vector<int>& color_map)
+{
+  int max_color = 0;
+  for ( auto c: color_map ) {
+    max_color = std::max(max_color, c);
+  }
+  vector<int> new_color(max_color + 1, 0);
+  for ( auto c: color_map ) {
+    new_color[c] = 1;
+  }
+  int nc = 0;
+  for ( auto& c: new_color ) {
+    if ( c ) {
+      ++ nc;
+      c = nc;
+    }
+  }
+  for ( auto& c: color_map ) {
+    c = new_color[c];
+  }
+  return nc;
+}
+
+END_NAMESPACE_YM_UDGRAPH
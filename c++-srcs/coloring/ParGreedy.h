@@ -0,0 +1,222 @@
+#ifndef PARGREEDY_H
+#define PARGREEDY_H
+
+/// @file ParGreedy.h
+/// @brief ParGreedy のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/UdGraph.h"
+#include "AdjIndex.h"
+#include "PerfCounter.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <memory>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+//////////////////////////////////////////////////////////////////////
+/// @class ParGreedy ParGreedy.h "ParGreedy.h"
+/// @brief 並列に greedy 彩色を行うクラス
+///
+/// - 各ノードに優先度を与え，優先度の高いノードから順に
+///   隣接ノードで使われていない最小の色を割り当てる．
+/// - 優先度は以下のいずれかとし，同点は乱数で決める．
+///   乱数も等しい場合はノード番号の小さい方を優先するので，
+///   隣接するノードの優先度が等しくなることはない．
+///   - "random" 乱数のみ
+///   - "ldf" 次数の大きい順(largest degree first)
+///   - "sl" smallest-last 順
+/// - jones_plassmann() は優先度の高い隣接ノードが全て彩色された
+///   ノードを並列に彩色する．結果は優先度の順に逐次に
+///   greedy 彩色したものと等しい．
+/// - speculative() は全てのノードを並列に仮に彩色してから
+///   衝突を調べ，優先度の低い側を彩色し直す(Gebremedhin-Manne)．
+///   結果はスレッド数によって変わりうる．
+//////////////////////////////////////////////////////////////////////
+class ParGreedy
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] adj_index 隣接リスト
+  ParGreedy(const shared_ptr<const AdjIndex>& adj_index);
+
+  /// @brief デストラクタ
+  ~ParGreedy() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 乱数の種を設定する．
+  /// @param[in] seed 乱数の種
+  void
+  set_seed(int seed);
+
+  /// @brief スレッド数を設定する．
+  /// @param[in] thread_num スレッド数(0 以下の場合はハードウェアの並列度)
+  void
+  set_thread_num(int thread_num);
+
+  /// @brief 優先度の種類を設定する．
+  /// @param[in] priority 優先度の種類
+  ///
+  /// "random", "ldf", "sl" 以外の場合は "ldf" となる．
+  void
+  set_priority(const string& priority);
+
+  /// @brief Jones-Plassmann 法で彩色する．
+  /// @param[out] color_map ノードに対する彩色結果(=int)を収める配列
+  /// @return 彩色数を返す．
+  int
+  jones_plassmann(vector<int>& color_map);
+
+  /// @brief 投機的に彩色して衝突を解消する．
+  /// @param[out] color_map ノードに対する彩色結果(=int)を収める配列
+  /// @return 彩色数を返す．
+  int
+  speculative(vector<int>& color_map);
+
+  /// @brief 性能計測用のカウンタを返す．
+  const PerfCounter&
+  perf() const
+  {
+    return mPerf;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 優先度を求める．
+  void
+  calc_priority();
+
+  /// @brief スレッドプールを用意する．
+  ///
+  /// ノード数が少なければ作らない．
+  void
+  make_pool();
+
+  /// @brief 0 から n - 1 までをチャンクに分けて func を適用する．
+  /// @param[in] n 要素数
+  /// @param[in] func 適用する関数(引数はチャンク番号と範囲)
+  void
+  for_chunks(int n,
+	     const std::function<void(int, int, int)>& func);
+
+  /// @brief 隣接ノードで使われていない最小の色を返す．
+  /// @param[in] node_id ノード番号
+  /// @param[in] color_func 隣接ノードの色を返す関数
+  /// @param[in] mark 作業用の印の配列
+  /// @param[inout] stamp mark に用いる値
+  template<class ColorFunc>
+  int
+  first_fit(int node_id,
+	    ColorFunc color_func,
+	    vector<int>& mark,
+	    int& stamp) const;
+
+  /// @brief 使われていない色を詰める．
+  /// @param[inout] color_map 彩色結果
+  /// @return 彩色数を返す．
+  static
+  int
+  compact(vector<int>& color_map);
+
+  /// @brief 優先度が高い時 true を返す．
+  ///
+  /// 優先度が等しい場合はノード番号の小さい方を高いとみなす．
+  bool
+  is_higher(int id1,
+	    int id2) const
+  {
+    auto p1 = mPriority[id1];
+    auto p2 = mPriority[id2];
+    return p1 > p2 || (p1 == p2 && id1 < id2);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 隣接リスト
+  shared_ptr<const AdjIndex> mAdjIndex;
+
+  // 乱数の種
+  int mSeed{0};
+
+  // スレッド数
+  int mThreadNum{0};
+
+  // 優先度の種類
+  string mPriorityType{"ldf"};
+
+  // 各ノードの優先度
+  vector<std::uint64_t> mPriority;
+
+  // 最大次数
+  int mMaxDegree{0};
+
+  // スレッドプール
+  //
+  // 段ごとに作り直さないように彩色の間だけ保持する．
+  std::unique_ptr<ThreadPool> mPool;
+
+  // 性能計測用のカウンタ
+  PerfCounter mPerf;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 隣接ノードで使われていない最小の色を返す．
+// @param[in] node_id ノード番号
+// @param[in] color_func 隣接ノードの色を返す関数
+// @param[in] mark 作業用の印の配列
+// @param[inout] stamp mark に用いる値
+template<class ColorFunc>
+inline
+int
+ParGreedy::first_fit(int node_id,
+		     ColorFunc color_func,
+		     vector<int>& mark,
+		     int& stamp) const
+{
+  // 次数 + 1 までの色のどれかは必ず空いている．
+  if ( stamp == numeric_limits<int>::max() ) {
+    // 一巡したら配列を初期化する．
+    std::fill(mark.begin(), mark.end(), 0);
+    stamp = 0;
+  }
+  ++ stamp;
+  for ( auto id: mAdjIndex->adj_list(node_id) ) {
+    int c = color_func(id);
+    if ( c < mark.size() ) {
+      mark[c] = stamp;
+    }
+  }
+  int c = 1;
+  while ( mark[c] == stamp ) {
+    ++ c;
+  }
+  return c;
+}
+
+END_NAMESPACE_YM_UDGRAPH
+
+#endif // PARGREEDY_H
@@ -41,6 +41,17 @@ TabuCol::TabuCol(const UdGraph& graph,
   init();
 }
 
+// @brief 隣接リストを共有するコンストラクタ
+// @param[in] adj_index 隣接リスト
+// @param[in] k 彩色数
+TabuCol::TabuCol(const shared_ptr<const AdjIndex>& adj_index,
+		 int k) :
+  ColGraph(adj_index),
+  mK(k)
+{
+  init();
+}
+
 // @brief 内部データ構造の初期化を行う．
 void
 TabuCol::init()
@@ -48,6 +59,11 @@ TabuCol::init()
   int n = node_num();
   mGammaTable = new int[n * mK];
   mTabuMatrix = new int[n * mK];
+
+  // set_color() が使えるように色数を mK に合わせておく．
+  while ( color_num() < mK ) {
+    new_color();
+  }
 }
 
 // @brief デストラクタ
@@ -72,18 +88,83 @@ TabuCol::coloring(int iter_limit,
 		  double alpha,
 		  vector<int>& color_map)
 {
+  perf().start();
   gen_random_solution();
+  perf().end_setup();
+
+  return search(iter_limit, L, alpha, color_map) == 0;
+}
+
+// @brief 与えられた初期解から局所探索を行う．
+// @param[in] init_map 初期解
+// @param[in] iter_limit 最大の繰り返し回数
+// @param[in] L タブー期間の基本パラメータ
+// @param[in] alpha タブ期間の節点数依存パラメータ
+// @param[out] color_map 探索中に見つかった最良解を入れる配列
+// @return color_map の衝突数を返す．
+int
+TabuCol::improve(const vector<int>& init_map,
+		 int iter_limit,
+		 int L,
+		 double alpha,
+		 vector<int>& color_map)
+{
+  ASSERT_COND( init_map.size() == node_num() );
+
+  perf().start();
+  std::uniform_int_distribution<int> rd_int(1, mK);
+  for ( auto node_id: node_list() ) {
+    int c = init_map[node_id];
+    if ( c < 1 || c > mK ) {
+      c = rd_int(mRandGen);
+    }
+    set_color(node_id, c);
+  }
+  init_tables();
+  perf().end_setup();
+
+  return search(iter_limit, L, alpha, color_map);
+}
+
+// @brief タブーサーチの本体
+// @param[in] iter_limit 最大の繰り返し回数
+// @param[in] L タブー期間の基本パラメータ
+// @param[in] alpha タブ期間の節点数依存パラメータ
+// @param[out] color_map 探索中に見つかった最良解を入れる配列
+// @return color_map の衝突数を返す．
+int
+TabuCol::search(int iter_limit,
+		int L,
+		double alpha,
+		vector<int>& color_map)
+{
+  int best_nc = conflict_num();
+  get_color_map(color_map);
 
   for ( mIter = 0; mIter < iter_limit; ++ mIter ) {
     int nc = conflict_num();
+    if ( best_nc > nc ) {
+      best_nc = nc;
+      get_color_map(color_map);
+    }
     if ( nc == 0 ) {
       break;
     }
+    if ( mLimit != nullptr && (mIter % 64) == 0 && mLimit->is_expired() ) {
+      // 時間切れ
+      break;
+    }
+
+    perf().count_iteration();
 
     // 最良ムーブを取り出す．
     auto p = get_move();
     int node_id = p.first;
     int col = p.second;
+    if ( node_id == -1 ) {
+      // 全てのムーブが禁止されていた．
+      continue;
+    }
 
     // 逆のムーブをタブーリストに加える．
     int tenure = L + static_cast<int>(alpha * nc);
@@ -95,6 +176,7 @@ TabuCol::coloring(int iter_limit,
     ASSERT_COND( old_col != col );
 
     set_color(node_id, col);
+    perf().count_move();
 
     for ( auto node1_id: adj_list(node_id) ) {
       -- mGammaTable[encode(node1_id, old_col)];
@@ -102,17 +184,20 @@ TabuCol::coloring(int iter_limit,
     }
   }
 
-  get_color_map(color_map);
+  int nc = conflict_num();
+  if ( best_nc > nc ) {
+    best_nc = nc;
+    get_color_map(color_map);
+  }
+  perf().end_search();
 
-  return conflict_num() == 0;
+  return best_nc;
 }
 
 // @brief 初期解を作る．
 void
 TabuCol::gen_random_solution()
 {
-  int n = node_num();
-
   // ランダムに色を割り当てる．
   for ( auto node_id: node_list() ) {
     std::uniform_int_distribution<int> rd_int(0, mK - 1);
@@ -120,6 +205,17 @@ TabuCol::gen_random_solution()
     set_color(node_id, color);
   }
 
+  init_tables();
+}
+
+// @brief γテーブルとタブーリストを初期化する．
+//
+// 全ての節点が彩色されていると仮定している．
+void
+TabuCol::init_tables()
+{
+  int n = node_num();
+
   // mGammaTable を初期化する．
   for ( auto i: Range(n * mK) ) {
     mGammaTable[i] = 0;
@@ -138,6 +234,8 @@ TabuCol::gen_random_solution()
 }
 
 // @brief γ(node, col) が最小となる move を得る．
+//
+// 全てのムーブが禁止されていた場合は (-1, -1) を返す．
 pair<int, int>
 TabuCol::get_move()
 {
@@ -176,8 +274,11 @@ TabuCol::get_move()
   }
 
   int n = cand_list.size();
-  ASSERT_COND( n > 0 );
-  if ( n == 1 ) {
+  if ( n == 0 ) {
+    // 全てのムーブがタブーリストで禁止されていた．
+    return make_pair(-1, -1);
+  }
+  else if ( n == 1 ) {
     return cand_list[0];
   }
   else {
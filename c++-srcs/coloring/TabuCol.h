@@ -11,6 +11,7 @@
 
 #include "ym/UdGraph.h"
 #include "ColGraph.h"
+#include "SearchLimit.h"
 #include <random>
 
 
@@ -39,6 +40,12 @@ public:
 	  const vector<int>& color_map,
 	  int k);
 
+  /// @brief 隣接リストを共有するコンストラクタ
+  /// @param[in] adj_index 隣接リスト
+  /// @param[in] k 彩色数
+  TabuCol(const shared_ptr<const AdjIndex>& adj_index,
+	  int k);
+
   /// @brief デストラクタ
   ~TabuCol();
 
@@ -63,6 +70,35 @@ public:
 	   double alpha,
 	   vector<int>& color_map);
 
+  /// @brief 与えられた初期解から局所探索を行う．
+  /// @param[in] init_map 初期解
+  /// @param[in] iter_limit 最大の繰り返し回数
+  /// @param[in] L タブー期間の基本パラメータ
+  /// @param[in] alpha タブ期間の節点数依存パラメータ
+  /// @param[out] color_map 探索中に見つかった最良解を入れる配列
+  /// @return color_map の衝突数を返す．
+  ///
+  /// - init_map[i] が 1 から k の範囲にない節点はランダムに彩色する．
+  /// - 戻り値が 0 なら color_map は正しい k 彩色になっている．
+  int
+  improve(const vector<int>& init_map,
+	  int iter_limit,
+	  int L,
+	  double alpha,
+	  vector<int>& color_map);
+
+  /// @brief 乱数の種を設定する．
+  /// @param[in] seed 乱数の種
+  void
+  set_seed(int seed);
+
+  /// @brief 打ち切り条件を設定する．
+  /// @param[in] limit 打ち切り条件
+  ///
+  /// limit が満たされたら iter_limit に達していなくても探索を終える．
+  void
+  set_limit(const SearchLimit* limit);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -77,7 +113,27 @@ private:
   void
   gen_random_solution();
 
+  /// @brief γテーブルとタブーリストを初期化する．
+  ///
+  /// 全ての節点が彩色されていると仮定している．
+  void
+  init_tables();
+
+  /// @brief タブーサーチの本体
+  /// @param[in] iter_limit 最大の繰り返し回数
+  /// @param[in] L タブー期間の基本パラメータ
+  /// @param[in] alpha タブ期間の節点数依存パラメータ
+  /// @param[out] color_map 探索中に見つかった最良解を入れる配列
+  /// @return color_map の衝突数を返す．
+  int
+  search(int iter_limit,
+	 int L,
+	 double alpha,
+	 vector<int>& color_map);
+
   /// @brief γ(node_id, col) が最小となる move を得る．
+  ///
+  /// 全てのムーブが禁止されていた場合は (-1, -1) を返す．
   pair<int, int>
   get_move();
 
@@ -138,6 +194,9 @@ private:
   // 乱数発生器
   std::mt19937 mRandGen;
 
+  // 打ち切り条件
+  const SearchLimit* mLimit{nullptr};
+
 };
 
 
@@ -182,6 +241,24 @@ TabuCol::check_tabu(int node_id,
   return mTabuMatrix[encode(node_id, col)] <= mIter;
 }
 
+// @brief 乱数の種を設定する．
+// @param[in] seed 乱数の種
+inline
+void
+TabuCol::set_seed(int seed)
+{
+  mRandGen.seed(seed);
+}
+
+// @brief 打ち切り条件を設定する．
+// @param[in] limit 打ち切り条件
+inline
+void
+TabuCol::set_limit(const SearchLimit* limit)
+{
+  mLimit = limit;
+}
+
 // @brief 節点と色番号からインデックスを作る．
 inline
 int
@@ -3,45 +3,173 @@
 /// @brief coloring の実装ファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
-/// Copyright (C) 2018 Yusuke Matsunaga
+/// Copyright (C) 2018, 2022 Yusuke Matsunaga
 /// All rights reserved.
 
 
 #include "ym/UdGraph.h"
+#include "ColControl.h"
 #include "Dsatur.h"
 #include "IsCov.h"
 #include "Isx.h"
 #include "Isx2.h"
 #include "TabuCol.h"
+#include "Hea.h"
+#include "ParGreedy.h"
+#include "ColLowerBound.h"
+#include "ThreadPool.h"
+#include "GraphDecomp.h"
+#include "ym/Range.h"
+#include <mutex>
+#include <algorithm>
 
 
 BEGIN_NAMESPACE_YM
 
+using nsUdGraph::ColControl;
+using nsUdGraph::AdjIndex;
+using nsUdGraph::PerfCounter;
+
 // dsatur で彩色問題を解く．
 int
-dsatur(const UdGraph& graph,
+dsatur(const shared_ptr<const AdjIndex>& adj_index,
+       ColControl& ctrl,
        vector<int>& color_map)
+{
+  nsUdGraph::Dsatur dsatsolver(adj_index);
+  int nc = dsatsolver.coloring(color_map);
+  ctrl.add_perf(dsatsolver.perf());
+  ctrl.update(nc, color_map, "dsatur");
+  return nc;
+}
+
+// 部分的な彩色結果を dsatur で完成させる．
+int
+dsatur_complete(const UdGraph& graph,
+		ColControl& ctrl,
+		const string& solver,
+		vector<int>& color_map)
 {
   nsUdGraph::Dsatur dsatsolver(graph, color_map);
-  return dsatsolver.coloring(color_map);
+  int nc = dsatsolver.coloring(color_map);
+  ctrl.add_perf(dsatsolver.perf());
+  ctrl.update(nc, color_map, solver);
+  return nc;
+}
+
+// iscov で彩色問題を解く．
+int
+iscov(const UdGraph& graph,
+      const shared_ptr<const AdjIndex>& adj_index,
+      ColControl& ctrl,
+      vector<int>& color_map)
+{
+  nsUdGraph::IsCov iscsolver(adj_index);
+  iscsolver.set_seed(ctrl.options().seed);
+  iscsolver.set_limit(&ctrl);
+  iscsolver.covering(ctrl.options().extract_limit, color_map);
+  ctrl.add_perf(iscsolver.perf());
+  return dsatur_complete(graph, ctrl, "iscov", color_map);
+}
+
+// isx で彩色問題を解く．
+int
+isx(const UdGraph& graph,
+    const shared_ptr<const AdjIndex>& adj_index,
+    ColControl& ctrl,
+    vector<int>& color_map)
+{
+  nsUdGraph::Isx isxsolver(adj_index);
+  isxsolver.set_seed(ctrl.options().seed);
+  isxsolver.set_limit(&ctrl);
+  isxsolver.coloring(ctrl.options().extract_limit, color_map);
+  ctrl.add_perf(isxsolver.perf());
+  return dsatur_complete(graph, ctrl, "isx", color_map);
+}
+
+// isx2 で彩色問題を解く．
+int
+isx2(const UdGraph& graph,
+     const shared_ptr<const AdjIndex>& adj_index,
+     ColControl& ctrl,
+     vector<int>& color_map)
+{
+  nsUdGraph::Isx2 isxsolver(adj_index);
+  isxsolver.set_seed(ctrl.options().seed);
+  isxsolver.set_limit(&ctrl);
+  isxsolver.coloring(ctrl.options().extract_limit, color_map);
+  ctrl.add_perf(isxsolver.perf());
+  return dsatur_complete(graph, ctrl, "isx2", color_map);
+}
+
+// 並列 greedy で彩色問題を解く．
+//
+// speculative が true なら投機的に彩色し，false なら Jones-Plassmann 法で彩色する．
+int
+parallel_greedy(const shared_ptr<const AdjIndex>& adj_index,
+		ColControl& ctrl,
+		bool speculative,
+		vector<int>& color_map)
+{
+  const auto& options = ctrl.options();
+  nsUdGraph::ParGreedy pgsolver(adj_index);
+  pgsolver.set_seed(options.seed);
+  pgsolver.set_thread_num(options.thread_num);
+  pgsolver.set_priority(options.greedy_priority);
+  int nc;
+  string solver;
+  if ( speculative ) {
+    nc = pgsolver.speculative(color_map);
+    solver = "parallel-greedy";
+  }
+  else {
+    nc = pgsolver.jones_plassmann(color_map);
+    solver = "parallel-greedy-jp";
+  }
+  ctrl.add_perf(pgsolver.perf());
+  ctrl.update(nc, color_map, solver);
+  return nc;
+}
+
+// 彩色数の下界を求めて ctrl に設定する．
+void
+set_lower_bound(const UdGraph& graph,
+		const shared_ptr<const AdjIndex>& adj_index,
+		ColControl& ctrl)
+{
+  nsUdGraph::ColLowerBound lbsolver(graph, adj_index);
+  ctrl.set_lower_bound(lbsolver.lower_bound());
 }
 
 // tabucol で彩色問題を解く．
+//
+// - 他のスレッドがより良い解を見つけていたらその彩色数から探索を続ける．
+// - 彩色数が下界に達したら終わる．
 int
-tabucol(const UdGraph& graph,
+tabucol(const shared_ptr<const AdjIndex>& adj_index,
+	ColControl& ctrl,
 	vector<int>& color_map)
 {
-  int k0 = dsatur(graph, color_map);
-  int limit = 100000;
-  int L = 9;
-  double alpha = 0.6;
-  int k1 = k0;
-  for ( int k = k0; k > 0; -- k ) {
-    nsUdGraph::TabuCol tabucol(graph, k);
+  const auto& options = ctrl.options();
+  int k1 = dsatur(adj_index, ctrl, color_map);
+  int limit = ctrl.iter_limit(100000);
+  int L = options.tabu_tenure;
+  double alpha = options.tabu_alpha;
+  for ( ; ; ) {
+    int k = std::min(k1, ctrl.best_num()) - 1;
+    if ( k < std::max(ctrl.lower_bound(), 1) || ctrl.is_expired() ) {
+      break;
+    }
+    nsUdGraph::TabuCol tabucol(adj_index, k);
+    tabucol.set_seed(options.seed + k);
+    tabucol.set_limit(&ctrl);
     vector<int> color_map1;
-    if ( tabucol.coloring(limit, L, alpha, color_map1) ) {
+    bool found = tabucol.coloring(limit, L, alpha, color_map1);
+    ctrl.add_perf(tabucol.perf());
+    if ( found ) {
       k1 = k;
-      color_map = color_map1;
+      color_map.swap(color_map1);
+      ctrl.update(k1, color_map, "tabucol");
     }
     else {
       break;
@@ -50,50 +178,272 @@ tabucol(const UdGraph& graph,
   return k1;
 }
 
-// @brief 彩色問題を解く
-// @param[in] algorithm アルゴリズム名
-// @return 彩色数とノードに対する彩色結果(=int)を収める配列(vector)を返す．
+// hea で彩色問題を解く．
 //
-// 結果の配列のサイズは node_num()
+// - 他のスレッドがより良い解を見つけていたらその彩色数から探索を続ける．
+// - 彩色数が下界に達したら終わる．
+int
+hea(const shared_ptr<const AdjIndex>& adj_index,
+    ColControl& ctrl,
+    int thread_num,
+    vector<int>& color_map)
+{
+  const auto& options = ctrl.options();
+  int k1 = dsatur(adj_index, ctrl, color_map);
+  nsUdGraph::Hea heasolver(adj_index);
+  heasolver.set_seed(options.seed);
+  heasolver.set_thread_num(thread_num);
+  heasolver.set_tabu_param(ctrl.iter_limit(2000),
+			   options.tabu_tenure, options.tabu_alpha);
+  heasolver.set_limit(&ctrl);
+  for ( ; ; ) {
+    int k = std::min(k1, ctrl.best_num()) - 1;
+    if ( k < std::max(ctrl.lower_bound(), 1) || ctrl.is_expired() ) {
+      break;
+    }
+    vector<int> color_map1;
+    if ( heasolver.k_coloring(k, color_map1) ) {
+      k1 = k;
+      color_map.swap(color_map1);
+      ctrl.update(k1, color_map, "hea");
+    }
+    else {
+      break;
+    }
+  }
+  ctrl.add_perf(heasolver.perf());
+  return k1;
+}
+
+// 複数のアルゴリズムを並列に走らせて彩色問題を解く．
+//
+// - 隣接リストは全てのアルゴリズムで共有する．
+// - 最良解の彩色数が下界に達したら ctrl.update() の中で
+//   cancel() が呼ばれ，残りのアルゴリズムは打ち切られる．
+int
+portfolio(const UdGraph& graph,
+	  const shared_ptr<const AdjIndex>& adj_index,
+	  ColControl& ctrl,
+	  vector<int>& color_map)
+{
+  using SolverFunc = std::function<int(vector<int>&)>;
+  vector<SolverFunc> solver_list{
+    [&](vector<int>& cmap) { return dsatur(adj_index, ctrl, cmap); },
+    [&](vector<int>& cmap) { return tabucol(adj_index, ctrl, cmap); },
+    [&](vector<int>& cmap) { return hea(adj_index, ctrl, 1, cmap); },
+    [&](vector<int>& cmap) { return isx(graph, adj_index, ctrl, cmap); },
+    [&](vector<int>& cmap) { return isx2(graph, adj_index, ctrl, cmap); },
+    [&](vector<int>& cmap) { return iscov(graph, adj_index, ctrl, cmap); },
+  };
+  int solver_num = solver_list.size();
+  int thread_num = ThreadPool::default_thread_num(ctrl.options().thread_num);
+  ThreadPool pool(std::min(thread_num, solver_num));
+  pool.parallel_for(solver_num, [&](int i) {
+    // 各アルゴリズムの結果は ctrl に登録される．
+    vector<int> cmap;
+    solver_list[i](cmap);
+  });
+
+  color_map = ctrl.best_map();
+  return ctrl.best_num();
+}
+
+// 並べ替えたグラフの彩色結果を元のノード番号に戻す．
+vector<int>
+restore_color_map(const vector<int>& order,
+		  const vector<int>& color_map1)
+{
+  vector<int> color_map(order.size());
+  for ( auto i: Range(order.size()) ) {
+    color_map[order[i]] = color_map1[i];
+  }
+  return color_map;
+}
+
+// 連結成分に分割せずに彩色問題を解く．
 pair<int, vector<int>>
-UdGraph::coloring(const string& algorithm) const
+coloring_sub(const UdGraph& graph,
+	     const string& algorithm,
+	     const UdGraph::ColoringOptions& options,
+	     UdGraph::ColoringStats& stats)
 {
+  PerfCounter perf;
+  perf.start();
+  ColControl ctrl(options);
+  shared_ptr<const AdjIndex> adj_index{new AdjIndex(graph)};
+  if ( algorithm == "tabucol" || algorithm == "hea" ||
+       algorithm == "portfolio" ) {
+    set_lower_bound(graph, adj_index, ctrl);
+  }
+  perf.end_setup();
+
   vector<int> color_map;
-  int nc;
   if ( algorithm == "dsatur" ) {
-    nc = dsatur(*this, color_map);
+    dsatur(adj_index, ctrl, color_map);
   }
   else if ( algorithm == "iscov" ) {
-    nsUdGraph::IsCov iscsolver(*this);
-    int c = iscsolver.covering(500, color_map);
-    nsUdGraph::Dsatur dsatsolver(*this, color_map);
-    nc = dsatsolver.coloring(color_map);
+    iscov(graph, adj_index, ctrl, color_map);
   }
   else if ( algorithm == "isx" ) {
-    nsUdGraph::Isx isxsolver(*this);
-    int c = isxsolver.coloring(500, color_map);
-    //cout << "isx end: c = " << c << endl;
-    nsUdGraph::Dsatur dsatsolver(*this, color_map);
-    //return dsatsolver.coloring(color_map);
-    nc = dsatsolver.coloring(color_map);
-    //cout << "dsatur end: c = " << nc << endl;
+    isx(graph, adj_index, ctrl, color_map);
   }
   else if ( algorithm == "isx2" ) {
-    nsUdGraph::Isx2 isxsolver(*this);
-    int c = isxsolver.coloring(500, color_map);
-    //cout << "isx2 end: c = " << c << endl;
-    nsUdGraph::Dsatur dsatsolver(*this, color_map);
-    //return dsatsolver.coloring(color_map);
-    nc = dsatsolver.coloring(color_map);
-    //cout << "dsatur end: c = " << nc << endl;
+    isx2(graph, adj_index, ctrl, color_map);
   }
   else if ( algorithm == "tabucol" ) {
-    nc = tabucol(*this, color_map);
+    tabucol(adj_index, ctrl, color_map);
+  }
+  else if ( algorithm == "hea" ) {
+    hea(adj_index, ctrl, options.thread_num, color_map);
+  }
+  else if ( algorithm == "portfolio" ) {
+    portfolio(graph, adj_index, ctrl, color_map);
+  }
+  else if ( algorithm == "parallel-greedy" ) {
+    parallel_greedy(adj_index, ctrl, true, color_map);
+  }
+  else if ( algorithm == "parallel-greedy-jp" ) {
+    parallel_greedy(adj_index, ctrl, false, color_map);
   }
   else {
     // デフォルトフォールバック
-    nc = dsatur(*this, color_map);
+    dsatur(adj_index, ctrl, color_map);
+  }
+  perf.end_search();
+  ctrl.add_perf(perf);
+
+  stats.solver = ctrl.best_solver();
+  stats.lower_bound = ctrl.lower_bound();
+  ctrl.perf().add_to(stats.perf);
+  return {ctrl.best_num(), ctrl.best_map()};
+}
+
+
+// @brief 彩色問題を解く
+// @param[in] algorithm アルゴリズム名
+// @return 彩色数とノードに対する彩色結果(=int)を収める配列(vector)を返す．
+//
+// 結果の配列のサイズは node_num()
+pair<int, vector<int>>
+UdGraph::coloring(const string& algorithm) const
+{
+  return coloring(algorithm, ColoringOptions{});
+}
+
+// @brief オプションを指定して彩色問題を解く
+// @param[in] algorithm アルゴリズム名
+// @param[in] options オプション
+// @return 彩色数とノードに対する彩色結果(=int)を収める配列(vector)を返す．
+pair<int, vector<int>>
+UdGraph::coloring(const string& algorithm,
+		  const ColoringOptions& options) const
+{
+  ColoringStats stats;
+  return coloring(algorithm, options, stats);
+}
+
+// @brief オプションを指定して彩色問題を解く
+// @param[in] algorithm アルゴリズム名
+// @param[in] options オプション
+// @param[out] stats 実行結果に関する情報
+// @return 彩色数とノードに対する彩色結果(=int)を収める配列(vector)を返す．
+//
+// 複数の連結成分からなる場合は部分グラフごとに並列に解く．
+// 彩色数は各部分グラフの彩色数の最大値となる．
+pair<int, vector<int>>
+UdGraph::coloring(const string& algorithm,
+		  const ColoringOptions& options,
+		  ColoringStats& stats) const
+{
+  stats.perf = PerfStats{};
+  if ( !options.reorder.empty() ) {
+    // 並べ替えたグラフで解いて結果を元のノード番号に戻す．
+    auto order = node_order(options.reorder);
+    auto graph1 = relabel(order);
+    ColoringOptions options1{options};
+    options1.reorder = string();
+    if ( options.callback ) {
+      options1.callback = [&](int k, const vector<int>& color_map1) {
+	options.callback(k, restore_color_map(order, color_map1));
+      };
+    }
+    auto ans = graph1.coloring(algorithm, options1, stats);
+    return {ans.first, restore_color_map(order, ans.second)};
+  }
+
+  nsUdGraph::GraphDecomp decomp(*this);
+  int np = decomp.part_num();
+  if ( np <= 1 ) {
+    return coloring_sub(*this, algorithm, options, stats);
+  }
+
+  // 制限時間と途中結果のコールバックは ctrl で全体で共有する．
+  ColControl ctrl(options);
+  // 部分グラフごとの途中結果をまとめたもの
+  std::mutex cur_mutex;
+  vector<int> cur_map(node_num(), 0);
+  vector<int> cur_num(np, 0);
+  int cur_part_num = 0;
+  // 部分グラフ i の途中結果を登録する．
+  // 全ての部分グラフの解が揃ったら全体の途中結果として ctrl に登録する．
+  auto update = [&](int i,
+		    int k,
+		    const vector<int>& color_map1) {
+    std::unique_lock<std::mutex> lock(cur_mutex);
+    const auto& node_map = decomp.node_map(i);
+    for ( auto id: Range(node_map.size()) ) {
+      cur_map[node_map[id]] = color_map1[id];
+    }
+    if ( cur_num[i] == 0 ) {
+      ++ cur_part_num;
+    }
+    cur_num[i] = k;
+    if ( cur_part_num == np ) {
+      int nc = *std::max_element(cur_num.begin(), cur_num.end());
+      ctrl.update(nc, cur_map, algorithm);
+    }
+  };
+
+  vector<pair<int, vector<int>>> ans_list(np);
+  vector<ColoringStats> stats_list(np);
+  int thread_num = ThreadPool::default_thread_num(options.thread_num);
+  ThreadPool pool(std::min(thread_num, np));
+  pool.parallel_for(np, [&](int i) {
+    // 部分グラフの中では大きさに応じたスレッド数を用いる．
+    // 巨大な連結成分があればほぼ全てのスレッドがそこに割り当てられる．
+    ColoringOptions options1{options};
+    options1.thread_num = decomp.part_thread_num(i, thread_num);
+    if ( ctrl.has_deadline() ) {
+      options1.time_limit = std::max(ctrl.remaining_time(), 1e-6);
+    }
+    if ( options.callback ) {
+      options1.callback = [&, i](int k, const vector<int>& color_map1) {
+	update(i, k, color_map1);
+      };
+    }
+    ans_list[i] = coloring_sub(decomp.part_graph(i), algorithm,
+			       options1, stats_list[i]);
+  });
+
+  // 結果をまとめる．
+  int nc = 0;
+  vector<int> color_map(node_num(), 0);
+  stats.lower_bound = 0;
+  for ( auto i: Range(np) ) {
+    const auto& node_map = decomp.node_map(i);
+    const auto& color_map1 = ans_list[i].second;
+    for ( auto id: Range(node_map.size()) ) {
+      color_map[node_map[id]] = color_map1[id];
+    }
+    if ( nc < ans_list[i].first ) {
+      nc = ans_list[i].first;
+      stats.solver = stats_list[i].solver;
+    }
+    stats.lower_bound = std::max(stats.lower_bound, stats_list[i].lower_bound);
+    PerfCounter::add_stats(stats.perf, stats_list[i].perf);
   }
+  // 途中結果として報告済みでなければコールバックを呼ぶ．
+  ctrl.update(nc, color_map, stats.solver);
   return {nc, color_map};
 }
 
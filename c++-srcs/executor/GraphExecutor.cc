@@ -0,0 +1,129 @@
+
+/// @file GraphExecutor.cc
+/// @brief GraphExecutor の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/GraphExecutor.h"
+#include "ThreadPool.h"
+#include <memory>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// スレッドプールを保護する mutex
+std::mutex pool_mutex;
+
+// スレッドプール
+//
+// 最初に使われる時に作る．
+std::unique_ptr<ThreadPool> the_pool;
+
+// 指定されたスレッド数
+int pool_thread_num = 0;
+
+// func をスレッドプールで実行する．
+template<typename T,
+	 typename F>
+GraphFuture<T>
+submit(F&& func)
+{
+  // ThreadPool::Task はコピーできなければならないので
+  // packaged_task は shared_ptr で持つ．
+  auto task = std::make_shared<std::packaged_task<T()>>(std::forward<F>(func));
+  GraphFuture<T> future{task->get_future().share()};
+  std::unique_lock<std::mutex> lck{pool_mutex};
+  if ( the_pool == nullptr ) {
+    the_pool.reset(new ThreadPool(pool_thread_num));
+  }
+  the_pool->submit([task]() { (*task)(); });
+  return future;
+}
+
+END_NONAMESPACE
+
+// @brief スレッドプールのスレッド数を設定する．
+// @param[in] thread_num スレッド数
+void
+GraphExecutor::set_thread_num(int thread_num)
+{
+  std::unique_lock<std::mutex> lck{pool_mutex};
+  pool_thread_num = thread_num;
+  // ThreadPool のデストラクタは未処理のタスクを全て実行してから終わる．
+  the_pool = nullptr;
+}
+
+// @brief スレッドプールのスレッド数を返す．
+int
+GraphExecutor::thread_num()
+{
+  std::unique_lock<std::mutex> lck{pool_mutex};
+  return ThreadPool::default_thread_num(pool_thread_num);
+}
+
+// @brief 彩色問題を非同期に解く．
+// @param[in] graph 対象のグラフ
+// @param[in] algorithm アルゴリズム名
+// @param[in] options オプション
+GraphFuture<GraphExecutor::ColoringResult>
+GraphExecutor::coloring(const UdGraph& graph,
+			const string& algorithm,
+			const UdGraph::ColoringOptions& options)
+{
+  return submit<ColoringResult>([graph, algorithm, options]() {
+    return graph.coloring(algorithm, options);
+  });
+}
+
+// @brief 最大独立集合を非同期に求める．
+// @param[in] graph 対象のグラフ
+// @param[in] algorithm アルゴリズム名
+GraphFuture<vector<int>>
+GraphExecutor::independent_set(const UdGraph& graph,
+			       const string& algorithm)
+{
+  return submit<vector<int>>([graph, algorithm]() {
+    return graph.independent_set(algorithm);
+  });
+}
+
+// @brief 最大クリークを非同期に求める．
+// @param[in] graph 対象のグラフ
+// @param[in] algorithm アルゴリズム名
+GraphFuture<vector<int>>
+GraphExecutor::max_clique(const UdGraph& graph,
+			  const string& algorithm)
+{
+  return submit<vector<int>>([graph, algorithm]() {
+    return graph.max_clique(algorithm);
+  });
+}
+
+// @brief 最大重みマッチングを非同期に求める．
+// @param[in] graph 対象のグラフ
+// @param[in] algorithm アルゴリズム名
+GraphFuture<vector<int>>
+GraphExecutor::max_matching(const UdGraph& graph,
+			    const string& algorithm)
+{
+  return submit<vector<int>>([graph, algorithm]() {
+    return graph.max_matching(algorithm);
+  });
+}
+
+// @brief 2部グラフの最大マッチングを非同期に求める．
+// @param[in] graph 対象のグラフ
+GraphFuture<vector<int>>
+GraphExecutor::max_matching(const BiGraph& graph)
+{
+  return submit<vector<int>>([graph]() {
+    return graph.max_matching();
+  });
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,651 @@
+
+/// @file GraphGen.cc
+/// @brief GraphGen の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/GraphGen.h"
+#include "ThreadPool.h"
+#include "ym/Range.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// チャンク数の上限
+//
+// スレッド数に依存しないように固定しておく．
+const int CHUNK_NUM = 256;
+
+// 順列を作る時に用いる乱数系列の番号
+//
+// チャンクの乱数系列(0 〜 CHUNK_NUM - 1)と重ならないようにする．
+const std::uint64_t PERM_STREAM = CHUNK_NUM;
+
+// splitmix64 の攪拌関数
+inline
+std::uint64_t
+mix64(std::uint64_t x)
+{
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// 64ビットの値を [0, 1) の実数に変換する．
+inline
+double
+to_real(std::uint64_t x)
+{
+  return (x >> 11) * (1.0 / 9007199254740992.0);
+}
+
+//////////////////////////////////////////////////////////////////////
+// 乱数生成器
+//
+// splitmix64 をそのまま用いる．
+// 標準ライブラリの分布は実装依存なので使わない．
+//////////////////////////////////////////////////////////////////////
+class GenRand
+{
+public:
+
+  // コンストラクタ
+  GenRand(int seed,
+	  std::uint64_t stream) :
+    mState{mix64(mix64(static_cast<std::uint64_t>(seed)) + stream)}
+  {
+  }
+
+  // 64ビットの乱数を返す．
+  std::uint64_t
+  next()
+  {
+    mState += 0x9e3779b97f4a7c15ULL;
+    return mix64(mState);
+  }
+
+  // [0, 1) の実数を返す．
+  double
+  real()
+  {
+    return to_real(next());
+  }
+
+  // [0, n) の整数を返す．
+  std::uint64_t
+  below(std::uint64_t n)
+  {
+    return next() % n;
+  }
+
+
+private:
+
+  // 内部状態
+  std::uint64_t mState;
+
+};
+
+// 生成途中の枝
+struct GenEdge
+{
+  int id1;
+  int id2;
+};
+
+// チャンクごとの枝のリスト
+using ChunkList = vector<vector<GenEdge>>;
+
+// チャンクごとに func を並列に実行する．
+ChunkList
+run_chunks(int chunk_num,
+	   int thread_num,
+	   const std::function<void(int, vector<GenEdge>&)>& func)
+{
+  ChunkList chunk_list(chunk_num);
+  if ( chunk_num == 0 ) {
+    return chunk_list;
+  }
+  int nt = std::min(ThreadPool::default_thread_num(thread_num), chunk_num);
+  ThreadPool pool(nt);
+  pool.parallel_for(chunk_num, [&](int c) {
+    func(c, chunk_list[c]);
+  });
+  return chunk_list;
+}
+
+// 行を重みがほぼ等しいチャンクに分割する．
+//
+// チャンク c は行 [bound[c], bound[c + 1]) を受け持つ．
+vector<int>
+split_rows(int row_num,
+	   const std::function<double(int)>& weight)
+{
+  double total = 0.0;
+  for ( auto i: Range(row_num) ) {
+    total += weight(i);
+  }
+  int chunk_num = std::min(CHUNK_NUM, row_num);
+  vector<int> bound{0};
+  double acc = 0.0;
+  for ( auto i: Range(row_num) ) {
+    acc += weight(i);
+    if ( bound.size() < chunk_num &&
+	 acc >= total * bound.size() / chunk_num ) {
+      bound.push_back(i + 1);
+    }
+  }
+  if ( bound.back() != row_num ) {
+    bound.push_back(row_num);
+  }
+  return bound;
+}
+
+// [0, total) を chunk_num 個に等分した時の c 番目の開始位置
+inline
+std::uint64_t
+chunk_begin(std::uint64_t total,
+	    int chunk_num,
+	    int c)
+{
+  std::uint64_t uc = c;
+  return total / chunk_num * uc + std::min(uc, total % chunk_num);
+}
+
+// 列 [begin, end) の各列を確率 prob で選んで func(col) を呼ぶ．
+//
+// 選ばれた列の間隔が幾何分布に従うことを利用して
+// 選ばれない列を読み飛ばす．
+template<class Func>
+void
+sample_row(GenRand& rand,
+	   double prob,
+	   int begin,
+	   int end,
+	   Func func)
+{
+  if ( prob >= 1.0 ) {
+    for ( int col = begin; col < end; ++ col ) {
+      func(col);
+    }
+    return;
+  }
+  if ( prob <= 0.0 ) {
+    return;
+  }
+  double log_q = std::log(1.0 - prob);
+  double col = begin - 1;
+  for ( ; ; ) {
+    // 1 - real() は (0, 1] なので log は有限となる．
+    col += 1.0 + std::floor(std::log(1.0 - rand.real()) / log_q);
+    if ( col >= end ) {
+      break;
+    }
+    func(static_cast<int>(col));
+  }
+}
+
+// G(n, p) の枝をチャンクごとに作る．
+//
+// skip(i, j) が true のノード対は除外する．
+template<class Skip>
+ChunkList
+gnp_chunks(int seed,
+	   int thread_num,
+	   int node_num,
+	   double prob,
+	   Skip skip)
+{
+  auto bound = split_rows(node_num,
+			  [=](int i) { return node_num - 1.0 - i; });
+  int chunk_num = bound.size() - 1;
+  return run_chunks(chunk_num, thread_num,
+		    [&](int c, vector<GenEdge>& edge_list) {
+		      GenRand rand(seed, c);
+		      for ( int i = bound[c]; i < bound[c + 1]; ++ i ) {
+			sample_row(rand, prob, i + 1, node_num,
+				   [&](int j) {
+				     if ( !skip(i, j) ) {
+				       edge_list.push_back({i, j});
+				     }
+				   });
+		      }
+		    });
+}
+
+// ノードの順列を作る．
+vector<int>
+random_perm(int seed,
+	    int node_num)
+{
+  vector<int> perm(node_num);
+  for ( auto i: Range(node_num) ) {
+    perm[i] = i;
+  }
+  GenRand rand(seed, PERM_STREAM);
+  for ( int i = node_num - 1; i > 0; -- i ) {
+    int j = rand.below(i + 1);
+    std::swap(perm[i], perm[j]);
+  }
+  return perm;
+}
+
+// チャンクごとの枝のリストを一つの枝のリストにまとめる．
+//
+// 追加し終わったチャンクはすぐに解放する．
+template<typename Edge>
+vector<Edge>
+merge_chunks(ChunkList& chunk_list)
+{
+  SizeType edge_num = 0;
+  for ( const auto& edge_list: chunk_list ) {
+    edge_num += edge_list.size();
+  }
+  vector<Edge> ans;
+  ans.reserve(edge_num);
+  for ( auto& edge_list: chunk_list ) {
+    for ( const auto& edge: edge_list ) {
+      ans.push_back({edge.id1, edge.id2, 1});
+    }
+    vector<GenEdge>().swap(edge_list);
+  }
+  return ans;
+}
+
+// チャンクごとの枝のリストから UdGraph を作る．
+UdGraph
+make_udgraph(int node_num,
+	     ChunkList& chunk_list)
+{
+  return UdGraph(node_num, merge_chunks<UdGraph::Edge>(chunk_list));
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス GraphGen
+//////////////////////////////////////////////////////////////////////
+
+// @brief Erdős–Rényi の G(n, p) を作る．
+// @param[in] node_num ノード数
+// @param[in] prob 各ノード対に枝を張る確率
+UdGraph
+GraphGen::gnp(int node_num,
+	      double prob) const
+{
+  auto chunk_list = gnp_chunks(mSeed, mThreadNum, node_num, prob,
+			       [](int, int) { return false; });
+  return make_udgraph(node_num, chunk_list);
+}
+
+// @brief Erdős–Rényi の G(n, m) を作る．
+// @param[in] node_num ノード数
+// @param[in] edge_num 枝数
+UdGraph
+GraphGen::gnm(int node_num,
+	      SizeType edge_num) const
+{
+  std::uint64_t n = node_num;
+  std::uint64_t pair_num = node_num > 1 ? n * (n - 1) / 2 : 0;
+  if ( edge_num >= pair_num ) {
+    return gnp(node_num, 1.0);
+  }
+
+  // 行 i の最初のノード対の通し番号
+  auto offset = [=](std::uint64_t i) {
+    return i * (2 * n - i - 1) / 2;
+  };
+
+  int chunk_num = std::min<std::uint64_t>(CHUNK_NUM, pair_num);
+  auto chunk_list = run_chunks(chunk_num, mThreadNum,
+			       [&](int c, vector<GenEdge>& edge_list) {
+    std::uint64_t lo = chunk_begin(pair_num, chunk_num, c);
+    std::uint64_t size = chunk_begin(pair_num, chunk_num, c + 1) - lo;
+    std::uint64_t k = chunk_begin(edge_num, chunk_num, c + 1)
+      - chunk_begin(edge_num, chunk_num, c);
+
+    // 半分以上選ぶ場合は選ばないものを選ぶ．
+    bool complement = k > size / 2;
+    std::uint64_t k1 = complement ? size - k : k;
+    GenRand rand(mSeed, c);
+    vector<std::uint64_t> sel_list;
+    sel_list.reserve(k1);
+    while ( sel_list.size() < k1 ) {
+      for ( auto need = k1 - sel_list.size(); need > 0; -- need ) {
+	sel_list.push_back(lo + rand.below(size));
+      }
+      std::sort(sel_list.begin(), sel_list.end());
+      sel_list.erase(std::unique(sel_list.begin(), sel_list.end()),
+		     sel_list.end());
+    }
+
+    // lo を含む行を求める．
+    double b = 2.0 * n - 1.0;
+    double x = std::floor((b - std::sqrt(b * b - 8.0 * lo)) / 2.0);
+    std::uint64_t i = std::max(0.0, std::min(x, n - 2.0));
+    while ( i > 0 && offset(i) > lo ) {
+      -- i;
+    }
+    while ( offset(i + 1) <= lo ) {
+      ++ i;
+    }
+
+    // 通し番号 t のノード対を追加する．
+    // t は単調増加でなければならない．
+    auto add = [&](std::uint64_t t) {
+      while ( offset(i + 1) <= t ) {
+	++ i;
+      }
+      int j = t - offset(i) + i + 1;
+      edge_list.push_back({static_cast<int>(i), j});
+    };
+    edge_list.reserve(k);
+    if ( complement ) {
+      auto p = sel_list.begin();
+      for ( auto t = lo; t < lo + size; ++ t ) {
+	if ( p != sel_list.end() && *p == t ) {
+	  ++ p;
+	}
+	else {
+	  add(t);
+	}
+      }
+    }
+    else {
+      for ( auto t: sel_list ) {
+	add(t);
+      }
+    }
+  });
+  return make_udgraph(node_num, chunk_list);
+}
+
+// @brief Barabási–Albert モデルのグラフを作る．
+// @param[in] node_num ノード数
+// @param[in] edge_per_node 新しいノードが張る枝数
+UdGraph
+GraphGen::barabasi_albert(int node_num,
+			  int edge_per_node) const
+{
+  if ( node_num <= 1 || edge_per_node <= 0 ) {
+    return UdGraph(node_num);
+  }
+
+  // 枝 e はノード src(e) から張られる．
+  // 枝 e の端点を [src(0), dst(0), src(1), dst(1), ...] と並べた列を T とすると，
+  // dst(e) は T[0 .. 2e - 1] から一様に選んだ要素となる．
+  // ただし src(e) 自身は選ばない．
+  // 選んだ要素が dst(e') の場合は dst(e') を同様に求める．
+  std::uint64_t m = edge_per_node;
+  std::uint64_t total = (node_num - 1) * m;
+  std::uint64_t base = mix64(static_cast<std::uint64_t>(mSeed));
+  auto src = [=](std::uint64_t e) {
+    return static_cast<int>(e / m) + 1;
+  };
+  auto dst = [=](std::uint64_t e) {
+    for ( ; ; ) {
+      if ( e == 0 ) {
+	return 0;
+      }
+      std::uint64_t r;
+      for ( std::uint64_t attempt = 0; ; ++ attempt ) {
+	r = mix64(mix64(base ^ e) + attempt) % (2 * e);
+	if ( r % 2 == 1 || src(r / 2) != src(e) ) {
+	  break;
+	}
+      }
+      if ( r % 2 == 0 ) {
+	return src(r / 2);
+      }
+      e = r / 2;
+    }
+  };
+
+  int chunk_num = std::min<std::uint64_t>(CHUNK_NUM, total);
+  auto chunk_list = run_chunks(chunk_num, mThreadNum,
+			       [&](int c, vector<GenEdge>& edge_list) {
+    auto lo = chunk_begin(total, chunk_num, c);
+    auto hi = chunk_begin(total, chunk_num, c + 1);
+    edge_list.reserve(hi - lo);
+    for ( auto e = lo; e < hi; ++ e ) {
+      edge_list.push_back({src(e), dst(e)});
+    }
+  });
+  return make_udgraph(node_num, chunk_list);
+}
+
+// @brief R-MAT (Kronecker) モデルのグラフを作る．
+// @param[in] scale ノード数の対数 (ノード数は 2^scale)
+// @param[in] edge_num 枝数
+// @param[in] a, b, c 隣接行列の4分割の選択確率(残りが d)
+UdGraph
+GraphGen::rmat(int scale,
+	       SizeType edge_num,
+	       double a,
+	       double b,
+	       double c) const
+{
+  ASSERT_COND( 0 <= scale && scale < 31 );
+
+  int node_num = 1 << scale;
+  if ( node_num == 1 ) {
+    // 自己ループしか作れない．
+    return UdGraph(node_num);
+  }
+  double ab = a + b;
+  double abc = a + b + c;
+  int chunk_num = std::min<SizeType>(CHUNK_NUM, edge_num);
+  auto chunk_list = run_chunks(chunk_num, mThreadNum,
+			       [&](int ch, vector<GenEdge>& edge_list) {
+    auto k = chunk_begin(edge_num, chunk_num, ch + 1)
+      - chunk_begin(edge_num, chunk_num, ch);
+    edge_list.reserve(k);
+    GenRand rand(mSeed, ch);
+    while ( edge_list.size() < k ) {
+      int id1 = 0;
+      int id2 = 0;
+      for ( int l = 0; l < scale; ++ l ) {
+	double r = rand.real();
+	id1 <<= 1;
+	id2 <<= 1;
+	if ( r < a ) {
+	  ;
+	}
+	else if ( r < ab ) {
+	  id2 |= 1;
+	}
+	else if ( r < abc ) {
+	  id1 |= 1;
+	}
+	else {
+	  id1 |= 1;
+	  id2 |= 1;
+	}
+      }
+      if ( id1 != id2 ) {
+	edge_list.push_back({id1, id2});
+      }
+    }
+  });
+  return make_udgraph(node_num, chunk_list);
+}
+
+// @brief 単位正方形上のランダム幾何グラフを作る．
+// @param[in] node_num ノード数
+// @param[in] radius 枝を張る距離の上限
+UdGraph
+GraphGen::geometric(int node_num,
+		    double radius) const
+{
+  if ( node_num == 0 || radius <= 0.0 ) {
+    return UdGraph(node_num);
+  }
+
+  // 座標はノード番号のハッシュ値から決める．
+  std::uint64_t base = mix64(static_cast<std::uint64_t>(mSeed));
+  vector<double> x_array(node_num);
+  vector<double> y_array(node_num);
+  for ( auto i: Range(node_num) ) {
+    std::uint64_t h = mix64(base ^ (2 * static_cast<std::uint64_t>(i)));
+    x_array[i] = to_real(h);
+    y_array[i] = to_real(mix64(h + 1));
+  }
+
+  // 一辺が 1 / g (>= radius) の格子に振り分ける．
+  // 格子の数はノード数程度に抑える．
+  double gmax = std::ceil(std::sqrt(static_cast<double>(node_num)));
+  int g = std::max(1.0, std::min(std::floor(1.0 / radius), gmax));
+  auto cell_of = [&](double v) {
+    return std::min(g - 1, static_cast<int>(v * g));
+  };
+  vector<int> cell_begin(g * g + 1, 0);
+  for ( auto i: Range(node_num) ) {
+    ++ cell_begin[cell_of(x_array[i]) * g + cell_of(y_array[i]) + 1];
+  }
+  for ( auto k: Range(g * g) ) {
+    cell_begin[k + 1] += cell_begin[k];
+  }
+  vector<int> cell_node(node_num);
+  {
+    vector<int> pos(cell_begin.begin(), cell_begin.end() - 1);
+    for ( auto i: Range(node_num) ) {
+      int k = cell_of(x_array[i]) * g + cell_of(y_array[i]);
+      cell_node[pos[k]] = i;
+      ++ pos[k];
+    }
+  }
+
+  // 格子の列ごとにチャンクに分割する．
+  double r2 = radius * radius;
+  auto bound = split_rows(g, [&](int cx) {
+    return cell_begin[(cx + 1) * g] - cell_begin[cx * g] + 1.0;
+  });
+  int chunk_num = bound.size() - 1;
+  auto chunk_list = run_chunks(chunk_num, mThreadNum,
+			       [&](int c, vector<GenEdge>& edge_list) {
+    // u と格子 (cx, cy) の first 番目以降のノードを調べる．
+    auto scan = [&](int u, int cx, int cy, int first) {
+      if ( cx >= g || cy < 0 || cy >= g ) {
+	return;
+      }
+      int k = cx * g + cy;
+      for ( int p = cell_begin[k] + first; p < cell_begin[k + 1]; ++ p ) {
+	int v = cell_node[p];
+	double dx = x_array[u] - x_array[v];
+	double dy = y_array[u] - y_array[v];
+	if ( dx * dx + dy * dy <= r2 ) {
+	  edge_list.push_back({u, v});
+	}
+      }
+    };
+    for ( int cx = bound[c]; cx < bound[c + 1]; ++ cx ) {
+      for ( int cy = 0; cy < g; ++ cy ) {
+	int k = cx * g + cy;
+	for ( int p = cell_begin[k]; p < cell_begin[k + 1]; ++ p ) {
+	  int u = cell_node[p];
+	  // 同じ格子は後ろのノードのみ，隣の格子は半分のみ調べる．
+	  scan(u, cx, cy, p - cell_begin[k] + 1);
+	  scan(u, cx, cy + 1, 0);
+	  scan(u, cx + 1, cy - 1, 0);
+	  scan(u, cx + 1, cy, 0);
+	  scan(u, cx + 1, cy + 1, 0);
+	}
+      }
+    }
+  });
+  return make_udgraph(node_num, chunk_list);
+}
+
+// @brief k 彩色可能なことがわかっているグラフを作る．
+// @param[in] node_num ノード数
+// @param[in] color_num 色数
+// @param[in] prob 色の異なるノード対に枝を張る確率
+// @return グラフと埋め込んだ彩色結果を返す．
+pair<UdGraph, vector<int>>
+GraphGen::planted_coloring(int node_num,
+			   int color_num,
+			   double prob) const
+{
+  ASSERT_COND( color_num > 0 );
+
+  auto perm = random_perm(mSeed, node_num);
+  vector<int> color_map(node_num);
+  for ( auto i: Range(node_num) ) {
+    color_map[i] = perm[i] % color_num;
+  }
+  auto chunk_list = gnp_chunks(mSeed, mThreadNum, node_num, prob,
+			       [&](int i, int j) {
+				 return color_map[i] == color_map[j];
+			       });
+  return make_pair(make_udgraph(node_num, chunk_list), color_map);
+}
+
+// @brief クリークを埋め込んだ G(n, p) を作る．
+// @param[in] node_num ノード数
+// @param[in] prob 各ノード対に枝を張る確率
+// @param[in] clique_size 埋め込むクリークの要素数
+// @return グラフと埋め込んだクリークのノード番号のリストを返す．
+pair<UdGraph, vector<int>>
+GraphGen::planted_clique(int node_num,
+			 double prob,
+			 int clique_size) const
+{
+  ASSERT_COND( 0 <= clique_size && clique_size <= node_num );
+
+  auto perm = random_perm(mSeed, node_num);
+  vector<int> clique(perm.begin(), perm.begin() + clique_size);
+  std::sort(clique.begin(), clique.end());
+  vector<bool> in_clique(node_num, false);
+  for ( auto id: clique ) {
+    in_clique[id] = true;
+  }
+
+  // クリーク内の枝は最後にまとめて追加する．
+  auto chunk_list = gnp_chunks(mSeed, mThreadNum, node_num, prob,
+			       [&](int i, int j) {
+				 return in_clique[i] && in_clique[j];
+			       });
+  vector<GenEdge> clique_edge_list;
+  for ( auto p1: Range(clique_size) ) {
+    for ( auto p2: Range(p1 + 1, clique_size) ) {
+      clique_edge_list.push_back({clique[p1], clique[p2]});
+    }
+  }
+  chunk_list.push_back(std::move(clique_edge_list));
+  return make_pair(make_udgraph(node_num, chunk_list), clique);
+}
+
+// @brief ランダムな2部グラフを作る．
+// @param[in] node1_num 頂点集合1の要素数
+// @param[in] node2_num 頂点集合2の要素数
+// @param[in] prob 各ノード対に枝を張る確率
+BiGraph
+GraphGen::bipartite(int node1_num,
+		    int node2_num,
+		    double prob) const
+{
+  auto bound = split_rows(node1_num, [](int) { return 1.0; });
+  int chunk_num = bound.size() - 1;
+  auto chunk_list = run_chunks(chunk_num, mThreadNum,
+			       [&](int c, vector<GenEdge>& edge_list) {
+    GenRand rand(mSeed, c);
+    for ( int i = bound[c]; i < bound[c + 1]; ++ i ) {
+      sample_row(rand, prob, 0, node2_num,
+		 [&](int j) { edge_list.push_back({i, j}); });
+    }
+  });
+
+  return BiGraph(node1_num, node2_num,
+		 merge_chunks<BiGraph::Edge>(chunk_list));
+}
+
+END_NAMESPACE_YM
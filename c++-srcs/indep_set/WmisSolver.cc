@@ -0,0 +1,399 @@
+
+/// @file WmisSolver.cc
+/// @brief WmisSolver の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "WmisSolver.h"
+#include "AdjIndex.h"
+#include "ym/Range.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+BEGIN_NONAMESPACE
+
+// 摂動の繰り返し回数の既定値
+const int DEFAULT_ITER_LIMIT = 10000;
+
+// 摂動で入れるノードを選ぶ時の試行回数
+const int PICK_TRIAL = 16;
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス WmisSolver
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] graph 対象のグラフ
+WmisSolver::WmisSolver(const UdGraph& graph)
+{
+  mPerf.start();
+
+  // 隣接リストが昇順で重複を含まないように正規形にしてから作る．
+  UdGraph graph1;
+  if ( !graph.is_canonical() ) {
+    graph1 = graph;
+    graph1.canonicalize();
+  }
+  AdjIndex adj_index(graph.is_canonical() ? graph : graph1);
+
+  int n = graph.node_num();
+  mAdjOffset.resize(n + 1);
+  mAdjOffset[0] = 0;
+  mAdjBody.reserve(adj_index.edge_num() * 2);
+  for ( auto id: Range(n) ) {
+    for ( auto id1: adj_index.adj_list(id) ) {
+      mAdjBody.push_back(id1);
+    }
+    mAdjOffset[id + 1] = mAdjBody.size();
+  }
+
+  mWeight.resize(n);
+  for ( auto id: Range(n) ) {
+    mWeight[id] = std::max(graph.node_weight(id), 0);
+  }
+
+  mInSet.resize(n, false);
+  mTightness.resize(n, 0);
+  mSetWeight.resize(n, 0);
+  mSetIdSum.resize(n, 0);
+  mInInsertQueue.resize(n, false);
+  mInSwapQueue.resize(n, false);
+  mMark.resize(n, 0);
+
+  mPerf.end_setup();
+}
+
+// @brief 制限時間を設定する．
+// @param[in] time_limit 制限時間(秒)(0 以下の場合は無制限)
+void
+WmisSolver::set_time_limit(double time_limit)
+{
+  mLimit.set_time_limit(time_limit);
+}
+
+// @brief 摂動の繰り返し回数の上限を設定する．
+// @param[in] iter_limit 繰り返し回数(0 以下の場合は既定値)
+void
+WmisSolver::set_iter_limit(int iter_limit)
+{
+  mIterLimit = iter_limit;
+}
+
+// @brief 乱数の種を設定する．
+// @param[in] seed 乱数の種
+void
+WmisSolver::set_seed(int seed)
+{
+  mRandGen.seed(seed);
+}
+
+// @brief 最大重み独立集合を求める．
+// @param[out] node_set 独立集合の要素(ノード番号の昇順)
+// @return 重みの和を返す．
+std::int64_t
+WmisSolver::solve(vector<int>& node_set)
+{
+  int n = mWeight.size();
+  init_solution();
+  local_search();
+
+  // 受理した解は常にそれまでの最良解である．
+  auto best_weight = mWeightSum;
+  int iter_limit = mIterLimit > 0 ? mIterLimit : DEFAULT_ITER_LIMIT;
+  std::uniform_int_distribution<int> rd_node(0, std::max(n - 1, 0));
+  for ( int iter = 0; iter < iter_limit && n > 0; ++ iter ) {
+    if ( mLimit.is_expired() ) {
+      break;
+    }
+    mPerf.count_iteration();
+
+    int forced = -1;
+    for ( int i = 0; i < PICK_TRIAL; ++ i ) {
+      int id = rd_node(mRandGen);
+      if ( !mInSet[id] && mWeight[id] > 0 ) {
+	forced = id;
+	break;
+      }
+    }
+    if ( forced == -1 ) {
+      continue;
+    }
+
+    mLog.clear();
+    mLogging = true;
+    mForced = forced;
+    force_insert(forced);
+    local_search();
+    mForced = -1;
+    mLogging = false;
+
+    if ( mWeightSum < best_weight ) {
+      undo();
+    }
+    else {
+      best_weight = mWeightSum;
+    }
+  }
+
+  node_set.clear();
+  for ( auto id: Range(n) ) {
+    if ( mInSet[id] ) {
+      node_set.push_back(id);
+    }
+  }
+  mPerf.end_search();
+  return mWeightSum;
+}
+
+// @brief 初期解を作る．
+void
+WmisSolver::init_solution()
+{
+  int n = mWeight.size();
+  vector<int> order_list;
+  order_list.reserve(n);
+  for ( auto id: Range(n) ) {
+    if ( mWeight[id] > 0 ) {
+      order_list.push_back(id);
+    }
+  }
+  // w1 / (d1 + 1) > w2 / (d2 + 1) を掛け算で比べる．
+  auto key_gt = [&](int id1, int id2) {
+    std::int64_t d1 = adj_end(id1) - adj_begin(id1) + 1;
+    std::int64_t d2 = adj_end(id2) - adj_begin(id2) + 1;
+    return mWeight[id1] * d2 > mWeight[id2] * d1;
+  };
+  std::stable_sort(order_list.begin(), order_list.end(), key_gt);
+  for ( auto id: order_list ) {
+    if ( mTightness[id] == 0 ) {
+      insert(id);
+    }
+  }
+
+  for ( auto id: order_list ) {
+    if ( mInSet[id] ) {
+      push_swap(id);
+    }
+    else {
+      push_insert(id);
+    }
+  }
+}
+
+// @brief 改善がなくなるまで局所探索を行う．
+void
+WmisSolver::local_search()
+{
+  for ( ; ; ) {
+    if ( !mInsertQueue.empty() ) {
+      int id = mInsertQueue.back();
+      mInsertQueue.pop_back();
+      mInInsertQueue[id] = false;
+      if ( try_insert(id) ) {
+	mPerf.count_move();
+      }
+    }
+    else if ( !mSwapQueue.empty() ) {
+      int id = mSwapQueue.back();
+      mSwapQueue.pop_back();
+      mInSwapQueue[id] = false;
+      if ( try_swap(id) ) {
+	mPerf.count_move();
+      }
+    }
+    else {
+      break;
+    }
+  }
+}
+
+// @brief (ω,1)-swap を試す．
+// @param[in] id 入れるノード
+// @return 行った時 true を返す．
+bool
+WmisSolver::try_insert(int id)
+{
+  if ( mInSet[id] || mWeight[id] <= mSetWeight[id] ) {
+    return false;
+  }
+  if ( mForced >= 0 && mInSet[mForced] &&
+       std::binary_search(adj_begin(id), adj_end(id), mForced) ) {
+    // 摂動で入れたノードは外さない．
+    return false;
+  }
+  force_insert(id);
+  return true;
+}
+
+// @brief (1,2)-swap を試す．
+// @param[in] id 外すノード
+// @return 行った時 true を返す．
+bool
+WmisSolver::try_swap(int id)
+{
+  if ( !mInSet[id] || id == mForced ) {
+    return false;
+  }
+
+  // id だけと隣接するノードを重みの降順に並べる．
+  vector<int> cand_list;
+  for ( auto p = adj_begin(id); p != adj_end(id); ++ p ) {
+    auto id1 = *p;
+    if ( mTightness[id1] == 1 && mWeight[id1] > 0 ) {
+      cand_list.push_back(id1);
+    }
+  }
+  int nc = cand_list.size();
+  if ( nc < 2 ) {
+    return false;
+  }
+  std::sort(cand_list.begin(), cand_list.end(),
+	    [&](int id1, int id2) { return mWeight[id1] > mWeight[id2]; });
+
+  auto w0 = mWeight[id];
+  for ( auto i: Range(nc) ) {
+    auto id1 = cand_list[i];
+    // 組み合わせる相手の重みは最大でもこれだけ
+    auto w1 = mWeight[cand_list[i == 0 ? 1 : 0]];
+    if ( mWeight[id1] + w1 <= w0 ) {
+      break;
+    }
+    if ( mStamp == numeric_limits<int>::max() ) {
+      std::fill(mMark.begin(), mMark.end(), 0);
+      mStamp = 0;
+    }
+    ++ mStamp;
+    for ( auto p = adj_begin(id1); p != adj_end(id1); ++ p ) {
+      mMark[*p] = mStamp;
+    }
+    for ( auto j: Range(nc) ) {
+      auto id2 = cand_list[j];
+      if ( mWeight[id1] + mWeight[id2] <= w0 ) {
+	break;
+      }
+      if ( j != i && mMark[id2] != mStamp ) {
+	remove(id);
+	insert(id1);
+	insert(id2);
+	return true;
+      }
+    }
+  }
+  return false;
+}
+
+// @brief 隣接ノードを外してからノードを入れる．
+// @param[in] id 入れるノード
+void
+WmisSolver::force_insert(int id)
+{
+  for ( auto p = adj_begin(id); p != adj_end(id); ++ p ) {
+    if ( mInSet[*p] ) {
+      remove(*p);
+    }
+  }
+  insert(id);
+}
+
+// @brief ノードを解に入れる．
+// @param[in] id ノード番号
+void
+WmisSolver::insert(int id)
+{
+  ASSERT_COND( !mInSet[id] && mTightness[id] == 0 );
+
+  mInSet[id] = true;
+  auto w = mWeight[id];
+  mWeightSum += w;
+  if ( mLogging ) {
+    mLog.push_back(id);
+  }
+  for ( auto p = adj_begin(id); p != adj_end(id); ++ p ) {
+    auto id1 = *p;
+    ++ mTightness[id1];
+    mSetWeight[id1] += w;
+    mSetIdSum[id1] += id;
+  }
+  push_swap(id);
+}
+
+// @brief ノードを解から外す．
+// @param[in] id ノード番号
+void
+WmisSolver::remove(int id)
+{
+  ASSERT_COND( mInSet[id] );
+
+  mInSet[id] = false;
+  auto w = mWeight[id];
+  mWeightSum -= w;
+  if ( mLogging ) {
+    mLog.push_back(~id);
+  }
+  for ( auto p = adj_begin(id); p != adj_end(id); ++ p ) {
+    auto id1 = *p;
+    -- mTightness[id1];
+    mSetWeight[id1] -= w;
+    mSetIdSum[id1] -= id;
+    push_insert(id1);
+    if ( mTightness[id1] == 1 ) {
+      // 唯一の隣接ノードを外す (1,2)-swap ができるかもしれない．
+      push_swap(mSetIdSum[id1]);
+    }
+  }
+}
+
+// @brief 記録した変更を取り消す．
+void
+WmisSolver::undo()
+{
+  for ( auto p = mLog.rbegin(); p != mLog.rend(); ++ p ) {
+    auto id = *p;
+    if ( id >= 0 ) {
+      remove(id);
+    }
+    else {
+      insert(~id);
+    }
+  }
+  mLog.clear();
+
+  // 取り消す前の解は局所最適なので候補は要らない．
+  for ( auto id: mInsertQueue ) {
+    mInInsertQueue[id] = false;
+  }
+  mInsertQueue.clear();
+  for ( auto id: mSwapQueue ) {
+    mInSwapQueue[id] = false;
+  }
+  mSwapQueue.clear();
+}
+
+// @brief (ω,1)-swap の候補に加える．
+void
+WmisSolver::push_insert(int id)
+{
+  if ( !mInInsertQueue[id] ) {
+    mInInsertQueue[id] = true;
+    mInsertQueue.push_back(id);
+  }
+}
+
+// @brief (1,2)-swap の候補に加える．
+void
+WmisSolver::push_swap(int id)
+{
+  if ( !mInSwapQueue[id] ) {
+    mInSwapQueue[id] = true;
+    mSwapQueue.push_back(id);
+  }
+}
+
+END_NAMESPACE_YM_UDGRAPH
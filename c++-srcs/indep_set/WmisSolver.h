@@ -0,0 +1,229 @@
+#ifndef WMISSOLVER_H
+#define WMISSOLVER_H
+
+/// @file WmisSolver.h
+/// @brief WmisSolver のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/UdGraph.h"
+#include "PerfCounter.h"
+#include "SearchLimit.h"
+#include <cstdint>
+#include <random>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+//////////////////////////////////////////////////////////////////////
+/// @class WmisSolver WmisSolver.h "WmisSolver.h"
+/// @brief 最大重み独立集合を局所探索で求めるクラス
+///
+/// - 反復局所探索(ILS-VND, Nogueira et al.)を簡略化したもの
+/// - 局所探索では以下の改善がなくなるまで繰り返す．
+///   - (ω,1)-swap: 解に入っている隣接ノードの重みの和より重いノードを
+///     入れてその隣接ノードを外す(空いているノードを入れる場合を含む)．
+///   - (1,2)-swap: 解のノード x を外して，x だけと隣接する互いに
+///     隣接しない2つのノードを重みの和が増える場合に入れる．
+/// - 摂動では解に入っていないノードを乱数で1つ選んで強制的に入れる．
+///   そのノードはその回の局所探索では外さない．
+/// - 局所探索の結果が悪くなった場合は変更を記録から取り消して戻す．
+///   同じ重みの場合は受理して探索を続ける．
+/// - 重みが 0 以下のノードは選ばない．
+//////////////////////////////////////////////////////////////////////
+class WmisSolver
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] graph 対象のグラフ
+  explicit
+  WmisSolver(const UdGraph& graph);
+
+  /// @brief デストラクタ
+  ~WmisSolver() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 制限時間を設定する．
+  /// @param[in] time_limit 制限時間(秒)(0 以下の場合は無制限)
+  void
+  set_time_limit(double time_limit);
+
+  /// @brief 摂動の繰り返し回数の上限を設定する．
+  /// @param[in] iter_limit 繰り返し回数(0 以下の場合は既定値)
+  void
+  set_iter_limit(int iter_limit);
+
+  /// @brief 乱数の種を設定する．
+  /// @param[in] seed 乱数の種
+  void
+  set_seed(int seed);
+
+  /// @brief 最大重み独立集合を求める．
+  /// @param[out] node_set 独立集合の要素(ノード番号の昇順)
+  /// @return 重みの和を返す．
+  std::int64_t
+  solve(vector<int>& node_set);
+
+  /// @brief 性能計測用のカウンタを返す．
+  const PerfCounter&
+  perf() const
+  {
+    return mPerf;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 初期解を作る．
+  ///
+  /// 重み / (次数 + 1) の大きい順に入れられるノードを入れる．
+  void
+  init_solution();
+
+  /// @brief 改善がなくなるまで局所探索を行う．
+  void
+  local_search();
+
+  /// @brief (ω,1)-swap を試す．
+  /// @param[in] id 入れるノード
+  /// @return 行った時 true を返す．
+  bool
+  try_insert(int id);
+
+  /// @brief (1,2)-swap を試す．
+  /// @param[in] id 外すノード
+  /// @return 行った時 true を返す．
+  bool
+  try_swap(int id);
+
+  /// @brief 隣接ノードを外してからノードを入れる．
+  /// @param[in] id 入れるノード
+  void
+  force_insert(int id);
+
+  /// @brief ノードを解に入れる．
+  /// @param[in] id ノード番号
+  void
+  insert(int id);
+
+  /// @brief ノードを解から外す．
+  /// @param[in] id ノード番号
+  void
+  remove(int id);
+
+  /// @brief 記録した変更を取り消す．
+  void
+  undo();
+
+  /// @brief (ω,1)-swap の候補に加える．
+  void
+  push_insert(int id);
+
+  /// @brief (1,2)-swap の候補に加える．
+  void
+  push_swap(int id);
+
+  /// @brief 隣接リストの先頭を返す．
+  const int*
+  adj_begin(int id) const
+  {
+    return mAdjBody.data() + mAdjOffset[id];
+  }
+
+  /// @brief 隣接リストの末尾を返す．
+  const int*
+  adj_end(int id) const
+  {
+    return mAdjBody.data() + mAdjOffset[id + 1];
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 各ノードの隣接リストの先頭位置(ノード数 + 1 個)
+  vector<SizeType> mAdjOffset;
+
+  // 隣接リストの本体(ノードごとに昇順で重複なし)
+  vector<int> mAdjBody;
+
+  // ノードの重み(0 以下のものは 0 とする)
+  vector<int> mWeight;
+
+  // 打ち切り条件
+  SearchLimit mLimit;
+
+  // 摂動の繰り返し回数の上限
+  int mIterLimit{0};
+
+  // 乱数発生器
+  std::mt19937 mRandGen;
+
+  // 解に含まれる時 true となる配列
+  vector<bool> mInSet;
+
+  // 解に含まれる隣接ノードの数
+  vector<int> mTightness;
+
+  // 解に含まれる隣接ノードの重みの和
+  vector<std::int64_t> mSetWeight;
+
+  // 解に含まれる隣接ノードの番号の和
+  //
+  // mTightness が 1 の時はその隣接ノードの番号となる．
+  vector<std::int64_t> mSetIdSum;
+
+  // 現在の解の重み
+  std::int64_t mWeightSum{0};
+
+  // (ω,1)-swap の候補のリスト
+  vector<int> mInsertQueue;
+
+  // mInsertQueue に含まれる時 true となる配列
+  vector<bool> mInInsertQueue;
+
+  // (1,2)-swap の候補のリスト
+  vector<int> mSwapQueue;
+
+  // mSwapQueue に含まれる時 true となる配列
+  vector<bool> mInSwapQueue;
+
+  // 摂動で入れたノード(-1 の時はなし)
+  int mForced{-1};
+
+  // 変更の記録
+  //
+  // 入れたノードは id，外したノードは ~id で記録する．
+  vector<int> mLog;
+
+  // 変更を記録する時 true にする．
+  bool mLogging{false};
+
+  // 作業用の印の配列
+  vector<int> mMark;
+
+  // mMark に用いる値
+  int mStamp{0};
+
+  // 性能計測用のカウンタ
+  PerfCounter mPerf;
+
+};
+
+END_NAMESPACE_YM_UDGRAPH
+
+#endif // WMISSOLVER_H
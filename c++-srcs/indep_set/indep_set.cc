@@ -8,18 +8,122 @@
 
 
 #include "ym/UdGraph.h"
+#include "AdjIndex.h"
+#include "PeelQueue.h"
+#include "WmisSolver.h"
+#include "ym/Range.h"
+#include <algorithm>
 
 
 BEGIN_NAMESPACE_YM_UDGRAPH
 
+BEGIN_NONAMESPACE
+
+// 残っているノードのうち次数最小のものを選び，
+// その隣接ノードを取り除くことを繰り返す．
+vector<int>
+greedy_indep_set(const UdGraph& graph)
+{
+  AdjIndex adj_index(graph);
+  int n = graph.node_num();
+  int max_degree = 0;
+  for ( auto id: Range(n) ) {
+    max_degree = std::max(max_degree, adj_index.degree(id));
+  }
+  PeelQueue queue;
+  queue.init(n, max_degree);
+  for ( auto id: Range(n) ) {
+    queue.put(id, adj_index.degree(id));
+  }
+  vector<int> node_set;
+  while ( !queue.empty() ) {
+    int id = queue.pop_min();
+    node_set.push_back(id);
+    for ( auto id1: adj_index.adj_list(id) ) {
+      if ( queue.contains(id1) ) {
+	queue.erase(id1);
+	for ( auto id2: adj_index.adj_list(id1) ) {
+	  if ( queue.contains(id2) ) {
+	    queue.dec_key(id2);
+	  }
+	}
+      }
+    }
+  }
+  std::sort(node_set.begin(), node_set.end());
+  return node_set;
+}
+
+END_NONAMESPACE
+
 // @brief (最大)独立集合を求める．
 // @param[in] algorithm アルゴリズム名
+// @param[in] reorder ノードの並べ替えの方法(空なら並べ替えない)
 // return 独立集合の要素(ノード番号)を収める配列を返す．
 vector<int>
-UdGraph::independent_set(const string& algorithm) const
+UdGraph::independent_set(const string& algorithm,
+			 const string& reorder) const
+{
+  NodeSetOptions options;
+  options.reorder = reorder;
+  NodeSetStats stats;
+  return independent_set(algorithm, options, stats);
+}
+
+// @brief オプションを指定して(最大)独立集合を求める．
+// @param[in] algorithm アルゴリズム名
+// @param[in] options オプション
+// @return 独立集合の要素(ノード番号)を収める配列を返す．
+vector<int>
+UdGraph::independent_set(const string& algorithm,
+			 const NodeSetOptions& options) const
 {
-  // 未完
-  return vector<int>();
+  NodeSetStats stats;
+  return independent_set(algorithm, options, stats);
+}
+
+// @brief オプションを指定して(最大)独立集合を求める．
+// @param[in] algorithm アルゴリズム名
+// @param[in] options オプション
+// @param[out] stats 実行結果に関する情報
+// @return 独立集合の要素(ノード番号)を収める配列を返す．
+vector<int>
+UdGraph::independent_set(const string& algorithm,
+			 const NodeSetOptions& options,
+			 NodeSetStats& stats) const
+{
+  stats = NodeSetStats{};
+  if ( !options.reorder.empty() ) {
+    // 並べ替えたグラフで解いて結果を元のノード番号に戻す．
+    auto order = node_order(options.reorder);
+    auto options1 = options;
+    options1.reorder = string();
+    auto node_set = relabel(order).independent_set(algorithm, options1,
+						   stats);
+    for ( auto& id: node_set ) {
+      id = order[id];
+    }
+    std::sort(node_set.begin(), node_set.end());
+    return node_set;
+  }
+
+  vector<int> node_set;
+  if ( algorithm == "weighted" ) {
+    WmisSolver solver(*this);
+    solver.set_time_limit(options.time_limit);
+    solver.set_iter_limit(options.iter_limit);
+    solver.set_seed(options.seed);
+    stats.weight = solver.solve(node_set);
+    solver.perf().add_to(stats.perf);
+    return node_set;
+  }
+
+  // デフォルトフォールバック
+  node_set = greedy_indep_set(*this);
+  for ( auto id: node_set ) {
+    stats.weight += node_weight(id);
+  }
+  return node_set;
 }
 
 END_NAMESPACE_YM_UDGRAPH
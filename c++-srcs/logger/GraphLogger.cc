@@ -0,0 +1,346 @@
+
+/// @file GraphLogger.cc
+/// @brief GraphLogger の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/GraphLogger.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <memory>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// リングバッファの大きさ(2のべき乗)
+const SizeType QUEUE_SIZE = 4096;
+
+// バックグラウンドのスレッドがバッファを調べる間隔
+const std::chrono::milliseconds POLL_INTERVAL{5};
+
+// 複数の書き手と一つの読み手のためのロックフリーのリングバッファ
+//
+// 各スロットに通し番号を持たせる Vyukov の方法を用いる．
+// 書き手はスロットの通し番号が自分の位置と等しければ書き込み，
+// 読み手は位置 + 1 と等しければ読み出す．
+class LogQueue
+{
+public:
+
+  using Record = GraphLogger::Record;
+
+  // コンストラクタ
+  LogQueue() :
+    mSlotArray{new Slot[QUEUE_SIZE]}
+  {
+    for ( SizeType i = 0; i < QUEUE_SIZE; ++ i ) {
+      mSlotArray[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // レコードを積む．
+  //
+  // 満杯の場合は false を返す．
+  bool
+  push(Record&& rec)
+  {
+    auto pos = mTail.load(std::memory_order_relaxed);
+    for ( ; ; ) {
+      auto& slot = mSlotArray[pos & (QUEUE_SIZE - 1)];
+      auto seq = slot.seq.load(std::memory_order_acquire);
+      if ( seq == pos ) {
+	if ( mTail.compare_exchange_weak(pos, pos + 1,
+					 std::memory_order_relaxed) ) {
+	  slot.rec = std::move(rec);
+	  slot.seq.store(pos + 1, std::memory_order_release);
+	  return true;
+	}
+	// 失敗した場合は pos が更新されている．
+      }
+      else if ( seq < pos ) {
+	// 読み手が一周遅れている．
+	return false;
+      }
+      else {
+	pos = mTail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // レコードを取り出す．
+  //
+  // 空の場合は false を返す．
+  // 読み手のスレッドのみが呼ぶ．
+  bool
+  pop(Record& rec)
+  {
+    auto& slot = mSlotArray[mHead & (QUEUE_SIZE - 1)];
+    auto seq = slot.seq.load(std::memory_order_acquire);
+    if ( seq != mHead + 1 ) {
+      return false;
+    }
+    rec = std::move(slot.rec);
+    slot.seq.store(mHead + QUEUE_SIZE, std::memory_order_release);
+    ++ mHead;
+    return true;
+  }
+
+
+private:
+
+  // スロット
+  struct Slot
+  {
+    // 通し番号
+    std::atomic<SizeType> seq;
+
+    // レコード
+    Record rec;
+  };
+
+  // スロットの配列
+  std::unique_ptr<Slot[]> mSlotArray;
+
+  // 次に書き込む位置
+  std::atomic<SizeType> mTail{0};
+
+  // 次に読み出す位置
+  SizeType mHead{0};
+
+};
+
+// ロガーの本体
+//
+// シンクの呼び出しとその切り替えは mMutex で保護する．
+// 書き手は mMutex を用いない．
+class LogImpl
+{
+public:
+
+  using Record = GraphLogger::Record;
+  using Sink = GraphLogger::Sink;
+
+  // デストラクタ
+  ~LogImpl()
+  {
+    stop();
+  }
+
+  // 唯一のインスタンスを返す．
+  static
+  LogImpl&
+  instance()
+  {
+    static LogImpl the_impl;
+    return the_impl;
+  }
+
+  // シンクを設定してスレッドを起動する．
+  void
+  start(Sink&& sink)
+  {
+    flush();
+    std::unique_lock<std::mutex> lck{mMutex};
+    mSink = std::move(sink);
+    if ( !mThread.joinable() ) {
+      mStop = false;
+      mThread = std::thread{[this]() { drain_loop(); }};
+    }
+  }
+
+  // 残りのレコードを処理してスレッドを止める．
+  void
+  stop()
+  {
+    flush();
+    {
+      std::unique_lock<std::mutex> lck{mMutex};
+      if ( !mThread.joinable() ) {
+	return;
+      }
+      mStop = true;
+      mCond.notify_one();
+    }
+    mThread.join();
+    mSink = nullptr;
+  }
+
+  // レコードを積む．
+  void
+  push(Record&& rec)
+  {
+    if ( mQueue.push(std::move(rec)) ) {
+      mPushed.fetch_add(1, std::memory_order_release);
+    }
+    else {
+      mDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // それまでに積まれたレコードが処理されるまで待つ．
+  void
+  flush()
+  {
+    auto target = mPushed.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lck{mMutex};
+    if ( !mThread.joinable() ) {
+      return;
+    }
+    mCond.notify_one();
+    mFlushCond.wait(lck, [&]() { return mDone >= target; });
+  }
+
+  // 捨てたレコード数を返す．
+  SizeType
+  dropped_num() const
+  {
+    return mDropped.load(std::memory_order_relaxed);
+  }
+
+
+private:
+
+  // バックグラウンドのスレッドの処理
+  void
+  drain_loop()
+  {
+    std::unique_lock<std::mutex> lck{mMutex};
+    for ( ; ; ) {
+      Record rec;
+      while ( mQueue.pop(rec) ) {
+	if ( mSink ) {
+	  mSink(rec);
+	}
+	++ mDone;
+      }
+      mFlushCond.notify_all();
+      if ( mStop ) {
+	break;
+      }
+      // 書き手は通知しないので一定時間ごとに調べる．
+      mCond.wait_for(lck, POLL_INTERVAL);
+    }
+  }
+
+
+private:
+
+  // リングバッファ
+  LogQueue mQueue;
+
+  // 積まれたレコード数
+  std::atomic<SizeType> mPushed{0};
+
+  // 捨てたレコード数
+  std::atomic<SizeType> mDropped{0};
+
+  // 処理したレコード数(mMutex で保護する)
+  SizeType mDone{0};
+
+  // シンク(mMutex で保護する)
+  Sink mSink;
+
+  // 排他制御用のミューテックス
+  std::mutex mMutex;
+
+  // バックグラウンドのスレッドを起こすための条件変数
+  std::condition_variable mCond;
+
+  // flush() を待つための条件変数
+  std::condition_variable mFlushCond;
+
+  // 終了を指示するフラグ(mMutex で保護する)
+  bool mStop{false};
+
+  // バックグラウンドのスレッド
+  std::thread mThread;
+
+};
+
+// レベルを表す文字列を返す．
+const char*
+level_str(GraphLogger::Level level)
+{
+  switch ( level ) {
+  case GraphLogger::Level::None:    return "none";
+  case GraphLogger::Level::Error:   return "error";
+  case GraphLogger::Level::Warning: return "warning";
+  case GraphLogger::Level::Info:    return "info";
+  case GraphLogger::Level::Debug:   return "debug";
+  }
+  return "";
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス GraphLogger
+//////////////////////////////////////////////////////////////////////
+
+std::atomic<int> GraphLogger::mLevel{0};
+
+// @brief シンクとレベルを設定する．
+// @param[in] sink シンク
+// @param[in] level 出力する最も詳細なレベル
+void
+GraphLogger::set_sink(Sink sink,
+		      Level level)
+{
+  auto& impl = LogImpl::instance();
+  if ( !sink || level == Level::None ) {
+    mLevel.store(static_cast<int>(Level::None), std::memory_order_relaxed);
+    impl.stop();
+    return;
+  }
+  impl.start(std::move(sink));
+  mLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+// @brief 標準エラー出力に書き出すシンクを返す．
+GraphLogger::Sink
+GraphLogger::stderr_sink()
+{
+  return [](const Record& rec) {
+    cerr << "[" << level_str(rec.level) << "] "
+	 << rec.source << ": " << rec.message << "\n";
+  };
+}
+
+// @brief ログを出力する．
+// @param[in] level レベル
+// @param[in] source 出力元のアルゴリズム名
+// @param[in] message メッセージ
+void
+GraphLogger::log(Level level,
+		 const string& source,
+		 string message)
+{
+  if ( !enabled(level) ) {
+    return;
+  }
+  LogImpl::instance().push(Record{level, source, std::move(message)});
+}
+
+// @brief それまでに積まれたレコードが全てシンクに渡されるまで待つ．
+void
+GraphLogger::flush()
+{
+  LogImpl::instance().flush();
+}
+
+// @brief バッファがあふれて捨てたレコード数を返す．
+SizeType
+GraphLogger::dropped_num()
+{
+  return LogImpl::instance().dropped_num();
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,555 @@
+
+/// @file CliqueEnum.cc
+/// @brief CliqueEnum の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "CliqueEnum.h"
+#include "AdjIndex.h"
+#include "CoreDecomp.h"
+#include "ThreadPool.h"
+#include "ym/Range.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+BEGIN_NONAMESPACE
+
+// ビットベクタで表す P と X の要素数の和の上限
+const int BITSET_LIMIT = 1024;
+
+// 1スレッドあたりの最小の根のノード数
+const int MIN_ROOTS = 64;
+
+// 打ち切り時刻を調べる間隔(分枝ノード数 - 1)
+const SizeType CHECK_MASK = (1 << 10) - 1;
+
+// 1ワードのビット数
+const int WORD_BITS = 64;
+
+// 立っているビットの数を返す．
+inline
+int
+popcount(std::uint64_t x)
+{
+  return __builtin_popcountll(x);
+}
+
+// 最下位の立っているビットの位置を返す．
+inline
+int
+lowest_bit(std::uint64_t x)
+{
+  return __builtin_ctzll(x);
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス CliqueEnum
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] graph 対象のグラフ
+CliqueEnum::CliqueEnum(const UdGraph& graph) :
+  mNodeNum{static_cast<int>(graph.node_num())}
+{
+  mPerf.start();
+
+  // 重複を除いて昇順に並べた隣接リストを作る．
+  AdjIndex adj_index(graph);
+  int n = mNodeNum;
+  vector<int> mark(n, -1);
+  mAdjOffset.resize(n + 1);
+  mAdjOffset[0] = 0;
+  for ( auto id: Range(n) ) {
+    for ( auto id1: adj_index.adj_list(id) ) {
+      if ( mark[id1] != id ) {
+	mark[id1] = id;
+	mAdjBody.push_back(id1);
+      }
+    }
+    mAdjOffset[id + 1] = mAdjBody.size();
+    std::sort(mAdjBody.begin() + mAdjOffset[id], mAdjBody.end());
+  }
+
+  CoreDecomp core_decomp(adj_index);
+  mOrder = core_decomp.order();
+  mOrderPos.resize(n);
+  for ( auto i: Range(n) ) {
+    mOrderPos[mOrder[i]] = i;
+  }
+
+  mPerf.end_setup();
+}
+
+// @brief 報告するクリークの要素数の下限を設定する．
+// @param[in] min_size 要素数の下限
+void
+CliqueEnum::set_min_size(int min_size)
+{
+  mMinSize = std::max(min_size, 1);
+}
+
+// @brief 制限時間を設定する．
+// @param[in] time_limit 制限時間(秒)(0 以下の場合は無制限)
+void
+CliqueEnum::set_time_limit(double time_limit)
+{
+  mLimit.set_time_limit(time_limit);
+}
+
+// @brief スレッド数を設定する．
+// @param[in] thread_num スレッド数(0 以下の場合はハードウェアの並列度)
+void
+CliqueEnum::set_thread_num(int thread_num)
+{
+  mThreadNum = thread_num;
+}
+
+// @brief 極大クリークを列挙する．
+// @param[in] callback 極大クリークを受け取る関数
+// @return 報告したクリーク数を返す．
+SizeType
+CliqueEnum::enumerate(const UdGraph::CliqueCallback& callback)
+{
+  mCallback = callback;
+  mCliqueNum = 0;
+
+  int n = mNodeNum;
+  int nt = ThreadPool::default_thread_num(mThreadNum);
+  nt = std::max(std::min(nt, n / MIN_ROOTS), 1);
+  vector<Work> work_list(nt);
+  for ( auto& work: work_list ) {
+    work.mark.resize(n, 0);
+    work.count.resize(n, 0);
+    work.local_id.resize(n, -1);
+  }
+
+  // 根のノードは一つずつ取り出すので負荷の偏りは小さい．
+  std::atomic<int> next_pos{0};
+  auto body = [&](int t) {
+    auto& work = work_list[t];
+    for ( ; ; ) {
+      int pos = next_pos.fetch_add(1, std::memory_order_relaxed);
+      if ( pos >= n || mLimit.is_canceled() ) {
+	break;
+      }
+      root(work, pos);
+    }
+  };
+  if ( nt > 1 ) {
+    ThreadPool pool(nt);
+    pool.parallel_for(nt, body);
+  }
+  else {
+    body(0);
+  }
+
+  mMaxSize = 0;
+  for ( auto& work: work_list ) {
+    mMaxSize = std::max(mMaxSize, work.max_size);
+    mPerf.merge(work.perf);
+  }
+  mCompleted = !mLimit.is_canceled();
+  mCallback = nullptr;
+  mPerf.end_search();
+  return mCliqueNum;
+}
+
+// @brief 根のノードから探索する．
+// @param[in] work 作業領域
+// @param[in] pos 根のノードの縮退度の順での位置
+void
+CliqueEnum::root(Work& work,
+		 int pos)
+{
+  work.perf.count_iteration();
+
+  // 隣接リストは昇順なので P も X も昇順となる．
+  int node_id = mOrder[pos];
+  vector<int> p_list;
+  vector<int> x_list;
+  for ( auto p = adj_begin(node_id); p != adj_end(node_id); ++ p ) {
+    auto id1 = *p;
+    if ( mOrderPos[id1] > pos ) {
+      p_list.push_back(id1);
+    }
+    else {
+      x_list.push_back(id1);
+    }
+  }
+  if ( p_list.size() + 1 < mMinSize ) {
+    return;
+  }
+
+  work.clique.clear();
+  work.clique.push_back(node_id);
+  if ( p_list.empty() ) {
+    if ( x_list.empty() ) {
+      report(work);
+    }
+    return;
+  }
+
+  // P のどのノードとも隣接しない X のノードは以降の探索に
+  // 関係しないので除いておく．
+  if ( work.stamp == numeric_limits<int>::max() ) {
+    std::fill(work.mark.begin(), work.mark.end(), 0);
+    work.stamp = 0;
+  }
+  int stamp = ++ work.stamp;
+  for ( auto id1: p_list ) {
+    for ( auto p = adj_begin(id1); p != adj_end(id1); ++ p ) {
+      work.mark[*p] = stamp;
+    }
+  }
+  auto wpos = 0;
+  for ( auto id1: x_list ) {
+    if ( work.mark[id1] == stamp ) {
+      x_list[wpos] = id1;
+      ++ wpos;
+    }
+  }
+  x_list.erase(x_list.begin() + wpos, x_list.end());
+
+  solve(work, p_list, x_list);
+}
+
+// @brief 大きさに応じて P, X の表現を選んで探索する．
+// @param[in] work 作業領域
+// @param[in] p_list 候補のノードのリスト(昇順)
+// @param[in] x_list 除外するノードのリスト(昇順)
+void
+CliqueEnum::solve(Work& work,
+		  vector<int>& p_list,
+		  vector<int>& x_list)
+{
+  if ( p_list.size() + x_list.size() <= BITSET_LIMIT ) {
+    start_bits(work, p_list, x_list);
+  }
+  else {
+    expand_list(work, p_list, x_list);
+  }
+}
+
+// @brief 配列で表した P, X に対して探索する．
+// @param[in] work 作業領域
+// @param[in] p_list 候補のノードのリスト(昇順)
+// @param[in] x_list 除外するノードのリスト(昇順)
+void
+CliqueEnum::expand_list(Work& work,
+			vector<int>& p_list,
+			vector<int>& x_list)
+{
+  if ( p_list.empty() ) {
+    if ( x_list.empty() ) {
+      report(work);
+    }
+    return;
+  }
+  if ( work.clique.size() + p_list.size() < mMinSize ) {
+    return;
+  }
+  if ( check_stop(work) ) {
+    return;
+  }
+
+  // P と X の中から P の隣接ノードが最も多いものをピボットにする．
+  if ( work.stamp == numeric_limits<int>::max() ) {
+    std::fill(work.mark.begin(), work.mark.end(), 0);
+    work.stamp = 0;
+  }
+  int stamp = ++ work.stamp;
+  for ( auto id: p_list ) {
+    work.mark[id] = stamp;
+    work.count[id] = 0;
+  }
+  for ( auto id: x_list ) {
+    work.mark[id] = stamp;
+    work.count[id] = 0;
+  }
+  for ( auto id: p_list ) {
+    for ( auto p = adj_begin(id); p != adj_end(id); ++ p ) {
+      if ( work.mark[*p] == stamp ) {
+	++ work.count[*p];
+      }
+    }
+  }
+  int pivot = p_list[0];
+  for ( auto id: p_list ) {
+    if ( work.count[pivot] < work.count[id] ) {
+      pivot = id;
+    }
+  }
+  for ( auto id: x_list ) {
+    if ( work.count[pivot] < work.count[id] ) {
+      pivot = id;
+    }
+  }
+
+  // ピボットと隣接しない P のノードで分枝する．
+  vector<int> branch_list;
+  intersect(p_list, pivot, branch_list);
+  {
+    vector<int> tmp_list;
+    std::set_difference(p_list.begin(), p_list.end(),
+			branch_list.begin(), branch_list.end(),
+			std::back_inserter(tmp_list));
+    branch_list.swap(tmp_list);
+  }
+
+  vector<int> p_list1;
+  vector<int> x_list1;
+  for ( auto id: branch_list ) {
+    intersect(p_list, id, p_list1);
+    intersect(x_list, id, x_list1);
+    work.clique.push_back(id);
+    solve(work, p_list1, x_list1);
+    work.clique.pop_back();
+    if ( mLimit.is_canceled() ) {
+      return;
+    }
+    // id を P から X に移す．
+    p_list.erase(std::lower_bound(p_list.begin(), p_list.end(), id));
+    x_list.insert(std::lower_bound(x_list.begin(), x_list.end(), id), id);
+  }
+}
+
+// @brief P, X をビットベクタで表して探索する．
+// @param[in] work 作業領域
+// @param[in] p_list 候補のノードのリスト
+// @param[in] x_list 除外するノードのリスト
+void
+CliqueEnum::start_bits(Work& work,
+		       const vector<int>& p_list,
+		       const vector<int>& x_list)
+{
+  // P のノードに 0 から，X のノードにその後ろから局所番号を振る．
+  int np = p_list.size();
+  int ns = np + x_list.size();
+  int nw = (ns + WORD_BITS - 1) / WORD_BITS;
+  work.word_num = nw;
+  work.local_node.clear();
+  work.local_node.insert(work.local_node.end(), p_list.begin(), p_list.end());
+  work.local_node.insert(work.local_node.end(), x_list.begin(), x_list.end());
+  for ( auto i: Range(ns) ) {
+    work.local_id[work.local_node[i]] = i;
+  }
+
+  // 探索で参照するのは P のノードの行と P のビットだけなので
+  // P のノードの隣接リストから作れば足りる．
+  work.bit_adj.clear();
+  work.bit_adj.resize(static_cast<SizeType>(ns) * nw, 0);
+  auto set_edge = [&](int i1, int i2) {
+    work.bit_adj[i1 * nw + i2 / WORD_BITS] |= 1ULL << (i2 % WORD_BITS);
+    work.bit_adj[i2 * nw + i1 / WORD_BITS] |= 1ULL << (i1 % WORD_BITS);
+  };
+  for ( auto i1: Range(np) ) {
+    auto id1 = work.local_node[i1];
+    if ( degree(id1) <= ns * 8 ) {
+      for ( auto p = adj_begin(id1); p != adj_end(id1); ++ p ) {
+	auto i2 = work.local_id[*p];
+	if ( i2 >= 0 ) {
+	  set_edge(i1, i2);
+	}
+      }
+    }
+    else {
+      // 次数の大きなノードは二分探索で調べる．
+      for ( auto i2: Range(ns) ) {
+	if ( std::binary_search(adj_begin(id1), adj_end(id1),
+				work.local_node[i2]) ) {
+	  set_edge(i1, i2);
+	}
+      }
+    }
+  }
+  for ( auto id: work.local_node ) {
+    work.local_id[id] = -1;
+  }
+
+  // 1段ごとに P の要素は1つ以上減るので深さは np + 1 以下となる．
+  SizeType stack_size = static_cast<SizeType>(np + 2) * nw * 3;
+  if ( work.bit_stack.size() < stack_size ) {
+    work.bit_stack.resize(stack_size);
+  }
+  auto p_bits = &work.bit_stack[0];
+  auto x_bits = p_bits + nw;
+  for ( auto i: Range(nw) ) {
+    p_bits[i] = 0;
+    x_bits[i] = 0;
+  }
+  for ( auto i: Range(np) ) {
+    p_bits[i / WORD_BITS] |= 1ULL << (i % WORD_BITS);
+  }
+  for ( auto i: Range(np, ns) ) {
+    x_bits[i / WORD_BITS] |= 1ULL << (i % WORD_BITS);
+  }
+
+  expand_bits(work, 0);
+}
+
+// @brief ビットベクタで表した P, X に対して探索する．
+// @param[in] work 作業領域
+// @param[in] depth 深さ(work.bit_stack 上の位置)
+void
+CliqueEnum::expand_bits(Work& work,
+			int depth)
+{
+  int nw = work.word_num;
+  auto p_bits = &work.bit_stack[static_cast<SizeType>(depth) * nw * 3];
+  auto x_bits = p_bits + nw;
+  auto branch_bits = x_bits + nw;
+
+  int np = 0;
+  bool x_empty = true;
+  for ( auto i: Range(nw) ) {
+    np += popcount(p_bits[i]);
+    if ( x_bits[i] != 0 ) {
+      x_empty = false;
+    }
+  }
+  if ( np == 0 ) {
+    if ( x_empty ) {
+      report(work);
+    }
+    return;
+  }
+  if ( work.clique.size() + np < mMinSize ) {
+    return;
+  }
+  if ( check_stop(work) ) {
+    return;
+  }
+
+  // P と X の中から P の隣接ノードが最も多いものをピボットにする．
+  // P の全てと隣接するものが見つかったらそれ以上調べない．
+  int pivot = -1;
+  int max_count = -1;
+  for ( int i = 0; i < nw && max_count < np; ++ i ) {
+    auto bits = p_bits[i] | x_bits[i];
+    while ( bits != 0 && max_count < np ) {
+      int u = i * WORD_BITS + lowest_bit(bits);
+      bits &= bits - 1;
+      auto row = &work.bit_adj[static_cast<SizeType>(u) * nw];
+      int c = 0;
+      for ( auto j: Range(nw) ) {
+	c += popcount(p_bits[j] & row[j]);
+      }
+      if ( max_count < c ) {
+	max_count = c;
+	pivot = u;
+      }
+    }
+  }
+
+  // ピボットと隣接しない P のノードで分枝する．
+  auto pivot_row = &work.bit_adj[static_cast<SizeType>(pivot) * nw];
+  for ( auto i: Range(nw) ) {
+    branch_bits[i] = p_bits[i] & ~pivot_row[i];
+  }
+  auto p_bits1 = branch_bits + nw;
+  auto x_bits1 = p_bits1 + nw;
+  for ( auto i: Range(nw) ) {
+    auto bits = branch_bits[i];
+    while ( bits != 0 ) {
+      int b = lowest_bit(bits);
+      bits &= bits - 1;
+      int v = i * WORD_BITS + b;
+      auto row = &work.bit_adj[static_cast<SizeType>(v) * nw];
+      for ( auto j: Range(nw) ) {
+	p_bits1[j] = p_bits[j] & row[j];
+	x_bits1[j] = x_bits[j] & row[j];
+      }
+      work.clique.push_back(work.local_node[v]);
+      expand_bits(work, depth + 1);
+      work.clique.pop_back();
+      if ( mLimit.is_canceled() ) {
+	return;
+      }
+      // v を P から X に移す．
+      p_bits[i] &= ~(1ULL << b);
+      x_bits[i] |= 1ULL << b;
+    }
+  }
+}
+
+// @brief 分枝ノードを数えて打ち切り条件を調べる．
+// @param[in] work 作業領域
+// @return 打ち切る場合に true を返す．
+bool
+CliqueEnum::check_stop(Work& work)
+{
+  work.perf.count_branch();
+  ++ work.branch_num;
+  if ( (work.branch_num & CHECK_MASK) == 0 && mLimit.is_expired() ) {
+    // 他のスレッドも止める．
+    mLimit.cancel();
+  }
+  return mLimit.is_canceled();
+}
+
+// @brief work.clique を報告する．
+void
+CliqueEnum::report(Work& work)
+{
+  if ( work.clique.size() < mMinSize ) {
+    return;
+  }
+  int size = work.clique.size();
+  work.max_size = std::max(work.max_size, size);
+  if ( mCallback == nullptr ) {
+    ++ mCliqueNum;
+    return;
+  }
+
+  auto node_set = work.clique;
+  std::sort(node_set.begin(), node_set.end());
+  std::unique_lock<std::mutex> lock(mMutex);
+  if ( mLimit.is_canceled() ) {
+    // 打ち切られた後のものは報告しない．
+    return;
+  }
+  ++ mCliqueNum;
+  if ( !mCallback(node_set) ) {
+    mLimit.cancel();
+  }
+}
+
+// @brief ソートされたリストと隣接リストの共通部分を求める．
+// @param[in] src_list 元のリスト(昇順)
+// @param[in] id 隣接リストのノード番号
+// @param[out] dst_list 結果を収めるリスト(昇順)
+void
+CliqueEnum::intersect(const vector<int>& src_list,
+		      int id,
+		      vector<int>& dst_list) const
+{
+  dst_list.clear();
+  auto begin = adj_begin(id);
+  auto end = adj_end(id);
+  if ( src_list.size() * 16 < degree(id) ) {
+    // 大きさが極端に違う時は二分探索で調べる．
+    for ( auto id1: src_list ) {
+      begin = std::lower_bound(begin, end, id1);
+      if ( begin == end ) {
+	break;
+      }
+      if ( *begin == id1 ) {
+	dst_list.push_back(id1);
+      }
+    }
+  }
+  else {
+    std::set_intersection(src_list.begin(), src_list.end(),
+			  begin, end,
+			  std::back_inserter(dst_list));
+  }
+}
+
+END_NAMESPACE_YM_UDGRAPH
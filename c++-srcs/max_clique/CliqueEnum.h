@@ -0,0 +1,283 @@
+#ifndef CLIQUEENUM_H
+#define CLIQUEENUM_H
+
+/// @file CliqueEnum.h
+/// @brief CliqueEnum のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/UdGraph.h"
+#include "PerfCounter.h"
+#include "SearchLimit.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+//////////////////////////////////////////////////////////////////////
+/// @class CliqueEnum CliqueEnum.h "CliqueEnum.h"
+/// @brief 極大クリークを列挙するクラス
+///
+/// - 縮退度の順(CoreDecomp::order())に根のノード v を選び，
+///   v より後ろの隣接ノードを候補(P)，前の隣接ノードを除外(X)として
+///   Bron-Kerbosch 法で列挙する(Eppstein-Löffler-Strash)．
+///   P の大きさは縮退度以下となる．
+/// - ピボットは P と X の中から P の隣接ノードが最も多いものを選ぶ(Tomita)．
+/// - P と X の要素数の和が BITSET_LIMIT 以下になったら局所的な番号を振って
+///   ビットベクタで表す．それより大きい間はノード番号の昇順に並べた
+///   配列で表す．
+/// - 根のノードごとの探索は独立しているので並列に行う．
+//////////////////////////////////////////////////////////////////////
+class CliqueEnum
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] graph 対象のグラフ
+  explicit
+  CliqueEnum(const UdGraph& graph);
+
+  /// @brief デストラクタ
+  ~CliqueEnum() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 報告するクリークの要素数の下限を設定する．
+  /// @param[in] min_size 要素数の下限
+  void
+  set_min_size(int min_size);
+
+  /// @brief 制限時間を設定する．
+  /// @param[in] time_limit 制限時間(秒)(0 以下の場合は無制限)
+  void
+  set_time_limit(double time_limit);
+
+  /// @brief スレッド数を設定する．
+  /// @param[in] thread_num スレッド数(0 以下の場合はハードウェアの並列度)
+  void
+  set_thread_num(int thread_num);
+
+  /// @brief 極大クリークを列挙する．
+  /// @param[in] callback 極大クリークを受け取る関数
+  /// @return 報告したクリーク数を返す．
+  SizeType
+  enumerate(const UdGraph::CliqueCallback& callback);
+
+  /// @brief 報告したクリークの要素数の最大値を返す．
+  int
+  max_size() const
+  {
+    return mMaxSize;
+  }
+
+  /// @brief 最後まで列挙した時 true を返す．
+  bool
+  is_completed() const
+  {
+    return mCompleted;
+  }
+
+  /// @brief 性能計測用のカウンタを返す．
+  const PerfCounter&
+  perf() const
+  {
+    return mPerf;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief スレッドごとの作業領域
+  struct Work
+  {
+    // 現在のクリーク(R)
+    vector<int> clique;
+
+    // ノード番号をキーにした印
+    vector<int> mark;
+
+    // mark に用いる値
+    int stamp{0};
+
+    // ノード番号をキーにしたピボットの評価値
+    vector<int> count;
+
+    // ノード番号をキーにした局所番号(-1 は対象外)
+    vector<int> local_id;
+
+    // 局所番号をキーにしたノード番号
+    vector<int> local_node;
+
+    // ビットベクタ1つあたりのワード数
+    int word_num{0};
+
+    // 局所番号をキーにした隣接ノードのビットベクタ
+    vector<std::uint64_t> bit_adj;
+
+    // 深さごとの P, X, 分枝するノードのビットベクタ
+    vector<std::uint64_t> bit_stack;
+
+    // 分枝ノード数
+    SizeType branch_num{0};
+
+    // 報告したクリークの要素数の最大値
+    int max_size{0};
+
+    // 性能計測用のカウンタ
+    PerfCounter perf;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 根のノードから探索する．
+  /// @param[in] work 作業領域
+  /// @param[in] pos 根のノードの縮退度の順での位置
+  void
+  root(Work& work,
+       int pos);
+
+  /// @brief 大きさに応じて P, X の表現を選んで探索する．
+  /// @param[in] work 作業領域
+  /// @param[in] p_list 候補のノードのリスト(昇順)
+  /// @param[in] x_list 除外するノードのリスト(昇順)
+  void
+  solve(Work& work,
+	vector<int>& p_list,
+	vector<int>& x_list);
+
+  /// @brief 配列で表した P, X に対して探索する．
+  /// @param[in] work 作業領域
+  /// @param[in] p_list 候補のノードのリスト(昇順)
+  /// @param[in] x_list 除外するノードのリスト(昇順)
+  void
+  expand_list(Work& work,
+	      vector<int>& p_list,
+	      vector<int>& x_list);
+
+  /// @brief P, X をビットベクタで表して探索する．
+  /// @param[in] work 作業領域
+  /// @param[in] p_list 候補のノードのリスト
+  /// @param[in] x_list 除外するノードのリスト
+  void
+  start_bits(Work& work,
+	     const vector<int>& p_list,
+	     const vector<int>& x_list);
+
+  /// @brief ビットベクタで表した P, X に対して探索する．
+  /// @param[in] work 作業領域
+  /// @param[in] depth 深さ(work.bit_stack 上の位置)
+  void
+  expand_bits(Work& work,
+	      int depth);
+
+  /// @brief 分枝ノードを数えて打ち切り条件を調べる．
+  /// @param[in] work 作業領域
+  /// @return 打ち切る場合に true を返す．
+  bool
+  check_stop(Work& work);
+
+  /// @brief work.clique を報告する．
+  void
+  report(Work& work);
+
+  /// @brief 隣接ノードのリストの先頭を返す．
+  const int*
+  adj_begin(int id) const
+  {
+    return mAdjBody.data() + mAdjOffset[id];
+  }
+
+  /// @brief 隣接ノードのリストの末尾を返す．
+  const int*
+  adj_end(int id) const
+  {
+    return mAdjBody.data() + mAdjOffset[id + 1];
+  }
+
+  /// @brief 次数(重複とセルフループを除く)を返す．
+  int
+  degree(int id) const
+  {
+    return mAdjOffset[id + 1] - mAdjOffset[id];
+  }
+
+  /// @brief ソートされたリストと隣接リストの共通部分を求める．
+  /// @param[in] src_list 元のリスト(昇順)
+  /// @param[in] id 隣接リストのノード番号
+  /// @param[out] dst_list 結果を収めるリスト(昇順)
+  void
+  intersect(const vector<int>& src_list,
+	    int id,
+	    vector<int>& dst_list) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ノード数
+  int mNodeNum;
+
+  // 各ノードの隣接リストの先頭位置(ノード数 + 1 個)
+  vector<SizeType> mAdjOffset;
+
+  // 隣接リストの本体(ノードごとに昇順で重複なし)
+  vector<int> mAdjBody;
+
+  // 縮退度の順のノードのリスト
+  vector<int> mOrder;
+
+  // ノード番号をキーにした mOrder 上の位置
+  vector<int> mOrderPos;
+
+  // 報告するクリークの要素数の下限
+  int mMinSize{1};
+
+  // スレッド数
+  int mThreadNum{0};
+
+  // 打ち切り条件
+  SearchLimit mLimit;
+
+  // クリークを受け取る関数
+  UdGraph::CliqueCallback mCallback;
+
+  // mCallback を呼ぶ時の排他制御
+  std::mutex mMutex;
+
+  // 報告したクリーク数
+  std::atomic<SizeType> mCliqueNum{0};
+
+  // 報告したクリークの要素数の最大値
+  //
+  // 探索中は Work::max_size に記録し，終了後にまとめる．
+  int mMaxSize{0};
+
+  // 最後まで列挙した時 true となる．
+  bool mCompleted{false};
+
+  // 性能計測用のカウンタ
+  PerfCounter mPerf;
+
+};
+
+END_NAMESPACE_YM_UDGRAPH
+
+#endif // CLIQUEENUM_H
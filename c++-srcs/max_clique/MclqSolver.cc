@@ -27,7 +27,7 @@ MclqSolver::MclqSolver(const UdGraph& graph) :
 
   // 隣接するノードの情報を link_array に入れる．
   vector<vector<int> > link_array(mNodeNum);
-  for ( const auto& edge: graph.edge_list() ) {
+  for ( const auto& edge: graph.edge_view() ) {
     int id1 = edge.id1;
     int id2 = edge.id2;
     link_array[id1].push_back(id2);
@@ -10,6 +10,7 @@
 
 
 #include "ym/UdGraph.h"
+#include "PerfCounter.h"
 
 
 BEGIN_NAMESPACE_YM_UDGRAPH
@@ -45,6 +46,10 @@ public:
   int
   exact(vector<int>& node_set);
 
+  /// @brief 性能計測用のカウンタを返す．
+  const PerfCounter&
+  perf() const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -63,8 +68,24 @@ private:
   // ノードの配列
   MclqNode* mNodeArray;
 
+  // 性能計測用のカウンタ
+  PerfCounter mPerf;
+
 };
 
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 性能計測用のカウンタを返す．
+inline
+const PerfCounter&
+MclqSolver::perf() const
+{
+  return mPerf;
+}
+
 END_NAMESPACE_YM_UDGRAPH
 
 #endif // MCLQSOLVER_H
@@ -25,13 +25,17 @@ struct NodeLt
   }
 };
 
-int count;
+// 分枝数の上限
+const int BRANCH_LIMIT = 10000;
 
+// count は分枝数を数えるカウンタで，呼び出しごとに用意する．
 int
 mc_recur(const vector<MclqNode*>& selected_node_list,
 	 const vector<MclqNode*>& rest_node_list,
 	 int best_so_far,
-	 vector<int>& node_set)
+	 vector<int>& node_set,
+	 int& count,
+	 PerfCounter& perf)
 {
 #if 0
   cout << "mc_recur(selected_node_list = " << selected_node_list.size()
@@ -44,7 +48,8 @@ mc_recur(const vector<MclqNode*>& selected_node_list,
   }
 
   ++ count;
-  if ( count >= 10000 ) {
+  perf.count_branch();
+  if ( count >= BRANCH_LIMIT ) {
     return 0;
   }
 
@@ -96,7 +101,8 @@ mc_recur(const vector<MclqNode*>& selected_node_list,
     vector<MclqNode*> new_selected_node_list = selected_node_list;
     new_selected_node_list.push_back(node1);
     vector<int> tmp_node_set;
-    mc_recur(new_selected_node_list, new_node_list, max_val, tmp_node_set);
+    mc_recur(new_selected_node_list, new_node_list, max_val, tmp_node_set,
+	     count, perf);
     int val = tmp_node_set.size();
     if ( max_val < val ) {
       max_val = val;
@@ -123,6 +129,7 @@ END_NONAMESPACE
 int
 MclqSolver::exact(vector<int>& node_set)
 {
+  mPerf.start();
   node_set.clear();
 
   // 処理対象のノードを収めるリスト
@@ -132,8 +139,11 @@ MclqSolver::exact(vector<int>& node_set)
     node_list.push_back(node);
   }
 
-  count = 0;
-  mc_recur(vector<MclqNode*>(0), node_list, 0, node_set);
+  mPerf.end_setup();
+
+  int count = 0;
+  mc_recur(vector<MclqNode*>(0), node_list, 0, node_set, count, mPerf);
+  mPerf.end_search();
 
   return node_set.size();
 }
@@ -16,33 +16,36 @@ BEGIN_NAMESPACE_YM_UDGRAPH
 
 BEGIN_NONAMESPACE
 
-// @brief max_clique 用の NodeHeap
-class MclqComp
+// @brief max_clique 用のキー関数
+//
+// 隣接ノード数の大きい順に取り出されるように
+// 隣接ノード数の最大値から隣接ノード数を引いた値をキーとする．
+class MclqKey
 {
 public:
 
-  /// @brief 比較関数
-  /// @param[in] node1, node2 対象のノード
-  /// @retval 負の値 node1 が node2 より前にある．
-  /// @retval 0 node1 と node2 は同じ
-  /// @retval 正の値 node1 が node2 より後ろにある．
+  /// @brief コンストラクタ
+  /// @param[in] max_adj 隣接ノード数の最大値
+  explicit
+  MclqKey(int max_adj) :
+    mMaxAdj{max_adj}
+  {
+  }
+
+  /// @brief ノードのキーを返す．
   int
-  operator()(MclqNode* node1,
-	     MclqNode* node2);
+  operator()(const MclqNode* node)
+  {
+    return mMaxAdj - node->adj_num();
+  }
 
-};
 
-// @brief 比較関数
-// @param[in] node1, node2 対象のノード
-// @retval 負の値 node1 が node2 より前にある．
-// @retval 0 node1 と node2 は同じ
-// @retval 正の値 node1 が node2 より後ろにある．
-int
-MclqComp::operator()(MclqNode* node1,
-		     MclqNode* node2)
-{
-  return node2->adj_num() - node1->adj_num();
-}
+private:
+
+  // 隣接ノード数の最大値
+  int mMaxAdj;
+
+};
 
 END_NONAMESPACE
 
@@ -50,25 +53,36 @@ END_NONAMESPACE
 int
 MclqSolver::greedy(vector<int>& node_set)
 {
-  using MclqHeap = NodeHeap<MclqNode, MclqComp>;
-  MclqHeap node_heap(mNodeNum);
-
+  mPerf.start();
   // ノードをヒープに積む．
+  // 隣接ノード数は減る一方で範囲も狭いので BucketHeap を用いる．
   vector<MclqNode*> node_list;
+  int max_adj = 0;
   for ( int i = 0; i < mNodeNum; ++ i ) {
     auto node = &mNodeArray[i];
-    node_heap.put_node(node);
     node_list.push_back(node);
+    max_adj = std::max(max_adj, node->adj_num());
   }
+  using MclqHeap = BucketHeap<MclqNode, MclqKey>;
+  MclqHeap node_heap(mNodeNum, max_adj, MclqKey{max_adj});
+  node_heap.bulk_build(node_list);
+  mPerf.count_heap_update(mNodeNum);
 
   // 作業用のフラグ配列
   vector<bool> tmp_mark(mNodeNum, false);
 
+  // ヒープから取り除かれたノードの印
+  // BucketHeap はノードの heap_location() を用いないので別に持つ．
+  vector<bool> deleted(mNodeNum, false);
+
   node_set.clear();
+  mPerf.end_setup();
 
   // 未処理の MclqNode のうち MclqNode::adj_num() が最大のものを取り出し，解に加える．
   while ( !node_heap.empty() ) {
+    mPerf.count_iteration();
     MclqNode* best_node = node_heap.get_min();
+    deleted[best_node->id()] = true;
     node_set.push_back(best_node->id());
 
     for ( int i = 0; i < best_node->adj_size(); ++ i ) {
@@ -84,7 +98,7 @@ MclqSolver::greedy(vector<int>& node_set)
     tmp_list.reserve(node_list.size());
     for ( auto node: node_list ) {
       if ( node != best_node ) {
-	ASSERT_COND( !node->deleted() );
+	ASSERT_COND( !deleted[node->id()] );
 	tmp_list.push_back(node);
       }
     }
@@ -96,12 +110,14 @@ MclqSolver::greedy(vector<int>& node_set)
       else {
 	// このノードを削除する．
 	node_heap.delete_node(node);
+	deleted[node->id()] = true;
 	// さらにこのノードに隣接しているノードの隣接数を減らす．
 	for ( int i = 0; i < node->adj_size(); ++ i ) {
 	  MclqNode* node1 = node->adj_node(i);
-	  if ( !node1->deleted() ) {
+	  if ( !deleted[node1->id()] ) {
 	    node1->dec_adj_num();
 	    node_heap.update(node1);
+	    mPerf.count_heap_update();
 	  }
 	}
       }
@@ -113,6 +129,7 @@ MclqSolver::greedy(vector<int>& node_set)
       tmp_mark[node2->id()] = false;
     }
   }
+  mPerf.end_search();
 
   return node_set.size();
 }
@@ -0,0 +1,326 @@
+
+/// @file MwclqSolver.cc
+/// @brief MwclqSolver の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "MwclqSolver.h"
+#include "AdjIndex.h"
+#include "CoreDecomp.h"
+#include "ym/Range.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+BEGIN_NONAMESPACE
+
+// 打ち切り時刻を調べる間隔(分枝ノード数 - 1)
+const SizeType CHECK_MASK = (1 << 10) - 1;
+
+// 1ワードのビット数
+const int WORD_BITS = 64;
+
+// 最下位の立っているビットの位置を返す．
+inline
+int
+lowest_bit(std::uint64_t x)
+{
+  return __builtin_ctzll(x);
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス MwclqSolver
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] graph 対象のグラフ
+MwclqSolver::MwclqSolver(const UdGraph& graph)
+{
+  mPerf.start();
+
+  // 隣接リストが昇順で重複を含まないように正規形にしてから作る．
+  UdGraph graph1;
+  if ( !graph.is_canonical() ) {
+    graph1 = graph;
+    graph1.canonicalize();
+  }
+  AdjIndex adj_index(graph.is_canonical() ? graph : graph1);
+
+  int n = graph.node_num();
+  mAdjOffset.resize(n + 1);
+  mAdjOffset[0] = 0;
+  mAdjBody.reserve(adj_index.edge_num() * 2);
+  for ( auto id: Range(n) ) {
+    for ( auto id1: adj_index.adj_list(id) ) {
+      mAdjBody.push_back(id1);
+    }
+    mAdjOffset[id + 1] = mAdjBody.size();
+  }
+
+  mWeight.resize(n);
+  for ( auto id: Range(n) ) {
+    mWeight[id] = std::max(graph.node_weight(id), 0);
+  }
+
+  CoreDecomp core_decomp(adj_index);
+  mOrder = core_decomp.order();
+  mOrderPos.resize(n);
+  for ( auto i: Range(n) ) {
+    mOrderPos[mOrder[i]] = i;
+  }
+  mLocalId.resize(n, -1);
+
+  mPerf.end_setup();
+}
+
+// @brief 制限時間を設定する．
+// @param[in] time_limit 制限時間(秒)(0 以下の場合は無制限)
+void
+MwclqSolver::set_time_limit(double time_limit)
+{
+  mLimit.set_time_limit(time_limit);
+}
+
+// @brief 最大重みクリークを求める．
+// @param[out] node_set クリークの要素(ノード番号の昇順)
+// @return 重みの和を返す．
+std::int64_t
+MwclqSolver::solve(vector<int>& node_set)
+{
+  // 最も重いノード1つを初期解とする．
+  int n = mWeight.size();
+  mBestWeight = 0;
+  mBestSet.clear();
+  for ( auto id: Range(n) ) {
+    if ( mBestWeight < mWeight[id] ) {
+      mBestWeight = mWeight[id];
+      mBestSet = {id};
+    }
+  }
+
+  // 密な部分ほど重いクリークを含みやすいので後ろから調べる．
+  mStop = false;
+  for ( int pos = n - 1; pos >= 0 && !mStop; -- pos ) {
+    root(pos);
+  }
+  mOptimal = !mStop;
+
+  node_set = mBestSet;
+  std::sort(node_set.begin(), node_set.end());
+  mPerf.end_search();
+  return mBestWeight;
+}
+
+// @brief 根のノードの部分問題を解く．
+// @param[in] pos 根のノードの縮退度の順での位置
+void
+MwclqSolver::root(int pos)
+{
+  int node_id = mOrder[pos];
+  if ( mWeight[node_id] == 0 ) {
+    return;
+  }
+  mPerf.count_iteration();
+
+  vector<int> cand_list;
+  std::int64_t total = mWeight[node_id];
+  for ( auto p = adj_begin(node_id); p != adj_end(node_id); ++ p ) {
+    auto id1 = *p;
+    if ( mOrderPos[id1] > pos && mWeight[id1] > 0 ) {
+      cand_list.push_back(id1);
+      total += mWeight[id1];
+    }
+  }
+  if ( total <= mBestWeight ) {
+    return;
+  }
+
+  // 重いノードから先に彩色されるように局所番号を振る．
+  std::sort(cand_list.begin(), cand_list.end(),
+	    [&](int id1, int id2) {
+	      if ( mWeight[id1] != mWeight[id2] ) {
+		return mWeight[id1] > mWeight[id2];
+	      }
+	      return id1 < id2;
+	    });
+  int ns = cand_list.size();
+  int nw = (ns + WORD_BITS - 1) / WORD_BITS;
+  mWordNum = nw;
+  mLocalNode = cand_list;
+  mLocalWeight.resize(ns);
+  for ( auto i: Range(ns) ) {
+    auto id = cand_list[i];
+    mLocalId[id] = i;
+    mLocalWeight[i] = mWeight[id];
+  }
+
+  mBitAdj.clear();
+  mBitAdj.resize(static_cast<SizeType>(ns) * nw, 0);
+  for ( auto i1: Range(ns) ) {
+    auto id1 = cand_list[i1];
+    auto row = &mBitAdj[static_cast<SizeType>(i1) * nw];
+    if ( adj_end(id1) - adj_begin(id1) <= ns * 8 ) {
+      for ( auto p = adj_begin(id1); p != adj_end(id1); ++ p ) {
+	auto i2 = mLocalId[*p];
+	if ( i2 >= 0 ) {
+	  row[i2 / WORD_BITS] |= 1ULL << (i2 % WORD_BITS);
+	}
+      }
+    }
+    else {
+      // 次数の大きなノードは二分探索で調べる．
+      for ( auto i2: Range(ns) ) {
+	if ( std::binary_search(adj_begin(id1), adj_end(id1),
+				cand_list[i2]) ) {
+	  row[i2 / WORD_BITS] |= 1ULL << (i2 % WORD_BITS);
+	}
+      }
+    }
+  }
+  for ( auto id: cand_list ) {
+    mLocalId[id] = -1;
+  }
+
+  // 1段ごとに候補は1つ以上減るので深さは ns + 1 以下となる．
+  SizeType stack_size = static_cast<SizeType>(ns + 2) * nw;
+  if ( mCandStack.size() < stack_size ) {
+    mCandStack.resize(stack_size);
+  }
+  if ( mOrderStack.size() < ns + 2 ) {
+    mOrderStack.resize(ns + 2);
+    mBoundStack.resize(ns + 2);
+  }
+  if ( mClassBits.size() < static_cast<SizeType>(ns) * nw ) {
+    mClassBits.resize(static_cast<SizeType>(ns) * nw);
+    mClassWeight.resize(ns);
+  }
+  auto cand = cand_bits(0);
+  for ( auto i: Range(nw) ) {
+    cand[i] = 0;
+  }
+  for ( auto i: Range(ns) ) {
+    cand[i / WORD_BITS] |= 1ULL << (i % WORD_BITS);
+  }
+
+  mClique.clear();
+  mClique.push_back(node_id);
+  expand(0, mWeight[node_id]);
+}
+
+// @brief 候補を彩色して上界を求める．
+// @param[in] depth 深さ
+void
+MwclqSolver::color_bound(int depth)
+{
+  int nw = mWordNum;
+  auto cand = cand_bits(depth);
+  auto& order_list = mOrderStack[depth];
+  auto& bound_list = mBoundStack[depth];
+  order_list.clear();
+  bound_list.clear();
+
+  int nc = 0;
+  std::int64_t ub = 0;
+  for ( auto i: Range(nw) ) {
+    auto bits = cand[i];
+    while ( bits != 0 ) {
+      int v = i * WORD_BITS + lowest_bit(bits);
+      bits &= bits - 1;
+      auto row = adj_bits(v);
+      std::int64_t rest = mLocalWeight[v];
+      // v と隣接しない色クラスに重みを分けて入れる．
+      for ( int c = 0; c < nc && rest > 0; ++ c ) {
+	auto class_bits = &mClassBits[static_cast<SizeType>(c) * nw];
+	bool conflict = false;
+	for ( auto j: Range(nw) ) {
+	  if ( (class_bits[j] & row[j]) != 0 ) {
+	    conflict = true;
+	    break;
+	  }
+	}
+	if ( !conflict ) {
+	  rest -= std::min(rest, mClassWeight[c]);
+	  class_bits[i] |= 1ULL << (v % WORD_BITS);
+	}
+      }
+      if ( rest > 0 ) {
+	// 入りきらなかった分で新しい色クラスを作る．
+	auto class_bits = &mClassBits[static_cast<SizeType>(nc) * nw];
+	for ( auto j: Range(nw) ) {
+	  class_bits[j] = 0;
+	}
+	class_bits[i] |= 1ULL << (v % WORD_BITS);
+	mClassWeight[nc] = rest;
+	++ nc;
+	ub += rest;
+      }
+      order_list.push_back(v);
+      bound_list.push_back(ub);
+    }
+  }
+}
+
+// @brief 分枝限定法の本体
+// @param[in] depth 深さ
+// @param[in] weight 現在のクリークの重み
+void
+MwclqSolver::expand(int depth,
+		    std::int64_t weight)
+{
+  mPerf.count_branch();
+  ++ mBranchNum;
+  if ( (mBranchNum & CHECK_MASK) == 0 && mLimit.is_expired() ) {
+    mStop = true;
+  }
+  if ( mStop ) {
+    return;
+  }
+
+  int nw = mWordNum;
+  auto cand = cand_bits(depth);
+  bool empty = true;
+  for ( auto i: Range(nw) ) {
+    if ( cand[i] != 0 ) {
+      empty = false;
+      break;
+    }
+  }
+  if ( empty ) {
+    if ( mBestWeight < weight ) {
+      mBestWeight = weight;
+      mBestSet = mClique;
+    }
+    return;
+  }
+
+  color_bound(depth);
+  const auto& order_list = mOrderStack[depth];
+  const auto& bound_list = mBoundStack[depth];
+  auto cand1 = cand_bits(depth + 1);
+  for ( int k = order_list.size() - 1; k >= 0; -- k ) {
+    if ( weight + bound_list[k] <= mBestWeight ) {
+      // これより前のノードだけでは最良解を超えられない．
+      break;
+    }
+    int v = order_list[k];
+    auto row = adj_bits(v);
+    for ( auto i: Range(nw) ) {
+      cand1[i] = cand[i] & row[i];
+    }
+    mClique.push_back(mLocalNode[v]);
+    expand(depth + 1, weight + mLocalWeight[v]);
+    mClique.pop_back();
+    if ( mStop ) {
+      return;
+    }
+    cand[v / WORD_BITS] &= ~(1ULL << (v % WORD_BITS));
+  }
+}
+
+END_NAMESPACE_YM_UDGRAPH
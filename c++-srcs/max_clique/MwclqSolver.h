@@ -0,0 +1,211 @@
+#ifndef MWCLQSOLVER_H
+#define MWCLQSOLVER_H
+
+/// @file MwclqSolver.h
+/// @brief MwclqSolver のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/UdGraph.h"
+#include "PerfCounter.h"
+#include "SearchLimit.h"
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+//////////////////////////////////////////////////////////////////////
+/// @class MwclqSolver MwclqSolver.h "MwclqSolver.h"
+/// @brief 最大重みクリークを分枝限定法で求めるクラス
+///
+/// - 縮退度の順(CoreDecomp::order())の逆順に根のノード v を選び，
+///   v より後ろの隣接ノードだけを候補とする部分問題を解く．
+///   候補数は縮退度以下なので局所的な番号を振ってビットベクタで表す．
+/// - 上界は候補を独立集合に分ける彩色で求める．ノードの重みは
+///   既存の色クラスに分割して入れてよいものとし(WLMC, TSM-MWC)，
+///   入りきらなかった分だけ新しい色クラスを作る．
+///   上界は各色クラスに入れた重みの最大値の和となる．
+/// - 候補を彩色した順に並べ，後ろから分枝する．ある位置までの
+///   上界で現在の最良解を超えられなければそれより前は調べない．
+/// - 重みが 0 以下のノードは選ばない．
+//////////////////////////////////////////////////////////////////////
+class MwclqSolver
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] graph 対象のグラフ
+  explicit
+  MwclqSolver(const UdGraph& graph);
+
+  /// @brief デストラクタ
+  ~MwclqSolver() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 制限時間を設定する．
+  /// @param[in] time_limit 制限時間(秒)(0 以下の場合は無制限)
+  void
+  set_time_limit(double time_limit);
+
+  /// @brief 最大重みクリークを求める．
+  /// @param[out] node_set クリークの要素(ノード番号の昇順)
+  /// @return 重みの和を返す．
+  std::int64_t
+  solve(vector<int>& node_set);
+
+  /// @brief 最後まで探索して最適解が得られた時 true を返す．
+  bool
+  is_optimal() const
+  {
+    return mOptimal;
+  }
+
+  /// @brief 性能計測用のカウンタを返す．
+  const PerfCounter&
+  perf() const
+  {
+    return mPerf;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 根のノードの部分問題を解く．
+  /// @param[in] pos 根のノードの縮退度の順での位置
+  void
+  root(int pos);
+
+  /// @brief 候補を彩色して上界を求める．
+  /// @param[in] depth 深さ
+  ///
+  /// mOrderStack[depth] に彩色した順のノードを，mBoundStack[depth] に
+  /// そこまでのノードの上界を入れる．
+  void
+  color_bound(int depth);
+
+  /// @brief 分枝限定法の本体
+  /// @param[in] depth 深さ
+  /// @param[in] weight 現在のクリークの重み
+  void
+  expand(int depth,
+	 std::int64_t weight);
+
+  /// @brief 隣接リストの先頭を返す．
+  const int*
+  adj_begin(int id) const
+  {
+    return mAdjBody.data() + mAdjOffset[id];
+  }
+
+  /// @brief 隣接リストの末尾を返す．
+  const int*
+  adj_end(int id) const
+  {
+    return mAdjBody.data() + mAdjOffset[id + 1];
+  }
+
+  /// @brief 深さ depth の候補のビットベクタを返す．
+  std::uint64_t*
+  cand_bits(int depth)
+  {
+    return &mCandStack[static_cast<SizeType>(depth) * mWordNum];
+  }
+
+  /// @brief 局所番号 i のノードの隣接ノードのビットベクタを返す．
+  const std::uint64_t*
+  adj_bits(int i) const
+  {
+    return &mBitAdj[static_cast<SizeType>(i) * mWordNum];
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 各ノードの隣接リストの先頭位置(ノード数 + 1 個)
+  vector<SizeType> mAdjOffset;
+
+  // 隣接リストの本体(ノードごとに昇順で重複なし)
+  vector<int> mAdjBody;
+
+  // ノードの重み(0 以下のものは 0 とする)
+  vector<int> mWeight;
+
+  // 縮退度の順のノードのリスト
+  vector<int> mOrder;
+
+  // ノード番号をキーにした mOrder 上の位置
+  vector<int> mOrderPos;
+
+  // 打ち切り条件
+  SearchLimit mLimit;
+
+  // 分枝ノード数
+  SizeType mBranchNum{0};
+
+  // 打ち切った時 true にする．
+  bool mStop{false};
+
+  // 最良解が最適解の時 true となる．
+  bool mOptimal{false};
+
+  // 最良解の重み
+  std::int64_t mBestWeight{0};
+
+  // 最良解
+  vector<int> mBestSet;
+
+  // 現在のクリーク
+  vector<int> mClique;
+
+  // ビットベクタ1つあたりのワード数
+  int mWordNum{0};
+
+  // 局所番号をキーにしたノード番号
+  vector<int> mLocalNode;
+
+  // 局所番号をキーにした重み
+  vector<int> mLocalWeight;
+
+  // ノード番号をキーにした局所番号(-1 は対象外)
+  vector<int> mLocalId;
+
+  // 局所番号をキーにした隣接ノードのビットベクタ
+  vector<std::uint64_t> mBitAdj;
+
+  // 深さごとの候補のビットベクタ
+  vector<std::uint64_t> mCandStack;
+
+  // 深さごとの彩色した順のノードのリスト
+  vector<vector<int>> mOrderStack;
+
+  // 深さごとの mOrderStack の各位置までの上界
+  vector<vector<std::int64_t>> mBoundStack;
+
+  // 色クラスごとの要素のビットベクタ(color_bound() の作業領域)
+  vector<std::uint64_t> mClassBits;
+
+  // 色クラスごとの重みの最大値(color_bound() の作業領域)
+  vector<std::int64_t> mClassWeight;
+
+  // 性能計測用のカウンタ
+  PerfCounter mPerf;
+
+};
+
+END_NAMESPACE_YM_UDGRAPH
+
+#endif // MWCLQSOLVER_H
@@ -9,19 +9,36 @@
 
 #include "ym/UdGraph.h"
 #include "MclqSolver.h"
+#include "MwclqSolver.h"
+#include "PerfCounter.h"
+#include "GraphDecomp.h"
+#include "ThreadPool.h"
+#include "SearchLimit.h"
+#include "ym/Range.h"
 
 
 BEGIN_NAMESPACE_YM_UDGRAPH
 
-// @brief (最大)クリークを求める．
-// @param[in] algorithm アルゴリズム名
-// @return クリークの要素(ノード番号)を収める配列を返す．
+BEGIN_NONAMESPACE
+
+// 連結成分に分割せずに最大クリークを求める．
 vector<int>
-UdGraph::max_clique(const string& algorithm) const
+max_clique_sub(const UdGraph& graph,
+	       const string& algorithm,
+	       const UdGraph::NodeSetOptions& options,
+	       UdGraph::NodeSetStats& stats)
 {
-  MclqSolver solver(*this);
-
   vector<int> node_set;
+  if ( algorithm == "weighted" ) {
+    MwclqSolver solver(graph);
+    solver.set_time_limit(options.time_limit);
+    stats.weight = solver.solve(node_set);
+    stats.optimal = solver.is_optimal();
+    solver.perf().add_to(stats.perf);
+    return node_set;
+  }
+
+  MclqSolver solver(graph);
   if ( algorithm == "exact" ) {
     solver.exact(node_set);
   }
@@ -32,6 +49,130 @@ UdGraph::max_clique(const string& algorithm) const
     // デフォルトフォールバック
     solver.greedy(node_set);
   }
+  stats.weight = 0;
+  for ( auto id: node_set ) {
+    stats.weight += graph.node_weight(id);
+  }
+  solver.perf().add_to(stats.perf);
+  return node_set;
+}
+
+END_NONAMESPACE
+
+// @brief (最大)クリークを求める．
+// @param[in] algorithm アルゴリズム名
+// @param[in] reorder ノードの並べ替えの方法(空なら並べ替えない)
+// @return クリークの要素(ノード番号)を収める配列を返す．
+vector<int>
+UdGraph::max_clique(const string& algorithm,
+		    const string& reorder) const
+{
+  PerfStats stats;
+  return max_clique(algorithm, reorder, stats);
+}
+
+// @brief (最大)クリークを求める．
+// @param[in] algorithm アルゴリズム名
+// @param[in] reorder ノードの並べ替えの方法(空なら並べ替えない)
+// @param[out] stats 性能計測用のカウンタ
+// @return クリークの要素(ノード番号)を収める配列を返す．
+vector<int>
+UdGraph::max_clique(const string& algorithm,
+		    const string& reorder,
+		    PerfStats& stats) const
+{
+  NodeSetOptions options;
+  options.reorder = reorder;
+  NodeSetStats stats1;
+  auto node_set = max_clique(algorithm, options, stats1);
+  stats = stats1.perf;
+  return node_set;
+}
+
+// @brief オプションを指定して(最大)クリークを求める．
+// @param[in] algorithm アルゴリズム名
+// @param[in] options オプション
+// @return クリークの要素(ノード番号)を収める配列を返す．
+vector<int>
+UdGraph::max_clique(const string& algorithm,
+		    const NodeSetOptions& options) const
+{
+  NodeSetStats stats;
+  return max_clique(algorithm, options, stats);
+}
+
+// @brief オプションを指定して(最大)クリークを求める．
+// @param[in] algorithm アルゴリズム名
+// @param[in] options オプション
+// @param[out] stats 実行結果に関する情報
+// @return クリークの要素(ノード番号)を収める配列を返す．
+//
+// 複数の連結成分からなる場合は部分グラフごとに並列に解いて
+// 最大のもの("weighted" の場合は重みの和が最大のもの)を選ぶ．
+vector<int>
+UdGraph::max_clique(const string& algorithm,
+		    const NodeSetOptions& options,
+		    NodeSetStats& stats) const
+{
+  stats = NodeSetStats{};
+  if ( !options.reorder.empty() ) {
+    // 並べ替えたグラフで解いて結果を元のノード番号に戻す．
+    auto order = node_order(options.reorder);
+    auto options1 = options;
+    options1.reorder = string();
+    auto node_set = relabel(order).max_clique(algorithm, options1, stats);
+    for ( auto& id: node_set ) {
+      id = order[id];
+    }
+    return node_set;
+  }
+
+  GraphDecomp decomp(*this);
+  int np = decomp.part_num();
+  if ( np <= 1 ) {
+    return max_clique_sub(*this, algorithm, options, stats);
+  }
+
+  // 制限時間は全体で共有する．
+  SearchLimit limit(options.time_limit);
+  vector<vector<int>> ans_list(np);
+  vector<NodeSetStats> stats_list(np);
+  int thread_num = ThreadPool::default_thread_num(options.thread_num);
+  ThreadPool pool(std::min(thread_num, np));
+  pool.parallel_for(np, [&](int i) {
+    auto options1 = options;
+    if ( limit.has_deadline() ) {
+      options1.time_limit = std::max(limit.remaining_time(), 1e-6);
+    }
+    ans_list[i] = max_clique_sub(decomp.part_graph(i), algorithm, options1,
+				 stats_list[i]);
+  });
+
+  bool weighted = algorithm == "weighted";
+  auto better = [&](int i1, int i2) {
+    if ( weighted ) {
+      return stats_list[i1].weight > stats_list[i2].weight;
+    }
+    return ans_list[i1].size() > ans_list[i2].size();
+  };
+  int max_pos = 0;
+  stats.optimal = true;
+  for ( auto i: Range(np) ) {
+    PerfCounter::add_stats(stats.perf, stats_list[i].perf);
+    stats.optimal = stats.optimal && stats_list[i].optimal;
+  }
+  for ( auto i: Range(1, np) ) {
+    if ( better(i, max_pos) ) {
+      max_pos = i;
+    }
+  }
+  stats.weight = stats_list[max_pos].weight;
+  const auto& node_map = decomp.node_map(max_pos);
+  vector<int> node_set;
+  node_set.reserve(ans_list[max_pos].size());
+  for ( auto id: ans_list[max_pos] ) {
+    node_set.push_back(node_map[id]);
+  }
   return node_set;
 }
 
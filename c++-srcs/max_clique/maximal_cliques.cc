@@ -0,0 +1,62 @@
+
+/// @file maximal_cliques.cc
+/// @brief enum_maximal_cliques の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/UdGraph.h"
+#include "CliqueEnum.h"
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+// @brief 極大クリークを列挙する．
+// @param[in] callback 極大クリークを受け取る関数
+// @return 報告したクリーク数を返す．
+SizeType
+UdGraph::enum_maximal_cliques(const CliqueCallback& callback) const
+{
+  CliqueEnumOptions options;
+  CliqueEnumStats stats;
+  return enum_maximal_cliques(options, callback, stats);
+}
+
+// @brief オプションを指定して極大クリークを列挙する．
+// @param[in] options オプション
+// @param[in] callback 極大クリークを受け取る関数
+// @return 報告したクリーク数を返す．
+SizeType
+UdGraph::enum_maximal_cliques(const CliqueEnumOptions& options,
+			      const CliqueCallback& callback) const
+{
+  CliqueEnumStats stats;
+  return enum_maximal_cliques(options, callback, stats);
+}
+
+// @brief オプションを指定して極大クリークを列挙する．
+// @param[in] options オプション
+// @param[in] callback 極大クリークを受け取る関数
+// @param[out] stats 実行結果に関する情報
+// @return 報告したクリーク数を返す．
+SizeType
+UdGraph::enum_maximal_cliques(const CliqueEnumOptions& options,
+			      const CliqueCallback& callback,
+			      CliqueEnumStats& stats) const
+{
+  stats = CliqueEnumStats{};
+  CliqueEnum solver(*this);
+  solver.set_min_size(options.min_size);
+  solver.set_time_limit(options.time_limit);
+  solver.set_thread_num(options.thread_num);
+  auto n = solver.enumerate(callback);
+  stats.clique_num = n;
+  stats.max_size = solver.max_size();
+  stats.completed = solver.is_completed();
+  solver.perf().add_to(stats.perf);
+  return n;
+}
+
+END_NAMESPACE_YM_UDGRAPH
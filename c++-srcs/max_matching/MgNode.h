@@ -9,6 +9,7 @@
 /// All rights reserved.
 
 #include "ym/UdGraph.h"
+#include "ym/Array.h"
 
 
 BEGIN_NAMESPACE_YM_UDGRAPH
@@ -26,8 +27,19 @@ public:
   // 番号
   int id;
 
-  // 枝のリスト
-  vector<MgEdge*> edge_list;
+  // 枝の配列の先頭
+  //
+  // 本体は MgWork が一つの配列にまとめて持つ．
+  MgEdge** edge_top{nullptr};
+
+  // 枝の数
+  int edge_num{0};
+
+  // 選択されている枝(mate)
+  //
+  // 選択されている枝がない場合は nullptr となる．
+  // 枝の選択状態を変える時には必ず両端のこの値を更新する．
+  MgEdge* mate{nullptr};
 
   // 現在の値のリスト
   vector<int> value_list;
@@ -35,9 +47,12 @@ public:
   // 増加路上の枝のリスト
   vector<MgEdge*> alt_edge_list;
 
-  // 選択されている枝を返す．
-  MgEdge*
-  selected_edge() const;
+  // 枝のリストを返す．
+  Array<MgEdge*>
+  edge_list() const
+  {
+    return Array<MgEdge*>(edge_top, 0, edge_num);
+  }
 
 };
 
@@ -0,0 +1,358 @@
+#ifndef UDGRAPH_MGWORK_H
+#define UDGRAPH_MGWORK_H
+
+/// @file MgWork.h
+/// @brief MgWork のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/UdGraph.h"
+#include "MgNode.h"
+#include "MgEdge.h"
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+//////////////////////////////////////////////////////////////////////
+/// @class MgWork MgWork.h "MgWork.h"
+/// @brief 最大重みマッチング用の作業領域を表すクラス
+///
+/// - ノード，枝，隣接リストをそれぞれ一つの配列(アリーナ)にまとめて持つ．
+/// - 初期解は MatchInit.h の関数で作る．
+/// - 探索用のキューや印の配列もここで持つ．
+/// - 自己ループはマッチングに選べないので，枝の配列には置くが
+///   隣接リストと edge_list() には入れない．
+///   そのため初期解も増加路も自己ループを用いることはない．
+/// - set_graph() は既存の領域を再利用するので，同程度の大きさのグラフを
+///   繰り返し解く場合には新たなメモリ確保は起こらない．
+//////////////////////////////////////////////////////////////////////
+class MgWork
+{
+public:
+
+  /// @brief ノードの型
+  using Node = MgNode;
+
+  /// @brief 枝の型
+  using Edge = MgEdge;
+
+  /// @brief コンストラクタ
+  MgWork() = default;
+
+  /// @brief デストラクタ
+  ~MgWork() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief グラフの内容を設定する．
+  /// @param[in] graph 対象のグラフ
+  ///
+  /// 以前の内容は破棄される．
+  void
+  set_graph(const UdGraph& graph);
+
+  /// @brief ノードの配列を返す．
+  vector<MgNode>&
+  node_array()
+  {
+    return mNodeArray;
+  }
+
+  /// @brief ノード数を返す．
+  int
+  node_num() const
+  {
+    return mNodeArray.size();
+  }
+
+  /// @brief ノードを返す．
+  /// @param[in] pos 位置番号 ( 0 <= pos < node_num() )
+  MgNode*
+  node(int pos)
+  {
+    return &mNodeArray[pos];
+  }
+
+  /// @brief ノードの位置番号を返す．
+  /// @param[in] node 対象のノード
+  int
+  node_index(const MgNode* node) const
+  {
+    return node - mNodeArray.data();
+  }
+
+  /// @brief 枝を返す．
+  /// @param[in] id 枝番号
+  MgEdge*
+  edge(int id)
+  {
+    return &mEdgeArray[id];
+  }
+
+  /// @brief 重みの降順に並べた枝のリストを返す．
+  const vector<MgEdge*>&
+  edge_list() const
+  {
+    return mEdgeList;
+  }
+
+  /// @brief 奇数番目の頂点を入れるキューを返す．
+  vector<MgNode*>&
+  queue1()
+  {
+    return mQueue1;
+  }
+
+  /// @brief 次の段の頂点を入れるキューを返す．
+  vector<MgNode*>&
+  queue2()
+  {
+    return mQueue2;
+  }
+
+  /// @brief 増加路を入れる領域を返す．
+  vector<MgEdge*>&
+  path()
+  {
+    return mPath;
+  }
+
+  /// @brief 枝を選択する．
+  /// @param[in] edge 対象の枝
+  ///
+  /// edge の両端は選択されていなければならない．
+  void
+  select_edge(MgEdge* edge);
+
+  /// @brief 増加路(path())を反転させてもマッチングになる時 true を返す．
+  ///
+  /// 奇閉路を含むグラフでは同じノードを2度通る経路が見つかることがあり，
+  /// それを反転させるとマッチングにならない．
+  bool
+  check_path();
+
+  /// @brief 増加路(path())上の枝の選択状態を反転させる．
+  void
+  flip_path();
+
+  /// @brief キューに積まれた印を全て消す．
+  void
+  clear_mark();
+
+  /// @brief キューに積まれた印を付ける．
+  void
+  set_mark(const MgNode* node)
+  {
+    mMarkArray[node->id] = mCurMark;
+  }
+
+  /// @brief キューに積まれた印を持つ時 true を返す．
+  bool
+  check_mark(const MgNode* node) const
+  {
+    return mMarkArray[node->id] == mCurMark;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ノードの配列
+  vector<MgNode> mNodeArray;
+
+  // 枝の配列
+  vector<MgEdge> mEdgeArray;
+
+  // 全ノードの枝のリストを詰めた配列
+  vector<MgEdge*> mAdjArray;
+
+  // 重みの降順に並べた枝のリスト
+  vector<MgEdge*> mEdgeList;
+
+  // キュー
+  vector<MgNode*> mQueue1;
+  vector<MgNode*> mQueue2;
+
+  // 増加路
+  vector<MgEdge*> mPath;
+
+  // キューに積まれた印の配列
+  //
+  // mCurMark と等しい時に印が付いているとみなす．
+  vector<int> mMarkArray;
+
+  // 現在の印の値
+  int mCurMark{0};
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief グラフの内容を設定する．
+// @param[in] graph 対象のグラフ
+inline
+void
+MgWork::set_graph(const UdGraph& graph)
+{
+  int n = graph.node_num();
+  int m = graph.edge_num();
+
+  // 配列の大きさを先に決めておく．
+  // 以降はポインタを取るので再確保してはいけない．
+  mNodeArray.resize(n);
+  mEdgeArray.resize(m);
+  mAdjArray.resize(m * 2);
+  mEdgeList.clear();
+  mEdgeList.reserve(m);
+  mQueue1.reserve(n);
+  mQueue2.reserve(n);
+  mPath.reserve(n);
+  mMarkArray.resize(n);
+  clear_mark();
+
+  for ( int i = 0; i < n; ++ i ) {
+    auto& node = mNodeArray[i];
+    node.id = i;
+    node.edge_num = 0;
+    node.mate = nullptr;
+  }
+  for ( const auto& pair: graph.edge_view() ) {
+    if ( pair.id1 == pair.id2 ) {
+      continue;
+    }
+    ++ mNodeArray[pair.id1].edge_num;
+    ++ mNodeArray[pair.id2].edge_num;
+  }
+  auto top = mAdjArray.data();
+  for ( auto& node: mNodeArray ) {
+    node.edge_top = top;
+    top += node.edge_num;
+    node.edge_num = 0;
+  }
+
+  for ( int i = 0; i < m; ++ i ) {
+    auto node1 = &mNodeArray[graph.edge_id1(i)];
+    auto node2 = &mNodeArray[graph.edge_id2(i)];
+    auto edge = &mEdgeArray[i];
+    *edge = MgEdge{i, node1, node2, graph.edge_weight(i)};
+    if ( node1 == node2 ) {
+      // 自己ループ
+      continue;
+    }
+    mEdgeList.push_back(edge);
+    node1->edge_top[node1->edge_num] = edge;
+    ++ node1->edge_num;
+    node2->edge_top[node2->edge_num] = edge;
+    ++ node2->edge_num;
+  }
+
+  // mEdgeList を重みの降順にソートする．
+  sort(mEdgeList.begin(), mEdgeList.end(), EdgeLt());
+}
+
+// @brief 枝を選択する．
+// @param[in] edge 対象の枝
+inline
+void
+MgWork::select_edge(MgEdge* edge)
+{
+  ASSERT_COND( edge->node1->mate == nullptr );
+  ASSERT_COND( edge->node2->mate == nullptr );
+  edge->selected = true;
+  edge->node1->mate = edge;
+  edge->node2->mate = edge;
+}
+
+// @brief 増加路(path())を反転させてもマッチングになる時 true を返す．
+inline
+bool
+MgWork::check_path()
+{
+  // 選択を外す枝の端点に印を付ける．
+  clear_mark();
+  for ( auto edge: mPath ) {
+    if ( edge->selected ) {
+      set_mark(edge->node1);
+      set_mark(edge->node2);
+    }
+  }
+  // 新たに選ぶ枝の端点は選択枝を持たないか，それが外れなければならない．
+  for ( auto edge: mPath ) {
+    if ( !edge->selected ) {
+      for ( auto node: {edge->node1, edge->node2} ) {
+	if ( node->mate != nullptr && !check_mark(node) ) {
+	  return false;
+	}
+      }
+    }
+  }
+  // 新たに選ぶ枝が同じ端点を共有してはならない．
+  clear_mark();
+  for ( auto edge: mPath ) {
+    if ( !edge->selected ) {
+      if ( check_mark(edge->node1) ) {
+	return false;
+      }
+      set_mark(edge->node1);
+      if ( edge->node2 != edge->node1 ) {
+	if ( check_mark(edge->node2) ) {
+	  return false;
+	}
+	set_mark(edge->node2);
+      }
+    }
+  }
+  return true;
+}
+
+// @brief 増加路(path())上の枝の選択状態を反転させる．
+inline
+void
+MgWork::flip_path()
+{
+  // 選択を外す枝の mate を先に消しておく．
+  for ( auto edge: mPath ) {
+    if ( edge->selected ) {
+      edge->selected = false;
+      edge->node1->mate = nullptr;
+      edge->node2->mate = nullptr;
+    }
+    else {
+      edge->selected = true;
+    }
+  }
+  for ( auto edge: mPath ) {
+    if ( edge->selected ) {
+      edge->node1->mate = edge;
+      edge->node2->mate = edge;
+    }
+  }
+}
+
+// @brief キューに積まれた印を全て消す．
+inline
+void
+MgWork::clear_mark()
+{
+  ++ mCurMark;
+  if ( mCurMark == numeric_limits<int>::max() ) {
+    // 一巡したら配列を初期化する．
+    std::fill(mMarkArray.begin(), mMarkArray.end(), 0);
+    mCurMark = 1;
+  }
+}
+
+END_NAMESPACE_YM_UDGRAPH
+
+#endif // UDGRAPH_MGWORK_H
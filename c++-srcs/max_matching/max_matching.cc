@@ -10,84 +10,80 @@
 #include "ym/UdGraph.h"
 #include "MgNode.h"
 #include "MgEdge.h"
+#include "MgWork.h"
+#include "MatchInit.h"
+#include "PerfCounter.h"
+#include "GraphDecomp.h"
+#include "ThreadPool.h"
 #include "ym/Range.h"
 
 
 BEGIN_NAMESPACE_YM_UDGRAPH
 
 
-//////////////////////////////////////////////////////////////////////
-// MgNode の関数
-//////////////////////////////////////////////////////////////////////
-
-// 選択されている枝を返す．
-inline
-MgEdge*
-MgNode::selected_edge() const
-{
-  for ( auto edge: edge_list ) {
-    if ( edge->selected ) {
-      return edge;
-    }
-  }
-  return nullptr;
-}
-
 BEGIN_NONAMESPACE
 
 // @brief パスを復元する．
-vector<MgEdge*>
+// @param[in] node1 増加路の端点
+// @param[in] edge1 node1 に接続する枝
+// @param[in] phase node1 の段数
+// @param[out] path 増加路上の枝を入れるリスト
+//
+// path に入る枝の順番は意味を持たない．
+void
 make_path(MgNode* node1,
 	  MgEdge* edge1,
-	  int phase)
+	  int phase,
+	  vector<MgEdge*>& path)
 {
-  auto node2 = edge1->alt_node(node1);
-  auto edge2 = node2->selected_edge();
-  if ( edge2 == nullptr ) {
-    return vector<MgEdge*>{edge1};
-  }
-  else {
-    auto node3 = edge2->alt_node(node2);
-    auto edge3 = node2->alt_edge_list[phase - 1];
-    auto path = make_path(node3, edge3, phase - 1);
-    path.push_back(edge2);
+  for ( ; ; ) {
     path.push_back(edge1);
-    return path;
+    auto node2 = edge1->alt_node(node1);
+    auto edge2 = node2->mate;
+    if ( edge2 == nullptr ) {
+      break;
+    }
+    path.push_back(edge2);
+    node1 = edge2->alt_node(node2);
+    edge1 = node2->alt_edge_list[phase - 1];
+    -- phase;
   }
 }
 
 // @brief 重み最大の交互路を見つける．
-vector<MgEdge*>
-find_path(const vector<MgNode*>& node_list,
-	  const vector<MgEdge*>& edge_list)
+// @return 見つかった交互路(work.path())を返す．
+//
+// 見つからなかった場合は空のリストを返す．
+const vector<MgEdge*>&
+find_path(MgWork& work,
+	  PerfCounter& perf)
 {
-  // 両端が選択されていない枝の中で重みが最大のものを選ぶ．
-  for ( auto edge: edge_list ) {
-    if ( edge->node1->selected_edge() == nullptr &&
-	 edge->node2->selected_edge() == nullptr ) {
-      return vector<MgEdge*>{edge};
-    }
-  }
+  auto& path = work.path();
+  path.clear();
 
-  // 以降は片方の端が選択されたノードのみとなる．
+  // 初期解の後なので両端が選択されていない枝はない．
+  // 増加路の端点は選択された枝を持つようになるだけなので
+  // 以降もそのような枝は現れない．
 
-  for ( auto node: node_list ) {
-    node->value_list.clear();
-    node->alt_edge_list.clear();
+  auto& node_array = work.node_array();
+  for ( auto& node: node_array ) {
+    node.value_list.clear();
+    node.alt_edge_list.clear();
   }
 
-  int n = node_list.size();
+  int n = node_array.size();
 
   // 奇数番目の頂点を入れるキュー
-  vector<MgNode*> queue1;
-  queue1.reserve(n);
+  auto& queue1 = work.queue1();
+  auto& queue2 = work.queue2();
+  queue1.clear();
 
-  for ( auto node: node_list ) {
+  for ( auto& node: node_array ) {
     // 選択された枝を持たないノードをキューに積む．
-    if ( node->selected_edge() == nullptr ) {
-      node->value_list.push_back(0);
-      node->alt_edge_list.push_back(nullptr);
-      queue1.push_back(node);
+    if ( node.mate == nullptr ) {
+      node.value_list.push_back(0);
+      node.alt_edge_list.push_back(nullptr);
+      queue1.push_back(&node);
     }
   }
 
@@ -96,20 +92,22 @@ find_path(const vector<MgNode*>& node_list,
   MgNode* max_node = nullptr;
   MgEdge* max_edge = nullptr;
   int phase = 0;
-  while ( !found && queue1.size() > 0 ) {
-    vector<MgNode*> queue2;
-    queue2.reserve(n);
-    vector<bool> in_queue(n, false);
+  // 増加路は同じノードを2度通らないので n 段で打ち切る．
+  // こうしないと増加路がなく交互閉路がある場合に終わらない．
+  while ( !found && queue1.size() > 0 && phase < n ) {
+    perf.count_iteration();
+    queue2.clear();
+    work.clear_mark();
     for ( auto node1: queue1 ) {
       int value1 = node1->value_list[phase];
-      for ( auto edge1: node1->edge_list ) {
+      for ( auto edge1: node1->edge_list() ) {
 	if ( edge1->selected ) {
 	  continue;
 	}
 	// 選択されていない枝を選ぶ．
 	int value2 = value1 + edge1->weight;
 	auto node2 = edge1->alt_node(node1);
-	auto edge2 = node2->selected_edge();
+	auto edge2 = node2->mate;
 	if ( edge2 == nullptr ) {
 	  // node2 は open node だった．
 	  if ( max_value < value2 ) {
@@ -129,9 +127,9 @@ find_path(const vector<MgNode*>& node_list,
 	  if ( node3->value_list[phase + 1] < value3 ) {
 	    node3->value_list[phase + 1] = value3;
 	    node3->alt_edge_list[phase] = edge1;
-	    if ( !in_queue[node3->id] ) {
+	    if ( !work.check_mark(node3) ) {
 	      queue2.push_back(node3);
-	      in_queue[node3->id] = true;
+	      work.set_mark(node3);
 	    }
 	  }
 	}
@@ -141,77 +139,257 @@ find_path(const vector<MgNode*>& node_list,
     queue1.swap(queue2);
   }
 
-  if ( max_node == nullptr ) {
-    return vector<MgEdge*>();
-  }
-  else {
-    auto max_path = make_path(max_node, max_edge, phase - 1);
-    return max_path;
+  if ( max_node != nullptr ) {
+    make_path(max_node, max_edge, phase - 1, path);
   }
+  return path;
 }
 
-END_NONAMESPACE
-
+// 重みの和の上界を求める．
+//
+// - 各ノードに接続する枝の重みの最大値の和の半分は上界となる．
+// - init_weight が 1/2 近似解の重みならその2倍も上界となる．
+std::int64_t
+upper_bound(MgWork& work,
+	    std::int64_t init_weight)
+{
+  std::int64_t sum = 0;
+  for ( int i = 0; i < work.node_num(); ++ i ) {
+    auto node = work.node(i);
+    int max_w = 0;
+    for ( auto edge: node->edge_list() ) {
+      if ( edge->alt_node(node) != node ) {
+	max_w = std::max(max_w, edge->weight);
+      }
+    }
+    sum += max_w;
+  }
+  return std::min(sum / 2, init_weight * 2);
+}
 
-// @brief 最大重みマッチングを求める．
-// @return マッチングに選ばれた枝番号のリストを返す．
+// 連結成分に分割せずに最大重みマッチングを求める．
+//
+// - work は作業領域
+// - algorithm は初期解を求めるアルゴリズム名
+// - augment_limit は増加路で改善する回数の上限(負なら無制限)
+// - bound が nullptr でなければ初期解が 1/2 近似であるとして
+//   重みの和の上界を求める．
 vector<int>
-UdGraph::max_matching(const string& algorithm) const
+max_matching_sub(const UdGraph& graph,
+		 MgWork& work,
+		 const string& algorithm,
+		 int thread_num,
+		 int augment_limit,
+		 UdGraph::PerfStats& stats,
+		 std::int64_t* bound = nullptr)
 {
-  vector<MgNode*> node_list(node_num());
-  for ( int i: Range(node_num()) ) {
-    auto node = new MgNode{i};
-    node_list[i] = node;
-  }
+  PerfCounter perf;
+  perf.start();
+  work.set_graph(graph);
+  perf.end_setup();
 
-  vector<MgEdge*> edge_list(edge_num());
-  for ( int i: Range(edge_num()) ) {
-    int id1 = edge_id1(i);
-    int id2 = edge_id2(i);
-    int w = edge_weight(i);
-    auto node1 = node_list[id1];
-    auto node2 = node_list[id2];
-    auto edge = new MgEdge{i, node1, node2, w};
-    edge_list[i] = edge;
-    node1->edge_list.push_back(edge);
-    node2->edge_list.push_back(edge);
-  }
+  perf.count_augmentation(init_matching(work, algorithm, thread_num));
 
-  // mEdgeList を重みの降順にソートする．
-  sort(edge_list.begin(), edge_list.end(), EdgeLt());
+  if ( bound != nullptr ) {
+    std::int64_t w = 0;
+    for ( auto edge: work.edge_list() ) {
+      if ( edge->selected ) {
+	w += edge->weight;
+      }
+    }
+    *bound = upper_bound(work, w);
+  }
 
-  // 増加路がなくなるまで繰り返す．
-  for ( ; ; ) {
+  // 増加路がなくなるか上限に達するまで繰り返す．
+  for ( int i = 0; augment_limit < 0 || i < augment_limit; ++ i ) {
     // 選択されていない頂点から始まる
     // 交互路を見つける．
-    auto alt_path = find_path(node_list, edge_list);
+    const auto& alt_path = find_path(work, perf);
     if ( alt_path.size() == 0 ) {
       // 増加路がなければ今の状態が最大
       break;
     }
+    if ( !work.check_path() ) {
+      // 奇閉路のせいで正しい増加路が得られなかった．
+      // これ以上は改善できないものとして打ち切る．
+      break;
+    }
 
     // alt_path に従って選択情報を更新する．
-    for ( auto edge: alt_path ) {
-      edge->selected = !edge->selected;
-    }
+    work.flip_path();
+    perf.count_augmentation();
   }
+  perf.end_search();
+  perf.add_to(stats);
 
   // 答のリストを作る．
   vector<int> ans;
-  ans.reserve(edge_list.size());
-  for ( auto edge: edge_list ) {
+  ans.reserve(work.edge_list().size());
+  for ( auto edge: work.edge_list() ) {
     if ( edge->selected ) {
       ans.push_back(edge->id);
     }
   }
 
-  for ( auto node: node_list ) {
-    delete node;
+  return ans;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス UdGraph::MatchingWork
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+UdGraph::MatchingWork::MatchingWork()
+{
+}
+
+// @brief デストラクタ
+UdGraph::MatchingWork::~MatchingWork()
+{
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス UdGraph
+//////////////////////////////////////////////////////////////////////
+
+// @brief 最大重みマッチングを求める．
+// @param[in] algorithm アルゴリズム名
+// @param[in] reorder ノードの並べ替えの方法(空なら並べ替えない)
+// @return マッチングに選ばれた枝番号のリストを返す．
+vector<int>
+UdGraph::max_matching(const string& algorithm,
+		      const string& reorder) const
+{
+  PerfStats stats;
+  return max_matching(algorithm, reorder, stats);
+}
+
+// @brief 最大重みマッチングを求める．
+// @param[in] algorithm アルゴリズム名
+// @param[in] reorder ノードの並べ替えの方法(空なら並べ替えない)
+// @param[out] stats 性能計測用のカウンタ
+// @return マッチングに選ばれた枝番号のリストを返す．
+vector<int>
+UdGraph::max_matching(const string& algorithm,
+		      const string& reorder,
+		      PerfStats& stats) const
+{
+  MatchingOptions options;
+  options.reorder = reorder;
+  MatchingStats match_stats;
+  auto ans = max_matching(algorithm, options, match_stats);
+  stats = match_stats.perf;
+  return ans;
+}
+
+// @brief オプションを指定して最大重みマッチングを求める．
+// @param[in] algorithm アルゴリズム名
+// @param[in] options オプション
+// @return マッチングに選ばれた枝番号のリストを返す．
+vector<int>
+UdGraph::max_matching(const string& algorithm,
+		      const MatchingOptions& options) const
+{
+  MatchingStats stats;
+  return max_matching(algorithm, options, stats);
+}
+
+// @brief オプションを指定して最大重みマッチングを求める．
+// @param[in] algorithm アルゴリズム名
+// @param[in] options オプション
+// @param[out] stats 実行結果に関する情報
+// @return マッチングに選ばれた枝番号のリストを返す．
+//
+vector<int>
+UdGraph::max_matching(const string& algorithm,
+		      const MatchingOptions& options,
+		      MatchingStats& stats) const
+{
+  MatchingWork work;
+  return max_matching(algorithm, options, stats, work);
+}
+
+// @brief 作業領域を指定して最大重みマッチングを求める．
+// @param[in] algorithm アルゴリズム名
+// @param[in] options オプション
+// @param[out] stats 実行結果に関する情報
+// @param[in] work 作業領域
+// @return マッチングに選ばれた枝番号のリストを返す．
+//
+// 複数の連結成分からなる場合は部分グラフごとに並列に解く．
+vector<int>
+UdGraph::max_matching(const string& algorithm,
+		      const MatchingOptions& options,
+		      MatchingStats& stats,
+		      MatchingWork& work) const
+{
+  stats = MatchingStats{};
+  if ( !options.reorder.empty() ) {
+    // relabel() は枝番号を変えないので結果はそのまま使える．
+    auto options1 = options;
+    options1.reorder = string();
+    return relabel(node_order(options.reorder)).max_matching(algorithm,
+							      options1,
+							      stats,
+							      work);
   }
-  for ( auto edge: edge_list ) {
-    delete edge;
+
+  // 部分グラフごとに別の作業領域を用いるので足りない分を作る．
+  auto& work_list = work.mWorkList;
+  auto reserve_work = [&](int np) {
+    while ( work_list.size() < np ) {
+      work_list.emplace_back(new MgWork);
+    }
+  };
+
+  vector<int> ans;
+  if ( algorithm == "approx-parallel" ) {
+    // 巨大なグラフを想定しているので連結成分には分割せずに
+    // 全体を Suitor 法で並列に解く．
+    reserve_work(1);
+    ans = max_matching_sub(*this, *work_list[0], "suitor", options.thread_num,
+			   options.augment_limit, stats.perf,
+			   &stats.upper_bound);
   }
+  else {
+    GraphDecomp decomp(*this);
+    int np = decomp.part_num();
+    if ( np <= 1 ) {
+      reserve_work(1);
+      ans = max_matching_sub(*this, *work_list[0], algorithm,
+			     options.thread_num, -1, stats.perf);
+    }
+    else {
+      vector<vector<int>> ans_list(np);
+      vector<PerfStats> stats_list(np);
+      reserve_work(np);
+      int nt = ThreadPool::default_thread_num(options.thread_num);
+      ThreadPool pool(std::min(nt, np));
+      // 連結成分ごとに並列に解き，初期解は大きさに応じたスレッド数で求める．
+      pool.parallel_for(np, [&](int i) {
+	ans_list[i] = max_matching_sub(decomp.part_graph(i), *work_list[i],
+				       algorithm,
+				       decomp.part_thread_num(i, nt),
+				       -1, stats_list[i]);
+      });
 
+      for ( auto i: Range(np) ) {
+	PerfCounter::add_stats(stats.perf, stats_list[i]);
+	const auto& edge_map = decomp.edge_map(i);
+	for ( auto id: ans_list[i] ) {
+	  ans.push_back(edge_map[id]);
+	}
+      }
+    }
+  }
+
+  for ( auto id: ans ) {
+    stats.weight += edge_weight(id);
+  }
   return ans;
 }
 
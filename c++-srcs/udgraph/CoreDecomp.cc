@@ -0,0 +1,86 @@
+
+/// @file CoreDecomp.cc
+/// @brief CoreDecomp の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "CoreDecomp.h"
+#include "PeelQueue.h"
+#include "ym/Range.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+//////////////////////////////////////////////////////////////////////
+// クラス CoreDecomp
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] adj_index 隣接リスト
+CoreDecomp::CoreDecomp(const AdjIndex& adj_index)
+{
+  int n = adj_index.node_num();
+
+  // 正規形でないグラフの隣接リストは重複を含むので印を付けて除く．
+  // mark[id1] == id の時 id1 は id の隣接ノードとして処理済みである．
+  vector<int> mark(n, -1);
+  vector<int> degree(n, 0);
+  int max_degree = 0;
+  for ( auto id: Range(n) ) {
+    for ( auto id1: adj_index.adj_list(id) ) {
+      if ( mark[id1] != id ) {
+	mark[id1] = id;
+	++ degree[id];
+      }
+    }
+    max_degree = std::max(max_degree, degree[id]);
+  }
+
+  PeelQueue queue;
+  queue.init(n, max_degree);
+  for ( auto id: Range(n) ) {
+    queue.put(id, degree[id]);
+  }
+
+  std::fill(mark.begin(), mark.end(), -1);
+  mOrder.reserve(n);
+  mCoreNum.resize(n);
+  int k = 0;
+  while ( !queue.empty() ) {
+    // 取り除くノードの次数の最大値がコア数となる．
+    k = std::max(k, queue.min_key());
+    int id = queue.pop_min();
+    mOrder.push_back(id);
+    mCoreNum[id] = k;
+    for ( auto id1: adj_index.adj_list(id) ) {
+      if ( mark[id1] != id && queue.contains(id1) ) {
+	mark[id1] = id;
+	queue.dec_key(id1);
+      }
+    }
+  }
+  mDegeneracy = k;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス UdGraph
+//////////////////////////////////////////////////////////////////////
+
+// @brief コア分解を行う．
+// @param[out] core_num 各ノードのコア数を収める配列
+// @return 縮退度を返す．
+int
+UdGraph::core_decomposition(vector<int>& core_num) const
+{
+  AdjIndex adj_index(*this);
+  CoreDecomp core_decomp(adj_index);
+  core_num = core_decomp.core_num_list();
+  return core_decomp.degeneracy();
+}
+
+END_NAMESPACE_YM_UDGRAPH
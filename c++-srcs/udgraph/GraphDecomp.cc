@@ -0,0 +1,134 @@
+
+/// @file GraphDecomp.cc
+/// @brief GraphDecomp の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "GraphDecomp.h"
+#include "ym/Range.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+BEGIN_NONAMESPACE
+
+// union-find の代表元を求める．
+int
+find_root(vector<int>& parent,
+	  int id)
+{
+  while ( parent[id] != id ) {
+    // path halving
+    parent[id] = parent[parent[id]];
+    id = parent[id];
+  }
+  return id;
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス GraphDecomp
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] graph 対象のグラフ
+// @param[in] batch_size 小さな連結成分をまとめる時のノード数
+GraphDecomp::GraphDecomp(const UdGraph& graph,
+			 int batch_size)
+{
+  int n = graph.node_num();
+  if ( n == 0 ) {
+    return;
+  }
+  mTotalSize = n + graph.edge_num();
+
+  // union-find で連結成分を求める．
+  vector<int> parent(n);
+  vector<int> size(n, 1);
+  for ( auto id: Range(n) ) {
+    parent[id] = id;
+  }
+  for ( const auto& edge: graph.edge_view() ) {
+    int r1 = find_root(parent, edge.id1);
+    int r2 = find_root(parent, edge.id2);
+    if ( r1 == r2 ) {
+      continue;
+    }
+    if ( size[r1] < size[r2] ) {
+      std::swap(r1, r2);
+    }
+    parent[r2] = r1;
+    size[r1] += size[r2];
+  }
+
+  // 代表元のリストをノード数の降順に並べる．
+  vector<int> root_list;
+  for ( auto id: Range(n) ) {
+    if ( find_root(parent, id) == id ) {
+      root_list.push_back(id);
+    }
+  }
+  mComponentNum = root_list.size();
+  std::stable_sort(root_list.begin(), root_list.end(),
+		   [&](int a, int b) { return size[a] > size[b]; });
+
+  // 連結成分を部分グラフに割り当てる．
+  vector<int> part_id(n, -1);
+  int batch_num = 0;
+  for ( auto root: root_list ) {
+    if ( mPartNum == 0 || size[root] >= batch_size || batch_num >= batch_size ) {
+      // 新しい部分グラフを作る．
+      ++ mPartNum;
+      batch_num = 0;
+    }
+    part_id[root] = mPartNum - 1;
+    batch_num += size[root];
+  }
+  if ( mPartNum == 1 ) {
+    return;
+  }
+
+  // ノード番号の写像を作る．
+  mNodeMapList.resize(mPartNum);
+  vector<int> local_id(n);
+  for ( auto id: Range(n) ) {
+    int pid = part_id[find_root(parent, id)];
+    local_id[id] = mNodeMapList[pid].size();
+    mNodeMapList[pid].push_back(id);
+  }
+
+  // 枝を振り分ける．
+  mEdgeMapList.resize(mPartNum);
+  vector<vector<UdGraph::Edge>> edge_list_array(mPartNum);
+  auto edge_view = graph.edge_view();
+  for ( auto i: Range(graph.edge_num()) ) {
+    auto edge = edge_view[i];
+    int pid = part_id[find_root(parent, edge.id1)];
+    edge_list_array[pid].push_back({local_id[edge.id1],
+				    local_id[edge.id2],
+				    edge.weight});
+    mEdgeMapList[pid].push_back(i);
+  }
+
+  mPartGraphList.reserve(mPartNum);
+  for ( auto pid: Range(mPartNum) ) {
+    mPartGraphList.push_back(UdGraph(mNodeMapList[pid].size(),
+				     edge_list_array[pid]));
+    if ( graph.is_node_weighted() ) {
+      const auto& node_map = mNodeMapList[pid];
+      vector<int> node_weight_list;
+      node_weight_list.reserve(node_map.size());
+      for ( auto id: node_map ) {
+	node_weight_list.push_back(graph.node_weight(id));
+      }
+      mPartGraphList.back().set_node_weight_list(node_weight_list);
+    }
+  }
+}
+
+END_NAMESPACE_YM_UDGRAPH
@@ -14,6 +14,37 @@
 
 BEGIN_NAMESPACE_YM_UDGRAPH
 
+BEGIN_NONAMESPACE
+
+// begin 番目以降の枝の両端を id1 <= id2 となるように入れ替える．
+//
+// - Edge と NodePair の両方に用いる．
+// - 分岐を含まないようにしてコンパイラのベクトル化が効くようにする．
+// - 範囲チェックも最小値と最大値を求めて最後に1回だけ行う．
+template<class T>
+void
+normalize_array(T* edge_array,
+		SizeType begin,
+		SizeType end,
+		SizeType node_num)
+{
+  int min_id = std::numeric_limits<int>::max();
+  int max_id = std::numeric_limits<int>::min();
+  for ( SizeType i = begin; i < end; ++ i ) {
+    int id1 = edge_array[i].id1;
+    int id2 = edge_array[i].id2;
+    int lo = std::min(id1, id2);
+    int hi = std::max(id1, id2);
+    edge_array[i].id1 = lo;
+    edge_array[i].id2 = hi;
+    min_id = std::min(min_id, lo);
+    max_id = std::max(max_id, hi);
+  }
+  ASSERT_COND( 0 <= min_id && max_id < static_cast<int>(node_num) );
+}
+
+END_NONAMESPACE
+
 //////////////////////////////////////////////////////////////////////
 // クラス UdGraph
 //////////////////////////////////////////////////////////////////////
@@ -26,11 +57,144 @@ UdGraph::UdGraph(SizeType node_num,
   mNodeNum{node_num},
   mEdgeList{edge_list}
 {
-  // mEdgeList の内容を正規化する．
-  for ( auto& edge: mEdgeList ) {
-    if ( edge.id1 > edge.id2 ) {
-      std::swap(edge.id1, edge.id2);
+  normalize(0);
+}
+
+// @brief コンストラクタ
+// @param[in] node_num ノード数
+// @param[in] edge_list 枝のリスト
+UdGraph::UdGraph(SizeType node_num,
+		 vector<Edge>&& edge_list) :
+  mNodeNum{node_num},
+  mEdgeList{std::move(edge_list)}
+{
+  normalize(0);
+}
+
+// @brief 枝をまとめて追加する．
+// @param[in] edge_array 枝の配列の先頭
+// @param[in] num 枝数
+void
+UdGraph::add_edges(const Edge* edge_array,
+		   SizeType num)
+{
+  if ( !is_packed() ) {
+    SizeType begin = mEdgeList.size();
+    mEdgeList.insert(mEdgeList.end(), edge_array, edge_array + num);
+    normalize(begin);
+    return;
+  }
+
+  SizeType begin = mPairList.size();
+  mPairList.resize(begin + num);
+  auto pair_array = mPairList.data() + begin;
+  bool weighted = is_weighted();
+  for ( SizeType i = 0; i < num; ++ i ) {
+    pair_array[i].id1 = edge_array[i].id1;
+    pair_array[i].id2 = edge_array[i].id2;
+    weighted |= edge_array[i].weight != 1;
+  }
+  if ( weighted ) {
+    // 重みの配列は 1 以外の重みが現れた時にだけ作る．
+    mWeightList.resize(begin, 1);
+    mWeightList.reserve(begin + num);
+    for ( SizeType i = 0; i < num; ++ i ) {
+      mWeightList.push_back(edge_array[i].weight);
+    }
+  }
+  normalize(begin);
+}
+
+// @brief 圧縮形式の枝のリストを設定する．
+// @param[in] pair_list 両端のノード番号の対のリスト
+// @param[in] weight_list 重みのリスト
+void
+UdGraph::assign(vector<NodePair>&& pair_list,
+		vector<int>&& weight_list)
+{
+  ASSERT_COND( weight_list.empty() || weight_list.size() == pair_list.size() );
+  vector<Edge>().swap(mEdgeList);
+  mPairList = std::move(pair_list);
+  mWeightList = std::move(weight_list);
+  mPacked = true;
+  mWeighted = false;
+  // 枝がなければ正規形のままとなる．
+  mCanonical = true;
+  normalize(0);
+}
+
+// @brief 枝を圧縮形式で持つようにする．
+void
+UdGraph::pack()
+{
+  if ( is_packed() ) {
+    return;
+  }
+
+  SizeType n = mEdgeList.size();
+  vector<NodePair> pair_list(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    const auto& edge = mEdgeList[i];
+    pair_list[i] = NodePair{static_cast<std::uint32_t>(edge.id1),
+			    static_cast<std::uint32_t>(edge.id2)};
+  }
+  vector<int> weight_list;
+  if ( mWeighted ) {
+    weight_list.resize(n);
+    for ( SizeType i = 0; i < n; ++ i ) {
+      weight_list[i] = mEdgeList[i].weight;
+    }
+  }
+  vector<Edge>().swap(mEdgeList);
+  mPairList.swap(pair_list);
+  mWeightList.swap(weight_list);
+  mPacked = true;
+  mWeighted = false;
+}
+
+// @brief 枝を非圧縮形式(Edge の配列)で持つようにする．
+void
+UdGraph::unpack()
+{
+  if ( !is_packed() ) {
+    return;
+  }
+
+  SizeType n = mPairList.size();
+  bool weighted = !mWeightList.empty();
+  vector<Edge> edge_list(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    const auto& pair = mPairList[i];
+    edge_list[i] = Edge{static_cast<int>(pair.id1),
+			static_cast<int>(pair.id2),
+			weighted ? mWeightList[i] : 1};
+  }
+  vector<NodePair>().swap(mPairList);
+  vector<int>().swap(mWeightList);
+  mEdgeList.swap(edge_list);
+  mPacked = false;
+  mWeighted = weighted;
+}
+
+// @brief begin 番目以降の枝を正規化する．
+// @param[in] begin 開始位置
+void
+UdGraph::normalize(SizeType begin)
+{
+  SizeType end = edge_num();
+  if ( begin >= end ) {
+    return;
+  }
+  mCanonical = false;
+
+  if ( is_packed() ) {
+    normalize_array(mPairList.data(), begin, end, node_num());
+  }
+  else {
+    for ( SizeType i = begin; i < end; ++ i ) {
+      mWeighted = mWeighted || mEdgeList[i].weight != 1;
     }
+    normalize_array(mEdgeList.data(), begin, end, node_num());
   }
 }
 
@@ -41,7 +205,7 @@ bool
 UdGraph::is_reflective() const
 {
   vector<bool> mark(node_num(), false);
-  for ( const auto& edge: edge_list() ) {
+  for ( const auto& edge: edge_view() ) {
     int id1 = edge.id1;
     int id2 = edge.id2;
     if ( id1 == id2 ) {
@@ -123,11 +287,13 @@ UdGraph::read_dimacs(istream& s)
   int max_node_id = 0;
 
   vector<Edge> edge_list;
+  vector<pair<int, int>> node_weight_list;
 
   // ファイルをスキャンする．
   // - 'p' 行から node_num, edge_num を得る．
   // - 'e' 行の内容を edge_list に入れる．
-  // - 'e' 行に現れるノード番号の最大値を max_node_id に入れる．
+  // - 'n' 行の内容(ノード番号と重み)を node_weight_list に入れる．
+  // - 'e' 行と 'n' 行に現れるノード番号の最大値を max_node_id に入れる．
   while ( getline(s, buff) ) {
     if ( buff[0] == 'c' ) {
       // コメント行は読み飛ばす
@@ -176,6 +342,18 @@ UdGraph::read_dimacs(istream& s)
       }
       edge_list.push_back({id1, id2});
     }
+    else if ( str_list[0] == "n" ) {
+      if ( str_list.size() != 3 ) {
+	syntax_error(line);
+	goto error_exit;
+      }
+      int id = atoi(str_list[1].c_str()) - 1;
+      int w = atoi(str_list[2].c_str());
+      if ( max_node_id < id ) {
+	max_node_id = id;
+      }
+      node_weight_list.push_back({id, w});
+    }
     else {
       syntax_error(line);
       goto error_exit;
@@ -199,7 +377,13 @@ UdGraph::read_dimacs(istream& s)
     // 実は edge_num は使わない．
   }
 
-  return UdGraph(node_num, edge_list);
+  {
+    UdGraph graph(node_num, edge_list);
+    for ( auto& p: node_weight_list ) {
+      graph.set_node_weight(p.first, p.second);
+    }
+    return graph;
+  }
 
  error_exit:
   return UdGraph();
@@ -229,7 +413,10 @@ void
 UdGraph::write_dimacs(ostream& s) const
 {
   s << "p edge " << node_num() << " " << edge_num() << endl;
-  for ( const auto& edge: edge_list() ) {
+  for ( auto id: Range(node_weight_list().size()) ) {
+    s << "n " << (id + 1) << " " << node_weight(id) << endl;
+  }
+  for ( const auto& edge: edge_view() ) {
     int id1 = edge.id1 + 1;
     int id2 = edge.id2 + 1;
     s << "e " << id1 << " " << id2 << endl;
@@ -251,11 +438,13 @@ UdGraph::restore(istream& s)
   int max_node_id = 0;
 
   vector<Edge> edge_list;
+  vector<pair<int, int>> node_weight_list;
 
   // ファイルをスキャンする．
   // - 'pw' 行から node_num, edge_num を得る．
   // - 'ew' 行の内容を edge_list に入れる．
-  // - 'ew' 行に現れるノード番号の最大値を max_node_id に入れる．
+  // - 'nw' 行の内容(ノード番号と重み)を node_weight_list に入れる．
+  // - 'ew' 行と 'nw' 行に現れるノード番号の最大値を max_node_id に入れる．
   while ( getline(s, buff) ) {
     if ( buff[0] == 'c' ) {
       // コメント行は読み飛ばす
@@ -290,19 +479,32 @@ UdGraph::restore(istream& s)
       edge_list.reserve(edge_num);
     }
     else if ( str_list[0] == "ew" ) {
-      if ( str_list.size() != 3 ) {
+      if ( str_list.size() != 4 ) {
 	syntax_error(line);
 	goto error_exit;
       }
       int id1 = atoi(str_list[1].c_str()) - 1;
       int id2 = atoi(str_list[2].c_str()) - 1;
+      int w = atoi(str_list[3].c_str());
       if ( max_node_id < id1 ) {
 	max_node_id = id1;
       }
       if ( max_node_id < id2 ) {
 	max_node_id = id2;
       }
-      edge_list.push_back({id1, id2});
+      edge_list.push_back({id1, id2, w});
+    }
+    else if ( str_list[0] == "nw" ) {
+      if ( str_list.size() != 3 ) {
+	syntax_error(line);
+	goto error_exit;
+      }
+      int id = atoi(str_list[1].c_str()) - 1;
+      int w = atoi(str_list[2].c_str());
+      if ( max_node_id < id ) {
+	max_node_id = id;
+      }
+      node_weight_list.push_back({id, w});
     }
     else {
       syntax_error(line);
@@ -327,7 +529,13 @@ UdGraph::restore(istream& s)
     // 実は edge_num は使わない．
   }
 
-  return UdGraph(node_num, edge_list);
+  {
+    UdGraph graph(node_num, edge_list);
+    for ( auto& p: node_weight_list ) {
+      graph.set_node_weight(p.first, p.second);
+    }
+    return graph;
+  }
 
  error_exit:
   return UdGraph();
@@ -359,7 +567,10 @@ void
 UdGraph::dump(ostream& s) const
 {
   s << "pw edge " << node_num() << " " << edge_num() << endl;
-  for ( const auto& edge: edge_list() ) {
+  for ( auto id: Range(node_weight_list().size()) ) {
+    s << "nw " << (id + 1) << " " << node_weight(id) << endl;
+  }
+  for ( const auto& edge: edge_view() ) {
     int id1 = edge.id1 + 1;
     int id2 = edge.id2 + 1;
     int w = edge.weight;
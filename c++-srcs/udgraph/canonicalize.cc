@@ -0,0 +1,142 @@
+
+/// @file canonicalize.cc
+/// @brief UdGraph::canonicalize() の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/UdGraph.h"
+#include "RadixSort.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+BEGIN_NONAMESPACE
+
+// 重複した枝の重みをまとめる．
+inline
+int
+combine_weight(UdGraph::CanonicalizeOptions::Combine combine,
+	       int w1,
+	       int w2)
+{
+  using Combine = UdGraph::CanonicalizeOptions::Combine;
+  switch ( combine ) {
+  case Combine::First: return w1;
+  case Combine::Sum:   return w1 + w2;
+  case Combine::Min:   return std::min(w1, w2);
+  case Combine::Max:   return std::max(w1, w2);
+  }
+  return w1;
+}
+
+END_NONAMESPACE
+
+// @brief 枝を正規形にする．
+// @param[in] options オプション
+// @return 重複した枝とセルフループの数を返す．
+UdGraph::CanonicalizeStats
+UdGraph::canonicalize(const CanonicalizeOptions& options)
+{
+  CanonicalizeStats stats;
+  SizeType n = edge_num();
+  if ( n == 0 ) {
+    mCanonical = true;
+    return stats;
+  }
+
+  // (id1, id2) を id1 * node_num + id2 という一つのキーにする．
+  // 両端は正規化されているので id1 <= id2 である．
+  std::uint64_t nn = node_num();
+  vector<std::uint64_t> key_list(n);
+  if ( is_packed() ) {
+    for ( SizeType i = 0; i < n; ++ i ) {
+      const auto& pair = mPairList[i];
+      key_list[i] = pair.id1 * nn + pair.id2;
+    }
+  }
+  else {
+    for ( SizeType i = 0; i < n; ++ i ) {
+      const auto& edge = mEdgeList[i];
+      key_list[i] = edge.id1 * nn + edge.id2;
+    }
+  }
+  int key_bits = 0;
+  for ( auto max_key = nn * nn - 1; (max_key >> key_bits) != 0; ++ key_bits ) {
+    ;
+  }
+
+  // 重みは値として一緒に並べ替える．
+  // 安定なので重複した枝は追加された順に並ぶ．
+  bool has_weight = is_weighted();
+  vector<int> value_list;
+  if ( has_weight ) {
+    if ( is_packed() ) {
+      value_list.swap(mWeightList);
+    }
+    else {
+      value_list.resize(n);
+      for ( SizeType i = 0; i < n; ++ i ) {
+	value_list[i] = mEdgeList[i].weight;
+      }
+    }
+  }
+  radix_sort(key_list, value_list, key_bits, options.thread_num);
+
+  // 重複した枝をまとめながら前に詰めていく．
+  auto combine = options.combine;
+  bool weighted = has_weight || combine == CanonicalizeOptions::Combine::Sum;
+  vector<int> weight_list(weighted && is_packed() ? n : 0);
+  bool all_one = true;
+  SizeType wpos = 0;
+  for ( SizeType i = 0; i < n; ) {
+    auto key = key_list[i];
+    int w = has_weight ? value_list[i] : 1;
+    SizeType j = i + 1;
+    for ( ; j < n && key_list[j] == key; ++ j ) {
+      w = combine_weight(combine, w, has_weight ? value_list[j] : 1);
+    }
+    stats.duplicate_num += j - i - 1;
+    i = j;
+
+    int id1 = key / nn;
+    int id2 = key % nn;
+    if ( id1 == id2 ) {
+      ++ stats.self_loop_num;
+      if ( options.remove_self_loop ) {
+	continue;
+      }
+    }
+    if ( is_packed() ) {
+      mPairList[wpos] = NodePair{static_cast<std::uint32_t>(id1),
+				 static_cast<std::uint32_t>(id2)};
+      if ( weighted ) {
+	weight_list[wpos] = w;
+      }
+    }
+    else {
+      mEdgeList[wpos] = Edge{id1, id2, w};
+    }
+    all_one = all_one && w == 1;
+    ++ wpos;
+  }
+  if ( is_packed() ) {
+    mPairList.resize(wpos);
+    if ( weighted && !all_one ) {
+      weight_list.resize(wpos);
+      mWeightList.swap(weight_list);
+    }
+  }
+  else {
+    mEdgeList.resize(wpos);
+    mWeighted = !all_one;
+  }
+  mCanonical = true;
+
+  return stats;
+}
+
+END_NAMESPACE_YM_UDGRAPH
@@ -0,0 +1,381 @@
+
+/// @file node_order.cc
+/// @brief UdGraph::node_order() の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/UdGraph.h"
+#include "AdjIndex.h"
+#include "CoreDecomp.h"
+#include "ym/Range.h"
+#include <algorithm>
+#include <cmath>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+BEGIN_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// キーが ±1 ずつ変化するノードのヒープ
+//
+// Gorder の論文の UnitHeap と同じもの
+// - キーごとのバケツを双方向リストで表す．
+// - increment/decrement/get_max はほぼ定数時間で行える．
+//////////////////////////////////////////////////////////////////////
+class UnitHeap
+{
+public:
+
+  // コンストラクタ
+  // 全てのノードのキーは 0 となる．
+  UnitHeap(int node_num) :
+    mKey(node_num, 0),
+    mPrev(node_num),
+    mNext(node_num),
+    mDeleted(node_num, false),
+    mHead(1, -1),
+    mTop(0)
+  {
+    for ( auto id: Range(node_num) ) {
+      mPrev[id] = -1;
+      mNext[id] = -1;
+      push(id);
+    }
+  }
+
+  // キーが最大のノードを取り出す．
+  //
+  // ヒープが空の場合は -1 を返す．
+  int
+  get_max()
+  {
+    while ( mTop > 0 && mHead[mTop] == -1 ) {
+      -- mTop;
+    }
+    int id = mHead[mTop];
+    if ( id != -1 ) {
+      remove(id);
+    }
+    return id;
+  }
+
+  // ノードを削除する．
+  void
+  erase(int id)
+  {
+    remove(id);
+  }
+
+  // キーを1増やす．
+  void
+  increment(int id)
+  {
+    if ( mDeleted[id] ) {
+      return;
+    }
+    unlink(id);
+    ++ mKey[id];
+    push(id);
+  }
+
+  // キーを1減らす．
+  void
+  decrement(int id)
+  {
+    if ( mDeleted[id] ) {
+      return;
+    }
+    unlink(id);
+    -- mKey[id];
+    push(id);
+  }
+
+
+private:
+
+  // バケツに追加する．
+  void
+  push(int id)
+  {
+    int key = mKey[id];
+    if ( mHead.size() <= key ) {
+      mHead.resize(key + 1, -1);
+    }
+    int next = mHead[key];
+    mPrev[id] = -1;
+    mNext[id] = next;
+    if ( next != -1 ) {
+      mPrev[next] = id;
+    }
+    mHead[key] = id;
+    if ( mTop < key ) {
+      mTop = key;
+    }
+  }
+
+  // バケツから取り除く．
+  void
+  unlink(int id)
+  {
+    int prev = mPrev[id];
+    int next = mNext[id];
+    if ( prev != -1 ) {
+      mNext[prev] = next;
+    }
+    else {
+      mHead[mKey[id]] = next;
+    }
+    if ( next != -1 ) {
+      mPrev[next] = prev;
+    }
+  }
+
+  // ヒープから削除する．
+  void
+  remove(int id)
+  {
+    ASSERT_COND( !mDeleted[id] );
+    unlink(id);
+    mDeleted[id] = true;
+  }
+
+  // キー
+  vector<int> mKey;
+
+  // バケツ内の前の要素
+  vector<int> mPrev;
+
+  // バケツ内の次の要素
+  vector<int> mNext;
+
+  // 削除済みの印
+  vector<bool> mDeleted;
+
+  // キーごとのバケツの先頭
+  vector<int> mHead;
+
+  // 空でない可能性のある最大のキー
+  int mTop;
+
+};
+
+// 次数の降順に並べる．
+vector<int>
+degree_order(const AdjIndex& adj_index)
+{
+  int n = adj_index.node_num();
+  vector<int> order(n);
+  for ( auto id: Range(n) ) {
+    order[id] = id;
+  }
+  std::stable_sort(order.begin(), order.end(),
+		   [&](int a, int b) {
+		     return adj_index.degree(a) > adj_index.degree(b);
+		   });
+  return order;
+}
+
+// reverse Cuthill-McKee 順に並べる．
+//
+// - 未訪問のノードのうち次数最小のものから幅優先探索を行う．
+// - 隣接ノードは次数の昇順に訪問する．
+// - 最後に全体を逆順にする．
+vector<int>
+rcm_order(const AdjIndex& adj_index)
+{
+  int n = adj_index.node_num();
+  vector<int> start_list(n);
+  for ( auto id: Range(n) ) {
+    start_list[id] = id;
+  }
+  std::stable_sort(start_list.begin(), start_list.end(),
+		   [&](int a, int b) {
+		     return adj_index.degree(a) < adj_index.degree(b);
+		   });
+
+  vector<int> order;
+  order.reserve(n);
+  vector<bool> visited(n, false);
+  vector<int> tmp_list;
+  for ( auto start: start_list ) {
+    if ( visited[start] ) {
+      continue;
+    }
+    // order 自身を幅優先探索のキューとして用いる．
+    int rpos = order.size();
+    order.push_back(start);
+    visited[start] = true;
+    while ( rpos < order.size() ) {
+      int id = order[rpos];
+      ++ rpos;
+      tmp_list.clear();
+      for ( auto id1: adj_index.adj_list(id) ) {
+	if ( !visited[id1] ) {
+	  visited[id1] = true;
+	  tmp_list.push_back(id1);
+	}
+      }
+      std::stable_sort(tmp_list.begin(), tmp_list.end(),
+		       [&](int a, int b) {
+			 return adj_index.degree(a) < adj_index.degree(b);
+		       });
+      order.insert(order.end(), tmp_list.begin(), tmp_list.end());
+    }
+  }
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+// Gorder で並べる．
+//
+// 直近に並べた window 個のノードとの局所性の合計
+// (隣接していれば 1 点，共通の隣接ノード1つにつき 1 点)
+// が最大のノードを greedy に選んでいく．
+// 次数が hub_degree を超えるノードを介した共通の隣接ノードは数えない．
+vector<int>
+gorder_order(const AdjIndex& adj_index,
+	     int window)
+{
+  int n = adj_index.node_num();
+  vector<int> order;
+  order.reserve(n);
+  if ( n == 0 ) {
+    return order;
+  }
+
+  int hub_degree = std::max(16, static_cast<int>(std::sqrt(n)));
+
+  // node_id を窓に出し入れした時のキーの増減を行う．
+  UnitHeap heap(n);
+  auto update = [&](int node_id, bool inc) {
+    auto update1 = [&](int id) {
+      if ( inc ) {
+	heap.increment(id);
+      }
+      else {
+	heap.decrement(id);
+      }
+    };
+    for ( auto id1: adj_index.adj_list(node_id) ) {
+      update1(id1);
+      if ( adj_index.degree(id1) > hub_degree ) {
+	continue;
+      }
+      for ( auto id2: adj_index.adj_list(id1) ) {
+	if ( id2 != node_id ) {
+	  update1(id2);
+	}
+      }
+    }
+  };
+
+  // 最初のノードは次数最大のものとする．
+  int start = 0;
+  for ( auto id: Range(n) ) {
+    if ( adj_index.degree(start) < adj_index.degree(id) ) {
+      start = id;
+    }
+  }
+  heap.erase(start);
+  order.push_back(start);
+  update(start, true);
+  while ( order.size() < n ) {
+    int id = heap.get_max();
+    ASSERT_COND( id != -1 );
+    order.push_back(id);
+    update(id, true);
+    int pos = order.size() - 1 - window;
+    if ( pos >= 0 ) {
+      // 窓から外れたノードの寄与を取り除く．
+      update(order[pos], false);
+    }
+  }
+  return order;
+}
+
+END_NONAMESPACE
+
+// @brief ノードの並べ替え順を求める．
+// @param[in] method 並べ替えの方法
+// @return 新しい順に元のノード番号を並べたリストを返す．
+vector<int>
+UdGraph::node_order(const string& method) const
+{
+  AdjIndex adj_index(*this);
+  if ( method == "degree" ) {
+    return degree_order(adj_index);
+  }
+  if ( method == "rcm" ) {
+    return rcm_order(adj_index);
+  }
+  if ( method == "gorder" ) {
+    return gorder_order(adj_index, 5);
+  }
+  if ( method == "degeneracy" ) {
+    CoreDecomp core_decomp(adj_index);
+    return core_decomp.order();
+  }
+
+  // デフォルトフォールバック
+  // 元の順番のまま
+  vector<int> order(node_num());
+  for ( auto id: Range(node_num()) ) {
+    order[id] = id;
+  }
+  return order;
+}
+
+// @brief ノード番号を付け替えたグラフを返す．
+// @param[in] order 新しい順に元のノード番号を並べたリスト
+// @return 新しいグラフを返す．
+//
+// 枝番号は変わらない．
+UdGraph
+UdGraph::relabel(const vector<int>& order) const
+{
+  ASSERT_COND( order.size() == node_num() );
+
+  vector<int> new_id(node_num(), -1);
+  for ( auto pos: Range(node_num()) ) {
+    int id = order[pos];
+    ASSERT_COND( 0 <= id && id < node_num() );
+    ASSERT_COND( new_id[id] == -1 );
+    new_id[id] = pos;
+  }
+
+  // 格納形式は元のグラフに合わせる．
+  UdGraph graph(node_num());
+  if ( is_packed() ) {
+    vector<NodePair> pair_list;
+    pair_list.reserve(edge_num());
+    for ( const auto& edge: mPairList ) {
+      pair_list.push_back({static_cast<std::uint32_t>(new_id[edge.id1]),
+			   static_cast<std::uint32_t>(new_id[edge.id2])});
+    }
+    // 重みは枝番号が変わらないのでそのままコピーする．
+    auto weight_list = mWeightList;
+    graph.assign(std::move(pair_list), std::move(weight_list));
+  }
+  else {
+    vector<Edge> edge_list;
+    edge_list.reserve(edge_num());
+    for ( const auto& edge: mEdgeList ) {
+      edge_list.push_back({new_id[edge.id1], new_id[edge.id2], edge.weight});
+    }
+    graph = UdGraph(node_num(), std::move(edge_list));
+  }
+  if ( is_node_weighted() ) {
+    vector<int> node_weight_list(node_num());
+    for ( auto pos: Range(node_num()) ) {
+      node_weight_list[pos] = node_weight(order[pos]);
+    }
+    graph.set_node_weight_list(node_weight_list);
+  }
+  return graph;
+}
+
+END_NAMESPACE_YM_UDGRAPH
@@ -15,18 +15,31 @@ cdef extern from "ym/BiGraph.h" namespace "nsYm" :
 
     # BiGraph クラスの cython バージョン
     cdef cppclass BiGraph :
+
+        # BiGraph::Edge
+        cppclass Edge :
+            int id1
+            int id2
+            int weight
+
         BiGraph()
+        BiGraph(int, int, const vector[Edge]&)
         void resize(int, int)
         void add_edge(int, int, int)
+        void add_edges(const vector[Edge]&)
+        void reserve(size_t)
+        void shrink_to_fit()
         int node1_num()
         int node2_num()
         int edge_num()
         int edge_id1(int)
         int edge_id2(int)
         int edge_weight(int)
+        const vector[Edge]& edge_list()
 
         @staticmethod
         BiGraph read(string&)
         void write(string&)
 
-        vector[int] max_matching()
+        # GIL を解放して呼び出せる．
+        vector[int] max_matching() nogil
@@ -0,0 +1,43 @@
+
+### @file CXX_GraphExecutor.pxd
+### @brief CXX_GraphExecutor 用の pxd ファイル
+### @author Yusuke Matsunaga (松永 裕介)
+###
+### Copyright (C) 2022 Yusuke Matsunaga
+### All rights reserved.
+
+from libcpp cimport bool
+from libcpp.vector cimport vector
+from libcpp.pair cimport pair
+from libcpp.string cimport string
+from CXX_UdGraph cimport UdGraph
+from CXX_BiGraph cimport BiGraph
+
+
+cdef extern from "ym/GraphExecutor.h" namespace "nsYm" :
+
+    # GraphFuture クラスの cython バージョン
+    cdef cppclass GraphFuture[T] :
+        GraphFuture()
+        bool valid() nogil
+        bool is_ready() nogil
+        void wait() nogil
+        bool wait_for(double) nogil
+        const T& get() except +
+
+    # GraphExecutor クラスの cython バージョン
+    cdef cppclass GraphExecutor :
+        @staticmethod
+        void set_thread_num(int) nogil
+        @staticmethod
+        int thread_num() nogil
+        @staticmethod
+        GraphFuture[pair[int, vector[int]]] coloring(const UdGraph&, const string&) nogil
+        @staticmethod
+        GraphFuture[vector[int]] independent_set(const UdGraph&, const string&) nogil
+        @staticmethod
+        GraphFuture[vector[int]] max_clique(const UdGraph&, const string&) nogil
+        @staticmethod
+        GraphFuture[vector[int]] max_matching(const UdGraph&, const string&) nogil
+        @staticmethod
+        GraphFuture[vector[int]] max_matching(const BiGraph&) nogil
@@ -16,15 +16,35 @@ cdef extern from "ym/UdGraph.h" namespace "nsYm" :
 
     # UdGraph クラスの cython バージョン
     cdef cppclass UdGraph :
+
+        # UdGraph::Edge
+        cppclass Edge :
+            int id1
+            int id2
+            int weight
+
         UdGraph()
+        UdGraph(int, const vector[Edge]&)
         void resize(int)
         void add_edge(int, int, int)
+        void add_edges(const vector[Edge]&)
+        void reserve(size_t)
+        void shrink_to_fit()
+        void pack()
+        void unpack()
         int node_num()
         int edge_num()
         bool is_reflective()
+        bool is_packed()
+        bool is_weighted()
         int edge_id1(int)
         int edge_id2(int)
         int edge_weight(int)
+        const vector[Edge]& edge_list()
+        const vector[int]& weight_list()
+        void set_node_weight(int, int)
+        bool is_node_weighted()
+        int node_weight(int)
 
         @staticmethod
         UdGraph read_dimacs(string&)
@@ -33,7 +53,8 @@ cdef extern from "ym/UdGraph.h" namespace "nsYm" :
         UdGraph restore(string&)
         void dump(string&)
 
-        pair[int, vector[int]] coloring(string&)
-        vector[int] independent_set(string&)
-        vector[int] max_clique(string&)
-        vector[int] max_matching(string&)
+        # 以下は GIL を解放して呼び出せる．
+        pair[int, vector[int]] coloring(string&) nogil
+        vector[int] independent_set(string&) nogil
+        vector[int] max_clique(string&) nogil
+        vector[int] max_matching(string&) nogil
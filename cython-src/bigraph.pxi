@@ -6,8 +6,12 @@
 ### Copyright (C) 2020 Yusuke Matsunaga
 ### All rights reserved.
 
+cimport cython
 from libcpp.string cimport string
+from libcpp.vector cimport vector
+from libcpp.utility cimport move
 from CXX_BiGraph cimport BiGraph as CXX_BiGraph
+from CXX_GraphExecutor cimport GraphExecutor as CXX_GraphExecutor
 
 
 ### @brief BiGraph の Python バージョン
@@ -16,8 +20,15 @@ cdef class BiGraph :
     cdef CXX_BiGraph _this
 
     ### @brief 初期化
-    def __init__(self, int node1_num, int node2_num, edge_list = list()) :
+    ###
+    ### edge_list はタプルのリストか，int32 の (m, 2) または (m, 3) の
+    ### 配列(numpy.ndarray などバッファプロトコルを持つもの)．
+    ### 配列の場合は C++ 側でまとめて読み込む．
+    def __init__(self, int node1_num = 0, int node2_num = 0, edge_list = list()) :
         cdef int id1, id2, w
+        if not isinstance(edge_list, (list, tuple)) :
+            self._this = _bigraph_from_array(node1_num, node2_num, edge_list)
+            return
         self._this.resize(node1_num, node2_num)
         for edge in edge_list :
             if len(edge) == 2 :
@@ -53,6 +64,17 @@ cdef class BiGraph :
             w = self._this.edge_weight(i)
             yield id1, id2, w
 
+    ### @brief 枝の (m, 3) の配列を返す．
+    ###
+    ### - 各行は (id1, id2, weight) である．
+    ### - C++ のメモリを共有する読み出し専用の IntArray を返す．
+    ###   numpy の配列が欲しければ numpy.asarray() を用いる．
+    def edge_array(self) :
+        cdef const vector[CXX_BiGraph.Edge]* c_list = &self._this.edge_list()
+        if c_list.size() == 0 :
+            return _new_int_view(NULL, 0, 3, self)
+        return _new_int_view(<int*>&c_list.at(0), c_list.size(), 3, self)
+
     ### @brief ファイルから読み込む．
     @staticmethod
     def read(str filename) :
@@ -70,12 +92,24 @@ cdef class BiGraph :
         self._this.write(c_str)
 
     ### @brief 最大マッチングを求める．
-    def max_matching(self) :
+    ###
+    ### as_array が True の場合は (id1, id2) を行とする (k, 2) の
+    ### numpy の配列で返す．
+    def max_matching(self, as_array = False) :
         cdef vector[int] c_pos_list
+        cdef vector[int] c_ans
         cdef int n
         cdef int pos
-        c_pos_list = self._this.max_matching()
+        with nogil :
+            c_pos_list = self._this.max_matching()
         n = c_pos_list.size()
+        if as_array :
+            c_ans.reserve(n * 2)
+            for i in range(n) :
+                pos = c_pos_list[i]
+                c_ans.push_back(self._this.edge_id1(pos))
+                c_ans.push_back(self._this.edge_id2(pos))
+            return _new_int_array(c_ans, 2).to_numpy()
         ans = list()
         for i in range(n) :
             pos = c_pos_list[i]
@@ -83,3 +117,44 @@ cdef class BiGraph :
             id2 = self._this.edge_id2(pos)
             ans.append( (id1, id2) )
         return ans
+
+    ### @brief 最大マッチングを非同期に求める．
+    ###
+    ### ListFuture を返す．
+    ### 結果は max_matching() と同じく枝の両端のノード番号の対のリストとなる．
+    def max_matching_async(self) :
+        cdef ListFuture future = ListFuture()
+        future._this = CXX_GraphExecutor.max_matching(self._this)
+        future._post = self._pos_to_edge
+        return future
+
+    ### @brief 枝番号のリストを両端のノード番号の対のリストに変換する．
+    def _pos_to_edge(self, pos_list) :
+        return [ (self._this.edge_id1(pos), self._this.edge_id2(pos)) for pos in pos_list ]
+
+
+### @brief 配列から C++ の BiGraph を作る．
+@cython.boundscheck(False)
+@cython.wraparound(False)
+cdef CXX_BiGraph _bigraph_from_array(int node1_num, int node2_num,
+                                     const int[:, :] edge_array) :
+    cdef Py_ssize_t m = edge_array.shape[0]
+    cdef Py_ssize_t ncol = edge_array.shape[1]
+    cdef Py_ssize_t i
+    cdef vector[CXX_BiGraph.Edge] c_list
+    cdef bint ok = True
+    if ncol != 2 and ncol != 3 :
+        raise ValueError("edge array must be of shape (m, 2) or (m, 3)")
+    with nogil :
+        c_list.resize(m)
+        for i in range(m) :
+            c_list[i].id1 = edge_array[i, 0]
+            c_list[i].id2 = edge_array[i, 1]
+            c_list[i].weight = edge_array[i, 2] if ncol == 3 else 1
+            if c_list[i].id1 < 0 or c_list[i].id1 >= node1_num or \
+               c_list[i].id2 < 0 or c_list[i].id2 >= node2_num :
+                ok = False
+                break
+    if not ok :
+        raise ValueError("node id out of range")
+    return CXX_BiGraph(node1_num, node2_num, move(c_list))
@@ -0,0 +1,107 @@
+
+### @file executor.pxi
+### @brief GraphExecutor の cython インターフェイス
+### @author Yusuke Matsunaga (松永 裕介)
+###
+### Copyright (C) 2022 Yusuke Matsunaga
+### All rights reserved.
+###
+### UdGraph.coloring_async() などが返す future クラスを定義する．
+### 問題は C++ のスレッドプールで解かれ，待っている間は GIL を解放する．
+### asyncio から待つ場合は
+###   await loop.run_in_executor(None, future.result)
+### のようにする．
+
+from libcpp cimport bool
+from libcpp.pair cimport pair
+from libcpp.vector cimport vector
+from CXX_GraphExecutor cimport GraphFuture as CXX_GraphFuture
+from CXX_GraphExecutor cimport GraphExecutor as CXX_GraphExecutor
+
+
+### @brief 非同期に解くためのスレッド数を設定する．
+###
+### 0 以下の場合はハードウェアの並列度を用いる．
+def set_async_thread_num(int thread_num) :
+    with nogil :
+        CXX_GraphExecutor.set_thread_num(thread_num)
+
+### @brief 非同期に解くためのスレッド数を返す．
+def async_thread_num() :
+    return CXX_GraphExecutor.thread_num()
+
+
+### @brief 彩色問題の結果を受け取る future
+cdef class ColoringFuture :
+
+    cdef CXX_GraphFuture[pair[int, vector[int]]] _this
+
+    ### @brief 結果が得られている時 True を返す．
+    def done(self) :
+        return self._this.is_ready()
+
+    ### @brief 結果が得られるまで待つ．
+    ###
+    ### timeout 秒経っても得られない場合は False を返す．
+    def wait(self, timeout = None) :
+        cdef CXX_GraphFuture[pair[int, vector[int]]] c_future = self._this
+        cdef double c_timeout
+        cdef bool ready
+        if timeout is None :
+            with nogil :
+                c_future.wait()
+            return True
+        c_timeout = timeout
+        with nogil :
+            ready = c_future.wait_for(c_timeout)
+        return ready
+
+    ### @brief 結果を返す．
+    ###
+    ### 結果は (彩色数, 彩色結果のリスト) となる．
+    def result(self, timeout = None) :
+        cdef pair[int, vector[int]] c_ans
+        if not self.wait(timeout) :
+            raise TimeoutError()
+        c_ans = self._this.get()
+        return c_ans.first, [ c_ans.second[i] for i in range(c_ans.second.size()) ]
+
+
+### @brief 番号のリストを結果とする問題の future
+cdef class ListFuture :
+
+    cdef CXX_GraphFuture[vector[int]] _this
+
+    # 結果を変換する関数(None なら変換しない)
+    cdef object _post
+
+    ### @brief 結果が得られている時 True を返す．
+    def done(self) :
+        return self._this.is_ready()
+
+    ### @brief 結果が得られるまで待つ．
+    ###
+    ### timeout 秒経っても得られない場合は False を返す．
+    def wait(self, timeout = None) :
+        cdef CXX_GraphFuture[vector[int]] c_future = self._this
+        cdef double c_timeout
+        cdef bool ready
+        if timeout is None :
+            with nogil :
+                c_future.wait()
+            return True
+        c_timeout = timeout
+        with nogil :
+            ready = c_future.wait_for(c_timeout)
+        return ready
+
+    ### @brief 結果を返す．
+    def result(self, timeout = None) :
+        cdef vector[int] c_ans
+        if not self.wait(timeout) :
+            raise TimeoutError()
+        c_ans = self._this.get()
+        ans = [ c_ans[i] for i in range(c_ans.size()) ]
+        if self._post is not None :
+            ans = self._post(ans)
+        return ans
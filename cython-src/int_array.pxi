@@ -0,0 +1,127 @@
+
+### @file int_array.pxi
+### @brief IntArray の cython インターフェイス
+### @author Yusuke Matsunaga (松永 裕介)
+###
+### Copyright (C) 2022 Yusuke Matsunaga
+### All rights reserved.
+###
+### C++ の int の配列をコピーせずに Python に見せるためのクラスを定義する．
+### IntArray はバッファプロトコルを実装しているので，
+### numpy.asarray() や memoryview() で同じメモリを共有する配列が得られる．
+
+from libcpp.vector cimport vector
+from cpython.buffer cimport PyBUF_WRITABLE
+
+
+### @brief int の1次元/2次元配列
+cdef class IntArray :
+
+    # 自分で持つ場合の本体
+    cdef vector[int] _data
+
+    # 先頭のポインタ
+    cdef int* _ptr
+
+    # 次元数
+    cdef int _ndim
+
+    # 各次元の大きさ
+    cdef Py_ssize_t _shape[2]
+
+    # 各次元の間隔(バイト)
+    cdef Py_ssize_t _strides[2]
+
+    # 書き換えを禁止する時 True
+    cdef bint _readonly
+
+    # _ptr の指すメモリを持っているオブジェクト
+    cdef object _owner
+
+    # 持ち主が生きているビューを弱参照で数えられるようにする．
+    cdef object __weakref__
+
+    ### @brief 要素数を返す．
+    def __len__(self) :
+        return self._shape[0]
+
+    ### @brief バッファを返す．
+    def __getbuffer__(self, Py_buffer* buffer, int flags) :
+        if self._readonly and (flags & PyBUF_WRITABLE) :
+            raise BufferError("IntArray is read-only")
+        buffer.buf = <void*>self._ptr
+        buffer.obj = self
+        buffer.len = self._shape[0] * self._strides[0]
+        buffer.readonly = self._readonly
+        buffer.itemsize = sizeof(int)
+        buffer.format = "i"
+        buffer.ndim = self._ndim
+        buffer.shape = self._shape
+        buffer.strides = self._strides
+        buffer.suboffsets = NULL
+        buffer.internal = NULL
+
+    def __releasebuffer__(self, Py_buffer* buffer) :
+        pass
+
+    ### @brief numpy の配列に変換する．
+    ###
+    ### メモリは共有される．
+    def to_numpy(self) :
+        import numpy
+        return numpy.asarray(self)
+
+
+### @brief vector[int] の内容を持つ IntArray を作る．
+###
+### - data の内容は IntArray に移され，data は空になる．
+### - ncol が 0 の場合は1次元，そうでなければ (n, ncol) の2次元配列となる．
+cdef IntArray _new_int_array(vector[int]& data, Py_ssize_t ncol = 0) :
+    cdef IntArray array = IntArray()
+    array._data.swap(data)
+    array._ptr = array._data.data()
+    array._readonly = False
+    if ncol == 0 :
+        array._ndim = 1
+        array._shape[0] = array._data.size()
+        array._shape[1] = 0
+        array._strides[0] = sizeof(int)
+        array._strides[1] = 0
+    else :
+        array._ndim = 2
+        array._shape[0] = array._data.size() // ncol
+        array._shape[1] = ncol
+        array._strides[0] = ncol * sizeof(int)
+        array._strides[1] = sizeof(int)
+    return array
+
+### @brief 他のオブジェクトが持つ (n, 列数) の配列を参照する IntArray を作る．
+###
+### - owner が生きている間は ptr が有効であり，内容は変化しないこと．
+### - ncol が 0 の場合は1次元の配列となる．
+cdef IntArray _new_int_view(int* ptr, Py_ssize_t n, Py_ssize_t ncol, object owner) :
+    cdef IntArray array = IntArray()
+    array._ptr = ptr
+    if ncol == 0 :
+        array._ndim = 1
+        array._shape[0] = n
+        array._shape[1] = 0
+        array._strides[0] = sizeof(int)
+        array._strides[1] = 0
+    else :
+        array._ndim = 2
+        array._shape[0] = n
+        array._shape[1] = ncol
+        array._strides[0] = ncol * sizeof(int)
+        array._strides[1] = sizeof(int)
+    array._readonly = True
+    array._owner = owner
+    return array
+
+### @brief 結果を返す．
+###
+### as_array が True の場合は numpy の配列，そうでなければリストを返す．
+cdef object _int_result(vector[int]& data, bint as_array) :
+    if as_array :
+        return _new_int_array(data).to_numpy()
+    return [ data[i] for i in range(data.size()) ]
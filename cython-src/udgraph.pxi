@@ -6,10 +6,14 @@
 ### Copyright (C) 2018 Yusuke Matsunaga
 ### All rights reserved.
 
+cimport cython
 from libcpp.string cimport string
 from libcpp.pair cimport pair
 from libcpp.vector cimport vector
+from libcpp.utility cimport move
+import weakref
 from CXX_UdGraph cimport UdGraph as CXX_UdGraph
+from CXX_GraphExecutor cimport GraphExecutor as CXX_GraphExecutor
 
 
 ### @brief UdGraph の Python バージョン
@@ -17,9 +21,24 @@ cdef class UdGraph :
 
     cdef CXX_UdGraph _this
 
+    # edge_array()/weight_array() が返した C++ のメモリを共有する IntArray
+    #
+    # これらが生きている間は pack()/unpack() でメモリを解放してはいけない．
+    cdef object _views
+
+    def __cinit__(self) :
+        self._views = weakref.WeakSet()
+
     ### @brief 初期化
-    def __init__(self, int node_num, edge_list = list()) :
+    ###
+    ### edge_list はタプルのリストか，int32 の (m, 2) または (m, 3) の
+    ### 配列(numpy.ndarray などバッファプロトコルを持つもの)．
+    ### 配列の場合は C++ 側でまとめて読み込む．
+    def __init__(self, int node_num = 0, edge_list = list()) :
         cdef int id1, id2, w
+        if not isinstance(edge_list, (list, tuple)) :
+            self._this = _udgraph_from_array(node_num, edge_list)
+            return
         self._this.resize(node_num)
         for edge in edge_list :
             if len(edge) == 2 :
@@ -41,6 +60,26 @@ cdef class UdGraph :
     def edge_num(self) :
         return self._this.edge_num()
 
+    ### @brief 1 以外の重みを持つ時 True を返す．
+    @property
+    def is_weighted(self) :
+        return self._this.is_weighted()
+
+    ### @brief ノードの重みを設定する．
+    ###
+    ### 重みを用いるのは "weighted" の max_clique() と independent_set() のみ
+    def set_node_weight(self, id, weight) :
+        self._this.set_node_weight(id, weight)
+
+    ### @brief ノードの重みを返す．
+    def node_weight(self, id) :
+        return self._this.node_weight(id)
+
+    ### @brief 1 以外のノードの重みを持つ時 True を返す．
+    @property
+    def is_node_weighted(self) :
+        return self._this.is_node_weighted()
+
     ### @brief 枝のリストを返す．
     def edge_list(self) :
         cdef int id1, id2, w
@@ -50,6 +89,78 @@ cdef class UdGraph :
             w = self._this.edge_weight(i)
             yield id1, id2, w
 
+    ### @brief 枝を圧縮形式で持つようにする．
+    ###
+    ### - 圧縮形式では edge_array() は C++ のメモリを共有しない．
+    ### - edge_array() が返した配列(から作った numpy の配列)が
+    ###   生きている間は BufferError となる．
+    def pack(self) :
+        if not self._this.is_packed() :
+            self._check_no_view()
+        self._this.pack()
+
+    ### @brief 枝を非圧縮形式で持つようにする．
+    ###
+    ### weight_array() が返した配列(から作った numpy の配列)が
+    ### 生きている間は BufferError となる．
+    def unpack(self) :
+        if self._this.is_packed() :
+            self._check_no_view()
+        self._this.unpack()
+
+    ### @brief C++ のメモリを共有する配列がないことを確かめる．
+    def _check_no_view(self) :
+        if len(self._views) > 0 :
+            raise BufferError("UdGraph has exported arrays sharing its memory")
+
+    ### @brief 枝を圧縮形式で持つ時 True を返す．
+    @property
+    def is_packed(self) :
+        return self._this.is_packed()
+
+    ### @brief 枝の (m, 3) の配列を返す．
+    ###
+    ### - 各行は (id1, id2, weight) である．
+    ### - 非圧縮形式の場合は C++ のメモリを共有する読み出し専用の
+    ###   IntArray を返す．圧縮形式の場合は新たに作って返す．
+    ###   numpy の配列が欲しければ numpy.asarray() を用いる．
+    def edge_array(self) :
+        cdef const vector[CXX_UdGraph.Edge]* c_list
+        cdef vector[int] c_data
+        cdef int i
+        if self._this.is_packed() :
+            c_data.reserve(self._this.edge_num() * 3)
+            for i in range(self._this.edge_num()) :
+                c_data.push_back(self._this.edge_id1(i))
+                c_data.push_back(self._this.edge_id2(i))
+                c_data.push_back(self._this.edge_weight(i))
+            return _new_int_array(c_data, 3)
+        c_list = &self._this.edge_list()
+        if c_list.size() == 0 :
+            return _new_int_view(NULL, 0, 3, self)
+        view = _new_int_view(<int*>&c_list.at(0), c_list.size(), 3, self)
+        self._views.add(view)
+        return view
+
+    ### @brief 枝の重みの (m,) の配列を返す．
+    ###
+    ### - 圧縮形式で is_weighted が True の場合は C++ のメモリを共有する
+    ###   読み出し専用の IntArray を返す．
+    ### - そうでなければ IntArray を新たに作って返す．
+    def weight_array(self) :
+        cdef const vector[int]* c_list
+        cdef vector[int] c_data
+        cdef int i
+        if self._this.is_packed() and self._this.is_weighted() :
+            c_list = &self._this.weight_list()
+            view = _new_int_view(<int*>&c_list.at(0), c_list.size(), 0, self)
+            self._views.add(view)
+            return view
+        c_data.reserve(self._this.edge_num())
+        for i in range(self._this.edge_num()) :
+            c_data.push_back(self._this.edge_weight(i))
+        return _new_int_array(c_data)
+
     ### @brief DIMACS 形式のファイルを読み込むクラスメソッド
     @staticmethod
     def read_dimacs(str filename) :
@@ -83,49 +194,137 @@ cdef class UdGraph :
         self._this.dump(c_str)
 
     ### @brief 彩色問題を解く
-    def coloring(self, algorithm = None) :
+    ###
+    ### as_array が True の場合は彩色結果を numpy の配列で返す．
+    def coloring(self, algorithm = None, as_array = False) :
         cdef string c_algorithm
         cdef pair[int, vector[int]] cmap_ans
-        cdef vector[int] c_color_map
         cdef int nc
         if algorithm != None :
             c_algorithm = algorithm.encode('UTF-8')
         else :
             c_algorithm = string()
-        cmap_ans = self._this.coloring(c_algorithm)
+        with nogil :
+            cmap_ans = self._this.coloring(c_algorithm)
         nc = cmap_ans.first
-        c_color_map = cmap_ans.second
-        return nc, [ c_color_map[i] for i in range(self.node_num) ]
+        return nc, _int_result(cmap_ans.second, as_array)
 
     ### @brief 最大独立集合を求める．
-    def independent_set(self, algorithm = None) :
+    ###
+    ### as_array が True の場合は numpy の配列で返す．
+    def independent_set(self, algorithm = None, as_array = False) :
         cdef string c_algorithm
         cdef vector[int] c_ans
         if algorithm != None :
             c_algorithm = algorithm.encode('UTF-8')
         else :
             c_algorithm = string()
-        c_ans = self._this.independent_set(c_algorithm)
-        return [ c_ans[i] for i in range(c_ans.size()) ]
+        with nogil :
+            c_ans = self._this.independent_set(c_algorithm)
+        return _int_result(c_ans, as_array)
 
     ### @brief 最大クリークを求める．
-    def max_clique(self, algorithm = None) :
+    ###
+    ### as_array が True の場合は numpy の配列で返す．
+    def max_clique(self, algorithm = None, as_array = False) :
         cdef string c_algorithm
         cdef vector[int] c_ans
         if algorithm != None :
             c_algorithm = algorithm.encode('UTF-8')
         else :
             c_algorithm = string()
-        c_ans = self._this.max_clique(c_algorithm)
-        return [ c_ans[i] for i in range(c_ans.size()) ]
+        with nogil :
+            c_ans = self._this.max_clique(c_algorithm)
+        return _int_result(c_ans, as_array)
 
     ### @brief 最大重みマッチングを求める．
-    def max_matching(self, algorithm = None) :
+    ###
+    ### as_array が True の場合は numpy の配列で返す．
+    def max_matching(self, algorithm = None, as_array = False) :
         cdef string c_algorithm
         cdef vector[int] c_ans
         if algorithm != None :
             c_algorithm = algorithm.encode('UTF-8')
         else :
             c_algorithm = string()
-        c_ans = self._this.max_matching(c_algorithm)
-        return [ c_ans[i] for i in range(c_ans.size()) ]
+        with nogil :
+            c_ans = self._this.max_matching(c_algorithm)
+        return _int_result(c_ans, as_array)
+
+    ### @brief 彩色問題を非同期に解く．
+    ###
+    ### ColoringFuture を返す．
+    def coloring_async(self, algorithm = None) :
+        cdef string c_algorithm
+        cdef ColoringFuture future = ColoringFuture()
+        if algorithm != None :
+            c_algorithm = algorithm.encode('UTF-8')
+        else :
+            c_algorithm = string()
+        future._this = CXX_GraphExecutor.coloring(self._this, c_algorithm)
+        return future
+
+    ### @brief 最大独立集合を非同期に求める．
+    ###
+    ### ListFuture を返す．
+    def independent_set_async(self, algorithm = None) :
+        cdef string c_algorithm
+        cdef ListFuture future = ListFuture()
+        if algorithm != None :
+            c_algorithm = algorithm.encode('UTF-8')
+        else :
+            c_algorithm = string()
+        future._this = CXX_GraphExecutor.independent_set(self._this, c_algorithm)
+        return future
+
+    ### @brief 最大クリークを非同期に求める．
+    ###
+    ### ListFuture を返す．
+    def max_clique_async(self, algorithm = None) :
+        cdef string c_algorithm
+        cdef ListFuture future = ListFuture()
+        if algorithm != None :
+            c_algorithm = algorithm.encode('UTF-8')
+        else :
+            c_algorithm = string()
+        future._this = CXX_GraphExecutor.max_clique(self._this, c_algorithm)
+        return future
+
+    ### @brief 最大重みマッチングを非同期に求める．
+    ###
+    ### ListFuture を返す．
+    def max_matching_async(self, algorithm = None) :
+        cdef string c_algorithm
+        cdef ListFuture future = ListFuture()
+        if algorithm != None :
+            c_algorithm = algorithm.encode('UTF-8')
+        else :
+            c_algorithm = string()
+        future._this = CXX_GraphExecutor.max_matching(self._this, c_algorithm)
+        return future
+
+
+### @brief 配列から C++ の UdGraph を作る．
+@cython.boundscheck(False)
+@cython.wraparound(False)
+cdef CXX_UdGraph _udgraph_from_array(int node_num, const int[:, :] edge_array) :
+    cdef Py_ssize_t m = edge_array.shape[0]
+    cdef Py_ssize_t ncol = edge_array.shape[1]
+    cdef Py_ssize_t i
+    cdef vector[CXX_UdGraph.Edge] c_list
+    cdef bint ok = True
+    if ncol != 2 and ncol != 3 :
+        raise ValueError("edge array must be of shape (m, 2) or (m, 3)")
+    with nogil :
+        c_list.resize(m)
+        for i in range(m) :
+            c_list[i].id1 = edge_array[i, 0]
+            c_list[i].id2 = edge_array[i, 1]
+            c_list[i].weight = edge_array[i, 2] if ncol == 3 else 1
+            if c_list[i].id1 < 0 or c_list[i].id1 >= node_num or \
+               c_list[i].id2 < 0 or c_list[i].id2 >= node_num :
+                ok = False
+                break
+    if not ok :
+        raise ValueError("node id out of range")
+    return CXX_UdGraph(node_num, move(c_list))
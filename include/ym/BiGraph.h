@@ -9,6 +9,7 @@
 /// All rights reserved.
 
 #include "ym_config.h"
+#include <memory>
 
 
 /// @brief bigraph 用の名前空間の開始
@@ -24,6 +25,8 @@ END_NAMESPACE_YM
 
 BEGIN_NAMESPACE_YM_BIGRAPH
 
+class MgWork;
+
 //////////////////////////////////////////////////////////////////////
 /// @class BiGraph BiGraph.h "ym/BiGraph.h"
 /// @brief bipartite graph を表すクラス
@@ -51,6 +54,39 @@ public:
     int weight{1};
   };
 
+  /// @brief 最大マッチングの作業領域を表すクラス
+  ///
+  /// - 呼び出し側で持って max_matching() に繰り返し渡すと確保済みの
+  ///   領域を再利用するので，同程度の大きさのグラフを解く場合には
+  ///   新たなメモリ確保は起こらない．
+  /// - 複数のスレッドから同時に使ってはいけない．
+  class MatchingWork
+  {
+  public:
+
+    /// @brief コンストラクタ
+    MatchingWork();
+
+    /// @brief コピーコンストラクタは禁止
+    MatchingWork(const MatchingWork& src) = delete;
+
+    /// @brief 代入演算子も禁止
+    MatchingWork&
+    operator=(const MatchingWork& src) = delete;
+
+    /// @brief デストラクタ
+    ~MatchingWork();
+
+
+  private:
+
+    friend class BiGraph;
+
+    // 作業領域の本体
+    std::unique_ptr<MgWork> mWork;
+
+  };
+
 
 public:
 
@@ -65,6 +101,16 @@ public:
 	  int node2_num,
 	  const vector<Edge>& edge_list = vector<Edge>());
 
+  /// @brief コンストラクタ
+  /// @param[in] node1_num 頂点集合1の要素数
+  /// @param[in] node2_num 頂点集合2の要素数
+  /// @param[in] edge_list 枝のリスト
+  ///
+  /// edge_list の中身を引き取るのでコピーは生じない．
+  BiGraph(int node1_num,
+	  int node2_num,
+	  vector<Edge>&& edge_list);
+
   /// @brief コピーコンストラクタ
   /// @param[in] src コピー元のオブジェクト
   BiGraph(const BiGraph& src) = default;
@@ -108,6 +154,29 @@ public:
 	   int id2,
 	   int weight = 1);
 
+  /// @brief 枝をまとめて追加する．
+  /// @param[in] edge_array 枝の配列の先頭
+  /// @param[in] num 枝数
+  ///
+  /// 範囲チェックは追加した枝に対してまとめて1回行う．
+  void
+  add_edges(const Edge* edge_array,
+	    SizeType num);
+
+  /// @brief 枝をまとめて追加する．
+  /// @param[in] edge_list 枝のリスト
+  void
+  add_edges(const vector<Edge>& edge_list);
+
+  /// @brief 枝数の分だけ領域を確保する．
+  /// @param[in] edge_num 枝数
+  void
+  reserve(SizeType edge_num);
+
+  /// @brief 余分な領域を解放する．
+  void
+  shrink_to_fit();
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -187,9 +256,34 @@ public:
   //////////////////////////////////////////////////////////////////////
 
   /// @brief 最大重みマッチングを求める．
+  /// @param[in] algorithm 初期解を求めるアルゴリズム名
+  /// @return マッチング結果の枝番号のリストを返す．
+  ///
+  /// algorithm には "greedy", "karp-sipser", "local-dominant" が指定できる．
+  /// それ以外の場合は "greedy" となる．
+  vector<int>
+  max_matching(const string& algorithm = string()) const;
+
+  /// @brief 作業領域を指定して最大重みマッチングを求める．
+  /// @param[in] algorithm 初期解を求めるアルゴリズム名
+  /// @param[in] work 作業領域
   /// @return マッチング結果の枝番号のリストを返す．
+  ///
+  /// 同じ work を使い回すと作業領域のメモリ確保が省ける．
   vector<int>
-  max_matching() const;
+  max_matching(const string& algorithm,
+	       MatchingWork& work) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief begin 番目以降の枝のノード番号の範囲チェックを行う．
+  /// @param[in] begin 開始位置
+  void
+  check_range(SizeType begin) const;
 
 
 private:
@@ -243,6 +337,32 @@ BiGraph::add_edge(int id1,
   mEdgeList.push_back({id1, id2, weight});
 }
 
+// @brief 枝をまとめて追加する．
+// @param[in] edge_list 枝のリスト
+inline
+void
+BiGraph::add_edges(const vector<Edge>& edge_list)
+{
+  add_edges(edge_list.data(), edge_list.size());
+}
+
+// @brief 枝数の分だけ領域を確保する．
+// @param[in] edge_num 枝数
+inline
+void
+BiGraph::reserve(SizeType edge_num)
+{
+  mEdgeList.reserve(edge_num);
+}
+
+// @brief 余分な領域を解放する．
+inline
+void
+BiGraph::shrink_to_fit()
+{
+  mEdgeList.shrink_to_fit();
+}
+
 // @brief 頂点集合1の要素数を返す．
 inline
 int
@@ -0,0 +1,236 @@
+#ifndef YM_BIMATCHER_H
+#define YM_BIMATCHER_H
+
+/// @file ym/BiMatcher.h
+/// @brief BiMatcher のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/BiGraph.h"
+#include <memory>
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_BIGRAPH
+
+class MgWork;
+
+//////////////////////////////////////////////////////////////////////
+/// @class BiMatcher BiMatcher.h "ym/BiMatcher.h"
+/// @brief 枝の変更に追従する2部グラフの最大マッチングを求めるクラス
+///
+/// - 最初の max_matching() は BiGraph::max_matching() と同じ方法で解く．
+/// - 以降は前回のマッチングを保持したまま，枝の追加・削除・重みの変更で
+///   影響を受けた部分だけを修復する．
+///   - 削除された枝が選ばれていた場合は両端をオープンにする．
+///   - 追加された枝と重みの変わった枝はその周辺で選び直す．
+///   - 増加路がなくなるまで改善する．
+/// - 最後に双対変数(ポテンシャル)が実行可能になるまで重みの和を増やす
+///   交互閉路を反転させるので，結果は常に最大重みマッチングとなり，
+///   BiGraph::max_matching() の結果より悪くなることはない．
+///   ポテンシャルは前回の値から始めるので，変更が少なければ
+///   枝を数回なめるだけで最適性が確かめられる．
+/// - 枝の追加・削除の後の max_matching() は作業領域を O(V + E) で
+///   作り直す．作業領域を少しずつ書き換えることはしない．
+/// - 枝番号は削除しても詰めないので，削除した枝の番号は無効になるだけで
+///   他の枝の番号は変わらない．
+/// - 重みの和が同じマッチングが複数ある場合はどれを選ぶかが前回までの解に
+///   依存するので，BiGraph::max_matching() の結果と一致するとは限らない．
+//////////////////////////////////////////////////////////////////////
+class BiMatcher
+{
+public:
+
+  /// @brief 空のコンストラクタ
+  BiMatcher();
+
+  /// @brief コンストラクタ
+  /// @param[in] graph 対象のグラフ
+  explicit
+  BiMatcher(const BiGraph& graph);
+
+  /// @brief コピーコンストラクタは禁止
+  BiMatcher(const BiMatcher& src) = delete;
+
+  /// @brief 代入演算子も禁止
+  BiMatcher&
+  operator=(const BiMatcher& src) = delete;
+
+  /// @brief デストラクタ
+  ~BiMatcher();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 内容を設定する外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief グラフを設定する．
+  /// @param[in] graph 対象のグラフ
+  ///
+  /// 以前の内容とマッチングは破棄される．
+  void
+  set_graph(const BiGraph& graph);
+
+  /// @brief 枝を追加する．
+  /// @param[in] id1, id2 枝の両端のノード番号
+  /// @param[in] weight 枝の重み
+  /// @return 追加した枝の番号を返す．
+  int
+  add_edge(int id1,
+	   int id2,
+	   int weight = 1);
+
+  /// @brief 枝を削除する．
+  /// @param[in] idx 枝番号 ( 0 <= idx < edge_num() )
+  void
+  remove_edge(int idx);
+
+  /// @brief 枝の重みを変える．
+  /// @param[in] idx 枝番号 ( 0 <= idx < edge_num() )
+  /// @param[in] weight 新しい重み
+  void
+  set_weight(int idx,
+	     int weight);
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 内容を取得する外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 頂点集合1の要素数を返す．
+  int
+  node1_num() const
+  {
+    return mNode1Num;
+  }
+
+  /// @brief 頂点集合2の要素数を返す．
+  int
+  node2_num() const
+  {
+    return mNode2Num;
+  }
+
+  /// @brief 枝番号の上限を返す．
+  ///
+  /// 削除された枝も含む．
+  int
+  edge_num() const
+  {
+    return mEdgeList.size();
+  }
+
+  /// @brief 枝の情報を返す．
+  /// @param[in] idx 枝番号 ( 0 <= idx < edge_num() )
+  const BiGraph::Edge&
+  edge(int idx) const
+  {
+    ASSERT_COND( 0 <= idx && idx < edge_num() );
+    return mEdgeList[idx];
+  }
+
+  /// @brief 削除された枝の時 true を返す．
+  /// @param[in] idx 枝番号 ( 0 <= idx < edge_num() )
+  bool
+  is_removed(int idx) const
+  {
+    ASSERT_COND( 0 <= idx && idx < edge_num() );
+    return mRemovedArray[idx];
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // マッチングアルゴリズム
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 変更を反映させた最大重みマッチングを求める．
+  /// @return マッチング結果の枝番号のリストを昇順に返す．
+  vector<int>
+  max_matching();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 枝の追加・削除を作業領域に反映させる．
+  ///
+  /// 削除されていない選択枝は選び直す．
+  void
+  rebuild();
+
+  /// @brief 枝の周辺で選び直す．
+  /// @param[in] idx 枝番号
+  void
+  improve(int idx);
+
+  /// @brief 重みの和を増やす交互閉路を一つ見つけて反転させる．
+  /// @return 見つからなかった時(最適な時) false を返す．
+  bool
+  cancel_cycle();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 頂点集合1の要素数
+  int mNode1Num{0};
+
+  // 頂点集合2の要素数
+  int mNode2Num{0};
+
+  // 枝のリスト
+  vector<BiGraph::Edge> mEdgeList;
+
+  // 削除された枝の印
+  vector<bool> mRemovedArray;
+
+  // 作業領域
+  std::unique_ptr<MgWork> mWork;
+
+  // 一度も解いていない時 true となるフラグ
+  bool mFirst{true};
+
+  // 作業領域を作り直す必要がある時 true となるフラグ
+  bool mNeedRebuild{true};
+
+  // 前回から追加されたか重みの変わった枝の番号のリスト
+  vector<int> mDirtyList;
+
+  // 作り直す時に選択枝を覚えておくための領域
+  vector<int> mSelectedList;
+
+  // 各ノードのポテンシャル
+  //
+  // 左側のノード，右側のノード，始点，終点の順に並ぶ．
+  vector<std::int64_t> mPotential;
+
+  // 最短路木の親のノードの位置
+  vector<int> mParentArray;
+
+  // 最短路木の親との間の枝番号(始点と終点との間は -1)
+  vector<int> mParentEdgeArray;
+
+  // 閉路を探す時の印
+  vector<int> mMarkArray;
+
+};
+
+END_NAMESPACE_YM_BIGRAPH
+
+BEGIN_NAMESPACE_YM
+
+using nsBiGraph::BiMatcher;
+
+END_NAMESPACE_YM
+
+#endif // YM_BIMATCHER_H
@@ -0,0 +1,190 @@
+#ifndef YM_GRAPHEXECUTOR_H
+#define YM_GRAPHEXECUTOR_H
+
+/// @file ym/GraphExecutor.h
+/// @brief GraphExecutor のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/UdGraph.h"
+#include "ym/BiGraph.h"
+#include <future>
+#include <chrono>
+
+
+BEGIN_NAMESPACE_YM
+
+//////////////////////////////////////////////////////////////////////
+/// @class GraphFuture GraphExecutor.h "ym/GraphExecutor.h"
+/// @brief GraphExecutor で非同期に解いた結果を受け取るためのクラス
+///
+/// std::shared_future の薄いラッパで，コピーできる．
+/// python(cython) から使いやすいように待ち時間は秒で指定する．
+//////////////////////////////////////////////////////////////////////
+template<typename T>
+class GraphFuture
+{
+public:
+
+  /// @brief 空のコンストラクタ
+  ///
+  /// valid() が false となる．
+  GraphFuture() = default;
+
+  /// @brief コンストラクタ
+  /// @param[in] future 結果を受け取る shared_future
+  explicit
+  GraphFuture(std::shared_future<T>&& future) :
+    mFuture{std::move(future)}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~GraphFuture() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 結果と結びついている時 true を返す．
+  bool
+  valid() const
+  {
+    return mFuture.valid();
+  }
+
+  /// @brief 結果が得られている時 true を返す．
+  bool
+  is_ready() const
+  {
+    return wait_for(0.0);
+  }
+
+  /// @brief 結果が得られるまで待つ．
+  void
+  wait() const
+  {
+    mFuture.wait();
+  }
+
+  /// @brief 結果が得られるまで最大 time 秒待つ．
+  /// @param[in] time 待ち時間(秒)
+  /// @return 結果が得られていれば true を返す．
+  bool
+  wait_for(double time) const
+  {
+    auto status = mFuture.wait_for(std::chrono::duration<double>(time));
+    return status == std::future_status::ready;
+  }
+
+  /// @brief 結果を返す．
+  ///
+  /// - 結果が得られるまで待つ．
+  /// - 解いている途中で例外が送出された場合はここで再送出される．
+  const T&
+  get() const
+  {
+    return mFuture.get();
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 本体
+  std::shared_future<T> mFuture;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class GraphExecutor GraphExecutor.h "ym/GraphExecutor.h"
+/// @brief グラフの問題を非同期に解くためのクラス
+///
+/// - 問題はプロセス全体で共通のスレッドプールで解かれ，
+///   結果は GraphFuture で受け取る．
+/// - グラフはコピーして渡すので，呼び出した後に元のグラフを
+///   変更したり破棄してもよい．
+/// - 各問題を解く関数自体も連結成分ごとにスレッドを用いることがある．
+//////////////////////////////////////////////////////////////////////
+class GraphExecutor
+{
+public:
+
+  /// @brief 彩色問題の結果の型
+  using ColoringResult = pair<int, vector<int>>;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief スレッドプールのスレッド数を設定する．
+  /// @param[in] thread_num スレッド数
+  ///
+  /// - thread_num が 0 以下の場合はハードウェアの並列度を用いる．
+  /// - 処理中の問題が全て終わるまで待ってから切り替える．
+  static
+  void
+  set_thread_num(int thread_num);
+
+  /// @brief スレッドプールのスレッド数を返す．
+  static
+  int
+  thread_num();
+
+  /// @brief 彩色問題を非同期に解く．
+  /// @param[in] graph 対象のグラフ
+  /// @param[in] algorithm アルゴリズム名
+  /// @param[in] options オプション
+  ///
+  /// 結果の意味は UdGraph::coloring() と同じ．
+  static
+  GraphFuture<ColoringResult>
+  coloring(const UdGraph& graph,
+	   const string& algorithm = string(),
+	   const UdGraph::ColoringOptions& options = UdGraph::ColoringOptions{});
+
+  /// @brief 最大独立集合を非同期に求める．
+  /// @param[in] graph 対象のグラフ
+  /// @param[in] algorithm アルゴリズム名
+  static
+  GraphFuture<vector<int>>
+  independent_set(const UdGraph& graph,
+		  const string& algorithm = string());
+
+  /// @brief 最大クリークを非同期に求める．
+  /// @param[in] graph 対象のグラフ
+  /// @param[in] algorithm アルゴリズム名
+  static
+  GraphFuture<vector<int>>
+  max_clique(const UdGraph& graph,
+	     const string& algorithm = string());
+
+  /// @brief 最大重みマッチングを非同期に求める．
+  /// @param[in] graph 対象のグラフ
+  /// @param[in] algorithm アルゴリズム名
+  static
+  GraphFuture<vector<int>>
+  max_matching(const UdGraph& graph,
+	       const string& algorithm = string());
+
+  /// @brief 2部グラフの最大マッチングを非同期に求める．
+  /// @param[in] graph 対象のグラフ
+  static
+  GraphFuture<vector<int>>
+  max_matching(const BiGraph& graph);
+
+};
+
+END_NAMESPACE_YM
+
+#endif // YM_GRAPHEXECUTOR_H
@@ -0,0 +1,170 @@
+#ifndef YM_GRAPHGEN_H
+#define YM_GRAPHGEN_H
+
+/// @file ym/GraphGen.h
+/// @brief GraphGen のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/UdGraph.h"
+#include "ym/BiGraph.h"
+
+
+BEGIN_NAMESPACE_YM
+
+//////////////////////////////////////////////////////////////////////
+/// @class GraphGen GraphGen.h "ym/GraphGen.h"
+/// @brief ベンチマークやストレステスト用のランダムグラフを作るクラス
+///
+/// - 結果は乱数の種のみで決まり，スレッド数や実行環境には依存しない．
+///   (乱数生成器も分布も自前で実装している)
+/// - 問題を固定個数のチャンクに分割し，チャンクごとに独立な乱数系列を用いて
+///   並列に枝を生成する．
+/// - 枝はチャンクの順にグラフに追加される．
+/// - 特に断りのない限り自己ループや多重枝は作らない．
+//////////////////////////////////////////////////////////////////////
+class GraphGen
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] seed 乱数の種
+  /// @param[in] thread_num スレッド数
+  ///
+  /// thread_num が 0 以下の場合はハードウェアの並列度を用いる．
+  explicit
+  GraphGen(int seed = 0,
+	   int thread_num = 0);
+
+  /// @brief デストラクタ
+  ~GraphGen() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief Erdős–Rényi の G(n, p) を作る．
+  /// @param[in] node_num ノード数
+  /// @param[in] prob 各ノード対に枝を張る確率
+  ///
+  /// 幾何分布による読み飛ばしを用いるので手間は O(n + m) となる．
+  UdGraph
+  gnp(int node_num,
+      double prob) const;
+
+  /// @brief Erdős–Rényi の G(n, m) を作る．
+  /// @param[in] node_num ノード数
+  /// @param[in] edge_num 枝数
+  ///
+  /// - ノード対の空間をチャンクに分割し，チャンクの大きさに比例した
+  ///   本数の枝をそれぞれ一様に選ぶ(層化抽出)．
+  /// - edge_num がノード対の総数を超える場合は完全グラフとなる．
+  UdGraph
+  gnm(int node_num,
+      SizeType edge_num) const;
+
+  /// @brief Barabási–Albert モデルのグラフを作る．
+  /// @param[in] node_num ノード数
+  /// @param[in] edge_per_node 新しいノードが張る枝数
+  ///
+  /// - 新しいノードは既存の枝の端点を一様に選ぶことで
+  ///   次数に比例した確率で接続先を選ぶ．
+  /// - 接続先は枝ごとのハッシュ値から遡って求めるので並列に計算できる．
+  ///   (Sanders と Schulz の方法)
+  /// - 多重枝が生じることがある．
+  UdGraph
+  barabasi_albert(int node_num,
+		  int edge_per_node) const;
+
+  /// @brief R-MAT (Kronecker) モデルのグラフを作る．
+  /// @param[in] scale ノード数の対数 (ノード数は 2^scale)
+  /// @param[in] edge_num 枝数
+  /// @param[in] a, b, c 隣接行列の4分割の選択確率(残りが d)
+  ///
+  /// - 既定値は Graph500 のもの．
+  /// - 多重枝が生じることがある．
+  UdGraph
+  rmat(int scale,
+       SizeType edge_num,
+       double a = 0.57,
+       double b = 0.19,
+       double c = 0.19) const;
+
+  /// @brief 単位正方形上のランダム幾何グラフを作る．
+  /// @param[in] node_num ノード数
+  /// @param[in] radius 枝を張る距離の上限
+  ///
+  /// 一辺が radius 以上の格子で近傍を探すので手間は O(n + m) となる．
+  UdGraph
+  geometric(int node_num,
+	    double radius) const;
+
+  /// @brief k 彩色可能なことがわかっているグラフを作る．
+  /// @param[in] node_num ノード数
+  /// @param[in] color_num 色数
+  /// @param[in] prob 色の異なるノード対に枝を張る確率
+  /// @return グラフと埋め込んだ彩色結果を返す．
+  ///
+  /// 色は各色のノード数がほぼ等しくなるようにランダムに割り当てる．
+  pair<UdGraph, vector<int>>
+  planted_coloring(int node_num,
+		   int color_num,
+		   double prob) const;
+
+  /// @brief クリークを埋め込んだ G(n, p) を作る．
+  /// @param[in] node_num ノード数
+  /// @param[in] prob 各ノード対に枝を張る確率
+  /// @param[in] clique_size 埋め込むクリークの要素数
+  /// @return グラフと埋め込んだクリークのノード番号のリストを返す．
+  pair<UdGraph, vector<int>>
+  planted_clique(int node_num,
+		 double prob,
+		 int clique_size) const;
+
+  /// @brief ランダムな2部グラフを作る．
+  /// @param[in] node1_num 頂点集合1の要素数
+  /// @param[in] node2_num 頂点集合2の要素数
+  /// @param[in] prob 各ノード対に枝を張る確率
+  BiGraph
+  bipartite(int node1_num,
+	    int node2_num,
+	    double prob) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 乱数の種
+  int mSeed;
+
+  // スレッド数
+  int mThreadNum;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] seed 乱数の種
+// @param[in] thread_num スレッド数
+inline
+GraphGen::GraphGen(int seed,
+		   int thread_num) :
+  mSeed{seed},
+  mThreadNum{thread_num}
+{
+}
+
+END_NAMESPACE_YM
+
+#endif // YM_GRAPHGEN_H
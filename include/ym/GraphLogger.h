@@ -0,0 +1,144 @@
+#ifndef YM_GRAPHLOGGER_H
+#define YM_GRAPHLOGGER_H
+
+/// @file ym/GraphLogger.h
+/// @brief GraphLogger のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_config.h"
+#include <atomic>
+#include <functional>
+
+
+BEGIN_NAMESPACE_YM
+
+//////////////////////////////////////////////////////////////////////
+/// @class GraphLogger GraphLogger.h "ym/GraphLogger.h"
+/// @brief グラフアルゴリズムの途中経過を出力するためのロガー
+///
+/// - 出力先(シンク)とレベルはプロセス全体で共通であり，
+///   set_sink() で設定する．
+///   シンクが設定されていない場合は何も出力しない．
+/// - log() はレコードを固定長のリングバッファ(ロックフリー)に積むだけで，
+///   シンクの呼び出しはバックグラウンドのスレッドが行う．
+///   そのため探索中のスレッドが入出力で待たされることはない．
+/// - バッファがあふれた場合はそのレコードを捨てて dropped_num() を増やす．
+/// - メッセージを作る手間を省くために，log() の前に enabled() で
+///   レベルを調べることが望ましい．
+//////////////////////////////////////////////////////////////////////
+class GraphLogger
+{
+public:
+
+  /// @brief ログのレベル
+  ///
+  /// 値の小さい方が重要度が高い．
+  enum class Level {
+    None = 0, ///< 何も出力しない(set_sink() でのみ用いる)
+    Error,    ///< エラー
+    Warning,  ///< 警告
+    Info,     ///< 途中経過
+    Debug     ///< デバッグ用の詳細な情報
+  };
+
+  /// @brief ログのレコード
+  struct Record
+  {
+    /// @brief レベル
+    Level level;
+
+    /// @brief 出力元のアルゴリズム名("isx2" など)
+    string source;
+
+    /// @brief メッセージ
+    string message;
+  };
+
+  /// @brief シンクを表す型
+  ///
+  /// バックグラウンドのスレッドから呼ばれる．
+  using Sink = std::function<void(const Record&)>;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief シンクとレベルを設定する．
+  /// @param[in] sink シンク
+  /// @param[in] level 出力する最も詳細なレベル
+  ///
+  /// - 以前のシンクに渡されていないレコードは flush() してから切り替える．
+  /// - sink が空か level が Level::None の場合はログを無効にする．
+  static
+  void
+  set_sink(Sink sink,
+	   Level level = Level::Info);
+
+  /// @brief 標準エラー出力に書き出すシンクを返す．
+  static
+  Sink
+  stderr_sink();
+
+  /// @brief 指定されたレベルのログが出力されるか調べる．
+  /// @param[in] level レベル
+  static
+  bool
+  enabled(Level level);
+
+  /// @brief ログを出力する．
+  /// @param[in] level レベル
+  /// @param[in] source 出力元のアルゴリズム名
+  /// @param[in] message メッセージ
+  ///
+  /// - enabled(level) が false の場合は何もしない．
+  /// - ブロックせずに戻る．
+  static
+  void
+  log(Level level,
+      const string& source,
+      string message);
+
+  /// @brief それまでに積まれたレコードが全てシンクに渡されるまで待つ．
+  static
+  void
+  flush();
+
+  /// @brief バッファがあふれて捨てたレコード数を返す．
+  static
+  SizeType
+  dropped_num();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 現在のレベル
+  static
+  std::atomic<int> mLevel;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 指定されたレベルのログが出力されるか調べる．
+inline
+bool
+GraphLogger::enabled(Level level)
+{
+  return static_cast<int>(level) <= mLevel.load(std::memory_order_relaxed);
+}
+
+END_NAMESPACE_YM
+
+#endif // YM_GRAPHLOGGER_H
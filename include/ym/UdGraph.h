@@ -10,6 +10,10 @@
 
 
 #include "ym_config.h"
+#include <functional>
+#include <cstdint>
+#include <iterator>
+#include <memory>
 
 
 /// @brief udgraph 用の名前空間の開始
@@ -25,12 +29,15 @@ END_NAMESPACE_YM
 
 BEGIN_NAMESPACE_YM_UDGRAPH
 
+class MgWork;
+
 //////////////////////////////////////////////////////////////////////
 /// @class UdGraph UdGraph.h "ym/UdGraph.h"
 /// @brief 一般的な無向グラフを表すクラス
 ///
 /// - Undirected Graph の略
 /// - 枝(ノード番号の対)のリストを持つ．
+/// - pack() で枝を圧縮形式(NodePair と重みの配列)で持つこともできる．
 /// - このクラスはインターフェイス用のもので凝ったデータ構造は持っていない．
 //////////////////////////////////////////////////////////////////////
 class UdGraph
@@ -52,6 +59,588 @@ public:
     int weight{1};
   };
 
+  /// @brief 圧縮形式で用いる枝の両端のノード番号の対
+  ///
+  /// - 1枝あたり 8 バイトで，重みは別の配列で持つ．
+  /// - pack() の後でのみ用いられる．
+  struct NodePair
+  {
+    /// @brief 両端のノード番号(id1 <= id2)
+    std::uint32_t id1, id2;
+  };
+
+  /// @brief edge_view() の返す枝のリスト
+  ///
+  /// - 格納形式によらずに全ての枝をなめるために用いる．
+  /// - 要素は Edge を値で返す．
+  class EdgeView
+  {
+  public:
+
+    /// @brief ランダムアクセス反復子
+    class const_iterator
+    {
+    public:
+
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type = Edge;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = Edge;
+
+      /// @brief 空のコンストラクタ
+      const_iterator() = default;
+
+      /// @brief コンストラクタ
+      const_iterator(const EdgeView* view,
+		     difference_type pos) :
+	mView{view},
+	mPos{pos}
+      {
+      }
+
+      /// @brief 枝を返す．
+      Edge
+      operator*() const
+      {
+	return (*mView)[mPos];
+      }
+
+      /// @brief n 個先の枝を返す．
+      Edge
+      operator[](difference_type n) const
+      {
+	return (*mView)[mPos + n];
+      }
+
+      /// @brief 次の要素に進む．
+      const_iterator&
+      operator++()
+      {
+	++ mPos;
+	return *this;
+      }
+
+      /// @brief 次の要素に進む．
+      const_iterator
+      operator++(int)
+      {
+	auto ans = *this;
+	++ mPos;
+	return ans;
+      }
+
+      /// @brief 前の要素に戻る．
+      const_iterator&
+      operator--()
+      {
+	-- mPos;
+	return *this;
+      }
+
+      /// @brief 前の要素に戻る．
+      const_iterator
+      operator--(int)
+      {
+	auto ans = *this;
+	-- mPos;
+	return ans;
+      }
+
+      /// @brief n 個進む．
+      const_iterator&
+      operator+=(difference_type n)
+      {
+	mPos += n;
+	return *this;
+      }
+
+      /// @brief n 個戻る．
+      const_iterator&
+      operator-=(difference_type n)
+      {
+	mPos -= n;
+	return *this;
+      }
+
+      /// @brief n 個先の反復子を返す．
+      friend
+      const_iterator
+      operator+(const_iterator it,
+		difference_type n)
+      {
+	return it += n;
+      }
+
+      /// @brief n 個先の反復子を返す．
+      friend
+      const_iterator
+      operator+(difference_type n,
+		const_iterator it)
+      {
+	return it += n;
+      }
+
+      /// @brief n 個前の反復子を返す．
+      friend
+      const_iterator
+      operator-(const_iterator it,
+		difference_type n)
+      {
+	return it -= n;
+      }
+
+      /// @brief 反復子の差を返す．
+      friend
+      difference_type
+      operator-(const const_iterator& left,
+		const const_iterator& right)
+      {
+	return left.mPos - right.mPos;
+      }
+
+      /// @brief 等価比較
+      bool
+      operator==(const const_iterator& right) const
+      {
+	return mPos == right.mPos;
+      }
+
+      /// @brief 非等価比較
+      bool
+      operator!=(const const_iterator& right) const
+      {
+	return !operator==(right);
+      }
+
+      /// @brief 小なり比較
+      bool
+      operator<(const const_iterator& right) const
+      {
+	return mPos < right.mPos;
+      }
+
+      /// @brief 大なり比較
+      bool
+      operator>(const const_iterator& right) const
+      {
+	return right.operator<(*this);
+      }
+
+      /// @brief 小なりイコール比較
+      bool
+      operator<=(const const_iterator& right) const
+      {
+	return !right.operator<(*this);
+      }
+
+      /// @brief 大なりイコール比較
+      bool
+      operator>=(const const_iterator& right) const
+      {
+	return !operator<(right);
+      }
+
+    private:
+
+      // 対象のリスト
+      const EdgeView* mView{nullptr};
+
+      // 位置
+      difference_type mPos{0};
+
+    };
+
+    /// @brief 非圧縮形式用のコンストラクタ
+    /// @param[in] edge_list 枝のリスト
+    explicit
+    EdgeView(const vector<Edge>& edge_list) :
+      mEdgeArray{edge_list.data()},
+      mNum{edge_list.size()}
+    {
+    }
+
+    /// @brief 圧縮形式用のコンストラクタ
+    /// @param[in] pair_list 両端のノード番号の対のリスト
+    /// @param[in] weight_list 重みのリスト(空の場合は全て 1)
+    EdgeView(const vector<NodePair>& pair_list,
+	     const vector<int>& weight_list) :
+      mPairArray{pair_list.data()},
+      mWeightArray{weight_list.empty() ? nullptr : weight_list.data()},
+      mNum{pair_list.size()}
+    {
+    }
+
+    /// @brief 要素数を返す．
+    SizeType
+    size() const
+    {
+      return mNum;
+    }
+
+    /// @brief 要素を返す．
+    Edge
+    operator[](SizeType pos) const
+    {
+      if ( mEdgeArray != nullptr ) {
+	return mEdgeArray[pos];
+      }
+      const auto& pair = mPairArray[pos];
+      return Edge{static_cast<int>(pair.id1),
+		  static_cast<int>(pair.id2),
+		  mWeightArray != nullptr ? mWeightArray[pos] : 1};
+    }
+
+    /// @brief 先頭の反復子を返す．
+    const_iterator
+    begin() const
+    {
+      return const_iterator{this, 0};
+    }
+
+    /// @brief 末尾の反復子を返す．
+    const_iterator
+    end() const
+    {
+      return const_iterator{this, static_cast<std::ptrdiff_t>(mNum)};
+    }
+
+  private:
+
+    // 非圧縮形式の枝の配列
+    const Edge* mEdgeArray{nullptr};
+
+    // 圧縮形式の両端の対の配列
+    const NodePair* mPairArray{nullptr};
+
+    // 圧縮形式の重みの配列
+    const int* mWeightArray{nullptr};
+
+    // 要素数
+    SizeType mNum;
+
+  };
+
+  /// @brief 彩色問題のオプションを表す構造体
+  ///
+  /// 既定値のままなら従来と同じ条件で解く．
+  struct ColoringOptions
+  {
+    /// @brief 制限時間(秒)
+    ///
+    /// - 壁時計で計る．
+    /// - 0 以下の場合は無制限
+    /// - 制限時間を過ぎた場合はそれまでに見つかった最良の解を返す．
+    double time_limit{0.0};
+
+    /// @brief 局所探索1回あたりの繰り返し回数の上限
+    ///
+    /// 0 以下の場合はアルゴリズムごとの既定値を用いる．
+    int iter_limit{0};
+
+    /// @brief タブー期間の基本パラメータ
+    int tabu_tenure{9};
+
+    /// @brief タブー期間の節点数依存パラメータ
+    double tabu_alpha{0.6};
+
+    /// @brief 独立集合の抽出を打ち切る残りノード数
+    ///
+    /// "iscov", "isx", "isx2" で用いられる．
+    int extract_limit{500};
+
+    /// @brief 乱数の種
+    int seed{0};
+
+    /// @brief スレッド数
+    ///
+    /// - 0 以下の場合はハードウェアの並列度を用いる．
+    /// - "portfolio" では同時に走らせるアルゴリズム数の上限となる．
+    /// - 複数の連結成分に分けて解く場合は各部分グラフの大きさに
+    ///   比例して割り振る．
+    int thread_num{0};
+
+    /// @brief 並列 greedy 彩色の優先度
+    ///
+    /// - "parallel-greedy", "parallel-greedy-jp" で用いられる．
+    /// - "random"(乱数)，"ldf"(次数の降順)，"sl"(smallest-last 順) が
+    ///   指定できる．それ以外の場合は "ldf" となる．
+    string greedy_priority;
+
+    /// @brief ノードの並べ替えの方法
+    ///
+    /// - 空でなければ node_order() で並べ替えたグラフに対して解く．
+    /// - 結果は元のノード番号に戻して返す．
+    string reorder;
+
+    /// @brief 解が改善されるたびに呼ばれる関数
+    ///
+    /// - 引数は彩色数と彩色結果
+    /// - 探索を行っているスレッドから呼ばれる．
+    /// - 複数の連結成分に分けて解く場合は，全ての部分グラフの解が
+    ///   揃ってから部分グラフの解をまとめた全体の彩色結果で呼ばれる．
+    std::function<void(int, const vector<int>&)> callback;
+  };
+
+  /// @brief 性能計測用のカウンタを表す構造体
+  ///
+  /// - YM_GRAPH_STATS を定義してビルドした場合のみ値が設定される．
+  ///   そうでない場合は全て 0 のままとなる．
+  /// - 複数のスレッドや部分グラフで解いた場合，回数は合計，
+  ///   時間とメモリ量は最大値となる．
+  struct PerfStats
+  {
+    /// @brief 探索の繰り返し回数
+    ///
+    /// tabucol の反復回数，hea の世代数，isx などの独立集合の抽出回数，
+    /// 増加路の探索の段数など
+    SizeType iterations{0};
+
+    /// @brief 局所探索の移動回数
+    SizeType moves{0};
+
+    /// @brief ヒープの更新回数
+    SizeType heap_updates{0};
+
+    /// @brief 分枝限定法の分枝ノード数
+    SizeType branch_nodes{0};
+
+    /// @brief 増加路による更新回数
+    SizeType augmentations{0};
+
+    /// @brief 前処理(データ構造の構築や下界の計算)に要した時間(秒)
+    double setup_time{0.0};
+
+    /// @brief 探索に要した時間(秒)
+    double search_time{0.0};
+
+    /// @brief プロセス全体の最大メモリ使用量(バイト)
+    SizeType peak_memory{0};
+  };
+
+  /// @brief 彩色問題の実行結果に関する情報を表す構造体
+  struct ColoringStats
+  {
+    /// @brief 最良解を見つけたアルゴリズム名
+    ///
+    /// "tabucol" などで初期解が改善されなかった場合は
+    /// 初期解を作ったアルゴリズム名("dsatur" など)となる．
+    string solver;
+
+    /// @brief 彩色数の下界
+    ///
+    /// - 彩色数がこの値と等しければ最適解である．
+    /// - 下界を求めるのは "tabucol", "hea", "portfolio" のみで，
+    ///   それ以外のアルゴリズムでは 0 となる．
+    int lower_bound{0};
+
+    /// @brief 性能計測用のカウンタ
+    PerfStats perf;
+  };
+
+  /// @brief 最大マッチングのオプションを表す構造体
+  struct MatchingOptions
+  {
+    /// @brief スレッド数
+    ///
+    /// - 0 以下の場合はハードウェアの並列度を用いる．
+    /// - 複数の連結成分に分けて解く場合は各部分グラフの大きさに
+    ///   比例して割り振る．
+    int thread_num{0};
+
+    /// @brief "approx-parallel" で近似解を求めた後に増加路で改善する回数の上限
+    ///
+    /// - 0 の場合は改善しない．
+    /// - 負の場合は増加路がなくなるまで改善する．
+    int augment_limit{0};
+
+    /// @brief ノードの並べ替えの方法
+    ///
+    /// - 空でなければ node_order() で並べ替えたグラフに対して解く．
+    /// - 枝番号は変わらないので結果はそのまま使える．
+    string reorder;
+  };
+
+  /// @brief 最大マッチングの作業領域を表すクラス
+  ///
+  /// - 呼び出し側で持って max_matching() に繰り返し渡すと確保済みの
+  ///   領域を再利用するので，同程度の大きさのグラフを解く場合には
+  ///   新たなメモリ確保は起こらない．
+  /// - 連結成分ごとに別の領域を持つ．
+  /// - 複数のスレッドから同時に使ってはいけない．
+  class MatchingWork
+  {
+  public:
+
+    /// @brief コンストラクタ
+    MatchingWork();
+
+    /// @brief コピーコンストラクタは禁止
+    MatchingWork(const MatchingWork& src) = delete;
+
+    /// @brief 代入演算子も禁止
+    MatchingWork&
+    operator=(const MatchingWork& src) = delete;
+
+    /// @brief デストラクタ
+    ~MatchingWork();
+
+
+  private:
+
+    friend class UdGraph;
+
+    // 部分グラフごとの作業領域
+    vector<std::unique_ptr<MgWork>> mWorkList;
+
+  };
+
+  /// @brief 最大マッチングの実行結果に関する情報を表す構造体
+  struct MatchingStats
+  {
+    /// @brief 選ばれた枝の重みの和
+    std::int64_t weight{0};
+
+    /// @brief 重みの和の上界
+    ///
+    /// - weight / upper_bound が近似の精度の目安となる．
+    /// - 上界を求めるのは "approx-parallel" のみで，
+    ///   それ以外のアルゴリズムでは 0 となる．
+    std::int64_t upper_bound{0};
+
+    /// @brief 性能計測用のカウンタ
+    PerfStats perf;
+  };
+
+  /// @brief 最大クリークと最大独立集合のオプションを表す構造体
+  struct NodeSetOptions
+  {
+    /// @brief 制限時間(秒)
+    ///
+    /// - 壁時計で計る．
+    /// - 0 以下の場合は無制限
+    /// - 制限時間を過ぎた場合はそれまでに見つかった最良の解を返す．
+    /// - max_clique() で連結成分ごとに解く場合は全体で共有する．
+    double time_limit{0.0};
+
+    /// @brief スレッド数
+    ///
+    /// - 0 以下の場合はハードウェアの並列度を用いる．
+    /// - max_clique() で連結成分ごとに並列に解く時に用いる．
+    int thread_num{0};
+
+    /// @brief 局所探索の繰り返し回数の上限
+    ///
+    /// 0 以下の場合はアルゴリズムごとの既定値を用いる．
+    int iter_limit{0};
+
+    /// @brief 乱数の種
+    int seed{0};
+
+    /// @brief ノードの並べ替えの方法
+    ///
+    /// - 空でなければ node_order() で並べ替えたグラフに対して解く．
+    /// - 結果は元のノード番号に戻して返す．
+    string reorder;
+  };
+
+  /// @brief 最大クリークと最大独立集合の実行結果に関する情報を表す構造体
+  struct NodeSetStats
+  {
+    /// @brief 選ばれたノードの重みの和
+    std::int64_t weight{0};
+
+    /// @brief 最適解であることが示された時 true となる．
+    ///
+    /// 示すのは "weighted" の max_clique() を最後まで探索した場合のみ
+    bool optimal{false};
+
+    /// @brief 性能計測用のカウンタ
+    PerfStats perf;
+  };
+
+  /// @brief 極大クリークの列挙のオプションを表す構造体
+  struct CliqueEnumOptions
+  {
+    /// @brief 列挙するクリークの要素数の下限
+    ///
+    /// これより小さい極大クリークは報告しない．探索もその分だけ枝刈りされる．
+    int min_size{1};
+
+    /// @brief 制限時間(秒)
+    ///
+    /// - 壁時計で計る．
+    /// - 0 以下の場合は無制限
+    /// - 制限時間を過ぎた場合は列挙を打ち切る．
+    double time_limit{0.0};
+
+    /// @brief スレッド数
+    ///
+    /// 0 以下の場合はハードウェアの並列度を用いる．
+    int thread_num{0};
+  };
+
+  /// @brief 極大クリークの列挙の実行結果に関する情報を表す構造体
+  struct CliqueEnumStats
+  {
+    /// @brief 報告したクリーク数
+    SizeType clique_num{0};
+
+    /// @brief 報告したクリークの要素数の最大値
+    int max_size{0};
+
+    /// @brief 最後まで列挙した時 true となる．
+    ///
+    /// 制限時間を過ぎたか callback が false を返した場合は false となる．
+    bool completed{false};
+
+    /// @brief 性能計測用のカウンタ
+    PerfStats perf;
+  };
+
+  /// @brief 極大クリークを受け取る関数の型
+  ///
+  /// - 引数はクリークの要素(ノード番号の昇順)
+  /// - false を返すと列挙を打ち切る．
+  using CliqueCallback = std::function<bool(const vector<int>&)>;
+
+  /// @brief canonicalize() のオプションを表す構造体
+  struct CanonicalizeOptions
+  {
+    /// @brief 重複した枝の重みをまとめる方法
+    enum class Combine {
+      First, ///< 最初に追加された枝の重みを用いる．
+      Sum,   ///< 重みの和を用いる．
+      Min,   ///< 重みの最小値を用いる．
+      Max    ///< 重みの最大値を用いる．
+    };
+
+    /// @brief 重複した枝の重みをまとめる方法
+    ///
+    /// 重みを持たないグラフは Sum 以外なら重みを持たないままとなる．
+    Combine combine{Combine::Max};
+
+    /// @brief true の時セルフループを取り除く．
+    bool remove_self_loop{false};
+
+    /// @brief スレッド数
+    ///
+    /// 0 以下の場合はハードウェアの並列度を用いる．
+    int thread_num{0};
+  };
+
+  /// @brief canonicalize() の結果を表す構造体
+  struct CanonicalizeStats
+  {
+    /// @brief まとめられて取り除かれた重複した枝の数
+    SizeType duplicate_num{0};
+
+    /// @brief セルフループの数(重複を除く)
+    ///
+    /// remove_self_loop が true の場合は取り除いた数となる．
+    SizeType self_loop_num{0};
+  };
+
 
 public:
 
@@ -65,6 +654,14 @@ public:
   UdGraph(SizeType node_num,
 	  const vector<Edge>& edge_list = vector<Edge>{});
 
+  /// @brief コンストラクタ
+  /// @param[in] node_num ノード数
+  /// @param[in] edge_list 枝のリスト
+  ///
+  /// edge_list の中身を引き取るのでコピーは生じない．
+  UdGraph(SizeType node_num,
+	  vector<Edge>&& edge_list);
+
   /// @brief コピーコンストラクタ
   UdGraph(const UdGraph& src) = default;
 
@@ -106,6 +703,91 @@ public:
 	   int id2,
 	   int weight = 1);
 
+  /// @brief 枝をまとめて追加する．
+  /// @param[in] edge_array 枝の配列の先頭
+  /// @param[in] num 枝数
+  ///
+  /// - 端点の正規化と範囲チェックは追加した枝に対してまとめて1回行う．
+  /// - 重複チェックは行わない．
+  void
+  add_edges(const Edge* edge_array,
+	    SizeType num);
+
+  /// @brief 枝をまとめて追加する．
+  /// @param[in] edge_list 枝のリスト
+  void
+  add_edges(const vector<Edge>& edge_list);
+
+  /// @brief 圧縮形式の枝のリストを設定する．
+  /// @param[in] pair_list 両端のノード番号の対のリスト
+  /// @param[in] weight_list 重みのリスト
+  ///
+  /// - 以前の枝はクリアされ，圧縮形式となる．
+  /// - pair_list と weight_list の中身は引き取るのでコピーは生じない．
+  /// - weight_list が空の場合は全ての重みが 1 となる．
+  ///   そうでなければ pair_list と同じ大きさでなければならない．
+  void
+  assign(vector<NodePair>&& pair_list,
+	 vector<int>&& weight_list = vector<int>{});
+
+  /// @brief ノードの重みを設定する．
+  /// @param[in] id ノード番号 ( 0 <= id < node_num() )
+  /// @param[in] weight 重み
+  ///
+  /// - 設定していないノードの重みは 1 となる．
+  /// - 重みを用いるのは "weighted" の max_clique() と independent_set()
+  ///   のみで，重みが 0 以下のノードは選ばれない．
+  void
+  set_node_weight(int id,
+		  int weight);
+
+  /// @brief 全てのノードの重みを設定する．
+  /// @param[in] weight_list 重みのリスト
+  ///
+  /// weight_list が空の場合は全ての重みが 1 となる．
+  /// そうでなければ node_num() と同じ大きさでなければならない．
+  void
+  set_node_weight_list(const vector<int>& weight_list);
+
+  /// @brief 枝を圧縮形式で持つようにする．
+  ///
+  /// - 枝を NodePair の配列で持ち，重みは 1 以外の重みがある時だけ
+  ///   別の配列で持つ．1枝あたり 12 バイトが 8 バイトになる．
+  /// - 圧縮形式では edge() と edge_list() は使えない．
+  ///   代わりに edge_view() か node_pair_list() と weight_list() を用いる．
+  /// - 枝番号は変わらない．
+  void
+  pack();
+
+  /// @brief 枝を非圧縮形式(Edge の配列)で持つようにする．
+  void
+  unpack();
+
+  /// @brief 枝数の分だけ領域を確保する．
+  /// @param[in] edge_num 枝数
+  void
+  reserve(SizeType edge_num);
+
+  /// @brief 余分な領域を解放する．
+  void
+  shrink_to_fit();
+
+  /// @brief 既定のオプションで枝を正規形にする．
+  /// @return 重複した枝とセルフループの数を返す．
+  CanonicalizeStats
+  canonicalize();
+
+  /// @brief 枝を正規形にする．
+  /// @param[in] options オプション
+  /// @return 重複した枝とセルフループの数を返す．
+  ///
+  /// - 枝を (id1, id2) の昇順に並べ替え，重複した枝を一つにまとめる．
+  /// - 並べ替えには並列の基数ソートを用いる．
+  /// - 枝番号は変わる．
+  /// - 正規形のグラフから作った隣接リストは昇順で重複を含まない．
+  CanonicalizeStats
+  canonicalize(const CanonicalizeOptions& options);
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -126,9 +808,45 @@ public:
   bool
   is_reflective() const;
 
+  /// @brief 正規形の時 true を返す．
+  ///
+  /// - canonicalize() を呼んだ後で枝を追加していなければ true となる．
+  /// - 枝のないグラフも正規形である．
+  bool
+  is_canonical() const;
+
+  /// @brief 枝を圧縮形式で持つ時 true を返す．
+  bool
+  is_packed() const;
+
+  /// @brief 重みを持つ時 true を返す．
+  ///
+  /// 圧縮形式では重みが全て 1 の場合は重みの配列を持たない．
+  bool
+  is_weighted() const;
+
+  /// @brief ノードの重みを持つ時 true を返す．
+  ///
+  /// 重みが全て 1 の場合は重みの配列を持たない．
+  bool
+  is_node_weighted() const;
+
+  /// @brief ノードの重みを返す．
+  /// @param[in] id ノード番号 ( 0 <= id < node_num() )
+  int
+  node_weight(int id) const;
+
+  /// @brief 全てのノードの重みのリストを返す．
+  ///
+  /// is_node_weighted() が false の場合は空となる．
+  const vector<int>&
+  node_weight_list() const;
+
   /// @brief 枝の情報を返す．
   /// @param[in] idx 枝番号 ( 0 <= idx < edge_num() )
   /// @return 枝を返す．
+  ///
+  /// 圧縮形式では使えない．
   const Edge&
   edge(int idx) const;
 
@@ -152,9 +870,28 @@ public:
   edge_weight(int idx) const;
 
   /// @brief 全ての枝のリストを返す．
+  ///
+  /// 圧縮形式では使えない．
   const vector<Edge>&
   edge_list() const;
 
+  /// @brief 格納形式によらずに全ての枝をなめるためのリストを返す．
+  EdgeView
+  edge_view() const;
+
+  /// @brief 全ての枝の両端のノード番号の対のリストを返す．
+  ///
+  /// 圧縮形式でのみ使える．
+  const vector<NodePair>&
+  node_pair_list() const;
+
+  /// @brief 全ての枝の重みのリストを返す．
+  ///
+  /// - 圧縮形式でのみ使える．
+  /// - is_weighted() が false の場合は空となる．
+  const vector<int>&
+  weight_list() const;
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -165,7 +902,8 @@ public:
   /// @param[in] s 入力のストリーム
   /// @return 読み込んだグラフを返す．
   ///
-  /// 枝の重みは全て1になる．
+  /// - 枝の重みは全て1になる．
+  /// - "n ノード番号 重み" の行があればノードの重みを設定する．
   static
   UdGraph
   read_dimacs(istream& s);
@@ -174,7 +912,8 @@ public:
   /// @param[in] filename 入力のファイル名
   /// @return 読み込んだグラフを返す．
   ///
-  /// 枝の重みは全て1になる．
+  /// - 枝の重みは全て1になる．
+  /// - "n ノード番号 重み" の行があればノードの重みを設定する．
   static
   UdGraph
   read_dimacs(const string& filename);
@@ -182,14 +921,16 @@ public:
   /// @brief 内容を DIMACS 形式で出力する．
   /// @param[in] s 出力のストリーム
   ///
-  /// 枝の重みは無視される．
+  /// - 枝の重みは無視される．
+  /// - ノードの重みを持つ場合は "n" 行として出力する．
   void
   write_dimacs(ostream& s) const;
 
   /// @brief 内容を DIMACS 形式で出力する．
   /// @param[in] filename ファイル名
   ///
-  /// 枝の重みは無視される．
+  /// - 枝の重みは無視される．
+  /// - ノードの重みを持つ場合は "n" 行として出力する．
   void
   write_dimacs(const string& filename) const;
 
@@ -229,27 +970,256 @@ public:
   /// @param[in] algorithm アルゴリズム名
   /// @return 彩色数とノードに対する彩色結果(=int)を収める配列(vector)を返す．
   ///
-  /// 結果の配列のサイズは node_num()
+  /// - 結果の配列のサイズは node_num()
+  /// - algorithm には "dsatur", "iscov", "isx", "isx2", "tabucol", "hea",
+  ///   "portfolio", "parallel-greedy", "parallel-greedy-jp" が指定できる．
+  ///   それ以外の場合は "dsatur" となる．
+  /// - "portfolio" は複数のアルゴリズムを並列に実行し，最良の結果を返す．
+  /// - "parallel-greedy" は全ノードを並列に仮に彩色して衝突を直す
+  ///   (Gebremedhin-Manne)．"parallel-greedy-jp" は Jones-Plassmann 法で
+  ///   並列に彩色する．いずれも大きなグラフの最初の彩色に向く．
+  /// - "tabucol", "hea", "portfolio" は彩色数の下界を求め，
+  ///   彩色数が下界に達した時点で探索を打ち切る．
   pair<int, vector<int>>
   coloring(const string& algorithm = string()) const;
 
+  /// @brief オプションを指定して彩色問題を解く
+  /// @param[in] algorithm アルゴリズム名
+  /// @param[in] options オプション
+  /// @return 彩色数とノードに対する彩色結果(=int)を収める配列(vector)を返す．
+  pair<int, vector<int>>
+  coloring(const string& algorithm,
+	   const ColoringOptions& options) const;
+
+  /// @brief オプションを指定して彩色問題を解く
+  /// @param[in] algorithm アルゴリズム名
+  /// @param[in] options オプション
+  /// @param[out] stats 実行結果に関する情報
+  /// @return 彩色数とノードに対する彩色結果(=int)を収める配列(vector)を返す．
+  pair<int, vector<int>>
+  coloring(const string& algorithm,
+	   const ColoringOptions& options,
+	   ColoringStats& stats) const;
+
   /// @brief (最大)独立集合を求める．
   /// @param[in] algorithm アルゴリズム名
+  /// @param[in] reorder ノードの並べ替えの方法(空なら並べ替えない)
   /// return 独立集合の要素(ノード番号)を収める配列を返す．
+  ///
+  /// - algorithm には以下のものが指定できる．
+  ///   それ以外の場合は "greedy" となる．
+  ///   - "greedy" 残っているノードのうち次数最小のものを選んでいく．
+  ///   - "weighted" ノードの重みの和を最大化する局所探索
+  /// - 結果は昇順に並ぶ．
   vector<int>
-  independent_set(const string& algorithm = string()) const;
+  independent_set(const string& algorithm = string(),
+		  const string& reorder = string()) const;
+
+  /// @brief オプションを指定して(最大)独立集合を求める．
+  /// @param[in] algorithm アルゴリズム名
+  /// @param[in] options オプション
+  /// @return 独立集合の要素(ノード番号)を収める配列を返す．
+  vector<int>
+  independent_set(const string& algorithm,
+		  const NodeSetOptions& options) const;
+
+  /// @brief オプションを指定して(最大)独立集合を求める．
+  /// @param[in] algorithm アルゴリズム名
+  /// @param[in] options オプション
+  /// @param[out] stats 実行結果に関する情報
+  /// @return 独立集合の要素(ノード番号)を収める配列を返す．
+  vector<int>
+  independent_set(const string& algorithm,
+		  const NodeSetOptions& options,
+		  NodeSetStats& stats) const;
 
   /// @brief (最大)クリークを求める．
   /// @param[in] algorithm アルゴリズム名
+  /// @param[in] reorder ノードの並べ替えの方法(空なら並べ替えない)
   /// @return クリークの要素(ノード番号)を収める配列を返す．
+  ///
+  /// algorithm には以下のものが指定できる．
+  /// それ以外の場合は "greedy" となる．
+  /// - "greedy" 貪欲法
+  /// - "exact" 分枝限定法(分枝数に上限がある)
+  /// - "weighted" ノードの重みの和を最大化する分枝限定法．
+  ///   上界には重みを分割する彩色を用いる．
   vector<int>
-  max_clique(const string& algorithm = string()) const;
+  max_clique(const string& algorithm = string(),
+	     const string& reorder = string()) const;
+
+  /// @brief (最大)クリークを求める．
+  /// @param[in] algorithm アルゴリズム名
+  /// @param[in] reorder ノードの並べ替えの方法(空なら並べ替えない)
+  /// @param[out] stats 性能計測用のカウンタ
+  /// @return クリークの要素(ノード番号)を収める配列を返す．
+  vector<int>
+  max_clique(const string& algorithm,
+	     const string& reorder,
+	     PerfStats& stats) const;
+
+  /// @brief オプションを指定して(最大)クリークを求める．
+  /// @param[in] algorithm アルゴリズム名
+  /// @param[in] options オプション
+  /// @return クリークの要素(ノード番号)を収める配列を返す．
+  vector<int>
+  max_clique(const string& algorithm,
+	     const NodeSetOptions& options) const;
+
+  /// @brief オプションを指定して(最大)クリークを求める．
+  /// @param[in] algorithm アルゴリズム名
+  /// @param[in] options オプション
+  /// @param[out] stats 実行結果に関する情報
+  /// @return クリークの要素(ノード番号)を収める配列を返す．
+  vector<int>
+  max_clique(const string& algorithm,
+	     const NodeSetOptions& options,
+	     NodeSetStats& stats) const;
+
+  /// @brief 極大クリークを列挙する．
+  /// @param[in] callback 極大クリークを受け取る関数
+  /// @return 報告したクリーク数を返す．
+  ///
+  /// - 縮退度の順に根のノードを選び，Tomita のピボット選択付きの
+  ///   Bron-Kerbosch 法で列挙する(Eppstein-Löffler-Strash)．
+  /// - クリークは見つかるたびに callback に渡され，保持されない．
+  /// - callback が空の場合は数えるだけとなる．
+  /// - セルフループと重複した枝は無視される．
+  SizeType
+  enum_maximal_cliques(const CliqueCallback& callback) const;
+
+  /// @brief オプションを指定して極大クリークを列挙する．
+  /// @param[in] options オプション
+  /// @param[in] callback 極大クリークを受け取る関数
+  /// @return 報告したクリーク数を返す．
+  ///
+  /// - 根のノードごとに並列に列挙する．
+  /// - callback が同時に呼ばれることはないが，呼ぶスレッドと順番は
+  ///   一定ではない．
+  SizeType
+  enum_maximal_cliques(const CliqueEnumOptions& options,
+		       const CliqueCallback& callback) const;
+
+  /// @brief オプションを指定して極大クリークを列挙する．
+  /// @param[in] options オプション
+  /// @param[in] callback 極大クリークを受け取る関数
+  /// @param[out] stats 実行結果に関する情報
+  /// @return 報告したクリーク数を返す．
+  SizeType
+  enum_maximal_cliques(const CliqueEnumOptions& options,
+		       const CliqueCallback& callback,
+		       CliqueEnumStats& stats) const;
 
   /// @brief 最大重みマッチングを求める．
   /// @param[in] algorithm アルゴリズム名
+  /// @param[in] reorder ノードの並べ替えの方法(空なら並べ替えない)
   /// @return マッチングに選ばれた枝番号のリストを返す．
+  ///
+  /// - algorithm には増加路を探す前の初期解の求め方として "greedy",
+  ///   "karp-sipser", "local-dominant", "suitor" が指定できる．
+  ///   それ以外の場合は "greedy" となる．
+  /// - "local-dominant", "suitor" は複数のスレッドで初期解を求める．
+  /// - "approx-parallel" は Suitor 法の解(1/2 近似)をそのまま返す．
+  ///   連結成分への分割も行わないので巨大なグラフ向けである．
+  /// - 自己ループはどのアルゴリズムでも選ばれない．
+  vector<int>
+  max_matching(const string& algorithm = string(),
+	       const string& reorder = string()) const;
+
+  /// @brief 最大重みマッチングを求める．
+  /// @param[in] algorithm アルゴリズム名
+  /// @param[in] reorder ノードの並べ替えの方法(空なら並べ替えない)
+  /// @param[out] stats 性能計測用のカウンタ
+  /// @return マッチングに選ばれた枝番号のリストを返す．
+  vector<int>
+  max_matching(const string& algorithm,
+	       const string& reorder,
+	       PerfStats& stats) const;
+
+  /// @brief オプションを指定して最大重みマッチングを求める．
+  /// @param[in] algorithm アルゴリズム名
+  /// @param[in] options オプション
+  /// @return マッチングに選ばれた枝番号のリストを返す．
+  vector<int>
+  max_matching(const string& algorithm,
+	       const MatchingOptions& options) const;
+
+  /// @brief オプションを指定して最大重みマッチングを求める．
+  /// @param[in] algorithm アルゴリズム名
+  /// @param[in] options オプション
+  /// @param[out] stats 実行結果に関する情報
+  /// @return マッチングに選ばれた枝番号のリストを返す．
+  vector<int>
+  max_matching(const string& algorithm,
+	       const MatchingOptions& options,
+	       MatchingStats& stats) const;
+
+  /// @brief 作業領域を指定して最大重みマッチングを求める．
+  /// @param[in] algorithm アルゴリズム名
+  /// @param[in] options オプション
+  /// @param[out] stats 実行結果に関する情報
+  /// @param[in] work 作業領域
+  /// @return マッチングに選ばれた枝番号のリストを返す．
+  ///
+  /// 同じ work を使い回すと作業領域のメモリ確保が省ける．
   vector<int>
-  max_matching(const string& algorithm = string()) const;
+  max_matching(const string& algorithm,
+	       const MatchingOptions& options,
+	       MatchingStats& stats,
+	       MatchingWork& work) const;
+
+  /// @brief コア分解を行う．
+  /// @param[out] core_num 各ノードのコア数を収める配列
+  /// @return 縮退度(degeneracy)を返す．
+  ///
+  /// - core_num のサイズは node_num() となる．
+  /// - core_num[i] はノード i を含む k-core の最大の k である．
+  /// - ノード i を含むクリークの要素数は core_num[i] + 1 以下となる．
+  int
+  core_decomposition(vector<int>& core_num) const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // ノード番号の付け替えを行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノードの並べ替え順を求める．
+  /// @param[in] method 並べ替えの方法
+  /// @return 新しい順に元のノード番号を並べたリストを返す．
+  ///
+  /// method には以下のものが指定できる．それ以外の場合は元の順番となる．
+  /// - "degree" 次数の降順
+  /// - "rcm" reverse Cuthill-McKee 順
+  /// - "gorder" Gorder (Wei et al.) による順
+  /// - "degeneracy" 次数最小のノードを取り除いていった順
+  ///   (逆順が smallest-last 順となる)
+  vector<int>
+  node_order(const string& method) const;
+
+  /// @brief ノード番号を付け替えたグラフを返す．
+  /// @param[in] order 新しい順に元のノード番号を並べたリスト
+  /// @return 新しいグラフを返す．
+  ///
+  /// - order は node_order() の結果などの置換でなければならない．
+  /// - 新しいグラフのノード i は元のグラフのノード order[i] に対応する．
+  /// - 枝番号は変わらない．
+  UdGraph
+  relabel(const vector<int>& order) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief begin 番目以降の枝を正規化する．
+  /// @param[in] begin 開始位置
+  ///
+  /// - id1 <= id2 となるように両端を入れ替える．
+  /// - ノード番号の範囲チェックを行う．
+  void
+  normalize(SizeType begin);
 
 
 private:
@@ -263,6 +1233,28 @@ private:
   // 枝の実体の配列
   vector<Edge> mEdgeList;
 
+  // 圧縮形式の枝の両端のノード番号の対の配列
+  vector<NodePair> mPairList;
+
+  // 圧縮形式の枝の重みの配列
+  //
+  // 重みが全て 1 の場合は空とする．
+  vector<int> mWeightList;
+
+  // ノードの重みの配列
+  //
+  // 重みが全て 1 の場合は空とする．
+  vector<int> mNodeWeightList;
+
+  // 正規形の時 true となるフラグ
+  bool mCanonical{true};
+
+  // 圧縮形式の時 true となるフラグ
+  bool mPacked{false};
+
+  // 非圧縮形式で 1 以外の重みを持つ時 true となるフラグ
+  bool mWeighted{false};
+
 };
 
 
@@ -280,6 +1272,11 @@ UdGraph::resize(SizeType node_num)
 {
   mNodeNum = node_num;
   mEdgeList.clear();
+  mPairList.clear();
+  mWeightList.clear();
+  mNodeWeightList.clear();
+  mCanonical = true;
+  mWeighted = false;
 }
 
 // @brief 枝を追加する．
@@ -301,7 +1298,84 @@ UdGraph::add_edge(int id1,
   if ( id1 > id2 ) {
     swap(id1, id2);
   }
-  mEdgeList.push_back({id1, id2, weight});
+  if ( is_packed() ) {
+    if ( weight != 1 || is_weighted() ) {
+      // 初めて 1 以外の重みが現れた時はそれまでの枝の重みを 1 で埋める．
+      mWeightList.resize(mPairList.size(), 1);
+      mWeightList.push_back(weight);
+    }
+    mPairList.push_back({static_cast<std::uint32_t>(id1),
+			 static_cast<std::uint32_t>(id2)});
+  }
+  else {
+    mEdgeList.push_back({id1, id2, weight});
+    mWeighted = mWeighted || weight != 1;
+  }
+  mCanonical = false;
+}
+
+// @brief 枝をまとめて追加する．
+// @param[in] edge_list 枝のリスト
+inline
+void
+UdGraph::add_edges(const vector<Edge>& edge_list)
+{
+  add_edges(edge_list.data(), edge_list.size());
+}
+
+// @brief ノードの重みを設定する．
+// @param[in] id ノード番号 ( 0 <= id < node_num() )
+// @param[in] weight 重み
+inline
+void
+UdGraph::set_node_weight(int id,
+			 int weight)
+{
+  ASSERT_COND( 0 <= id && id < node_num() );
+
+  if ( weight != 1 || is_node_weighted() ) {
+    // 初めて 1 以外の重みが現れた時は他のノードの重みを 1 で埋める．
+    mNodeWeightList.resize(node_num(), 1);
+    mNodeWeightList[id] = weight;
+  }
+}
+
+// @brief 全てのノードの重みを設定する．
+// @param[in] weight_list 重みのリスト
+inline
+void
+UdGraph::set_node_weight_list(const vector<int>& weight_list)
+{
+  ASSERT_COND( weight_list.empty() || weight_list.size() == node_num() );
+
+  mNodeWeightList = weight_list;
+}
+
+// @brief 枝数の分だけ領域を確保する．
+// @param[in] edge_num 枝数
+inline
+void
+UdGraph::reserve(SizeType edge_num)
+{
+  if ( is_packed() ) {
+    mPairList.reserve(edge_num);
+    if ( is_weighted() ) {
+      mWeightList.reserve(edge_num);
+    }
+  }
+  else {
+    mEdgeList.reserve(edge_num);
+  }
+}
+
+// @brief 余分な領域を解放する．
+inline
+void
+UdGraph::shrink_to_fit()
+{
+  mEdgeList.shrink_to_fit();
+  mPairList.shrink_to_fit();
+  mWeightList.shrink_to_fit();
 }
 
 // @brief ノード数を得る．
@@ -317,7 +1391,65 @@ inline
 SizeType
 UdGraph::edge_num() const
 {
-  return mEdgeList.size();
+  return is_packed() ? mPairList.size() : mEdgeList.size();
+}
+
+// @brief 枝を圧縮形式で持つ時 true を返す．
+inline
+bool
+UdGraph::is_packed() const
+{
+  return mPacked;
+}
+
+// @brief 重みを持つ時 true を返す．
+inline
+bool
+UdGraph::is_weighted() const
+{
+  return is_packed() ? !mWeightList.empty() : mWeighted;
+}
+
+// @brief ノードの重みを持つ時 true を返す．
+inline
+bool
+UdGraph::is_node_weighted() const
+{
+  return !mNodeWeightList.empty();
+}
+
+// @brief ノードの重みを返す．
+// @param[in] id ノード番号 ( 0 <= id < node_num() )
+inline
+int
+UdGraph::node_weight(int id) const
+{
+  ASSERT_COND( 0 <= id && id < node_num() );
+  return mNodeWeightList.empty() ? 1 : mNodeWeightList[id];
+}
+
+// @brief 全てのノードの重みのリストを返す．
+inline
+const vector<int>&
+UdGraph::node_weight_list() const
+{
+  return mNodeWeightList;
+}
+
+// @brief 既定のオプションで枝を正規形にする．
+inline
+UdGraph::CanonicalizeStats
+UdGraph::canonicalize()
+{
+  return canonicalize(CanonicalizeOptions{});
+}
+
+// @brief 正規形の時 true を返す．
+inline
+bool
+UdGraph::is_canonical() const
+{
+  return mCanonical;
 }
 
 // @brief 枝の情報を返す．
@@ -327,6 +1459,7 @@ inline
 const UdGraph::Edge&
 UdGraph::edge(int idx) const
 {
+  ASSERT_COND( !is_packed() );
   ASSERT_COND( 0 <= idx && idx < edge_num() );
   return mEdgeList[idx];
 }
@@ -337,7 +1470,8 @@ inline
 int
 UdGraph::edge_id1(int idx) const
 {
-  return edge(idx).id1;
+  ASSERT_COND( 0 <= idx && idx < edge_num() );
+  return is_packed() ? mPairList[idx].id1 : mEdgeList[idx].id1;
 }
 
 // @brief 枝の端点2を返す．
@@ -346,7 +1480,8 @@ inline
 int
 UdGraph::edge_id2(int idx) const
 {
-  return edge(idx).id2;
+  ASSERT_COND( 0 <= idx && idx < edge_num() );
+  return is_packed() ? mPairList[idx].id2 : mEdgeList[idx].id2;
 }
 
 // @brief 枝の重みを返す．
@@ -355,7 +1490,11 @@ inline
 int
 UdGraph::edge_weight(int idx) const
 {
-  return edge(idx).weight;
+  ASSERT_COND( 0 <= idx && idx < edge_num() );
+  if ( is_packed() ) {
+    return mWeightList.empty() ? 1 : mWeightList[idx];
+  }
+  return mEdgeList[idx].weight;
 }
 
 // @brief 全ての枝のリストを返す．
@@ -363,9 +1502,39 @@ inline
 const vector<UdGraph::Edge>&
 UdGraph::edge_list() const
 {
+  ASSERT_COND( !is_packed() );
   return mEdgeList;
 }
 
+// @brief 格納形式によらずに全ての枝をなめるためのリストを返す．
+inline
+UdGraph::EdgeView
+UdGraph::edge_view() const
+{
+  if ( is_packed() ) {
+    return EdgeView{mPairList, mWeightList};
+  }
+  return EdgeView{mEdgeList};
+}
+
+// @brief 全ての枝の両端のノード番号の対のリストを返す．
+inline
+const vector<UdGraph::NodePair>&
+UdGraph::node_pair_list() const
+{
+  ASSERT_COND( is_packed() );
+  return mPairList;
+}
+
+// @brief 全ての枝の重みのリストを返す．
+inline
+const vector<int>&
+UdGraph::weight_list() const
+{
+  ASSERT_COND( is_packed() );
+  return mWeightList;
+}
+
 END_NAMESPACE_YM_UDGRAPH
 
 BEGIN_NAMESPACE_YM
@@ -0,0 +1,226 @@
+#ifndef ADJINDEX_H
+#define ADJINDEX_H
+
+/// @file AdjIndex.h
+/// @brief AdjIndex のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/UdGraph.h"
+#include "ym/Array.h"
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+//////////////////////////////////////////////////////////////////////
+/// @class AdjIndex AdjIndex.h "AdjIndex.h"
+/// @brief UdGraph の隣接リストを表すクラス
+///
+/// - 全ノードの隣接リストを一つの配列に詰めて持つ(CSR 形式)．
+/// - セルフループは含まない．
+/// - グラフが正規形(UdGraph::is_canonical())なら各隣接リストは
+///   昇順に並んでいて重複を含まない．
+/// - 作成後は変更されないので複数のスレッドから同時に参照してよい．
+//////////////////////////////////////////////////////////////////////
+class AdjIndex
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] graph 対象のグラフ
+  explicit
+  AdjIndex(const UdGraph& graph);
+
+  /// @brief 固定ノードを指定したコンストラクタ
+  /// @param[in] graph 対象のグラフ
+  /// @param[in] fixed_mark 固定ノードの印
+  ///
+  /// 両端が固定ノードの枝は含まない．
+  AdjIndex(const UdGraph& graph,
+	   const vector<bool>& fixed_mark);
+
+  /// @brief デストラクタ
+  ~AdjIndex() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノード数を返す．
+  int
+  node_num() const;
+
+  /// @brief 枝数を返す．
+  int
+  edge_num() const;
+
+  /// @brief 隣接ノード数を返す．
+  /// @param[in] node_id 対象のノード番号 ( 0 <= node_id < node_num() )
+  int
+  degree(int node_id) const;
+
+  /// @brief 隣接するノード番号のリストを返す．
+  /// @param[in] node_id 対象のノード番号 ( 0 <= node_id < node_num() )
+  Array<int>
+  adj_list(int node_id) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容を設定する．
+  /// @param[in] graph 対象のグラフ
+  /// @param[in] fixed_mark 固定ノードの印(空の場合は固定ノードなし)
+  void
+  init(const UdGraph& graph,
+       const vector<bool>& fixed_mark);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ノード数
+  int mNodeNum;
+
+  // 枝数
+  int mEdgeNum;
+
+  // 各ノードの隣接リストの先頭位置
+  // サイズは mNodeNum + 1
+  vector<int> mOffsetArray;
+
+  // 隣接リストの本体
+  // サイズは mEdgeNum * 2
+  vector<int> mBody;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] graph 対象のグラフ
+inline
+AdjIndex::AdjIndex(const UdGraph& graph)
+{
+  init(graph, vector<bool>());
+}
+
+// @brief 固定ノードを指定したコンストラクタ
+// @param[in] graph 対象のグラフ
+// @param[in] fixed_mark 固定ノードの印
+inline
+AdjIndex::AdjIndex(const UdGraph& graph,
+		   const vector<bool>& fixed_mark)
+{
+  ASSERT_COND( fixed_mark.size() == graph.node_num() );
+
+  init(graph, fixed_mark);
+}
+
+// @brief ノード数を返す．
+inline
+int
+AdjIndex::node_num() const
+{
+  return mNodeNum;
+}
+
+// @brief 枝数を返す．
+inline
+int
+AdjIndex::edge_num() const
+{
+  return mEdgeNum;
+}
+
+// @brief 隣接ノード数を返す．
+// @param[in] node_id 対象のノード番号 ( 0 <= node_id < node_num() )
+inline
+int
+AdjIndex::degree(int node_id) const
+{
+  ASSERT_COND( node_id >= 0 && node_id < node_num() );
+
+  return mOffsetArray[node_id + 1] - mOffsetArray[node_id];
+}
+
+// @brief 隣接するノード番号のリストを返す．
+// @param[in] node_id 対象のノード番号 ( 0 <= node_id < node_num() )
+inline
+Array<int>
+AdjIndex::adj_list(int node_id) const
+{
+  ASSERT_COND( node_id >= 0 && node_id < node_num() );
+
+  int* body = const_cast<int*>(mBody.data()) + mOffsetArray[node_id];
+  return Array<int>(body, 0, degree(node_id));
+}
+
+// @brief 内容を設定する．
+// @param[in] graph 対象のグラフ
+// @param[in] fixed_mark 固定ノードの印(空の場合は固定ノードなし)
+inline
+void
+AdjIndex::init(const UdGraph& graph,
+	       const vector<bool>& fixed_mark)
+{
+  mNodeNum = graph.node_num();
+  mOffsetArray.clear();
+  mOffsetArray.resize(mNodeNum + 1, 0);
+
+  // 対象の枝なら true を返す．
+  auto is_target = [&](int id1, int id2) {
+    if ( id1 == id2 ) {
+      // セルフループは無視する．
+      return false;
+    }
+    if ( !fixed_mark.empty() && fixed_mark[id1] && fixed_mark[id2] ) {
+      // 両端が固定ノードの枝も無視する．
+      return false;
+    }
+    return true;
+  };
+
+  // 各ノードの隣接ノード数を数える．
+  mEdgeNum = 0;
+  for ( const auto& edge: graph.edge_view() ) {
+    int id1 = edge.id1;
+    int id2 = edge.id2;
+    if ( is_target(id1, id2) ) {
+      ++ mEdgeNum;
+      ++ mOffsetArray[id1 + 1];
+      ++ mOffsetArray[id2 + 1];
+    }
+  }
+  for ( int i = 0; i < mNodeNum; ++ i ) {
+    mOffsetArray[i + 1] += mOffsetArray[i];
+  }
+
+  // 隣接リストを設定する．
+  mBody.resize(mEdgeNum * 2);
+  vector<int> wpos(mOffsetArray.begin(), mOffsetArray.end() - 1);
+  for ( const auto& edge: graph.edge_view() ) {
+    int id1 = edge.id1;
+    int id2 = edge.id2;
+    if ( is_target(id1, id2) ) {
+      mBody[wpos[id1]] = id2; ++ wpos[id1];
+      mBody[wpos[id2]] = id1; ++ wpos[id2];
+    }
+  }
+}
+
+END_NAMESPACE_YM_UDGRAPH
+
+#endif // ADJINDEX_H
@@ -0,0 +1,96 @@
+#ifndef COREDECOMP_H
+#define COREDECOMP_H
+
+/// @file CoreDecomp.h
+/// @brief CoreDecomp のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/UdGraph.h"
+#include "AdjIndex.h"
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+//////////////////////////////////////////////////////////////////////
+/// @class CoreDecomp CoreDecomp.h "CoreDecomp.h"
+/// @brief コア分解を行うクラス
+///
+/// - 次数最小のノードを取り除くことを繰り返す(Matula-Beck)．
+///   PeelQueue を用いるので O(ノード数 + 枝数) で終わる．
+/// - order() は取り除いた順(degeneracy order)で，各ノードの後ろにある
+///   隣接ノード数は degeneracy() 以下となる．逆順が smallest-last 順である．
+/// - core_num() はそのノードを含む k-core の最大の k である．
+///   ノードを含むクリークの要素数は core_num() + 1 以下となる．
+/// - 正規形でないグラフの重複した枝は一本として数える．
+//////////////////////////////////////////////////////////////////////
+class CoreDecomp
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] adj_index 隣接リスト
+  explicit
+  CoreDecomp(const AdjIndex& adj_index);
+
+  /// @brief デストラクタ
+  ~CoreDecomp() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 取り除いた順にノード番号を並べたリストを返す．
+  const vector<int>&
+  order() const
+  {
+    return mOrder;
+  }
+
+  /// @brief ノードのコア数を返す．
+  /// @param[in] node_id ノード番号
+  int
+  core_num(int node_id) const
+  {
+    return mCoreNum[node_id];
+  }
+
+  /// @brief 全ノードのコア数のリストを返す．
+  const vector<int>&
+  core_num_list() const
+  {
+    return mCoreNum;
+  }
+
+  /// @brief 縮退度(コア数の最大値)を返す．
+  int
+  degeneracy() const
+  {
+    return mDegeneracy;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 取り除いた順のノード番号のリスト
+  vector<int> mOrder;
+
+  // 各ノードのコア数
+  vector<int> mCoreNum;
+
+  // 縮退度
+  int mDegeneracy{0};
+
+};
+
+END_NAMESPACE_YM_UDGRAPH
+
+#endif // COREDECOMP_H
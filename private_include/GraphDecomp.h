@@ -0,0 +1,193 @@
+#ifndef GRAPHDECOMP_H
+#define GRAPHDECOMP_H
+
+/// @file GraphDecomp.h
+/// @brief GraphDecomp のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/UdGraph.h"
+#include <cstdint>
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+//////////////////////////////////////////////////////////////////////
+/// @class GraphDecomp GraphDecomp.h "GraphDecomp.h"
+/// @brief UdGraph を連結成分ごとに分割するクラス
+///
+/// - 連結成分は union-find で求める．
+/// - ノード数が batch_size 以上の連結成分はそれ単独で一つの部分グラフとなる．
+/// - それより小さい連結成分はノード数が batch_size に達するまで
+///   まとめて一つの部分グラフとする．
+/// - 部分グラフはノード数の降順に並ぶ．
+/// - 部分グラフのノード番号，枝番号の順序は元のグラフと同じなので
+///   枝の id1 <= id2 の関係も保たれる．
+/// - ノードの重みも部分グラフに引き継がれる．
+/// - 部分グラフが一つしかない場合は部分グラフは作らない．
+///   この場合は元のグラフをそのまま用いること．
+/// - 部分グラフを並列に解く場合，part_thread_num() で大きさに比例した
+///   スレッド数を割り当てる．巨大な連結成分と孤立ノードからなるグラフでも
+///   巨大な連結成分の中の並列化が損なわれないようにするためである．
+//////////////////////////////////////////////////////////////////////
+class GraphDecomp
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] graph 対象のグラフ
+  /// @param[in] batch_size 小さな連結成分をまとめる時のノード数
+  explicit
+  GraphDecomp(const UdGraph& graph,
+	      int batch_size = 1024);
+
+  /// @brief デストラクタ
+  ~GraphDecomp() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 連結成分数を返す．
+  int
+  component_num() const;
+
+  /// @brief 部分グラフ数を返す．
+  int
+  part_num() const;
+
+  /// @brief 部分グラフを返す．
+  /// @param[in] pos 位置番号 ( 0 <= pos < part_num() )
+  ///
+  /// part_num() == 1 の場合は使えない．
+  const UdGraph&
+  part_graph(int pos) const;
+
+  /// @brief 部分グラフのノード番号から元のノード番号への写像を返す．
+  /// @param[in] pos 位置番号 ( 0 <= pos < part_num() )
+  ///
+  /// part_num() == 1 の場合は使えない．
+  const vector<int>&
+  node_map(int pos) const;
+
+  /// @brief 部分グラフの枝番号から元の枝番号への写像を返す．
+  /// @param[in] pos 位置番号 ( 0 <= pos < part_num() )
+  ///
+  /// part_num() == 1 の場合は使えない．
+  const vector<int>&
+  edge_map(int pos) const;
+
+  /// @brief 部分グラフを解く時に用いるスレッド数を返す．
+  /// @param[in] pos 位置番号 ( 0 <= pos < part_num() )
+  /// @param[in] thread_num 全体のスレッド数
+  ///
+  /// - 部分グラフの大きさ(ノード数 + 枝数)に比例して thread_num を割り振る．
+  /// - 最低でも 1 となるので，合計は thread_num を少し超えることがある．
+  int
+  part_thread_num(int pos,
+		  int thread_num) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 連結成分数
+  int mComponentNum{0};
+
+  // 部分グラフ数
+  int mPartNum{0};
+
+  // 元のグラフのノード数 + 枝数
+  std::int64_t mTotalSize{0};
+
+  // 部分グラフのリスト
+  vector<UdGraph> mPartGraphList;
+
+  // 部分グラフごとのノード番号の写像
+  vector<vector<int>> mNodeMapList;
+
+  // 部分グラフごとの枝番号の写像
+  vector<vector<int>> mEdgeMapList;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 連結成分数を返す．
+inline
+int
+GraphDecomp::component_num() const
+{
+  return mComponentNum;
+}
+
+// @brief 部分グラフ数を返す．
+inline
+int
+GraphDecomp::part_num() const
+{
+  return mPartNum;
+}
+
+// @brief 部分グラフを返す．
+// @param[in] pos 位置番号 ( 0 <= pos < part_num() )
+inline
+const UdGraph&
+GraphDecomp::part_graph(int pos) const
+{
+  ASSERT_COND( 0 <= pos && pos < mPartGraphList.size() );
+
+  return mPartGraphList[pos];
+}
+
+// @brief 部分グラフのノード番号から元のノード番号への写像を返す．
+// @param[in] pos 位置番号 ( 0 <= pos < part_num() )
+inline
+const vector<int>&
+GraphDecomp::node_map(int pos) const
+{
+  ASSERT_COND( 0 <= pos && pos < mNodeMapList.size() );
+
+  return mNodeMapList[pos];
+}
+
+// @brief 部分グラフの枝番号から元の枝番号への写像を返す．
+// @param[in] pos 位置番号 ( 0 <= pos < part_num() )
+inline
+const vector<int>&
+GraphDecomp::edge_map(int pos) const
+{
+  ASSERT_COND( 0 <= pos && pos < mEdgeMapList.size() );
+
+  return mEdgeMapList[pos];
+}
+
+// @brief 部分グラフを解く時に用いるスレッド数を返す．
+// @param[in] pos 位置番号 ( 0 <= pos < part_num() )
+// @param[in] thread_num 全体のスレッド数
+inline
+int
+GraphDecomp::part_thread_num(int pos,
+			     int thread_num) const
+{
+  const auto& graph = part_graph(pos);
+  std::int64_t size = graph.node_num() + graph.edge_num();
+  // 四捨五入する．
+  auto nt = (thread_num * size + mTotalSize / 2) / mTotalSize;
+  return std::max(static_cast<int>(nt), 1);
+}
+
+END_NAMESPACE_YM_UDGRAPH
+
+#endif // GRAPHDECOMP_H
@@ -0,0 +1,571 @@
+#ifndef MATCHINIT_H
+#define MATCHINIT_H
+
+/// @file MatchInit.h
+/// @brief マッチングの初期解を求める関数のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// いずれの関数も最大マッチングの作業領域(MgWork)を対象とするテンプレートで，
+/// Work は以下の関数を持つものとする．
+/// - int node_num()
+/// - Node* node(int pos)
+/// - int node_index(const Node* node)
+/// - Edge* edge(int id)
+/// - const vector<Edge*>& edge_list() (重みの降順に並んでいるものとする)
+/// - void select_edge(Edge* edge)
+///
+/// ノードは mate と edge_list() を，枝は id, node1, node2, weight と
+/// alt_node() を持つ．
+/// 戻り値はいずれも新たに選んだ枝の数となる．
+/// 自己ループはいずれの関数も選ばない．
+
+
+#include "ym_config.h"
+#include "ThreadPool.h"
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM
+
+//////////////////////////////////////////////////////////////////////
+/// @brief 重みの降順に両端が選択されていない枝を選ぶ．
+/// @param[in] work 作業領域
+/// @return 選んだ枝の数を返す．
+//////////////////////////////////////////////////////////////////////
+template<class Work>
+int
+greedy_matching(Work& work);
+
+//////////////////////////////////////////////////////////////////////
+/// @brief Karp-Sipser 法で初期解を求める．
+/// @param[in] work 作業領域
+/// @return 選んだ枝の数を返す．
+///
+/// - 選ばれていない隣接ノードが1つしかないノードがあれば
+///   その枝を選ぶ(これは要素数最大の解を損なわない)．
+/// - ただし重みの和も損なわないように，相手のノードの残りの枝の中で
+///   最も重い場合に限る．
+/// - そのようなノードがなければ残りの枝のうち最も重いものを選ぶ．
+//////////////////////////////////////////////////////////////////////
+template<class Work>
+int
+karp_sipser_matching(Work& work);
+
+//////////////////////////////////////////////////////////////////////
+/// @brief 局所的に最も重い枝を並列に選んで初期解を求める．
+/// @param[in] work 作業領域
+/// @param[in] thread_num スレッド数(0 以下の場合はハードウェアの並列度)
+/// @return 選んだ枝の数を返す．
+///
+/// - 各ノードは選ばれていない隣接ノードへの最も重い枝を候補とする．
+///   重みが等しい場合は枝番号の小さい方を優先する．
+/// - 両端の候補が一致する枝を選ぶ．
+/// - 候補の相手が選ばれたノードだけ候補を求め直す．
+/// - 結果は greedy_matching() と同じく 1/2 近似となる．
+//////////////////////////////////////////////////////////////////////
+template<class Work>
+int
+local_dominant_matching(Work& work,
+			int thread_num);
+
+//////////////////////////////////////////////////////////////////////
+/// @brief Suitor 法で初期解を並列に求める．
+/// @param[in] work 作業領域
+/// @param[in] thread_num スレッド数(0 以下の場合はハードウェアの並列度)
+/// @return 選んだ枝の数を返す．
+///
+/// - 各ノードは自分を求める相手(suitor)の枝よりも重い枝を持つ
+///   隣接ノードのうち最も重いものに求婚する．
+///   追い出されたノードは次の相手を探す．
+/// - 各ノードの suitor は (重み, 枝番号) を詰めた 64 ビットの値で持ち，
+///   compare-and-swap で更新するのでロックは用いない．
+/// - 隣接リストを重い順に並べておき，各ノードは前回の続きから調べる．
+/// - 互いに suitor となっている枝を選ぶ．
+///   結果は local_dominant_matching() と同じく 1/2 近似となる．
+/// - 重みが 0 以下の枝と自己ループは選ばない．
+//////////////////////////////////////////////////////////////////////
+template<class Work>
+int
+suitor_matching(Work& work,
+		int thread_num);
+
+//////////////////////////////////////////////////////////////////////
+/// @brief アルゴリズム名を指定して初期解を求める．
+/// @param[in] work 作業領域
+/// @param[in] algorithm アルゴリズム名
+/// @param[in] thread_num スレッド数(0 以下の場合はハードウェアの並列度)
+/// @return 選んだ枝の数を返す．
+///
+/// algorithm には "greedy", "karp-sipser", "local-dominant", "suitor" が
+/// 指定できる．
+/// それ以外の場合は "greedy" となる．
+//////////////////////////////////////////////////////////////////////
+template<class Work>
+int
+init_matching(Work& work,
+	      const string& algorithm,
+	      int thread_num);
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 重みの降順に両端が選択されていない枝を選ぶ．
+// @param[in] work 作業領域
+// @return 選んだ枝の数を返す．
+template<class Work>
+int
+greedy_matching(Work& work)
+{
+  int n = 0;
+  for ( auto edge: work.edge_list() ) {
+    if ( edge->node1 != edge->node2 &&
+	 edge->node1->mate == nullptr &&
+	 edge->node2->mate == nullptr ) {
+      work.select_edge(edge);
+      ++ n;
+    }
+  }
+  return n;
+}
+
+// @brief Karp-Sipser 法で初期解を求める．
+// @param[in] work 作業領域
+// @return 選んだ枝の数を返す．
+template<class Work>
+int
+karp_sipser_matching(Work& work)
+{
+  using Node = typename Work::Node;
+  using Edge = typename Work::Edge;
+
+  // 自己ループを除いた両端が選ばれていない枝の時 true を返す．
+  auto is_free = [](Edge* edge) {
+    return edge->node1 != edge->node2 &&
+      edge->node1->mate == nullptr &&
+      edge->node2->mate == nullptr;
+  };
+
+  // 選ばれていない隣接ノードへの枝の数
+  int nn = work.node_num();
+  vector<int> deg_array(nn, 0);
+  for ( auto edge: work.edge_list() ) {
+    if ( is_free(edge) ) {
+      ++ deg_array[work.node_index(edge->node1)];
+      ++ deg_array[work.node_index(edge->node2)];
+    }
+  }
+
+  // 次数1のノードのスタック
+  vector<Node*> stack;
+  for ( int i = 0; i < nn; ++ i ) {
+    if ( deg_array[i] == 1 ) {
+      stack.push_back(work.node(i));
+    }
+  }
+
+  int n = 0;
+  // edge を選んで隣接ノードの次数を更新する．
+  auto select = [&](Edge* edge) {
+    work.select_edge(edge);
+    ++ n;
+    for ( auto node: {edge->node1, edge->node2} ) {
+      for ( auto edge1: node->edge_list() ) {
+	auto node1 = edge1->alt_node(node);
+	if ( node1 == node || node1->mate != nullptr ) {
+	  continue;
+	}
+	int& deg = deg_array[work.node_index(node1)];
+	-- deg;
+	if ( deg == 1 ) {
+	  stack.push_back(node1);
+	}
+      }
+    }
+  };
+
+  // 一度選べなくなった枝は再び選べるようにはならないので
+  // 重い枝の候補は先頭から順に一度だけ調べればよい．
+  const auto& edge_list = work.edge_list();
+  auto p = edge_list.begin();
+  for ( ; ; ) {
+    while ( !stack.empty() ) {
+      auto node = stack.back();
+      stack.pop_back();
+      if ( node->mate != nullptr || deg_array[work.node_index(node)] != 1 ) {
+	continue;
+      }
+      Edge* edge = nullptr;
+      for ( auto edge1: node->edge_list() ) {
+	if ( is_free(edge1) ) {
+	  edge = edge1;
+	  break;
+	}
+      }
+      ASSERT_COND( edge != nullptr );
+      // 相手のノードにより重い枝があれば選ばない．
+      auto node1 = edge->alt_node(node);
+      bool heaviest = true;
+      for ( auto edge1: node1->edge_list() ) {
+	if ( is_free(edge1) && edge1->weight > edge->weight ) {
+	  heaviest = false;
+	  break;
+	}
+      }
+      if ( heaviest ) {
+	select(edge);
+      }
+    }
+    while ( p != edge_list.end() && !is_free(*p) ) {
+      ++ p;
+    }
+    if ( p == edge_list.end() ) {
+      break;
+    }
+    select(*p);
+  }
+  return n;
+}
+
+// @brief 局所的に最も重い枝を並列に選んで初期解を求める．
+// @param[in] work 作業領域
+// @param[in] thread_num スレッド数(0 以下の場合はハードウェアの並列度)
+// @return 選んだ枝の数を返す．
+template<class Work>
+int
+local_dominant_matching(Work& work,
+			int thread_num)
+{
+  using Node = typename Work::Node;
+  using Edge = typename Work::Edge;
+
+  // 1スレッドあたりの最小の要素数
+  const int MIN_CHUNK = 1 << 12;
+
+  int nn = work.node_num();
+  int nt_max = ThreadPool::default_thread_num(thread_num);
+  nt_max = std::min(nt_max, (nn + MIN_CHUNK - 1) / MIN_CHUNK);
+  std::unique_ptr<ThreadPool> pool;
+  if ( nt_max > 1 ) {
+    pool.reset(new ThreadPool(nt_max));
+  }
+
+  // 各ノードの候補の枝
+  vector<Edge*> cand_array(nn, nullptr);
+  // 現在の段で候補を求めたノードの印
+  vector<int> active_mark(nn, 0);
+  int round = 0;
+  // スレッドごとの選んだ枝のリスト
+  vector<vector<Edge*>> selected_list(std::max(nt_max, 1));
+
+  // 枝の全順序
+  auto better = [](const Edge* edge1,
+		   const Edge* edge2) {
+    if ( edge2 == nullptr ) {
+      return true;
+    }
+    if ( edge1->weight != edge2->weight ) {
+      return edge1->weight > edge2->weight;
+    }
+    return edge1->id < edge2->id;
+  };
+
+  // 候補を求めるノードのリスト
+  vector<Node*> active_list;
+  for ( int i = 0; i < nn; ++ i ) {
+    auto node = work.node(i);
+    if ( node->mate == nullptr ) {
+      active_list.push_back(node);
+    }
+  }
+
+  // active_list をチャンクに分けて func を適用する．
+  auto for_chunks = [&](const std::function<void(int, int, int)>& func) {
+    int n = active_list.size();
+    int nt = std::min(nt_max, (n + MIN_CHUNK - 1) / MIN_CHUNK);
+    auto body = [&](int t) {
+      func(t, n * t / nt, n * (t + 1) / nt);
+    };
+    if ( pool == nullptr || nt <= 1 ) {
+      func(0, 0, n);
+    }
+    else {
+      pool->parallel_for(nt, body);
+    }
+  };
+
+  int n = 0;
+  while ( !active_list.empty() ) {
+    ++ round;
+    for ( auto node: active_list ) {
+      active_mark[work.node_index(node)] = round;
+    }
+
+    // 候補を求める．
+    // この段では mate は書き換えられない．
+    for_chunks([&](int, int begin, int end) {
+      for ( int i = begin; i < end; ++ i ) {
+	auto node = active_list[i];
+	Edge* best = nullptr;
+	for ( auto edge: node->edge_list() ) {
+	  auto node1 = edge->alt_node(node);
+	  if ( node1 != node && node1->mate == nullptr && better(edge, best) ) {
+	    best = edge;
+	  }
+	}
+	cand_array[work.node_index(node)] = best;
+      }
+    });
+
+    // 両端の候補が一致する枝を集める．
+    // 相手も候補を求め直した場合は番号の小さい方だけが集める．
+    for_chunks([&](int t, int begin, int end) {
+      auto& selected = selected_list[t];
+      for ( int i = begin; i < end; ++ i ) {
+	auto node = active_list[i];
+	int index = work.node_index(node);
+	auto edge = cand_array[index];
+	if ( edge == nullptr ) {
+	  continue;
+	}
+	int index1 = work.node_index(edge->alt_node(node));
+	if ( cand_array[index1] == edge &&
+	     (index < index1 || active_mark[index1] != round) ) {
+	  selected.push_back(edge);
+	}
+      }
+    });
+
+    // 選んだ枝の両端に隣接するノードのうち候補の相手が
+    // 選ばれたものだけを次の段で調べる．
+    active_list.clear();
+    for ( auto& selected: selected_list ) {
+      for ( auto edge: selected ) {
+	work.select_edge(edge);
+	++ n;
+      }
+    }
+    for ( auto& selected: selected_list ) {
+      for ( auto edge: selected ) {
+	for ( auto node: {edge->node1, edge->node2} ) {
+	  for ( auto edge1: node->edge_list() ) {
+	    auto node1 = edge1->alt_node(node);
+	    if ( node1->mate != nullptr ) {
+	      continue;
+	    }
+	    int index1 = work.node_index(node1);
+	    if ( active_mark[index1] == round + 1 ) {
+	      continue;
+	    }
+	    auto cand = cand_array[index1];
+	    if ( cand != nullptr && cand->alt_node(node1)->mate != nullptr ) {
+	      active_list.push_back(node1);
+	      active_mark[index1] = round + 1;
+	    }
+	  }
+	}
+      }
+      selected.clear();
+    }
+  }
+  return n;
+}
+
+// @brief Suitor 法で初期解を並列に求める．
+// @param[in] work 作業領域
+// @param[in] thread_num スレッド数(0 以下の場合はハードウェアの並列度)
+// @return 選んだ枝の数を返す．
+template<class Work>
+int
+suitor_matching(Work& work,
+		int thread_num)
+{
+  using Node = typename Work::Node;
+  using Edge = typename Work::Edge;
+
+  // 1スレッドあたりの最小の要素数
+  const int MIN_CHUNK = 1 << 12;
+  // 枝番号を取り出すマスク
+  const std::uint64_t ID_MASK = 0xFFFFFFFFULL;
+
+  int nn = work.node_num();
+  int nt = ThreadPool::default_thread_num(thread_num);
+  nt = std::min(nt, (nn + MIN_CHUNK - 1) / MIN_CHUNK);
+  std::unique_ptr<ThreadPool> pool;
+  if ( nt > 1 ) {
+    pool.reset(new ThreadPool(nt));
+  }
+  // ノードをチャンクに分けて func を適用する．
+  auto for_chunks = [&](const std::function<void(int, int)>& func) {
+    auto body = [&](int t) {
+      func(static_cast<std::int64_t>(nn) * t / nt,
+	   static_cast<std::int64_t>(nn) * (t + 1) / nt);
+    };
+    if ( pool == nullptr ) {
+      func(0, nn);
+    }
+    else {
+      pool->parallel_for(nt, body);
+    }
+  };
+
+  // 枝の (重み, 枝番号) を詰めた値
+  auto edge_key = [](const Edge* edge) {
+    return (static_cast<std::uint64_t>(edge->weight) << 32) |
+      static_cast<std::uint32_t>(edge->id);
+  };
+
+  // 候補となる枝を重い順に並べた隣接リスト(CSR 形式)
+  // 自己ループと重みが 0 以下の枝は含まない．
+  vector<int> offset_array(nn + 1, 0);
+  for ( int i = 0; i < nn; ++ i ) {
+    auto node = work.node(i);
+    int deg = 0;
+    for ( auto edge: node->edge_list() ) {
+      if ( edge->alt_node(node) != node && edge->weight > 0 ) {
+	++ deg;
+      }
+    }
+    offset_array[i + 1] = offset_array[i] + deg;
+  }
+  vector<Edge*> adj_array(offset_array[nn]);
+  for_chunks([&](int begin, int end) {
+    for ( int i = begin; i < end; ++ i ) {
+      auto node = work.node(i);
+      auto top = adj_array.begin() + offset_array[i];
+      auto p = top;
+      for ( auto edge: node->edge_list() ) {
+	if ( edge->alt_node(node) != node && edge->weight > 0 ) {
+	  *p = edge;
+	  ++ p;
+	}
+      }
+      sort(top, p, [&](const Edge* edge1, const Edge* edge2) {
+	return edge_key(edge1) > edge_key(edge2);
+      });
+    }
+  });
+
+  // 各ノードの suitor の枝の (重み, 枝番号)
+  // 0 は suitor がいないことを表す．
+  vector<std::atomic<std::uint64_t>> suitor_array(nn);
+  for ( auto& suitor: suitor_array ) {
+    suitor.store(0, std::memory_order_relaxed);
+  }
+
+  // 各ノードが次に調べる隣接リストの位置
+  //
+  // suitor の値は増える一方なので一度候補から外れた枝は
+  // 二度と候補にならない．そのため隣接リストは全体で一度しか走査しない．
+  // あるノードを求婚させるスレッドは同時には一つだけなので
+  // 排他制御は要らない．
+  vector<int> cursor_array(offset_array.begin(), offset_array.end() - 1);
+
+  // begin から end の直前までのノードを順に求婚させる．
+  for_chunks([&](int begin, int end) {
+    for ( int i = begin; i < end; ++ i ) {
+      Node* cur = work.node(i);
+      while ( cur != nullptr ) {
+	// 今の suitor より重い枝を持つ隣接ノードのうち最も重いものを探す．
+	int index = work.node_index(cur);
+	int& pos = cursor_array[index];
+	int end_pos = offset_array[index + 1];
+	Node* partner = nullptr;
+	std::uint64_t key = 0;
+	for ( ; pos < end_pos; ++ pos ) {
+	  auto edge = adj_array[pos];
+	  auto node1 = edge->alt_node(cur);
+	  key = edge_key(edge);
+	  auto& suitor = suitor_array[work.node_index(node1)];
+	  if ( key > suitor.load(std::memory_order_relaxed) ) {
+	    partner = node1;
+	    break;
+	  }
+	}
+	if ( partner == nullptr ) {
+	  break;
+	}
+	// いずれにせよこの枝は二度と候補にならない．
+	// CAS に成功すると cur は他のスレッドに追い出されうるので先に進めておく．
+	++ pos;
+	auto& suitor = suitor_array[work.node_index(partner)];
+	auto old_key = suitor.load(std::memory_order_relaxed);
+	bool success = true;
+	while ( !suitor.compare_exchange_weak(old_key, key,
+					      std::memory_order_acq_rel,
+					      std::memory_order_relaxed) ) {
+	  if ( old_key >= key ) {
+	    // 他のスレッドに先を越された．
+	    success = false;
+	    break;
+	  }
+	}
+	if ( !success ) {
+	  continue;
+	}
+	if ( old_key == 0 ) {
+	  cur = nullptr;
+	}
+	else {
+	  // 追い出されたノードが次の相手を探す．
+	  cur = work.edge(old_key & ID_MASK)->alt_node(partner);
+	}
+      }
+    }
+  });
+
+  // 互いに suitor となっている枝を選ぶ．
+  int n = 0;
+  for ( int i = 0; i < nn; ++ i ) {
+    auto key = suitor_array[i].load(std::memory_order_relaxed);
+    if ( key == 0 ) {
+      continue;
+    }
+    auto node = work.node(i);
+    auto edge = work.edge(key & ID_MASK);
+    int index1 = work.node_index(edge->alt_node(node));
+    if ( i < index1 &&
+	 suitor_array[index1].load(std::memory_order_relaxed) == key &&
+	 edge->node1->mate == nullptr &&
+	 edge->node2->mate == nullptr ) {
+      work.select_edge(edge);
+      ++ n;
+    }
+  }
+  return n;
+}
+
+// @brief アルゴリズム名を指定して初期解を求める．
+// @param[in] work 作業領域
+// @param[in] algorithm アルゴリズム名
+// @param[in] thread_num スレッド数(0 以下の場合はハードウェアの並列度)
+// @return 選んだ枝の数を返す．
+template<class Work>
+int
+init_matching(Work& work,
+	      const string& algorithm,
+	      int thread_num)
+{
+  if ( algorithm == "karp-sipser" ) {
+    return karp_sipser_matching(work);
+  }
+  if ( algorithm == "local-dominant" ) {
+    return local_dominant_matching(work, thread_num);
+  }
+  if ( algorithm == "suitor" ) {
+    return suitor_matching(work, thread_num);
+  }
+  // デフォルトフォールバック
+  return greedy_matching(work);
+}
+
+END_NAMESPACE_YM
+
+#endif // MATCHINIT_H
@@ -10,18 +10,38 @@
 
 
 #include "ym/UdGraph.h"
+#include <algorithm>
+#include <cstdint>
 
 
 BEGIN_NAMESPACE_YM_UDGRAPH
 
+//////////////////////////////////////////////////////////////////////
+// このファイルでは同じインターフェイスを持つ3種類のヒープを定義する．
+//
+// - NodeHeap:   ノードへのポインタを並べた D 分木のヒープ
+//               (比較関数で比較し，位置はノード自身に持たせる)
+// - KeyHeap:    キーとノードの対を並べた D 分木のヒープ
+//               (キーを配列に持つので比較の際にノードを参照しない)
+// - BucketHeap: 小さな整数のキーごとのバケツ
+//
+// いずれも empty(), put_node(), bulk_build(), delete_node(), get_min(),
+// update() を持つので，利用側は型の別名を切り替えるだけでよい．
+// どれを用いるかは tests/benchmark/heap_bench.cc の結果で選ぶ．
+//////////////////////////////////////////////////////////////////////
+
+
 //////////////////////////////////////////////////////////////////////
 /// @class NodeHeap NodeHeap.h "NodeHeap.h"
 /// @brief Node のヒープ木
 ///
-/// 比較関数 compare() を実装した継承クラスを作る必要がある．
+/// - 比較関数 compare() を実装した継承クラスを作る必要がある．
+/// - ヒープ上の位置は NodeClass::heap_location() に持たせる．
+/// - D は分岐数で，D = 2 の時は通常の2分ヒープとなる．
 //////////////////////////////////////////////////////////////////////
 template <typename NodeClass,
-	  typename CompFuncClass>
+	  typename CompFuncClass,
+	  int D = 2>
 class NodeHeap
 {
 public:
@@ -47,6 +67,13 @@ public:
   void
   put_node(NodeClass* node);
 
+  /// @brief ノードをまとめて追加する．
+  /// @param[in] node_list ノードのリスト
+  ///
+  /// 全てを積んでから下から順にヒープ化するので O(n) で済む．
+  void
+  bulk_build(const vector<NodeClass*>& node_list);
+
   /// @brief ノードを取り去る．
   void
   delete_node(NodeClass* node);
@@ -107,15 +134,240 @@ private:
 
 
 //////////////////////////////////////////////////////////////////////
-// インライン関数の定義
+/// @class KeyHeap NodeHeap.h "NodeHeap.h"
+/// @brief キーを配列に持つノードのヒープ木
+///
+/// - キーは KeyFuncClass の operator()(const NodeClass*) で求める
+///   std::int64_t で，小さい方が先に取り出される．
+/// - キーとノードの対を一つの配列に詰めて持つので，比較の際に
+///   ノードを参照しない．キーはノードを追加した時と update() の時に求める．
+/// - ヒープ上の位置は NodeClass::id() を添字とする配列で持つ．
+/// - D は分岐数
+//////////////////////////////////////////////////////////////////////
+template <typename NodeClass,
+	  typename KeyFuncClass,
+	  int D = 4>
+class KeyHeap
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] max_size 最大の要素数(ノード番号の上限)
+  /// @param[in] key_func キーを求める関数オブジェクト
+  KeyHeap(int max_size,
+	  KeyFuncClass key_func = KeyFuncClass{});
+
+  /// @brief デストラクタ
+  ~KeyHeap() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ヒープが空の時 true を返す．
+  bool
+  empty() const;
+
+  /// @brief ノードを追加する．
+  void
+  put_node(NodeClass* node);
+
+  /// @brief ノードをまとめて追加する．
+  /// @param[in] node_list ノードのリスト
+  void
+  bulk_build(const vector<NodeClass*>& node_list);
+
+  /// @brief ノードを取り去る．
+  void
+  delete_node(NodeClass* node);
+
+  /// @brief キーが最小の要素を取り出す．
+  /// そのノードはヒープから取り除かれる．
+  NodeClass*
+  get_min();
+
+  /// @brief ノードのキーを求め直してヒープ構造を更新する．
+  /// @param[in] node 値が変更されたノード
+  void
+  update(NodeClass* node);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // ヒープの要素
+  struct Cell
+  {
+    // キー
+    std::int64_t key;
+
+    // ノード
+    NodeClass* node;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief idx の要素を適当な位置まで沈める．
+  void
+  move_down(int idx);
+
+  /// @brief idx の要素を適当な位置まで浮かび上がらせる．
+  void
+  move_up(int idx);
+
+  /// @brief 要素をヒープ上の pos に置く．
+  void
+  locate_cell(const Cell& cell,
+	      int pos);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // キーを求める関数オブジェクト
+  KeyFuncClass mKeyFunc;
+
+  // ヒープ木
+  vector<Cell> mHeap;
+
+  // ノード番号をキーにしてヒープ上の位置を持つ配列
+  // ヒープに含まれない場合は -1
+  vector<int> mPosArray;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class BucketHeap NodeHeap.h "NodeHeap.h"
+/// @brief 小さな整数のキーのためのバケツ構造
+///
+/// - キーは KeyFuncClass の operator()(const NodeClass*) で求める
+///   0 以上 max_key 以下の int で，小さい方が先に取り出される．
+/// - キーごとのバケツを双方向リストで表し，最小のキーのバケツを覚えておく．
+///   get_min() 以外は定数時間で，get_min() はキーの増加分だけ走査する．
+/// - 同じキーのノードは後から入れたものが先に取り出される．
+/// - リストのリンクは NodeClass::id() を添字とする配列で持つ．
+//////////////////////////////////////////////////////////////////////
+template <typename NodeClass,
+	  typename KeyFuncClass>
+class BucketHeap
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] max_size 最大の要素数(ノード番号の上限)
+  /// @param[in] max_key キーの最大値
+  /// @param[in] key_func キーを求める関数オブジェクト
+  BucketHeap(int max_size,
+	     int max_key,
+	     KeyFuncClass key_func = KeyFuncClass{});
+
+  /// @brief デストラクタ
+  ~BucketHeap() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ヒープが空の時 true を返す．
+  bool
+  empty() const;
+
+  /// @brief ノードを追加する．
+  void
+  put_node(NodeClass* node);
+
+  /// @brief ノードをまとめて追加する．
+  /// @param[in] node_list ノードのリスト
+  void
+  bulk_build(const vector<NodeClass*>& node_list);
+
+  /// @brief ノードを取り去る．
+  void
+  delete_node(NodeClass* node);
+
+  /// @brief キーが最小の要素を取り出す．
+  /// そのノードはヒープから取り除かれる．
+  NodeClass*
+  get_min();
+
+  /// @brief ノードのキーを求め直してバケツを移す．
+  /// @param[in] node 値が変更されたノード
+  void
+  update(NodeClass* node);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノードをバケツに入れる．
+  void
+  link(int id,
+       int key);
+
+  /// @brief ノードをバケツから外す．
+  void
+  unlink(int id);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // キーを求める関数オブジェクト
+  KeyFuncClass mKeyFunc;
+
+  // キーごとのリストの先頭のノード番号(空の場合は -1)
+  vector<int> mHead;
+
+  // ノード番号をキーにして次のノード番号を持つ配列
+  vector<int> mNext;
+
+  // ノード番号をキーにして前のノード番号を持つ配列
+  vector<int> mPrev;
+
+  // ノード番号をキーにして現在のキーを持つ配列
+  // バケツに含まれない場合は -1
+  vector<int> mKey;
+
+  // ノード番号をキーにしてノードを持つ配列
+  vector<NodeClass*> mNodeArray;
+
+  // 要素数
+  int mNum{0};
+
+  // 空でないバケツのキーの下限
+  int mMinKey{0};
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// NodeHeap のインライン関数の定義
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
 // @param[in] num ノード数
 template <typename NodeClass,
-	  typename CompFuncClass>
+	  typename CompFuncClass,
+	  int D>
 inline
-NodeHeap<NodeClass, CompFuncClass>::NodeHeap(int num)
+NodeHeap<NodeClass, CompFuncClass, D>::NodeHeap(int num)
 {
   mHeapSize = num;
   mNodeHeap = new NodeClass*[num];
@@ -124,29 +376,32 @@ NodeHeap<NodeClass, CompFuncClass>::NodeHeap(int num)
 
 // @brief デストラクタ
 template <typename NodeClass,
-	  typename CompFuncClass>
+	  typename CompFuncClass,
+	  int D>
 inline
-NodeHeap<NodeClass, CompFuncClass>::~NodeHeap()
+NodeHeap<NodeClass, CompFuncClass, D>::~NodeHeap()
 {
   delete [] mNodeHeap;
 }
 
 // @brief ヒープが空の時 true を返す．
 template <typename NodeClass,
-	  typename CompFuncClass>
+	  typename CompFuncClass,
+	  int D>
 inline
 bool
-NodeHeap<NodeClass, CompFuncClass>::empty() const
+NodeHeap<NodeClass, CompFuncClass, D>::empty() const
 {
   return mNodeNum == 0;
 }
 
 // @brief ノードを追加する．
 template <typename NodeClass,
-	  typename CompFuncClass>
+	  typename CompFuncClass,
+	  int D>
 inline
 void
-NodeHeap<NodeClass, CompFuncClass>::put_node(NodeClass* node)
+NodeHeap<NodeClass, CompFuncClass, D>::put_node(NodeClass* node)
 {
   ASSERT_COND( mNodeNum < mHeapSize );
 
@@ -155,12 +410,37 @@ NodeHeap<NodeClass, CompFuncClass>::put_node(NodeClass* node)
   move_up(node);
 }
 
+// @brief ノードをまとめて追加する．
+// @param[in] node_list ノードのリスト
+template <typename NodeClass,
+	  typename CompFuncClass,
+	  int D>
+inline
+void
+NodeHeap<NodeClass, CompFuncClass, D>::bulk_build(const vector<NodeClass*>& node_list)
+{
+  ASSERT_COND( mNodeNum + node_list.size() <= mHeapSize );
+
+  for ( auto node: node_list ) {
+    locate_node(node, mNodeNum);
+    ++ mNodeNum;
+  }
+  // 子供を持つ最後のノードから順に沈める．
+  if ( mNodeNum < 2 ) {
+    return;
+  }
+  for ( int idx = (mNodeNum - 2) / D; idx >= 0; -- idx ) {
+    move_down(mNodeHeap[idx]);
+  }
+}
+
 // @brief ノードを取り去る．
 template <typename NodeClass,
-	  typename CompFuncClass>
+	  typename CompFuncClass,
+	  int D>
 inline
 void
-NodeHeap<NodeClass, CompFuncClass>::delete_node(NodeClass* node)
+NodeHeap<NodeClass, CompFuncClass, D>::delete_node(NodeClass* node)
 {
   ASSERT_COND( !empty() );
 
@@ -172,8 +452,11 @@ NodeHeap<NodeClass, CompFuncClass>::delete_node(NodeClass* node)
   -- mNodeNum;
   NodeClass* last = mNodeHeap[mNodeNum];
   if ( last != node ) {
+    // 最後のノードを空いた位置に置く．
+    // 元の位置の親よりも小さい場合があるので上下に動かす．
     -- idx;
     locate_node(last, idx);
+    move_up(last);
     move_down(last);
   }
 }
@@ -181,10 +464,11 @@ NodeHeap<NodeClass, CompFuncClass>::delete_node(NodeClass* node)
 // @brief 値が最小の要素を取り出す．
 // そのノードはヒープから取り除かれる．
 template <typename NodeClass,
-	  typename CompFuncClass>
+	  typename CompFuncClass,
+	  int D>
 inline
 NodeClass*
-NodeHeap<NodeClass, CompFuncClass>::get_min()
+NodeHeap<NodeClass, CompFuncClass, D>::get_min()
 {
   ASSERT_COND( !empty() );
 
@@ -202,10 +486,11 @@ NodeHeap<NodeClass, CompFuncClass>::get_min()
 // @brief ノードの値の変更に伴ってヒープ構造を更新する．
 // @param[in] node 値が変更されたノード
 template <typename NodeClass,
-	  typename CompFuncClass>
+	  typename CompFuncClass,
+	  int D>
 inline
 void
-NodeHeap<NodeClass, CompFuncClass>::update(NodeClass* node)
+NodeHeap<NodeClass, CompFuncClass, D>::update(NodeClass* node)
 {
   int idx = node->heap_location();
   ASSERT_COND( idx > 0 );
@@ -220,10 +505,11 @@ NodeHeap<NodeClass, CompFuncClass>::update(NodeClass* node)
 // @brief ノードを適当な位置まで沈める．
 // @param[in] node 対象のノード
 template <typename NodeClass,
-	  typename CompFuncClass>
+	  typename CompFuncClass,
+	  int D>
 inline
 void
-NodeHeap<NodeClass, CompFuncClass>::move_down(NodeClass* node)
+NodeHeap<NodeClass, CompFuncClass, D>::move_down(NodeClass* node)
 {
   int idx = node->heap_location();
   if ( idx == 0 ) {
@@ -236,57 +522,41 @@ NodeHeap<NodeClass, CompFuncClass>::move_down(NodeClass* node)
   -- idx;
   for ( ; ; ) {
     // ヒープ木の性質から親の位置から子の位置が分かる．
-    int l_idx = idx * 2 + 1;
-    int r_idx = l_idx + 1;
-    if ( r_idx > mNodeNum ) {
-      // 左右の子供を持たない時
+    int c_idx = idx * D + 1;
+    if ( c_idx >= mNodeNum ) {
+      // 子供を持たない時
       break;
     }
-    NodeClass* p_node = mNodeHeap[idx];
-    NodeClass* l_node = mNodeHeap[l_idx];
-    if ( r_idx == mNodeNum ) {
-      // 右の子供を持たない時
-      if ( compare(p_node, l_node) > 0 ) {
-	// 逆転
-	locate_node(p_node, l_idx);
-	locate_node(l_node, idx);
+    // 子供の中で最小のものを求める．
+    // 等しい場合は左の子供を優先する．
+    int c_end = std::min(c_idx + D, mNodeNum);
+    int min_idx = c_idx;
+    for ( int i = c_idx + 1; i < c_end; ++ i ) {
+      if ( compare(mNodeHeap[i], mNodeHeap[min_idx]) < 0 ) {
+	min_idx = i;
       }
-      // これ以上子供はいない．
-      break;
     }
-    else {
-      // 左右の子供がいる場合
-      NodeClass* r_node = mNodeHeap[r_idx];
-      if ( compare(p_node, l_node) > 0 &&
-	   compare(l_node, r_node) <= 0 ) {
-	// 左の子供と入れ替える．
-	// 次は左の子供に対して同じ事をする．
-	locate_node(p_node, l_idx);
-	locate_node(l_node, idx);
-	idx = l_idx;
-      }
-      else if ( compare(p_node, r_node) > 0 &&
-		compare(r_node, l_node) < 0 ) {
-	// 右の子供と入れ替える．
-	// 次は右の子供に対して同じ事をする．
-	locate_node(p_node, r_idx);
-	locate_node(r_node, idx);
-	idx = r_idx;
-      }
-      else {
-	break;
-      }
+    NodeClass* p_node = mNodeHeap[idx];
+    NodeClass* c_node = mNodeHeap[min_idx];
+    if ( compare(p_node, c_node) <= 0 ) {
+      break;
     }
+    // 最小の子供と入れ替える．
+    // 次はその子供の位置に対して同じ事をする．
+    locate_node(p_node, min_idx);
+    locate_node(c_node, idx);
+    idx = min_idx;
   }
 }
 
 // @brief ノードを適当な位置まで浮かび上がらせる．
 // @param[in] node 対象のノード
 template <typename NodeClass,
-	  typename CompFuncClass>
+	  typename CompFuncClass,
+	  int D>
 inline
 void
-NodeHeap<NodeClass, CompFuncClass>::move_up(NodeClass* node)
+NodeHeap<NodeClass, CompFuncClass, D>::move_up(NodeClass* node)
 {
   int idx = node->heap_location();
   if ( idx == 0 ) {
@@ -299,7 +569,7 @@ NodeHeap<NodeClass, CompFuncClass>::move_up(NodeClass* node)
   -- idx;
   while ( idx > 0 ) {
     NodeClass* node = mNodeHeap[idx];
-    int p_idx = (idx - 1) / 2;
+    int p_idx = (idx - 1) / D;
     NodeClass* p_node = mNodeHeap[p_idx];
     if ( compare(p_node, node) > 0 ) {
       locate_node(node, p_idx);
@@ -314,10 +584,11 @@ NodeHeap<NodeClass, CompFuncClass>::move_up(NodeClass* node)
 
 // @brief 内容を出力する．
 template <typename NodeClass,
-	  typename CompFuncClass>
+	  typename CompFuncClass,
+	  int D>
 inline
 void
-NodeHeap<NodeClass, CompFuncClass>::print(ostream& s) const
+NodeHeap<NodeClass, CompFuncClass, D>::print(ostream& s) const
 {
   s << " heap_size = " << mHeapSize << endl;
   for ( int i = 0; i < mNodeNum; ++ i ) {
@@ -335,16 +606,376 @@ NodeHeap<NodeClass, CompFuncClass>::print(ostream& s) const
 // @param[in] node 要素
 // @param[in] pos 位置
 template <typename NodeClass,
-	  typename CompFuncClass>
+	  typename CompFuncClass,
+	  int D>
 inline
 void
-NodeHeap<NodeClass, CompFuncClass>::locate_node(NodeClass* node,
+NodeHeap<NodeClass, CompFuncClass, D>::locate_node(NodeClass* node,
 						int pos)
 {
   mNodeHeap[pos] = node;
   node->set_heap_location(pos + 1);
 }
 
+
+//////////////////////////////////////////////////////////////////////
+// KeyHeap のインライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] max_size 最大の要素数(ノード番号の上限)
+// @param[in] key_func キーを求める関数オブジェクト
+template <typename NodeClass,
+	  typename KeyFuncClass,
+	  int D>
+inline
+KeyHeap<NodeClass, KeyFuncClass, D>::KeyHeap(int max_size,
+					     KeyFuncClass key_func) :
+  mKeyFunc{key_func},
+  mPosArray(max_size, -1)
+{
+  mHeap.reserve(max_size);
+}
+
+// @brief ヒープが空の時 true を返す．
+template <typename NodeClass,
+	  typename KeyFuncClass,
+	  int D>
+inline
+bool
+KeyHeap<NodeClass, KeyFuncClass, D>::empty() const
+{
+  return mHeap.empty();
+}
+
+// @brief ノードを追加する．
+template <typename NodeClass,
+	  typename KeyFuncClass,
+	  int D>
+inline
+void
+KeyHeap<NodeClass, KeyFuncClass, D>::put_node(NodeClass* node)
+{
+  ASSERT_COND( mPosArray[node->id()] == -1 );
+
+  int pos = mHeap.size();
+  mHeap.push_back(Cell{mKeyFunc(node), node});
+  mPosArray[node->id()] = pos;
+  move_up(pos);
+}
+
+// @brief ノードをまとめて追加する．
+// @param[in] node_list ノードのリスト
+template <typename NodeClass,
+	  typename KeyFuncClass,
+	  int D>
+inline
+void
+KeyHeap<NodeClass, KeyFuncClass, D>::bulk_build(const vector<NodeClass*>& node_list)
+{
+  for ( auto node: node_list ) {
+    ASSERT_COND( mPosArray[node->id()] == -1 );
+    mPosArray[node->id()] = mHeap.size();
+    mHeap.push_back(Cell{mKeyFunc(node), node});
+  }
+  // 子供を持つ最後の要素から順に沈める．
+  int n = mHeap.size();
+  if ( n < 2 ) {
+    return;
+  }
+  for ( int idx = (n - 2) / D; idx >= 0; -- idx ) {
+    move_down(idx);
+  }
+}
+
+// @brief ノードを取り去る．
+template <typename NodeClass,
+	  typename KeyFuncClass,
+	  int D>
+inline
+void
+KeyHeap<NodeClass, KeyFuncClass, D>::delete_node(NodeClass* node)
+{
+  int idx = mPosArray[node->id()];
+  ASSERT_COND( idx >= 0 );
+
+  mPosArray[node->id()] = -1;
+  Cell last = mHeap.back();
+  mHeap.pop_back();
+  if ( last.node != node ) {
+    // 最後の要素を空いた位置に置いて上下に動かす．
+    locate_cell(last, idx);
+    move_up(idx);
+    move_down(mPosArray[last.node->id()]);
+  }
+}
+
+// @brief キーが最小の要素を取り出す．
+template <typename NodeClass,
+	  typename KeyFuncClass,
+	  int D>
+inline
+NodeClass*
+KeyHeap<NodeClass, KeyFuncClass, D>::get_min()
+{
+  ASSERT_COND( !empty() );
+
+  NodeClass* node = mHeap[0].node;
+  mPosArray[node->id()] = -1;
+  Cell last = mHeap.back();
+  mHeap.pop_back();
+  if ( !mHeap.empty() ) {
+    locate_cell(last, 0);
+    move_down(0);
+  }
+  return node;
+}
+
+// @brief ノードのキーを求め直してヒープ構造を更新する．
+template <typename NodeClass,
+	  typename KeyFuncClass,
+	  int D>
+inline
+void
+KeyHeap<NodeClass, KeyFuncClass, D>::update(NodeClass* node)
+{
+  int idx = mPosArray[node->id()];
+  ASSERT_COND( idx >= 0 );
+
+  auto old_key = mHeap[idx].key;
+  auto new_key = mKeyFunc(node);
+  mHeap[idx].key = new_key;
+  if ( new_key < old_key ) {
+    move_up(idx);
+  }
+  else if ( new_key > old_key ) {
+    move_down(idx);
+  }
+}
+
+// @brief idx の要素を適当な位置まで沈める．
+template <typename NodeClass,
+	  typename KeyFuncClass,
+	  int D>
+inline
+void
+KeyHeap<NodeClass, KeyFuncClass, D>::move_down(int idx)
+{
+  int n = mHeap.size();
+  Cell cell = mHeap[idx];
+  for ( ; ; ) {
+    int c_idx = idx * D + 1;
+    if ( c_idx >= n ) {
+      break;
+    }
+    // 子供の中で最小のものを求める．
+    int c_end = std::min(c_idx + D, n);
+    int min_idx = c_idx;
+    for ( int i = c_idx + 1; i < c_end; ++ i ) {
+      if ( mHeap[i].key < mHeap[min_idx].key ) {
+	min_idx = i;
+      }
+    }
+    if ( cell.key <= mHeap[min_idx].key ) {
+      break;
+    }
+    // 子供を上げて穴を下ろしていく．
+    locate_cell(mHeap[min_idx], idx);
+    idx = min_idx;
+  }
+  locate_cell(cell, idx);
+}
+
+// @brief idx の要素を適当な位置まで浮かび上がらせる．
+template <typename NodeClass,
+	  typename KeyFuncClass,
+	  int D>
+inline
+void
+KeyHeap<NodeClass, KeyFuncClass, D>::move_up(int idx)
+{
+  Cell cell = mHeap[idx];
+  while ( idx > 0 ) {
+    int p_idx = (idx - 1) / D;
+    if ( mHeap[p_idx].key <= cell.key ) {
+      break;
+    }
+    // 親を下げて穴を上げていく．
+    locate_cell(mHeap[p_idx], idx);
+    idx = p_idx;
+  }
+  locate_cell(cell, idx);
+}
+
+// @brief 要素をヒープ上の pos に置く．
+template <typename NodeClass,
+	  typename KeyFuncClass,
+	  int D>
+inline
+void
+KeyHeap<NodeClass, KeyFuncClass, D>::locate_cell(const Cell& cell,
+						 int pos)
+{
+  mHeap[pos] = cell;
+  mPosArray[cell.node->id()] = pos;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// BucketHeap のインライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] max_size 最大の要素数(ノード番号の上限)
+// @param[in] max_key キーの最大値
+// @param[in] key_func キーを求める関数オブジェクト
+template <typename NodeClass,
+	  typename KeyFuncClass>
+inline
+BucketHeap<NodeClass, KeyFuncClass>::BucketHeap(int max_size,
+						int max_key,
+						KeyFuncClass key_func) :
+  mKeyFunc{key_func},
+  mHead(max_key + 1, -1),
+  mNext(max_size, -1),
+  mPrev(max_size, -1),
+  mKey(max_size, -1),
+  mNodeArray(max_size, nullptr),
+  mMinKey{max_key + 1}
+{
+}
+
+// @brief ヒープが空の時 true を返す．
+template <typename NodeClass,
+	  typename KeyFuncClass>
+inline
+bool
+BucketHeap<NodeClass, KeyFuncClass>::empty() const
+{
+  return mNum == 0;
+}
+
+// @brief ノードを追加する．
+template <typename NodeClass,
+	  typename KeyFuncClass>
+inline
+void
+BucketHeap<NodeClass, KeyFuncClass>::put_node(NodeClass* node)
+{
+  int id = node->id();
+  ASSERT_COND( mKey[id] == -1 );
+
+  mNodeArray[id] = node;
+  link(id, mKeyFunc(node));
+  ++ mNum;
+}
+
+// @brief ノードをまとめて追加する．
+// @param[in] node_list ノードのリスト
+//
+// バケツへの追加は定数時間なので put_node() を繰り返すだけでよい．
+template <typename NodeClass,
+	  typename KeyFuncClass>
+inline
+void
+BucketHeap<NodeClass, KeyFuncClass>::bulk_build(const vector<NodeClass*>& node_list)
+{
+  for ( auto node: node_list ) {
+    put_node(node);
+  }
+}
+
+// @brief ノードを取り去る．
+template <typename NodeClass,
+	  typename KeyFuncClass>
+inline
+void
+BucketHeap<NodeClass, KeyFuncClass>::delete_node(NodeClass* node)
+{
+  unlink(node->id());
+  -- mNum;
+}
+
+// @brief キーが最小の要素を取り出す．
+template <typename NodeClass,
+	  typename KeyFuncClass>
+inline
+NodeClass*
+BucketHeap<NodeClass, KeyFuncClass>::get_min()
+{
+  ASSERT_COND( !empty() );
+
+  while ( mHead[mMinKey] == -1 ) {
+    ++ mMinKey;
+  }
+  int id = mHead[mMinKey];
+  unlink(id);
+  -- mNum;
+  return mNodeArray[id];
+}
+
+// @brief ノードのキーを求め直してバケツを移す．
+template <typename NodeClass,
+	  typename KeyFuncClass>
+inline
+void
+BucketHeap<NodeClass, KeyFuncClass>::update(NodeClass* node)
+{
+  int id = node->id();
+  int key = mKeyFunc(node);
+  if ( key != mKey[id] ) {
+    unlink(id);
+    link(id, key);
+  }
+}
+
+// @brief ノードをバケツに入れる．
+template <typename NodeClass,
+	  typename KeyFuncClass>
+inline
+void
+BucketHeap<NodeClass, KeyFuncClass>::link(int id,
+					  int key)
+{
+  ASSERT_COND( 0 <= key && key < mHead.size() );
+
+  int next = mHead[key];
+  mNext[id] = next;
+  mPrev[id] = -1;
+  if ( next != -1 ) {
+    mPrev[next] = id;
+  }
+  mHead[key] = id;
+  mKey[id] = key;
+  if ( mMinKey > key ) {
+    mMinKey = key;
+  }
+}
+
+// @brief ノードをバケツから外す．
+template <typename NodeClass,
+	  typename KeyFuncClass>
+inline
+void
+BucketHeap<NodeClass, KeyFuncClass>::unlink(int id)
+{
+  int key = mKey[id];
+  ASSERT_COND( key >= 0 );
+
+  int prev = mPrev[id];
+  int next = mNext[id];
+  if ( prev == -1 ) {
+    mHead[key] = next;
+  }
+  else {
+    mNext[prev] = next;
+  }
+  if ( next != -1 ) {
+    mPrev[next] = prev;
+  }
+  mKey[id] = -1;
+}
+
 END_NAMESPACE_YM_UDGRAPH
 
 #endif // NODEHEAP_H
@@ -0,0 +1,316 @@
+#ifndef PEELQUEUE_H
+#define PEELQUEUE_H
+
+/// @file PeelQueue.h
+/// @brief PeelQueue のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/UdGraph.h"
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+//////////////////////////////////////////////////////////////////////
+/// @class PeelQueue PeelQueue.h "PeelQueue.h"
+/// @brief 次数の小さいノードから順に取り除くためのバケツ
+///
+/// - Matula-Beck のバケツ構造で，キー(次数)ごとのバケツにノード番号を入れる．
+/// - キーは 0 以上 max_key 以下の int で，減らすことしかできない．
+/// - put(), erase(), dec_key() は定数時間で，min_key() は
+///   キーの増加分だけ走査するので，全体で O(ノード数 + 枝数) となる．
+/// - 同じノードのキーを何度も減らす場合はまとめて dec_key() を
+///   呼んだ方がバケツの移動が少なくて済む．
+/// - バケツの中は配列なので，最小のキーのノードから乱数で選ぶことができる．
+/// - 全ての要素を並べた配列も持つので，全体から乱数で選ぶこともできる．
+/// - init() は既存の領域を再利用するので，繰り返し用いてもよい．
+//////////////////////////////////////////////////////////////////////
+class PeelQueue
+{
+public:
+
+  /// @brief コンストラクタ
+  PeelQueue() = default;
+
+  /// @brief デストラクタ
+  ~PeelQueue() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 空にする．
+  /// @param[in] node_num ノード番号の上限
+  /// @param[in] max_key キーの最大値
+  void
+  init(int node_num,
+       int max_key);
+
+  /// @brief 空の時 true を返す．
+  bool
+  empty() const
+  {
+    return mNodeList.empty();
+  }
+
+  /// @brief 要素数を返す．
+  int
+  size() const
+  {
+    return mNodeList.size();
+  }
+
+  /// @brief 要素を返す．
+  /// @param[in] pos 位置番号 ( 0 <= pos < size() )
+  ///
+  /// 要素の順番は erase() などで入れ替わる．
+  int
+  node(int pos) const
+  {
+    ASSERT_COND( 0 <= pos && pos < size() );
+    return mNodeList[pos];
+  }
+
+  /// @brief ノードが含まれている時 true を返す．
+  /// @param[in] id ノード番号
+  bool
+  contains(int id) const
+  {
+    return mKey[id] >= 0;
+  }
+
+  /// @brief ノードのキーを返す．
+  /// @param[in] id ノード番号
+  ///
+  /// 含まれていない時は -1 を返す．
+  int
+  key(int id) const
+  {
+    return mKey[id];
+  }
+
+  /// @brief ノードを追加する．
+  /// @param[in] id ノード番号
+  /// @param[in] key キー ( 0 <= key <= max_key )
+  void
+  put(int id,
+      int key);
+
+  /// @brief ノードを取り除く．
+  /// @param[in] id ノード番号
+  void
+  erase(int id);
+
+  /// @brief ノードのキーを減らす．
+  /// @param[in] id ノード番号
+  /// @param[in] delta 減らす値
+  ///
+  /// キーは 0 より小さくならない．
+  void
+  dec_key(int id,
+	  int delta = 1);
+
+  /// @brief 最小のキーを返す．
+  ///
+  /// 空であってはならない．
+  int
+  min_key();
+
+  /// @brief 最小のキーを持つノードのリストを返す．
+  ///
+  /// 空であってはならない．
+  const vector<int>&
+  min_bucket()
+  {
+    return mBucket[min_key()];
+  }
+
+  /// @brief 最小のキーを持つノードを一つ取り出す．
+  ///
+  /// - そのノードは取り除かれる．
+  /// - 同じキーのノードは後から入れたものが先に取り出される．
+  int
+  pop_min();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief バケツに入れる．
+  void
+  link(int id,
+       int key);
+
+  /// @brief バケツから外す．
+  void
+  unlink(int id);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // キーごとのバケツ
+  vector<vector<int>> mBucket;
+
+  // ノード番号をキーにして現在のキーを持つ配列
+  // 含まれない場合は -1
+  vector<int> mKey;
+
+  // ノード番号をキーにしてバケツ内の位置を持つ配列
+  vector<int> mBucketPos;
+
+  // 全ての要素のリスト
+  vector<int> mNodeList;
+
+  // ノード番号をキーにして mNodeList 内の位置を持つ配列
+  vector<int> mListPos;
+
+  // 空でないバケツのキーの下限
+  int mMinKey{0};
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 空にする．
+// @param[in] node_num ノード番号の上限
+// @param[in] max_key キーの最大値
+inline
+void
+PeelQueue::init(int node_num,
+		int max_key)
+{
+  // バケツの領域は再利用する．
+  if ( mBucket.size() < max_key + 1 ) {
+    mBucket.resize(max_key + 1);
+  }
+  for ( auto& bucket: mBucket ) {
+    bucket.clear();
+  }
+  mKey.clear();
+  mKey.resize(node_num, -1);
+  mBucketPos.resize(node_num);
+  mListPos.resize(node_num);
+  mNodeList.clear();
+  mMinKey = 0;
+}
+
+// @brief ノードを追加する．
+// @param[in] id ノード番号
+// @param[in] key キー ( 0 <= key <= max_key )
+inline
+void
+PeelQueue::put(int id,
+	       int key)
+{
+  ASSERT_COND( !contains(id) );
+  ASSERT_COND( 0 <= key && key < mBucket.size() );
+
+  link(id, key);
+  mListPos[id] = mNodeList.size();
+  mNodeList.push_back(id);
+}
+
+// @brief ノードを取り除く．
+// @param[in] id ノード番号
+inline
+void
+PeelQueue::erase(int id)
+{
+  ASSERT_COND( contains(id) );
+
+  unlink(id);
+  mKey[id] = -1;
+  // 最後の要素を空いた位置に移す．
+  int pos = mListPos[id];
+  int last = mNodeList.back();
+  mNodeList[pos] = last;
+  mListPos[last] = pos;
+  mNodeList.pop_back();
+}
+
+// @brief ノードのキーを減らす．
+// @param[in] id ノード番号
+// @param[in] delta 減らす値
+inline
+void
+PeelQueue::dec_key(int id,
+		   int delta)
+{
+  ASSERT_COND( contains(id) );
+
+  int key = mKey[id];
+  int new_key = std::max(key - delta, 0);
+  if ( new_key < key ) {
+    unlink(id);
+    link(id, new_key);
+  }
+}
+
+// @brief 最小のキーを返す．
+inline
+int
+PeelQueue::min_key()
+{
+  ASSERT_COND( !empty() );
+
+  while ( mBucket[mMinKey].empty() ) {
+    ++ mMinKey;
+  }
+  return mMinKey;
+}
+
+// @brief 最小のキーを持つノードを一つ取り出す．
+inline
+int
+PeelQueue::pop_min()
+{
+  int id = min_bucket().back();
+  erase(id);
+  return id;
+}
+
+// @brief バケツに入れる．
+inline
+void
+PeelQueue::link(int id,
+		int key)
+{
+  auto& bucket = mBucket[key];
+  mKey[id] = key;
+  mBucketPos[id] = bucket.size();
+  bucket.push_back(id);
+  if ( mMinKey > key ) {
+    mMinKey = key;
+  }
+}
+
+// @brief バケツから外す．
+inline
+void
+PeelQueue::unlink(int id)
+{
+  // 最後の要素を空いた位置に移す．
+  auto& bucket = mBucket[mKey[id]];
+  int pos = mBucketPos[id];
+  int last = bucket.back();
+  bucket[pos] = last;
+  mBucketPos[last] = pos;
+  bucket.pop_back();
+}
+
+END_NAMESPACE_YM_UDGRAPH
+
+#endif // PEELQUEUE_H
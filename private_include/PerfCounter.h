@@ -0,0 +1,314 @@
+#ifndef PERFCOUNTER_H
+#define PERFCOUNTER_H
+
+/// @file PerfCounter.h
+/// @brief PerfCounter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/UdGraph.h"
+
+#include <algorithm>
+
+#if defined(YM_GRAPH_STATS)
+#include <chrono>
+#include <sys/resource.h>
+#endif
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+//////////////////////////////////////////////////////////////////////
+/// @class PerfCounter PerfCounter.h "PerfCounter.h"
+/// @brief UdGraph::PerfStats を集計するクラス
+///
+/// - YM_GRAPH_STATS が定義されていない場合はデータメンバを持たず，
+///   全てのメンバ関数は空のインライン関数になる．
+///   そのため探索の内側のループで呼んでもコストはかからない．
+/// - スレッドセーフではない．
+///   スレッドごとに別のインスタンスを用いて最後に merge() すること．
+//////////////////////////////////////////////////////////////////////
+class PerfCounter
+{
+public:
+
+  /// @brief コンストラクタ
+  PerfCounter() = default;
+
+  /// @brief デストラクタ
+  ~PerfCounter() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 繰り返し回数を数える．
+  void
+  count_iteration(SizeType n = 1);
+
+  /// @brief 局所探索の移動回数を数える．
+  void
+  count_move(SizeType n = 1);
+
+  /// @brief ヒープの更新回数を数える．
+  void
+  count_heap_update(SizeType n = 1);
+
+  /// @brief 分枝ノード数を数える．
+  void
+  count_branch(SizeType n = 1);
+
+  /// @brief 増加路による更新回数を数える．
+  void
+  count_augmentation(SizeType n = 1);
+
+  /// @brief 計時を開始する．
+  void
+  start();
+
+  /// @brief 前処理の終了を記録する．
+  ///
+  /// start() からの経過時間を setup_time に加える．
+  void
+  end_setup();
+
+  /// @brief 探索の終了を記録する．
+  ///
+  /// - end_setup() からの経過時間を search_time に加える．
+  /// - peak_memory を更新する．
+  void
+  end_search();
+
+  /// @brief 他のカウンタの値を加える．
+  /// @param[in] src 加えるカウンタ
+  ///
+  /// 時間は並列に動いていたものとみなして大きい方をとる．
+  void
+  merge(const PerfCounter& src);
+
+  /// @brief 集計結果を stats に加える．
+  /// @param[in] stats 結果を加える構造体
+  ///
+  /// 時間は merge() と同様に大きい方をとる．
+  void
+  add_to(UdGraph::PerfStats& stats) const;
+
+  /// @brief dst に src を加える．
+  /// @param[in] dst 結果を加える構造体
+  /// @param[in] src 加える値
+  ///
+  /// 部分グラフごとの結果をまとめる時にも用いるので
+  /// YM_GRAPH_STATS によらず定義されている．
+  static
+  void
+  add_stats(UdGraph::PerfStats& dst,
+	    const UdGraph::PerfStats& src);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+#if defined(YM_GRAPH_STATS)
+
+  // 集計結果
+  UdGraph::PerfStats mStats;
+
+  // 計時の開始時刻
+  std::chrono::steady_clock::time_point mLap;
+
+#endif
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief dst に src を加える．
+// @param[in] dst 結果を加える構造体
+// @param[in] src 加える値
+inline
+void
+PerfCounter::add_stats(UdGraph::PerfStats& dst,
+		       const UdGraph::PerfStats& src)
+{
+  dst.iterations += src.iterations;
+  dst.moves += src.moves;
+  dst.heap_updates += src.heap_updates;
+  dst.branch_nodes += src.branch_nodes;
+  dst.augmentations += src.augmentations;
+  dst.setup_time = std::max(dst.setup_time, src.setup_time);
+  dst.search_time = std::max(dst.search_time, src.search_time);
+  dst.peak_memory = std::max(dst.peak_memory, src.peak_memory);
+}
+
+#if defined(YM_GRAPH_STATS)
+
+// @brief 繰り返し回数を数える．
+inline
+void
+PerfCounter::count_iteration(SizeType n)
+{
+  mStats.iterations += n;
+}
+
+// @brief 局所探索の移動回数を数える．
+inline
+void
+PerfCounter::count_move(SizeType n)
+{
+  mStats.moves += n;
+}
+
+// @brief ヒープの更新回数を数える．
+inline
+void
+PerfCounter::count_heap_update(SizeType n)
+{
+  mStats.heap_updates += n;
+}
+
+// @brief 分枝ノード数を数える．
+inline
+void
+PerfCounter::count_branch(SizeType n)
+{
+  mStats.branch_nodes += n;
+}
+
+// @brief 増加路による更新回数を数える．
+inline
+void
+PerfCounter::count_augmentation(SizeType n)
+{
+  mStats.augmentations += n;
+}
+
+// @brief 計時を開始する．
+inline
+void
+PerfCounter::start()
+{
+  mLap = std::chrono::steady_clock::now();
+}
+
+// @brief 前処理の終了を記録する．
+inline
+void
+PerfCounter::end_setup()
+{
+  auto now = std::chrono::steady_clock::now();
+  mStats.setup_time += std::chrono::duration<double>(now - mLap).count();
+  mLap = now;
+}
+
+// @brief 探索の終了を記録する．
+inline
+void
+PerfCounter::end_search()
+{
+  auto now = std::chrono::steady_clock::now();
+  mStats.search_time += std::chrono::duration<double>(now - mLap).count();
+  mLap = now;
+
+  // ru_maxrss の単位は Linux では KB
+  struct rusage usage;
+  if ( getrusage(RUSAGE_SELF, &usage) == 0 ) {
+    SizeType peak = static_cast<SizeType>(usage.ru_maxrss) * 1024;
+    mStats.peak_memory = std::max(mStats.peak_memory, peak);
+  }
+}
+
+// @brief 他のカウンタの値を加える．
+inline
+void
+PerfCounter::merge(const PerfCounter& src)
+{
+  add_stats(mStats, src.mStats);
+}
+
+// @brief 集計結果を stats に加える．
+inline
+void
+PerfCounter::add_to(UdGraph::PerfStats& stats) const
+{
+  add_stats(stats, mStats);
+}
+
+#else // YM_GRAPH_STATS
+
+// 以下は全て何もしない．
+
+inline
+void
+PerfCounter::count_iteration(SizeType /*n*/)
+{
+}
+
+inline
+void
+PerfCounter::count_move(SizeType /*n*/)
+{
+}
+
+inline
+void
+PerfCounter::count_heap_update(SizeType /*n*/)
+{
+}
+
+inline
+void
+PerfCounter::count_branch(SizeType /*n*/)
+{
+}
+
+inline
+void
+PerfCounter::count_augmentation(SizeType /*n*/)
+{
+}
+
+inline
+void
+PerfCounter::start()
+{
+}
+
+inline
+void
+PerfCounter::end_setup()
+{
+}
+
+inline
+void
+PerfCounter::end_search()
+{
+}
+
+inline
+void
+PerfCounter::merge(const PerfCounter& /*src*/)
+{
+}
+
+inline
+void
+PerfCounter::add_to(UdGraph::PerfStats& /*stats*/) const
+{
+}
+
+#endif // YM_GRAPH_STATS
+
+END_NAMESPACE_YM_UDGRAPH
+
+#endif // PERFCOUNTER_H
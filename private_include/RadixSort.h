@@ -0,0 +1,143 @@
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+/// @file RadixSort.h
+/// @brief radix_sort() のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_config.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <memory>
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM
+
+//////////////////////////////////////////////////////////////////////
+/// @brief 64ビットのキーを並列の LSD 基数ソートで安定に並べ替える．
+/// @param[inout] key_list キーのリスト
+/// @param[inout] value_list キーと同じ順に並べ替える値のリスト
+/// @param[in] key_bits キーの有効ビット数
+/// @param[in] thread_num スレッド数(0 以下の場合はハードウェアの並列度)
+///
+/// - value_list は空でもよい．そうでなければ key_list と同じ大きさとする．
+/// - 安定なので等しいキーの要素は元の順序を保つ．
+/// - 1桁ごとにスレッドごとの頻度表を作り，(桁の値, スレッド)の順に
+///   累積和をとってから各スレッドが独立に書き込む．
+/// - 全ての要素が同じ値を持つ桁は飛ばす．
+//////////////////////////////////////////////////////////////////////
+void
+radix_sort(vector<std::uint64_t>& key_list,
+	   vector<int>& value_list,
+	   int key_bits,
+	   int thread_num);
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 64ビットのキーを並列の LSD 基数ソートで安定に並べ替える．
+// @param[inout] key_list キーのリスト
+// @param[inout] value_list キーと同じ順に並べ替える値のリスト
+// @param[in] key_bits キーの有効ビット数
+// @param[in] thread_num スレッド数(0 以下の場合はハードウェアの並列度)
+inline
+void
+radix_sort(vector<std::uint64_t>& key_list,
+	   vector<int>& value_list,
+	   int key_bits,
+	   int thread_num)
+{
+  // 1桁のビット数
+  const int DIGIT_BITS = 11;
+  const SizeType BUCKET_NUM = 1 << DIGIT_BITS;
+  const std::uint64_t DIGIT_MASK = BUCKET_NUM - 1;
+  // 1スレッドあたりの最小の要素数
+  const SizeType MIN_CHUNK = 1 << 16;
+
+  SizeType n = key_list.size();
+  bool has_value = !value_list.empty();
+  ASSERT_COND( !has_value || value_list.size() == n );
+  if ( n <= 1 ) {
+    return;
+  }
+
+  int nt = ThreadPool::default_thread_num(thread_num);
+  nt = std::min<SizeType>(nt, (n + MIN_CHUNK - 1) / MIN_CHUNK);
+  std::unique_ptr<ThreadPool> pool;
+  if ( nt > 1 ) {
+    pool.reset(new ThreadPool(nt));
+  }
+  // 0 から nt - 1 までのチャンクに対して func を適用する．
+  auto for_chunks = [&](const std::function<void(int, SizeType, SizeType)>& func) {
+    auto body = [&](int t) {
+      func(t, n * t / nt, n * (t + 1) / nt);
+    };
+    if ( pool == nullptr ) {
+      body(0);
+    }
+    else {
+      pool->parallel_for(nt, body);
+    }
+  };
+
+  vector<std::uint64_t> tmp_key_list(n);
+  vector<int> tmp_value_list(has_value ? n : 0);
+  // hist[t * BUCKET_NUM + d] はチャンク t の桁の値 d の要素数
+  vector<SizeType> hist(nt * BUCKET_NUM);
+  for ( int shift = 0; shift < key_bits; shift += DIGIT_BITS ) {
+    std::fill(hist.begin(), hist.end(), 0);
+    for_chunks([&](int t, SizeType begin, SizeType end) {
+      auto h = &hist[t * BUCKET_NUM];
+      for ( SizeType i = begin; i < end; ++ i ) {
+	++ h[(key_list[i] >> shift) & DIGIT_MASK];
+      }
+    });
+
+    // 累積和を書き込み位置に変える．
+    SizeType pos = 0;
+    bool trivial = false;
+    for ( SizeType d = 0; d < BUCKET_NUM; ++ d ) {
+      SizeType num = 0;
+      for ( int t = 0; t < nt; ++ t ) {
+	auto& h = hist[t * BUCKET_NUM + d];
+	num += h;
+	SizeType c = h;
+	h = pos;
+	pos += c;
+      }
+      if ( num == n ) {
+	trivial = true;
+	break;
+      }
+    }
+    if ( trivial ) {
+      // この桁は全て同じ値なので並べ替えの必要はない．
+      continue;
+    }
+
+    for_chunks([&](int t, SizeType begin, SizeType end) {
+      auto h = &hist[t * BUCKET_NUM];
+      for ( SizeType i = begin; i < end; ++ i ) {
+	auto key = key_list[i];
+	auto wpos = h[(key >> shift) & DIGIT_MASK] ++;
+	tmp_key_list[wpos] = key;
+	if ( has_value ) {
+	  tmp_value_list[wpos] = value_list[i];
+	}
+      }
+    });
+    key_list.swap(tmp_key_list);
+    value_list.swap(tmp_value_list);
+  }
+}
+
+END_NAMESPACE_YM
+
+#endif // RADIXSORT_H
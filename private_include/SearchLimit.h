@@ -0,0 +1,176 @@
+#ifndef SEARCHLIMIT_H
+#define SEARCHLIMIT_H
+
+/// @file SearchLimit.h
+/// @brief SearchLimit のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_config.h"
+#include <atomic>
+#include <chrono>
+
+
+BEGIN_NAMESPACE_YM
+
+//////////////////////////////////////////////////////////////////////
+/// @class SearchLimit SearchLimit.h "SearchLimit.h"
+/// @brief 探索の打ち切り条件を表すクラス
+///
+/// - 壁時計での終了時刻と中断フラグを持つ．
+/// - 中断フラグは他のスレッドから cancel() で立てることができる．
+/// - 探索を行うクラスは is_expired() を適当な間隔で調べて
+///   true なら探索を打ち切る．
+//////////////////////////////////////////////////////////////////////
+class SearchLimit
+{
+public:
+
+  /// @brief 時計の型
+  using Clock = std::chrono::steady_clock;
+
+  /// @brief コンストラクタ
+  /// @param[in] time_limit 制限時間(秒)
+  ///
+  /// time_limit が 0 以下の場合は無制限となる．
+  explicit
+  SearchLimit(double time_limit = 0.0);
+
+  /// @brief デストラクタ
+  ~SearchLimit() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 制限時間を設定する．
+  /// @param[in] time_limit 制限時間(秒)
+  ///
+  /// - 現在時刻からの相対時間で指定する．
+  /// - time_limit が 0 以下の場合は無制限となる．
+  void
+  set_time_limit(double time_limit);
+
+  /// @brief 制限時間が設定されている時 true を返す．
+  bool
+  has_deadline() const;
+
+  /// @brief 残り時間(秒)を返す．
+  ///
+  /// 制限時間が設定されていない場合は負の値を返す．
+  double
+  remaining_time() const;
+
+  /// @brief 探索を中断させる．
+  void
+  cancel();
+
+  /// @brief 中断されていたら true を返す．
+  bool
+  is_canceled() const;
+
+  /// @brief 制限時間を過ぎたか中断されていたら true を返す．
+  bool
+  is_expired() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 制限時間が設定されている時 true にする．
+  bool mHasDeadline{false};
+
+  // 終了時刻
+  Clock::time_point mDeadline;
+
+  // 中断フラグ
+  std::atomic<bool> mCanceled{false};
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] time_limit 制限時間(秒)
+inline
+SearchLimit::SearchLimit(double time_limit)
+{
+  set_time_limit(time_limit);
+}
+
+// @brief 制限時間を設定する．
+// @param[in] time_limit 制限時間(秒)
+inline
+void
+SearchLimit::set_time_limit(double time_limit)
+{
+  if ( time_limit > 0.0 ) {
+    mHasDeadline = true;
+    auto d = std::chrono::duration<double>(time_limit);
+    mDeadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(d);
+  }
+  else {
+    mHasDeadline = false;
+  }
+}
+
+// @brief 制限時間が設定されている時 true を返す．
+inline
+bool
+SearchLimit::has_deadline() const
+{
+  return mHasDeadline;
+}
+
+// @brief 残り時間(秒)を返す．
+inline
+double
+SearchLimit::remaining_time() const
+{
+  if ( !mHasDeadline ) {
+    return -1.0;
+  }
+  std::chrono::duration<double> d = mDeadline - Clock::now();
+  return d.count() > 0.0 ? d.count() : 0.0;
+}
+
+// @brief 探索を中断させる．
+inline
+void
+SearchLimit::cancel()
+{
+  mCanceled.store(true, std::memory_order_relaxed);
+}
+
+// @brief 中断されていたら true を返す．
+inline
+bool
+SearchLimit::is_canceled() const
+{
+  return mCanceled.load(std::memory_order_relaxed);
+}
+
+// @brief 制限時間を過ぎたか中断されていたら true を返す．
+inline
+bool
+SearchLimit::is_expired() const
+{
+  if ( is_canceled() ) {
+    return true;
+  }
+  return mHasDeadline && Clock::now() >= mDeadline;
+}
+
+END_NAMESPACE_YM
+
+#endif // SEARCHLIMIT_H
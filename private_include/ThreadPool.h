@@ -0,0 +1,245 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+/// @file ThreadPool.h
+/// @brief ThreadPool のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_config.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+
+
+BEGIN_NAMESPACE_YM
+
+//////////////////////////////////////////////////////////////////////
+/// @class ThreadPool ThreadPool.h "ThreadPool.h"
+/// @brief 簡単なスレッドプール
+///
+/// - コンストラクタでワーカースレッドを起動し，デストラクタで終了させる．
+/// - submit() でタスクを登録し，wait() で全てのタスクの終了を待つ．
+/// - タスクは例外を送出してはいけない．
+//////////////////////////////////////////////////////////////////////
+class ThreadPool
+{
+public:
+
+  /// @brief タスクを表す型
+  using Task = std::function<void()>;
+
+  /// @brief コンストラクタ
+  /// @param[in] thread_num スレッド数
+  ///
+  /// thread_num が 0 以下の場合はハードウェアの並列度を用いる．
+  explicit
+  ThreadPool(int thread_num = 0);
+
+  /// @brief デストラクタ
+  ///
+  /// 未処理のタスクは全て実行してから終了する．
+  ~ThreadPool();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief スレッド数を返す．
+  int
+  thread_num() const;
+
+  /// @brief タスクを登録する．
+  /// @param[in] task タスク
+  void
+  submit(Task task);
+
+  /// @brief 登録されたタスクが全て終わるまで待つ．
+  void
+  wait();
+
+  /// @brief 0 から n - 1 までの番号に対して func を並列に適用する．
+  /// @param[in] n タスク数
+  /// @param[in] func 番号を引数にとる関数
+  ///
+  /// 全てのタスクが終わるまで戻らない．
+  void
+  parallel_for(int n,
+	       const std::function<void(int)>& func);
+
+  /// @brief 既定のスレッド数を返す．
+  /// @param[in] thread_num 指定されたスレッド数
+  ///
+  /// thread_num が 0 以下の場合はハードウェアの並列度を返す．
+  static
+  int
+  default_thread_num(int thread_num = 0);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ワーカースレッドの本体
+  void
+  worker_loop();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ワーカースレッドのリスト
+  vector<std::thread> mWorkerList;
+
+  // 未処理のタスクのキュー
+  std::deque<Task> mTaskQueue;
+
+  // mTaskQueue と mPendingNum を保護する mutex
+  std::mutex mMutex;
+
+  // タスクが登録されたことを知らせる条件変数
+  std::condition_variable mTaskCond;
+
+  // 全てのタスクが終わったことを知らせる条件変数
+  std::condition_variable mDoneCond;
+
+  // 登録済みで終了していないタスク数
+  int mPendingNum{0};
+
+  // 終了要求フラグ
+  bool mStop{false};
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] thread_num スレッド数
+inline
+ThreadPool::ThreadPool(int thread_num)
+{
+  int n = default_thread_num(thread_num);
+  mWorkerList.reserve(n);
+  for ( int i = 0; i < n; ++ i ) {
+    mWorkerList.emplace_back([this]() { worker_loop(); });
+  }
+}
+
+// @brief デストラクタ
+inline
+ThreadPool::~ThreadPool()
+{
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mStop = true;
+  }
+  mTaskCond.notify_all();
+  for ( auto& th: mWorkerList ) {
+    th.join();
+  }
+}
+
+// @brief スレッド数を返す．
+inline
+int
+ThreadPool::thread_num() const
+{
+  return mWorkerList.size();
+}
+
+// @brief タスクを登録する．
+// @param[in] task タスク
+inline
+void
+ThreadPool::submit(Task task)
+{
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mTaskQueue.push_back(std::move(task));
+    ++ mPendingNum;
+  }
+  mTaskCond.notify_one();
+}
+
+// @brief 登録されたタスクが全て終わるまで待つ．
+inline
+void
+ThreadPool::wait()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mDoneCond.wait(lock, [this]() { return mPendingNum == 0; });
+}
+
+// @brief 0 から n - 1 までの番号に対して func を並列に適用する．
+// @param[in] n タスク数
+// @param[in] func 番号を引数にとる関数
+inline
+void
+ThreadPool::parallel_for(int n,
+			 const std::function<void(int)>& func)
+{
+  for ( int i = 0; i < n; ++ i ) {
+    submit([&func, i]() { func(i); });
+  }
+  wait();
+}
+
+// @brief 既定のスレッド数を返す．
+// @param[in] thread_num 指定されたスレッド数
+inline
+int
+ThreadPool::default_thread_num(int thread_num)
+{
+  if ( thread_num > 0 ) {
+    return thread_num;
+  }
+  int n = std::thread::hardware_concurrency();
+  return n > 0 ? n : 1;
+}
+
+// @brief ワーカースレッドの本体
+inline
+void
+ThreadPool::worker_loop()
+{
+  for ( ; ; ) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mTaskCond.wait(lock, [this]() { return mStop || !mTaskQueue.empty(); });
+      if ( mTaskQueue.empty() ) {
+	// mStop が立っていてタスクも残っていない．
+	return;
+      }
+      task = std::move(mTaskQueue.front());
+      mTaskQueue.pop_front();
+    }
+
+    task();
+
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      -- mPendingNum;
+      if ( mPendingNum == 0 ) {
+	mDoneCond.notify_all();
+      }
+    }
+  }
+}
+
+END_NAMESPACE_YM
+
+#endif // THREADPOOL_H
@@ -0,0 +1,468 @@
+
+/// @file graph_bench.cc
+/// @brief ym-graph のベンチマークプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// Google Benchmark を用いる．
+/// 結果を JSON で出力する場合は
+///   graph_bench --benchmark_out=result.json --benchmark_out_format=json
+/// のように実行する(graph_bench_json ターゲットでも同じことができる)．
+
+
+#include "benchmark/benchmark.h"
+#include "ym/UdGraph.h"
+#include "ym/GraphGen.h"
+#include "ym/BiMatcher.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 乱数の種
+const int SEED = 20220401;
+
+// ベンチマークの対象となる無向グラフ
+struct UdCase
+{
+  // 名前
+  string name;
+
+  // グラフ
+  UdGraph graph;
+
+  // 重い処理(max_clique の exact など)を行う時 true
+  bool heavy;
+};
+
+// 2部グラフを無向グラフに変換する．
+//
+// 右側のノード番号は左側のノード数だけずらす．
+UdGraph
+to_udgraph(const BiGraph& bigraph)
+{
+  int n1 = bigraph.node1_num();
+  UdGraph graph(n1 + bigraph.node2_num());
+  for ( const auto& edge: bigraph.edge_list() ) {
+    graph.add_edge(edge.id1, edge.id2 + n1, edge.weight);
+  }
+  return graph;
+}
+
+// ファイルの内容を読み込む．
+string
+read_file(const string& filename)
+{
+  ifstream s{filename};
+  ostringstream buf;
+  buf << s.rdbuf();
+  return buf.str();
+}
+
+// 無向グラフのベンチマーク対象のリストを作る．
+vector<UdCase>
+make_ud_cases()
+{
+  vector<UdCase> case_list;
+  string filename = string(TESTDATA_DIR) + string("/anna.col");
+  case_list.push_back({"anna", UdGraph::read_dimacs(filename), true});
+  GraphGen gen(SEED);
+  case_list.push_back({"ba_4000_4", gen.barabasi_albert(4000, 4), false});
+  case_list.push_back({"rmat_12_32000", gen.rmat(12, 32000), false});
+  case_list.push_back({"geometric_4000_0.03", gen.geometric(4000, 0.03), true});
+  case_list.push_back({"planted_1000_10_0.2",
+		       gen.planted_coloring(1000, 10, 0.2).first, false});
+  // 最後の要素は入出力のベンチマークにも用いる．
+  for ( auto n: {1000, 4000} ) {
+    for ( auto p: {0.01, 0.1} ) {
+      ostringstream buf;
+      buf << "gnp_" << n << "_" << p;
+      bool heavy = n * p <= 10;
+      case_list.push_back({buf.str(), gen.gnp(n, p), heavy});
+    }
+  }
+  return case_list;
+}
+
+// read_dimacs のベンチマーク
+void
+bm_read_dimacs(benchmark::State& state,
+	       const string& text)
+{
+  for ( auto _: state ) {
+    istringstream s{text};
+    auto graph = UdGraph::read_dimacs(s);
+    benchmark::DoNotOptimize(graph);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+// restore のベンチマーク
+void
+bm_restore(benchmark::State& state,
+	   const string& text)
+{
+  for ( auto _: state ) {
+    istringstream s{text};
+    auto graph = UdGraph::restore(s);
+    benchmark::DoNotOptimize(graph);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+// BiGraph::read のベンチマーク
+void
+bm_bigraph_read(benchmark::State& state,
+		const string& text)
+{
+  for ( auto _: state ) {
+    istringstream s{text};
+    auto graph = BiGraph::read(s);
+    benchmark::DoNotOptimize(graph);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+// coloring のベンチマーク
+//
+// 彩色数も colors カウンタとして記録する．
+// YM_GRAPH_STATS を有効にしてビルドした場合は UdGraph::PerfStats の値も記録する．
+void
+bm_coloring(benchmark::State& state,
+	    const UdGraph* graph,
+	    const string& algorithm)
+{
+  UdGraph::ColoringOptions options;
+  // 局所探索系のアルゴリズムが終わらなくならないように制限時間を設ける．
+  options.time_limit = 2.0;
+  int nc = 0;
+  UdGraph::ColoringStats stats;
+  for ( auto _: state ) {
+    auto ans = graph->coloring(algorithm, options, stats);
+    nc = ans.first;
+  }
+  state.counters["colors"] = nc;
+#if defined(YM_GRAPH_STATS)
+  state.counters["iterations"] = stats.perf.iterations;
+  state.counters["moves"] = stats.perf.moves;
+  state.counters["heap_updates"] = stats.perf.heap_updates;
+  state.counters["setup_time"] = stats.perf.setup_time;
+  state.counters["search_time"] = stats.perf.search_time;
+#endif
+}
+
+// max_clique のベンチマーク
+void
+bm_max_clique(benchmark::State& state,
+	      const UdGraph* graph,
+	      const string& algorithm)
+{
+  int size = 0;
+  for ( auto _: state ) {
+    auto ans = graph->max_clique(algorithm);
+    size = ans.size();
+  }
+  state.counters["size"] = size;
+}
+
+// ノードに重みを付けたグラフを作る．
+UdGraph
+make_node_weighted(const UdGraph& graph)
+{
+  auto graph1 = graph;
+  for ( int id = 0; id < graph1.node_num(); ++ id ) {
+    graph1.set_node_weight(id, (id * 37) % 100 + 1);
+  }
+  return graph1;
+}
+
+// max_clique("weighted") のベンチマーク
+void
+bm_weighted_max_clique(benchmark::State& state,
+		       const UdGraph* graph)
+{
+  auto graph1 = make_node_weighted(*graph);
+  UdGraph::NodeSetOptions options;
+  UdGraph::NodeSetStats stats;
+  for ( auto _: state ) {
+    graph1.max_clique("weighted", options, stats);
+  }
+  state.counters["weight"] = stats.weight;
+}
+
+// コア分解のベンチマーク
+void
+bm_core_decomposition(benchmark::State& state,
+		      const UdGraph* graph)
+{
+  int d = 0;
+  for ( auto _: state ) {
+    vector<int> core_num;
+    d = graph->core_decomposition(core_num);
+  }
+  state.counters["degeneracy"] = d;
+}
+
+// 極大クリークの列挙のベンチマーク
+//
+// クリークは数えるだけで受け取らない．
+void
+bm_maximal_cliques(benchmark::State& state,
+		   const UdGraph* graph,
+		   int thread_num)
+{
+  UdGraph::CliqueEnumOptions options;
+  options.thread_num = thread_num;
+  UdGraph::CliqueEnumStats stats;
+  for ( auto _: state ) {
+    graph->enum_maximal_cliques(options, nullptr, stats);
+  }
+  state.counters["cliques"] = stats.clique_num;
+  state.counters["max_size"] = stats.max_size;
+}
+
+// 独立集合のベンチマーク
+void
+bm_independent_set(benchmark::State& state,
+		   const UdGraph* graph)
+{
+  int size = 0;
+  for ( auto _: state ) {
+    auto ans = graph->independent_set();
+    size = ans.size();
+  }
+  state.counters["size"] = size;
+}
+
+// independent_set("weighted") のベンチマーク
+void
+bm_weighted_independent_set(benchmark::State& state,
+			    const UdGraph* graph)
+{
+  auto graph1 = make_node_weighted(*graph);
+  UdGraph::NodeSetOptions options;
+  UdGraph::NodeSetStats stats;
+  for ( auto _: state ) {
+    graph1.independent_set("weighted", options, stats);
+  }
+  state.counters["weight"] = stats.weight;
+}
+
+// UdGraph::max_matching のベンチマーク
+void
+bm_ud_max_matching(benchmark::State& state,
+		   const UdGraph* graph,
+		   const string& algorithm)
+{
+  int size = 0;
+  for ( auto _: state ) {
+    auto ans = graph->max_matching(algorithm);
+    size = ans.size();
+  }
+  state.counters["size"] = size;
+}
+
+// UdGraph::max_matching("approx-parallel") のベンチマーク
+//
+// 上界に対する重みの比を ratio として報告する．
+void
+bm_ud_approx_matching(benchmark::State& state,
+		      const UdGraph* graph)
+{
+  UdGraph::MatchingOptions options;
+  options.augment_limit = state.range(0);
+  UdGraph::MatchingStats stats;
+  int size = 0;
+  for ( auto _: state ) {
+    auto ans = graph->max_matching("approx-parallel", options, stats);
+    size = ans.size();
+  }
+  state.counters["size"] = size;
+  if ( stats.upper_bound > 0 ) {
+    state.counters["ratio"] = static_cast<double>(stats.weight) / stats.upper_bound;
+  }
+}
+
+// BiGraph::max_matching のベンチマーク
+void
+bm_bi_max_matching(benchmark::State& state,
+		   const BiGraph* graph,
+		   const string& algorithm)
+{
+  int size = 0;
+  for ( auto _: state ) {
+    auto ans = graph->max_matching(algorithm);
+    size = ans.size();
+  }
+  state.counters["size"] = size;
+}
+
+// BiMatcher で少しずつ変更しながら解き直すベンチマーク
+//
+// 毎回，選ばれている枝を edit_num 本削除し，ランダムな枝を
+// edit_num 本追加してから解き直す．
+void
+bm_bi_matcher_update(benchmark::State& state,
+		     const BiGraph* graph)
+{
+  int edit_num = state.range(0);
+  std::mt19937 rg{SEED};
+  std::uniform_int_distribution<int> rd1{0, graph->node1_num() - 1};
+  std::uniform_int_distribution<int> rd2{0, graph->node2_num() - 1};
+  BiMatcher matcher{*graph};
+  auto ans = matcher.max_matching();
+  for ( auto _: state ) {
+    for ( int i = 0; i < edit_num; ++ i ) {
+      std::uniform_int_distribution<int> rd_pos{0, static_cast<int>(ans.size()) - 1};
+      matcher.remove_edge(ans[rd_pos(rg)]);
+      matcher.add_edge(rd1(rg), rd2(rg));
+    }
+    ans = matcher.max_matching();
+  }
+  state.counters["size"] = ans.size();
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM
+
+
+int
+main(int argc,
+     char** argv)
+{
+  using namespace nsYm;
+
+  // グラフは main() の終わりまで生きていなければならない．
+  auto ud_case_list = make_ud_cases();
+  vector<pair<string, BiGraph>> bi_case_list;
+  GraphGen gen(SEED);
+  for ( auto n: {200, 1000} ) {
+    ostringstream buf;
+    buf << "bip_" << n << "_" << n;
+    bi_case_list.push_back({buf.str(), gen.bipartite(n, n, 0.02)});
+  }
+
+  // 入出力
+  {
+    string filename = string(TESTDATA_DIR) + string("/anna.col");
+    string dimacs_text = read_file(filename);
+    benchmark::RegisterBenchmark("read_dimacs/anna", bm_read_dimacs,
+				 dimacs_text);
+
+    const auto& graph = ud_case_list.back().graph;
+    ostringstream dimacs_buf;
+    graph.write_dimacs(dimacs_buf);
+    benchmark::RegisterBenchmark(("read_dimacs/" + ud_case_list.back().name).c_str(),
+				 bm_read_dimacs, dimacs_buf.str());
+
+    ostringstream dump_buf;
+    graph.dump(dump_buf);
+    benchmark::RegisterBenchmark(("restore/" + ud_case_list.back().name).c_str(),
+				 bm_restore, dump_buf.str());
+
+    ostringstream bi_buf;
+    bi_case_list.back().second.write(bi_buf);
+    benchmark::RegisterBenchmark(("bigraph_read/" + bi_case_list.back().first).c_str(),
+				 bm_bigraph_read, bi_buf.str());
+  }
+
+  // 彩色
+  for ( auto algorithm: {"dsatur", "iscov", "isx", "isx2",
+			 "tabucol", "hea", "portfolio",
+			 "parallel-greedy", "parallel-greedy-jp"} ) {
+    for ( const auto& ud_case: ud_case_list ) {
+      string name = string("coloring/") + algorithm + "/" + ud_case.name;
+      benchmark::RegisterBenchmark(name.c_str(), bm_coloring,
+				   &ud_case.graph, string(algorithm))
+	->Unit(benchmark::kMillisecond)
+	->UseRealTime()
+	->Iterations(1);
+    }
+  }
+
+  // 最大クリーク
+  for ( const auto& ud_case: ud_case_list ) {
+    benchmark::RegisterBenchmark(("max_clique/greedy/" + ud_case.name).c_str(),
+				 bm_max_clique, &ud_case.graph, string("greedy"))
+      ->Unit(benchmark::kMillisecond);
+    if ( ud_case.heavy ) {
+      benchmark::RegisterBenchmark(("max_clique/exact/" + ud_case.name).c_str(),
+				   bm_max_clique, &ud_case.graph, string("exact"))
+	->Unit(benchmark::kMillisecond);
+      benchmark::RegisterBenchmark(("max_clique/weighted/" + ud_case.name).c_str(),
+				   bm_weighted_max_clique, &ud_case.graph)
+	->Unit(benchmark::kMillisecond);
+    }
+  }
+
+  // コア分解と独立集合
+  for ( const auto& ud_case: ud_case_list ) {
+    benchmark::RegisterBenchmark(("core_decomposition/" + ud_case.name).c_str(),
+				 bm_core_decomposition, &ud_case.graph)
+      ->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark(("independent_set/" + ud_case.name).c_str(),
+				 bm_independent_set, &ud_case.graph)
+      ->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark(("independent_set/weighted/" + ud_case.name).c_str(),
+				 bm_weighted_independent_set, &ud_case.graph)
+      ->Unit(benchmark::kMillisecond);
+    for ( auto nt: {1, 4} ) {
+      ostringstream buf;
+      buf << "maximal_cliques/t" << nt << "/" << ud_case.name;
+      benchmark::RegisterBenchmark(buf.str().c_str(),
+				   bm_maximal_cliques, &ud_case.graph, nt)
+	->Unit(benchmark::kMillisecond);
+    }
+  }
+
+  // 最大マッチング
+  //
+  // UdGraph::max_matching() は奇閉路を含むグラフを扱えないので
+  // 両方とも2部グラフを対象とする．
+  // また，重み付きだと終わらない場合があるので重みは全て 1 とする．
+  vector<pair<string, UdGraph>> bi_ud_list;
+  for ( const auto& bi_case: bi_case_list ) {
+    bi_ud_list.push_back({bi_case.first, to_udgraph(bi_case.second)});
+  }
+  // 初期解の求め方ごとに計測する．
+  vector<string> init_list{"greedy", "karp-sipser", "local-dominant"};
+  for ( const auto& bi_case: bi_ud_list ) {
+    for ( const auto& algorithm: init_list ) {
+      benchmark::RegisterBenchmark(("udgraph_max_matching/" + algorithm + "/" + bi_case.first).c_str(),
+				   bm_ud_max_matching, &bi_case.second, algorithm)
+	->Unit(benchmark::kMillisecond);
+    }
+  }
+  // 近似解は奇閉路を含んでいても構わない．
+  for ( const auto& ud_case: ud_case_list ) {
+    benchmark::RegisterBenchmark(("udgraph_max_matching/approx-parallel/" + ud_case.name).c_str(),
+				 bm_ud_approx_matching, &ud_case.graph)
+      ->Arg(0)->Arg(10)
+      ->Unit(benchmark::kMillisecond);
+  }
+  for ( const auto& bi_case: bi_case_list ) {
+    for ( const auto& algorithm: init_list ) {
+      benchmark::RegisterBenchmark(("bigraph_max_matching/" + algorithm + "/" + bi_case.first).c_str(),
+				   bm_bi_max_matching, &bi_case.second, algorithm)
+	->Unit(benchmark::kMillisecond);
+    }
+  }
+  for ( const auto& bi_case: bi_case_list ) {
+    benchmark::RegisterBenchmark(("bimatcher_update/" + bi_case.first).c_str(),
+				 bm_bi_matcher_update, &bi_case.second)
+      ->Arg(1)->Arg(10)
+      ->Unit(benchmark::kMillisecond);
+  }
+
+  benchmark::Initialize(&argc, argv);
+  if ( benchmark::ReportUnrecognizedArguments(argc, argv) ) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
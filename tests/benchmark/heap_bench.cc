@@ -0,0 +1,223 @@
+
+/// @file heap_bench.cc
+/// @brief NodeHeap/KeyHeap/BucketHeap のベンチマークプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// Google Benchmark を用いる．
+/// Dsatur や MclqSolver::greedy と同じように，全ノードを積んだ後で
+/// 最小のノードを取り出しては他のノードのキーを1ずつ変える操作を計る．
+
+
+#include "benchmark/benchmark.h"
+#include "NodeHeap.h"
+#include <memory>
+#include <random>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+BEGIN_NONAMESPACE
+
+// 乱数の種
+const int SEED = 20220401;
+
+// キーの最大値
+const int MAX_KEY = 1000;
+
+// 1回取り出すごとに更新するノード数
+const int UPDATE_NUM = 8;
+
+// ベンチマーク用のノード
+class BenchNode
+{
+public:
+
+  int
+  id() const
+  {
+    return mId;
+  }
+
+  int
+  key() const
+  {
+    return mKey;
+  }
+
+  int
+  heap_location() const
+  {
+    return mHeapLocation;
+  }
+
+  void
+  set_heap_location(int pos)
+  {
+    mHeapLocation = pos;
+  }
+
+  int mId{0};
+  int mKey{0};
+  int mHeapLocation{0};
+};
+
+// NodeHeap 用の比較関数
+class BenchComp
+{
+public:
+
+  int
+  operator()(BenchNode* node1,
+	     BenchNode* node2)
+  {
+    return node1->key() - node2->key();
+  }
+
+};
+
+// KeyHeap/BucketHeap 用のキー関数
+class BenchKey
+{
+public:
+
+  int
+  operator()(const BenchNode* node)
+  {
+    return node->key();
+  }
+
+};
+
+// ノードの配列を作る．
+vector<BenchNode>
+make_nodes(int n)
+{
+  std::mt19937 rg{SEED};
+  std::uniform_int_distribution<int> rd{MAX_KEY / 4, MAX_KEY * 3 / 4};
+  vector<BenchNode> node_array(n);
+  for ( int i = 0; i < n; ++ i ) {
+    node_array[i].mId = i;
+    node_array[i].mKey = rd(rg);
+  }
+  return node_array;
+}
+
+using BinaryHeap = NodeHeap<BenchNode, BenchComp, 2>;
+using QuadHeap = NodeHeap<BenchNode, BenchComp, 4>;
+using QuadKeyHeap = KeyHeap<BenchNode, BenchKey, 4>;
+using BenchBucketHeap = BucketHeap<BenchNode, BenchKey>;
+
+// ヒープを作る．
+template <typename Heap>
+std::unique_ptr<Heap>
+new_heap(int n)
+{
+  return std::unique_ptr<Heap>{new Heap(n)};
+}
+
+// BucketHeap はキーの最大値も指定する．
+template <>
+std::unique_ptr<BenchBucketHeap>
+new_heap<BenchBucketHeap>(int n)
+{
+  return std::unique_ptr<BenchBucketHeap>{new BenchBucketHeap(n, MAX_KEY)};
+}
+
+// 全てのノードを積む時間を計る．
+template <typename Heap,
+	  bool bulk>
+void
+bm_build(benchmark::State& state)
+{
+  int n = state.range(0);
+  auto node_array = make_nodes(n);
+  vector<BenchNode*> node_list;
+  for ( auto& node: node_array ) {
+    node_list.push_back(&node);
+  }
+  for ( auto _: state ) {
+    for ( auto& node: node_array ) {
+      node.mHeapLocation = 0;
+    }
+    auto heap = new_heap<Heap>(n);
+    if ( bulk ) {
+      heap->bulk_build(node_list);
+    }
+    else {
+      for ( auto node: node_list ) {
+	heap->put_node(node);
+      }
+    }
+    benchmark::DoNotOptimize(heap->empty());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// 取り出しと更新を繰り返す時間を計る．
+template <typename Heap>
+void
+bm_extract(benchmark::State& state)
+{
+  int n = state.range(0);
+  auto node_array0 = make_nodes(n);
+  std::mt19937 rg{SEED};
+  std::uniform_int_distribution<int> rd{0, n - 1};
+  vector<int> pick_list(n * UPDATE_NUM);
+  for ( auto& id: pick_list ) {
+    id = rd(rg);
+  }
+  for ( auto _: state ) {
+    state.PauseTiming();
+    auto node_array = node_array0;
+    vector<BenchNode*> node_list;
+    for ( auto& node: node_array ) {
+      node_list.push_back(&node);
+    }
+    vector<bool> done(n, false);
+    state.ResumeTiming();
+
+    auto heap = new_heap<Heap>(n);
+    heap->bulk_build(node_list);
+    int pos = 0;
+    while ( !heap->empty() ) {
+      auto node = heap->get_min();
+      done[node->id()] = true;
+      for ( int i = 0; i < UPDATE_NUM; ++ i, ++ pos ) {
+	int id = pick_list[pos];
+	if ( done[id] ) {
+	  continue;
+	}
+	auto& node1 = node_array[id];
+	// キーは1ずつ小さくなる(saturation degree が増える場合に相当)
+	if ( node1.mKey > 0 ) {
+	  -- node1.mKey;
+	  heap->update(&node1);
+	}
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM_UDGRAPH
+
+
+using namespace nsYm::nsUdGraph;
+
+BENCHMARK_TEMPLATE2(bm_build, BinaryHeap, false)->Arg(1 << 16);
+BENCHMARK_TEMPLATE2(bm_build, BinaryHeap, true)->Arg(1 << 16);
+BENCHMARK_TEMPLATE2(bm_build, QuadHeap, true)->Arg(1 << 16);
+BENCHMARK_TEMPLATE2(bm_build, QuadKeyHeap, true)->Arg(1 << 16);
+BENCHMARK_TEMPLATE2(bm_build, BenchBucketHeap, true)->Arg(1 << 16);
+
+BENCHMARK_TEMPLATE(bm_extract, BinaryHeap)->Arg(1 << 12)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(bm_extract, QuadHeap)->Arg(1 << 12)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(bm_extract, QuadKeyHeap)->Arg(1 << 12)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(bm_extract, BenchBucketHeap)->Arg(1 << 12)->Arg(1 << 16);
+
+BENCHMARK_MAIN();
@@ -9,6 +9,7 @@
 
 #include "gtest/gtest.h"
 #include "ym/BiGraph.h"
+#include <random>
 
 
 BEGIN_NAMESPACE_YM
@@ -46,6 +47,26 @@ TEST(BiGraphTest, constructor2)
   ASSERT_EQ( 2, edge1.id2 );
 }
 
+TEST(BiGraphTest, add_edges)
+{
+  // 枝のリストをムーブするコンストラクタと add_edges() のテスト
+  vector<BiGraph::Edge> edge_list{{0, 1}, {2, 0, 3}};
+  auto ptr = edge_list.data();
+  BiGraph graph(3, 2, std::move(edge_list));
+  EXPECT_EQ( ptr, graph.edge_list().data() );
+
+  graph.reserve(4);
+  graph.add_edges(vector<BiGraph::Edge>{{1, 1}, {2, 1}});
+
+  ASSERT_EQ( 4, graph.edge_num() );
+  EXPECT_EQ( 2, graph.edge(1).id1 );
+  EXPECT_EQ( 0, graph.edge(1).id2 );
+  EXPECT_EQ( 3, graph.edge(1).weight );
+  EXPECT_EQ( 1, graph.edge(2).id1 );
+  EXPECT_EQ( 2, graph.edge(3).id1 );
+  EXPECT_EQ( 1, graph.edge(3).id2 );
+}
+
 TEST(BiGraphTest, max_match1)
 {
   int n1 = 4;
@@ -80,4 +101,108 @@ TEST(BiGraphTest, max_match2)
   ASSERT_EQ( 1, match[0] );
 }
 
+TEST(BiGraphTest, max_match3)
+{
+  // 完全マッチングが存在しない場合
+  // (増加路はないが交互閉路がある)
+  int n1 = 3;
+  int n2 = 2;
+  vector<BiGraph::Edge> edge_list{{0, 0}, {0, 1},
+				  {1, 0}, {1, 1},
+				  {2, 0}, {2, 1}};
+  BiGraph graph{n1, n2, edge_list};
+
+  auto match = graph.max_matching();
+
+  ASSERT_EQ( 2, match.size() );
+}
+
+TEST(BiGraphTest, max_match_repeat)
+{
+  // 作業領域を使い回しても結果が変わらないことを確かめる．
+  BiGraph graph1{4, 4, vector<BiGraph::Edge>{{0, 0}, {0, 1},
+					     {1, 0}, {1, 1}, {1, 2},
+					     {2, 1}, {2, 2},
+					     {3, 1}, {3, 2}, {3, 3}}};
+  BiGraph graph2{2, 2, vector<BiGraph::Edge>{{0, 0, 1},
+					     {1, 0, 3},
+					     {1, 1, 1}}};
+
+  auto match1 = graph1.max_matching();
+  auto match2 = graph2.max_matching();
+  EXPECT_EQ( 4, match1.size() );
+  EXPECT_EQ( 1, match2.size() );
+  EXPECT_EQ( match1, graph1.max_matching() );
+  EXPECT_EQ( match2, graph2.max_matching() );
+
+  // 呼び出し側の作業領域を使い回す．
+  BiGraph::MatchingWork work;
+  EXPECT_EQ( match1, graph1.max_matching(string(), work) );
+  EXPECT_EQ( match2, graph2.max_matching(string(), work) );
+  EXPECT_EQ( match1, graph1.max_matching(string(), work) );
+}
+
+TEST(BiGraphTest, max_match_perfect)
+{
+  // (i, i) の枝を必ず含むので完全マッチングが存在する．
+  // 貪欲法の初期解からの増加路の探索を確かめる．
+  int n = 500;
+  std::mt19937 rg{1};
+  std::uniform_int_distribution<int> rd{0, n - 1};
+  BiGraph graph{n, n};
+  for ( int i = 0; i < n; ++ i ) {
+    for ( int k = 0; k < 10; ++ k ) {
+      graph.add_edge(i, rd(rg));
+    }
+    graph.add_edge(i, i);
+  }
+
+  auto match = graph.max_matching();
+
+  ASSERT_EQ( n, match.size() );
+  vector<bool> used1(n, false);
+  vector<bool> used2(n, false);
+  for ( auto pos: match ) {
+    const auto& edge = graph.edge(pos);
+    EXPECT_FALSE( used1[edge.id1] );
+    EXPECT_FALSE( used2[edge.id2] );
+    used1[edge.id1] = true;
+    used2[edge.id2] = true;
+  }
+}
+
+TEST(BiGraphTest, max_match_init)
+{
+  // 初期解の求め方によらず要素数は変わらない．
+  int n = 500;
+  std::mt19937 rg{2};
+  std::uniform_int_distribution<int> rd{0, n - 1};
+  BiGraph graph{n, n};
+  for ( int i = 0; i < n * 3; ++ i ) {
+    graph.add_edge(rd(rg), rd(rg));
+  }
+  auto size = graph.max_matching().size();
+
+  BiGraph graph2{2, 2, vector<BiGraph::Edge>{{0, 0, 1},
+					     {1, 0, 3},
+					     {1, 1, 1}}};
+
+  for ( auto algorithm: {"greedy", "karp-sipser", "local-dominant", "suitor",
+			  "foo"} ) {
+    auto match = graph.max_matching(algorithm);
+    EXPECT_EQ( size, match.size() ) << algorithm;
+    vector<bool> used1(n, false);
+    vector<bool> used2(n, false);
+    for ( auto pos: match ) {
+      const auto& edge = graph.edge(pos);
+      EXPECT_FALSE( used1[edge.id1] );
+      EXPECT_FALSE( used2[edge.id2] );
+      used1[edge.id1] = true;
+      used2[edge.id2] = true;
+    }
+
+    EXPECT_EQ( vector<int>{1}, graph2.max_matching(algorithm) ) << algorithm;
+  }
+}
+
 END_NAMESPACE_YM
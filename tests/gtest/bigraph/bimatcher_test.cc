@@ -0,0 +1,282 @@
+
+/// @file bimatcher_test.cc
+/// @brief BiMatcher のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "ym/BiMatcher.h"
+#include <algorithm>
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// マッチングになっているか調べる．
+void
+check_matching(const BiMatcher& matcher,
+	       const vector<int>& match)
+{
+  vector<bool> used1(matcher.node1_num(), false);
+  vector<bool> used2(matcher.node2_num(), false);
+  for ( auto idx: match ) {
+    EXPECT_FALSE( matcher.is_removed(idx) );
+    const auto& edge = matcher.edge(idx);
+    EXPECT_FALSE( used1[edge.id1] );
+    EXPECT_FALSE( used2[edge.id2] );
+    used1[edge.id1] = true;
+    used2[edge.id2] = true;
+  }
+}
+
+// 削除されていない枝からなるグラフを作る．
+BiGraph
+live_graph(const BiMatcher& matcher)
+{
+  BiGraph graph{matcher.node1_num(), matcher.node2_num()};
+  for ( int i = 0; i < matcher.edge_num(); ++ i ) {
+    if ( !matcher.is_removed(i) ) {
+      const auto& edge = matcher.edge(i);
+      graph.add_edge(edge.id1, edge.id2, edge.weight);
+    }
+  }
+  return graph;
+}
+
+// 選ばれた枝の重みの和を求める．
+int
+match_weight(const BiMatcher& matcher,
+	     const vector<int>& match)
+{
+  int weight = 0;
+  for ( auto idx: match ) {
+    weight += matcher.edge(idx).weight;
+  }
+  return weight;
+}
+
+// BiGraph のマッチングの重みの和を求める．
+int
+match_weight(const BiGraph& graph,
+	     const vector<int>& match)
+{
+  int weight = 0;
+  for ( auto idx: match ) {
+    weight += graph.edge(idx).weight;
+  }
+  return weight;
+}
+
+// 全ての組み合わせを調べて最大の重みを求める．
+int
+brute_force_weight(const BiMatcher& matcher)
+{
+  int n2 = matcher.node2_num();
+  // best[i][mask]: 左側の i 番目以降で右側の mask を使わない時の最大値
+  vector<int> best(1 << n2, 0);
+  for ( int i = matcher.node1_num() - 1; i >= 0; -- i ) {
+    vector<int> best1(best);
+    for ( int idx = 0; idx < matcher.edge_num(); ++ idx ) {
+      const auto& edge = matcher.edge(idx);
+      if ( matcher.is_removed(idx) || edge.id1 != i ) {
+	continue;
+      }
+      int bit = 1 << edge.id2;
+      for ( int mask = 0; mask < (1 << n2); ++ mask ) {
+	if ( (mask & bit) == 0 ) {
+	  best1[mask] = std::max(best1[mask], best[mask | bit] + edge.weight);
+	}
+      }
+    }
+    best.swap(best1);
+  }
+  return best[0];
+}
+
+END_NONAMESPACE
+
+TEST(BiMatcherTest, first)
+{
+  // 最初は BiGraph::max_matching() と同じ結果になる．
+  BiGraph graph{4, 4, vector<BiGraph::Edge>{{0, 0}, {0, 1},
+					    {1, 0}, {1, 1}, {1, 2},
+					    {2, 1}, {2, 2},
+					    {3, 1}, {3, 2}, {3, 3}}};
+  BiMatcher matcher{graph};
+
+  auto match = matcher.max_matching();
+  auto expected = graph.max_matching();
+  sort(expected.begin(), expected.end());
+  EXPECT_EQ( expected, match );
+}
+
+TEST(BiMatcherTest, remove_edge)
+{
+  BiGraph graph{3, 3, vector<BiGraph::Edge>{{0, 0}, {0, 1},
+					    {1, 1}, {1, 2},
+					    {2, 2}}};
+  BiMatcher matcher{graph};
+  auto match1 = matcher.max_matching();
+  EXPECT_EQ( 3, match1.size() );
+
+  // (0, 0) がなくなっても (0, 1), (1, 2), (2, 2) のうち
+  // 2本を選び直せる．
+  matcher.remove_edge(0);
+  auto match2 = matcher.max_matching();
+  EXPECT_EQ( 2, match2.size() );
+  check_matching(matcher, match2);
+
+  // 枝番号は変わらない．
+  int idx = matcher.add_edge(2, 0);
+  EXPECT_EQ( 5, idx );
+  auto match3 = matcher.max_matching();
+  EXPECT_EQ( 3, match3.size() );
+  check_matching(matcher, match3);
+}
+
+TEST(BiMatcherTest, set_weight)
+{
+  BiGraph graph{2, 2, vector<BiGraph::Edge>{{0, 0}, {1, 1},
+					    {0, 1}, {1, 0}}};
+  BiMatcher matcher{graph};
+  auto match1 = matcher.max_matching();
+  EXPECT_EQ( 2, match1.size() );
+
+  // 交差する枝を重くすると入れ替わる．
+  matcher.set_weight(2, 5);
+  matcher.set_weight(3, 5);
+  auto match2 = matcher.max_matching();
+  EXPECT_EQ( (vector<int>{2, 3}), match2 );
+
+  // 重さを逆にすると戻る．
+  matcher.set_weight(2, 1);
+  matcher.set_weight(3, 1);
+  matcher.set_weight(0, 3);
+  matcher.set_weight(1, 3);
+  auto match3 = matcher.max_matching();
+  EXPECT_EQ( (vector<int>{0, 1}), match3 );
+}
+
+TEST(BiMatcherTest, random_update)
+{
+  // 重みが全て 1 なら要素数は作り直した場合と等しくなる．
+  int n = 200;
+  std::mt19937 rg{1};
+  std::uniform_int_distribution<int> rd_node{0, n - 1};
+  BiGraph graph{n, n};
+  for ( int i = 0; i < n * 3; ++ i ) {
+    graph.add_edge(rd_node(rg), rd_node(rg));
+  }
+  BiMatcher matcher{graph};
+  auto match = matcher.max_matching();
+  EXPECT_EQ( graph.max_matching().size(), match.size() );
+
+  for ( int k = 0; k < 20; ++ k ) {
+    for ( int j = 0; j < 5; ++ j ) {
+      // 選ばれている枝を優先して消す．
+      std::uniform_int_distribution<int> rd_pos{0, static_cast<int>(match.size()) - 1};
+      matcher.remove_edge(match[rd_pos(rg)]);
+      matcher.add_edge(rd_node(rg), rd_node(rg));
+    }
+    match = matcher.max_matching();
+    check_matching(matcher, match);
+    EXPECT_EQ( live_graph(matcher).max_matching().size(), match.size() );
+  }
+}
+
+TEST(BiMatcherTest, warm_start_cycle)
+{
+  // 重い枝 (0, 1) を足すと，増加路ではなく交互閉路
+  // (0, 0) -> (0, 1) -> (1, 1) -> (1, 0) を反転させる必要がある．
+  BiGraph graph{2, 2, vector<BiGraph::Edge>{{0, 0, 5}, {1, 1, 5},
+					    {1, 0, 1}}};
+  BiMatcher matcher{graph};
+  auto match1 = matcher.max_matching();
+  EXPECT_EQ( 10, match_weight(matcher, match1) );
+
+  matcher.add_edge(0, 1, 20);
+  auto match2 = matcher.max_matching();
+  check_matching(matcher, match2);
+  EXPECT_EQ( 21, match_weight(matcher, match2) );
+}
+
+TEST(BiMatcherTest, random_weighted_update)
+{
+  // 重み付きでも作り直した場合より悪くならない．
+  int n = 40;
+  std::mt19937 rg{2};
+  std::uniform_int_distribution<int> rd_node{0, n - 1};
+  std::uniform_int_distribution<int> rd_weight{1, 20};
+  BiGraph graph{n, n};
+  for ( int i = 0; i < n * 3; ++ i ) {
+    graph.add_edge(rd_node(rg), rd_node(rg), rd_weight(rg));
+  }
+  BiMatcher matcher{graph};
+  auto match = matcher.max_matching();
+  check_matching(matcher, match);
+  EXPECT_LE( match_weight(graph, graph.max_matching()),
+	     match_weight(matcher, match) );
+
+  for ( int k = 0; k < 30; ++ k ) {
+    for ( int j = 0; j < 4; ++ j ) {
+      std::uniform_int_distribution<int> rd_pos{0, static_cast<int>(match.size()) - 1};
+      switch ( k % 3 ) {
+      case 0:
+	matcher.remove_edge(match[rd_pos(rg)]);
+	break;
+      case 1:
+	matcher.set_weight(match[rd_pos(rg)], rd_weight(rg));
+	break;
+      default:
+	break;
+      }
+      matcher.add_edge(rd_node(rg), rd_node(rg), rd_weight(rg));
+    }
+    match = matcher.max_matching();
+    check_matching(matcher, match);
+    auto graph1 = live_graph(matcher);
+    EXPECT_LE( match_weight(graph1, graph1.max_matching()),
+	       match_weight(matcher, match) );
+  }
+}
+
+TEST(BiMatcherTest, random_small_optimal)
+{
+  // 小さなグラフでは全探索の結果と一致する．
+  int n = 6;
+  std::mt19937 rg{3};
+  std::uniform_int_distribution<int> rd_node{0, n - 1};
+  std::uniform_int_distribution<int> rd_weight{1, 10};
+  for ( int trial = 0; trial < 20; ++ trial ) {
+    BiGraph graph{n, n};
+    for ( int i = 0; i < n * 2; ++ i ) {
+      graph.add_edge(rd_node(rg), rd_node(rg), rd_weight(rg));
+    }
+    BiMatcher matcher{graph};
+    auto match = matcher.max_matching();
+    EXPECT_EQ( brute_force_weight(matcher), match_weight(matcher, match) );
+    for ( int k = 0; k < 10; ++ k ) {
+      std::uniform_int_distribution<int> rd_edge{0, matcher.edge_num() - 1};
+      int idx = rd_edge(rg);
+      if ( matcher.is_removed(idx) ) {
+	matcher.add_edge(rd_node(rg), rd_node(rg), rd_weight(rg));
+      }
+      else if ( k % 2 == 0 ) {
+	matcher.set_weight(idx, rd_weight(rg));
+      }
+      else {
+	matcher.remove_edge(idx);
+      }
+      match = matcher.max_matching();
+      check_matching(matcher, match);
+      EXPECT_EQ( brute_force_weight(matcher), match_weight(matcher, match) );
+    }
+  }
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,367 @@
+
+/// @file coloring_test.cc
+/// @brief UdGraph::coloring() のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "ym/UdGraph.h"
+#include "ym/GraphGen.h"
+#include <algorithm>
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+class ColoringTest :
+  public ::testing::TestWithParam<string>
+{
+public:
+
+  /// @brief テスト用のグラフを読み込む．
+  UdGraph
+  read_anna()
+  {
+    string filename = string(TESTDATA_DIR) + string("/anna.col");
+    return UdGraph::read_dimacs(filename);
+  }
+
+  /// @brief 彩色結果が妥当か調べる．
+  void
+  check_coloring(const UdGraph& graph,
+		 int nc,
+		 const vector<int>& color_map)
+  {
+    ASSERT_EQ( graph.node_num(), color_map.size() );
+    for ( auto c: color_map ) {
+      EXPECT_LE( 1, c );
+      EXPECT_GE( nc, c );
+    }
+    for ( const auto& edge: graph.edge_list() ) {
+      if ( edge.id1 != edge.id2 ) {
+	EXPECT_NE( color_map[edge.id1], color_map[edge.id2] );
+      }
+    }
+  }
+
+};
+
+TEST_P(ColoringTest, anna)
+{
+  auto graph = read_anna();
+  ASSERT_EQ( 138, graph.node_num() );
+
+  auto ans = graph.coloring(GetParam());
+  check_coloring(graph, ans.first, ans.second);
+
+  // anna.col の彩色数は 11
+  EXPECT_LE( 11, ans.first );
+}
+
+TEST_P(ColoringTest, cycle5)
+{
+  // 奇数長のサイクルは3彩色が最適
+  UdGraph graph(5);
+  for ( int i = 0; i < 5; ++ i ) {
+    graph.add_edge(i, (i + 1) % 5);
+  }
+
+  auto ans = graph.coloring(GetParam());
+  check_coloring(graph, ans.first, ans.second);
+  EXPECT_LE( 3, ans.first );
+}
+
+TEST_P(ColoringTest, callback)
+{
+  auto graph = read_anna();
+
+  UdGraph::ColoringOptions options;
+  options.extract_limit = 0;
+  vector<int> nc_list;
+  options.callback = [&](int k, const vector<int>& color_map) {
+    nc_list.push_back(k);
+    check_coloring(graph, k, color_map);
+  };
+  auto ans = graph.coloring(GetParam(), options);
+  check_coloring(graph, ans.first, ans.second);
+
+  // 彩色数が減少するたびに呼ばれる．
+  ASSERT_FALSE( nc_list.empty() );
+  for ( int i = 1; i < nc_list.size(); ++ i ) {
+    EXPECT_GT( nc_list[i - 1], nc_list[i] );
+  }
+  EXPECT_EQ( ans.first, nc_list.back() );
+}
+
+TEST_P(ColoringTest, time_limit)
+{
+  auto graph = read_anna();
+
+  UdGraph::ColoringOptions options;
+  options.time_limit = 0.01;
+  options.seed = 1;
+  options.thread_num = 2;
+  auto ans = graph.coloring(GetParam(), options);
+  check_coloring(graph, ans.first, ans.second);
+}
+
+TEST_P(ColoringTest, stats)
+{
+  auto graph = read_anna();
+
+  UdGraph::ColoringOptions options;
+  options.time_limit = 0.05;
+  UdGraph::ColoringStats stats;
+  auto ans = graph.coloring(GetParam(), options, stats);
+  check_coloring(graph, ans.first, ans.second);
+  EXPECT_FALSE( stats.solver.empty() );
+  EXPECT_LE( stats.lower_bound, ans.first );
+#if defined(YM_GRAPH_STATS)
+  EXPECT_LT( 0, stats.perf.iterations );
+  EXPECT_LT( 0.0, stats.perf.setup_time + stats.perf.search_time );
+  EXPECT_LT( 0, stats.perf.peak_memory );
+#else
+  EXPECT_EQ( 0, stats.perf.iterations );
+  EXPECT_EQ( 0, stats.perf.peak_memory );
+#endif
+}
+
+TEST_P(ColoringTest, components)
+{
+  // 1500 ノードの奇数長のサイクルと 5 ノードの完全グラフ，孤立ノード
+  const int n = 1501 + 5 + 10;
+  UdGraph graph(n);
+  for ( int i = 0; i < 1501; ++ i ) {
+    graph.add_edge(i, (i + 1) % 1501);
+  }
+  for ( int i = 0; i < 5; ++ i ) {
+    for ( int j = i + 1; j < 5; ++ j ) {
+      graph.add_edge(1501 + i, 1501 + j);
+    }
+  }
+
+  UdGraph::ColoringOptions options;
+  options.time_limit = 0.5;
+  vector<int> nc_list;
+  options.callback = [&](int k, const vector<int>& color_map) {
+    nc_list.push_back(k);
+  };
+  UdGraph::ColoringStats stats;
+  auto ans = graph.coloring(GetParam(), options, stats);
+  check_coloring(graph, ans.first, ans.second);
+  EXPECT_LE( 5, ans.first );
+  EXPECT_LE( stats.lower_bound, ans.first );
+  ASSERT_FALSE( nc_list.empty() );
+  EXPECT_EQ( ans.first, nc_list.back() );
+}
+
+INSTANTIATE_TEST_SUITE_P(UdGraphTest,
+			 ColoringTest,
+			 ::testing::Values("dsatur", "iscov", "isx", "isx2",
+					   "tabucol", "hea", "portfolio",
+					   "parallel-greedy",
+					   "parallel-greedy-jp"));
+
+TEST(UdGraphTest, coloring_lower_bound)
+{
+  // anna.col は dsatur の結果が最適なので下界で探索が打ち切られる．
+  string filename = string(TESTDATA_DIR) + string("/anna.col");
+  auto graph = UdGraph::read_dimacs(filename);
+
+  for ( auto algorithm: {"tabucol", "hea"} ) {
+    UdGraph::ColoringOptions options;
+    UdGraph::ColoringStats stats;
+    auto ans = graph.coloring(algorithm, options, stats);
+    EXPECT_EQ( 11, ans.first );
+    EXPECT_EQ( 11, stats.lower_bound );
+  }
+}
+
+TEST(UdGraphTest, coloring_planted)
+{
+  // 5 彩色を埋め込んだグラフに各色1ノードずつからなる K5 を加える．
+  // 彩色数はちょうど 5 で，クリークによる下界も 5 となる．
+  const int n = 200;
+  const int k = 5;
+  GraphGen gen(0);
+  auto p = gen.planted_coloring(n, k, 0.2);
+  auto graph = p.first;
+  vector<int> rep_list;
+  vector<bool> used(n, false);
+  for ( int i = 0; i < n; ++ i ) {
+    int c = p.second[i];
+    if ( !used[c] ) {
+      used[c] = true;
+      rep_list.push_back(i);
+    }
+  }
+  ASSERT_EQ( k, rep_list.size() );
+  for ( int i = 0; i < k; ++ i ) {
+    for ( int j = i + 1; j < k; ++ j ) {
+      graph.add_edge(rep_list[i], rep_list[j]);
+    }
+  }
+
+  // 構築的な方法は最適解が得られるとは限らないが，妥当な彩色となる．
+  for ( auto algorithm: {"dsatur", "iscov", "isx", "isx2"} ) {
+    auto ans = graph.coloring(algorithm);
+    EXPECT_LE( k, ans.first ) << algorithm;
+    for ( auto c: ans.second ) {
+      EXPECT_LE( 1, c ) << algorithm;
+      EXPECT_GE( ans.first, c ) << algorithm;
+    }
+    for ( const auto& edge: graph.edge_list() ) {
+      EXPECT_NE( ans.second[edge.id1], ans.second[edge.id2] ) << algorithm;
+    }
+  }
+
+  // TabuCol::search() と Hea(TabuCol::improve()) は最適解に達する．
+  for ( auto algorithm: {"tabucol", "hea"} ) {
+    UdGraph::ColoringOptions options;
+    UdGraph::ColoringStats stats;
+    auto ans = graph.coloring(algorithm, options, stats);
+    EXPECT_EQ( k, ans.first );
+    EXPECT_EQ( k, stats.lower_bound );
+    for ( const auto& edge: graph.edge_list() ) {
+      EXPECT_NE( ans.second[edge.id1], ans.second[edge.id2] );
+    }
+  }
+}
+
+TEST(UdGraphTest, coloring_components_callback)
+{
+  // 二つの大きな連結成分からなるグラフでも途中結果は
+  // 全体の彩色結果として報告される．
+  // "hea" と "portfolio" では通常は最終結果の前に途中結果が報告されるが，
+  // 回数は実行時間に依存するので調べない．
+  const int n = 1200;
+  GraphGen gen(1);
+  UdGraph graph(n * 2);
+  for ( int t = 0; t < 2; ++ t ) {
+    auto graph1 = gen.planted_coloring(n, 5, 0.05).first;
+    for ( const auto& edge: graph1.edge_list() ) {
+      graph.add_edge(edge.id1 + n * t, edge.id2 + n * t);
+    }
+  }
+
+  for ( auto algorithm: {"dsatur", "hea", "portfolio"} ) {
+    UdGraph::ColoringOptions options;
+    options.time_limit = 0.2;
+    options.thread_num = 4;
+    vector<int> nc_list;
+    options.callback = [&](int k, const vector<int>& color_map) {
+      nc_list.push_back(k);
+      ASSERT_EQ( graph.node_num(), color_map.size() );
+      for ( auto c: color_map ) {
+	EXPECT_LE( 1, c );
+	EXPECT_GE( k, c );
+      }
+      for ( const auto& edge: graph.edge_list() ) {
+	EXPECT_NE( color_map[edge.id1], color_map[edge.id2] );
+      }
+    };
+    auto ans = graph.coloring(algorithm, options);
+    ASSERT_FALSE( nc_list.empty() ) << algorithm;
+    EXPECT_EQ( ans.first, nc_list.back() ) << algorithm;
+    for ( int i = 1; i < nc_list.size(); ++ i ) {
+      EXPECT_GT( nc_list[i - 1], nc_list[i] ) << algorithm;
+    }
+  }
+}
+
+TEST(UdGraphTest, coloring_portfolio)
+{
+  // 完全グラフはクリークによる下界で最適性が示される．
+  const int n = 6;
+  UdGraph graph(n);
+  for ( int i = 0; i < n; ++ i ) {
+    for ( int j = i + 1; j < n; ++ j ) {
+      graph.add_edge(i, j);
+    }
+  }
+
+  UdGraph::ColoringOptions options;
+  options.thread_num = 2;
+  UdGraph::ColoringStats stats;
+  auto ans = graph.coloring("portfolio", options, stats);
+  EXPECT_EQ( n, ans.first );
+
+  // 最初に下界に達したアルゴリズムの名前が記録される．
+  vector<string> name_list{"dsatur", "iscov", "isx", "isx2", "tabucol", "hea"};
+  EXPECT_NE( name_list.end(),
+	     std::find(name_list.begin(), name_list.end(), stats.solver) );
+}
+
+TEST(UdGraphTest, coloring_parallel_greedy)
+{
+  // Jones-Plassmann 法の結果はスレッド数によらない．
+  const int n = 3000;
+  UdGraph graph(n);
+  std::mt19937 rg(1);
+  std::uniform_int_distribution<int> rd(0, n - 1);
+  for ( int i = 0; i < n * 8; ++ i ) {
+    int id1 = rd(rg);
+    int id2 = rd(rg);
+    if ( id1 != id2 ) {
+      graph.add_edge(id1, id2);
+    }
+  }
+
+  auto check = [&](const pair<int, vector<int>>& ans) {
+    for ( auto c: ans.second ) {
+      EXPECT_LE( 1, c );
+      EXPECT_GE( ans.first, c );
+    }
+    for ( const auto& edge: graph.edge_list() ) {
+      EXPECT_NE( ans.second[edge.id1], ans.second[edge.id2] );
+    }
+  };
+
+  for ( auto priority: {"random", "ldf", "sl"} ) {
+    UdGraph::ColoringOptions options;
+    options.greedy_priority = priority;
+    options.thread_num = 1;
+    auto ans1 = graph.coloring("parallel-greedy-jp", options);
+    check(ans1);
+    options.thread_num = 4;
+    auto ans2 = graph.coloring("parallel-greedy-jp", options);
+    EXPECT_EQ( ans1, ans2 );
+
+    auto ans3 = graph.coloring("parallel-greedy", options);
+    check(ans3);
+  }
+}
+
+TEST(UdGraphTest, coloring_parallel_greedy_tie)
+{
+  // seed が 0 の時，ノード 65336 と 81207 の優先度の乱数部分は等しい．
+  // パスの上で両者だけ次数を 3 にして隣接させると "ldf" の優先度が
+  // 等しくなるので，ノード番号で順序を決めないと同じ段で彩色される．
+  const int n = 90000;
+  const int id1 = 65336;
+  const int id2 = 81207;
+  UdGraph graph(n);
+  for ( int i = 0; i + 1 < n; ++ i ) {
+    graph.add_edge(i, i + 1);
+  }
+  graph.add_edge(id1, id2);
+
+  UdGraph::ColoringOptions options;
+  options.seed = 0;
+  options.greedy_priority = "ldf";
+  options.thread_num = 4;
+  for ( auto algorithm: {"parallel-greedy-jp", "parallel-greedy"} ) {
+    for ( int i = 0; i < 10; ++ i ) {
+      auto ans = graph.coloring(algorithm, options);
+      EXPECT_NE( ans.second[id1], ans.second[id2] ) << algorithm;
+      for ( const auto& edge: graph.edge_list() ) {
+	ASSERT_NE( ans.second[edge.id1], ans.second[edge.id2] ) << algorithm;
+      }
+    }
+  }
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,207 @@
+
+/// @file graph_gen_test.cc
+/// @brief GraphGen のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "ym/GraphGen.h"
+#include <set>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 自己ループと多重枝がないことを調べる．
+void
+check_simple(const UdGraph& graph)
+{
+  std::set<pair<int, int>> edge_set;
+  for ( const auto& edge: graph.edge_list() ) {
+    ASSERT_LT( edge.id1, edge.id2 );
+    ASSERT_GT( graph.node_num(), edge.id2 );
+    EXPECT_TRUE( edge_set.insert({edge.id1, edge.id2}).second );
+  }
+}
+
+// 枝のリストが等しいか調べる．
+void
+check_same(const UdGraph& graph1,
+	   const UdGraph& graph2)
+{
+  ASSERT_EQ( graph1.node_num(), graph2.node_num() );
+  ASSERT_EQ( graph1.edge_num(), graph2.edge_num() );
+  for ( int i = 0; i < graph1.edge_num(); ++ i ) {
+    EXPECT_EQ( graph1.edge(i).id1, graph2.edge(i).id1 );
+    EXPECT_EQ( graph1.edge(i).id2, graph2.edge(i).id2 );
+  }
+}
+
+END_NONAMESPACE
+
+TEST(GraphGenTest, gnp)
+{
+  int n = 2000;
+  double p = 0.01;
+  GraphGen gen1(1, 1);
+  GraphGen gen4(1, 4);
+  auto graph = gen1.gnp(n, p);
+  check_simple(graph);
+
+  // 期待値は 19990 で標準偏差は 141 程度
+  EXPECT_LT( 19000, graph.edge_num() );
+  EXPECT_GT( 21000, graph.edge_num() );
+
+  // スレッド数によらず同じ結果になる．
+  check_same(graph, gen4.gnp(n, p));
+
+  // 種が異なれば異なる結果になる．
+  GraphGen gen2(2, 4);
+  EXPECT_NE( graph.edge_list()[0].id2, gen2.gnp(n, p).edge_list()[0].id2 );
+
+  // p = 1 なら完全グラフ
+  EXPECT_EQ( 45, gen4.gnp(10, 1.0).edge_num() );
+  EXPECT_EQ( 0, gen4.gnp(10, 0.0).edge_num() );
+}
+
+TEST(GraphGenTest, gnm)
+{
+  GraphGen gen1(3, 1);
+  GraphGen gen4(3, 4);
+  for ( SizeType m: {0, 1, 5000, 400000, 499500} ) {
+    auto graph = gen1.gnm(1000, m);
+    EXPECT_EQ( m, graph.edge_num() );
+    check_simple(graph);
+    check_same(graph, gen4.gnm(1000, m));
+  }
+
+  // ノード対の総数を超える場合は完全グラフ
+  EXPECT_EQ( 45, gen4.gnm(10, 100).edge_num() );
+}
+
+TEST(GraphGenTest, barabasi_albert)
+{
+  int n = 5000;
+  int m = 3;
+  GraphGen gen1(5, 1);
+  GraphGen gen4(5, 4);
+  auto graph = gen1.barabasi_albert(n, m);
+  ASSERT_EQ( (n - 1) * m, graph.edge_num() );
+
+  vector<int> degree(n, 0);
+  for ( const auto& edge: graph.edge_list() ) {
+    ASSERT_LT( edge.id1, edge.id2 );
+    ++ degree[edge.id1];
+    ++ degree[edge.id2];
+  }
+  // 優先的選択なので古いノードほど次数が大きい．
+  EXPECT_LT( 50, degree[0] + degree[1] );
+
+  check_same(graph, gen4.barabasi_albert(n, m));
+}
+
+TEST(GraphGenTest, rmat)
+{
+  int scale = 12;
+  SizeType m = 30000;
+  GraphGen gen1(7, 1);
+  GraphGen gen4(7, 4);
+  auto graph = gen1.rmat(scale, m);
+  ASSERT_EQ( 1 << scale, graph.node_num() );
+  ASSERT_EQ( m, graph.edge_num() );
+  for ( const auto& edge: graph.edge_list() ) {
+    ASSERT_LT( edge.id1, edge.id2 );
+  }
+  check_same(graph, gen4.rmat(scale, m));
+}
+
+TEST(GraphGenTest, geometric)
+{
+  int n = 3000;
+  GraphGen gen1(11, 1);
+  GraphGen gen4(11, 4);
+  auto graph = gen1.geometric(n, 0.02);
+  check_simple(graph);
+
+  // 期待値は n^2 π r^2 / 2 = 5655 程度(境界の効果で少し減る)
+  EXPECT_LT( 4500, graph.edge_num() );
+  EXPECT_GT( 6500, graph.edge_num() );
+
+  check_same(graph, gen4.geometric(n, 0.02));
+
+  // 対角線より長ければ完全グラフ
+  EXPECT_EQ( 4950, gen4.geometric(100, 1.5).edge_num() );
+}
+
+TEST(GraphGenTest, planted_coloring)
+{
+  int n = 1000;
+  int k = 5;
+  GraphGen gen(13);
+  UdGraph graph;
+  vector<int> color_map;
+  tie(graph, color_map) = gen.planted_coloring(n, k, 0.1);
+  check_simple(graph);
+  ASSERT_EQ( n, color_map.size() );
+  vector<int> count(k, 0);
+  for ( auto c: color_map ) {
+    ASSERT_LE( 0, c );
+    ASSERT_GT( k, c );
+    ++ count[c];
+  }
+  for ( auto c: count ) {
+    EXPECT_EQ( n / k, c );
+  }
+  for ( const auto& edge: graph.edge_list() ) {
+    EXPECT_NE( color_map[edge.id1], color_map[edge.id2] );
+  }
+}
+
+TEST(GraphGenTest, planted_clique)
+{
+  int n = 300;
+  int s = 12;
+  GraphGen gen(17);
+  UdGraph graph;
+  vector<int> clique;
+  tie(graph, clique) = gen.planted_clique(n, 0.05, s);
+  check_simple(graph);
+  ASSERT_EQ( s, clique.size() );
+
+  std::set<pair<int, int>> edge_set;
+  for ( const auto& edge: graph.edge_list() ) {
+    edge_set.insert({edge.id1, edge.id2});
+  }
+  for ( int i = 0; i < s; ++ i ) {
+    for ( int j = i + 1; j < s; ++ j ) {
+      EXPECT_TRUE( edge_set.count({clique[i], clique[j]}) > 0 );
+    }
+  }
+  EXPECT_EQ( s, graph.max_clique("exact").size() );
+}
+
+TEST(GraphGenTest, bipartite)
+{
+  GraphGen gen1(19, 1);
+  GraphGen gen4(19, 4);
+  auto graph1 = gen1.bipartite(500, 300, 0.02);
+  auto graph4 = gen4.bipartite(500, 300, 0.02);
+  ASSERT_EQ( 500, graph1.node1_num() );
+  ASSERT_EQ( 300, graph1.node2_num() );
+
+  // 期待値は 3000 で標準偏差は 54 程度
+  EXPECT_LT( 2700, graph1.edge_num() );
+  EXPECT_GT( 3300, graph1.edge_num() );
+
+  ASSERT_EQ( graph1.edge_num(), graph4.edge_num() );
+  for ( int i = 0; i < graph1.edge_num(); ++ i ) {
+    EXPECT_EQ( graph1.edge(i).id1, graph4.edge(i).id1 );
+    EXPECT_EQ( graph1.edge(i).id2, graph4.edge(i).id2 );
+  }
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,101 @@
+
+/// @file logger_test.cc
+/// @brief GraphLogger のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "ym/GraphLogger.h"
+#include "ym/UdGraph.h"
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM
+
+TEST(GraphLoggerTest, disabled)
+{
+  GraphLogger::set_sink(nullptr);
+  EXPECT_FALSE( GraphLogger::enabled(GraphLogger::Level::Error) );
+
+  // シンクがなければ何も起こらない．
+  GraphLogger::log(GraphLogger::Level::Error, "test", "message");
+  GraphLogger::flush();
+}
+
+TEST(GraphLoggerTest, level)
+{
+  vector<GraphLogger::Record> rec_list;
+  GraphLogger::set_sink([&](const GraphLogger::Record& rec) {
+    rec_list.push_back(rec);
+  }, GraphLogger::Level::Warning);
+  EXPECT_TRUE( GraphLogger::enabled(GraphLogger::Level::Error) );
+  EXPECT_TRUE( GraphLogger::enabled(GraphLogger::Level::Warning) );
+  EXPECT_FALSE( GraphLogger::enabled(GraphLogger::Level::Info) );
+
+  GraphLogger::log(GraphLogger::Level::Error, "test", "e");
+  GraphLogger::log(GraphLogger::Level::Info, "test", "i");
+  GraphLogger::log(GraphLogger::Level::Warning, "test", "w");
+  GraphLogger::flush();
+  GraphLogger::set_sink(nullptr);
+
+  ASSERT_EQ( 2, rec_list.size() );
+  EXPECT_EQ( GraphLogger::Level::Error, rec_list[0].level );
+  EXPECT_EQ( "test", rec_list[0].source );
+  EXPECT_EQ( "e", rec_list[0].message );
+  EXPECT_EQ( "w", rec_list[1].message );
+}
+
+TEST(GraphLoggerTest, multi_thread)
+{
+  // シンクはバックグラウンドのスレッドからのみ呼ばれるので排他制御は要らない．
+  SizeType count = 0;
+  GraphLogger::set_sink([&](const GraphLogger::Record& rec) {
+    ++ count;
+  }, GraphLogger::Level::Debug);
+
+  auto dropped0 = GraphLogger::dropped_num();
+  const int thread_num = 4;
+  const int n = 10000;
+  vector<std::thread> thread_list;
+  for ( int i = 0; i < thread_num; ++ i ) {
+    thread_list.push_back(std::thread{[&]() {
+      for ( int j = 0; j < n; ++ j ) {
+	GraphLogger::log(GraphLogger::Level::Debug, "test", "m");
+      }
+    }});
+  }
+  for ( auto& th: thread_list ) {
+    th.join();
+  }
+  GraphLogger::flush();
+  GraphLogger::set_sink(nullptr);
+
+  // あふれた分は捨てられる．
+  auto dropped = GraphLogger::dropped_num() - dropped0;
+  EXPECT_EQ( thread_num * n, count + dropped );
+}
+
+TEST(GraphLoggerTest, isx2)
+{
+  string filename = string(TESTDATA_DIR) + string("/anna.col");
+  auto graph = UdGraph::read_dimacs(filename);
+
+  vector<string> msg_list;
+  GraphLogger::set_sink([&](const GraphLogger::Record& rec) {
+    if ( rec.source == "isx2" ) {
+      msg_list.push_back(rec.message);
+    }
+  }, GraphLogger::Level::Debug);
+  UdGraph::ColoringOptions options;
+  options.extract_limit = 10;
+  graph.coloring("isx2", options);
+  GraphLogger::flush();
+  GraphLogger::set_sink(nullptr);
+
+  EXPECT_FALSE( msg_list.empty() );
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,226 @@
+
+/// @file node_heap_test.cc
+/// @brief NodeHeap/KeyHeap/BucketHeap/PeelQueue のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "NodeHeap.h"
+#include "PeelQueue.h"
+#include <memory>
+#include <random>
+
+
+BEGIN_NAMESPACE_YM_UDGRAPH
+
+BEGIN_NONAMESPACE
+
+// キーの最大値
+const int MAX_KEY = 100;
+
+// テスト用のノード
+struct TestNode
+{
+  int
+  id() const
+  {
+    return mId;
+  }
+
+  int
+  heap_location() const
+  {
+    return mHeapLocation;
+  }
+
+  void
+  set_heap_location(int pos)
+  {
+    mHeapLocation = pos;
+  }
+
+  int mId{0};
+  int mKey{0};
+  int mHeapLocation{0};
+};
+
+// NodeHeap 用の比較関数
+struct TestComp
+{
+  int
+  operator()(TestNode* node1,
+	     TestNode* node2)
+  {
+    return node1->mKey - node2->mKey;
+  }
+};
+
+// KeyHeap/BucketHeap 用のキー関数
+struct TestKey
+{
+  int
+  operator()(const TestNode* node)
+  {
+    return node->mKey;
+  }
+};
+
+// ヒープを作る．
+template <typename Heap>
+std::unique_ptr<Heap>
+new_heap(int n)
+{
+  return std::unique_ptr<Heap>{new Heap(n)};
+}
+
+template <>
+std::unique_ptr<BucketHeap<TestNode, TestKey>>
+new_heap<BucketHeap<TestNode, TestKey>>(int n)
+{
+  return std::unique_ptr<BucketHeap<TestNode, TestKey>>{new BucketHeap<TestNode, TestKey>(n, MAX_KEY)};
+}
+
+END_NONAMESPACE
+
+template <typename Heap>
+class NodeHeapTest :
+  public ::testing::Test
+{
+};
+
+using HeapTypes = ::testing::Types<NodeHeap<TestNode, TestComp>,
+				   NodeHeap<TestNode, TestComp, 4>,
+				   KeyHeap<TestNode, TestKey, 4>,
+				   BucketHeap<TestNode, TestKey>>;
+TYPED_TEST_SUITE(NodeHeapTest, HeapTypes);
+
+TYPED_TEST(NodeHeapTest, random_ops)
+{
+  const int n = 1000;
+  std::mt19937 rg{1};
+  std::uniform_int_distribution<int> rd_key{0, MAX_KEY};
+  vector<TestNode> node_array(n);
+  vector<TestNode*> node_list;
+  for ( int i = 0; i < n; ++ i ) {
+    node_array[i].mId = i;
+    node_array[i].mKey = rd_key(rg);
+    node_list.push_back(&node_array[i]);
+  }
+
+  // 半分は bulk_build() で，残りは put_node() で積む．
+  auto heap = new_heap<TypeParam>(n);
+  vector<TestNode*> first_half(node_list.begin(), node_list.begin() + n / 2);
+  heap->bulk_build(first_half);
+  for ( int i = n / 2; i < n; ++ i ) {
+    heap->put_node(node_list[i]);
+  }
+
+  // キーを変えたり取り除いたりする．
+  vector<bool> in_heap(n, true);
+  std::uniform_int_distribution<int> rd_id{0, n - 1};
+  for ( int k = 0; k < n; ++ k ) {
+    int id = rd_id(rg);
+    if ( !in_heap[id] ) {
+      continue;
+    }
+    if ( k % 10 == 0 ) {
+      heap->delete_node(&node_array[id]);
+      in_heap[id] = false;
+    }
+    else {
+      node_array[id].mKey = rd_key(rg);
+      heap->update(&node_array[id]);
+    }
+  }
+
+  // キーの小さい順に取り出される．
+  int num = 0;
+  int prev_key = -1;
+  while ( !heap->empty() ) {
+    auto node = heap->get_min();
+    ASSERT_TRUE( in_heap[node->id()] );
+    in_heap[node->id()] = false;
+    EXPECT_LE( prev_key, node->mKey );
+    prev_key = node->mKey;
+    ++ num;
+  }
+  for ( int i = 0; i < n; ++ i ) {
+    EXPECT_FALSE( in_heap[i] );
+  }
+  EXPECT_LT( 0, num );
+}
+
+TYPED_TEST(NodeHeapTest, empty_build)
+{
+  auto heap = new_heap<TypeParam>(1);
+  heap->bulk_build(vector<TestNode*>{});
+  EXPECT_TRUE( heap->empty() );
+}
+
+TEST(PeelQueueTest, random_ops)
+{
+  const int n = 1000;
+  std::mt19937 rg{1};
+  std::uniform_int_distribution<int> rd_key{0, MAX_KEY};
+  vector<int> key_array(n);
+  PeelQueue queue;
+  // init() を2回呼んでも正しく動く．
+  queue.init(n, MAX_KEY);
+  queue.put(0, 0);
+  queue.init(n, MAX_KEY);
+  for ( int i = 0; i < n; ++ i ) {
+    key_array[i] = rd_key(rg);
+    queue.put(i, key_array[i]);
+  }
+  EXPECT_EQ( n, queue.size() );
+
+  // キーを減らしたり取り除いたりする．
+  std::uniform_int_distribution<int> rd_id{0, n - 1};
+  for ( int k = 0; k < n; ++ k ) {
+    int id = rd_id(rg);
+    if ( !queue.contains(id) ) {
+      continue;
+    }
+    if ( k % 10 == 0 ) {
+      queue.erase(id);
+      key_array[id] = -1;
+    }
+    else {
+      int delta = k % 3 + 1;
+      queue.dec_key(id, delta);
+      key_array[id] = std::max(key_array[id] - delta, 0);
+    }
+    EXPECT_EQ( key_array[id], queue.key(id) );
+  }
+
+  // node() は残っている要素を列挙する．
+  int num = 0;
+  for ( int i = 0; i < n; ++ i ) {
+    if ( key_array[i] >= 0 ) {
+      ++ num;
+    }
+  }
+  ASSERT_EQ( num, queue.size() );
+  for ( int pos = 0; pos < queue.size(); ++ pos ) {
+    EXPECT_LE( 0, key_array[queue.node(pos)] );
+  }
+
+  // キーの小さい順に取り出される．
+  int prev_key = -1;
+  while ( !queue.empty() ) {
+    int min_key = queue.min_key();
+    for ( auto id: queue.min_bucket() ) {
+      EXPECT_EQ( min_key, key_array[id] );
+    }
+    int id = queue.pop_min();
+    EXPECT_EQ( min_key, key_array[id] );
+    EXPECT_LE( prev_key, min_key );
+    EXPECT_FALSE( queue.contains(id) );
+    prev_key = min_key;
+  }
+}
+
+END_NAMESPACE_YM_UDGRAPH
@@ -0,0 +1,182 @@
+
+/// @file node_order_test.cc
+/// @brief UdGraph::node_order() のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "ym/UdGraph.h"
+
+
+BEGIN_NAMESPACE_YM
+
+class NodeOrderTest :
+  public ::testing::TestWithParam<string>
+{
+public:
+
+  /// @brief テスト用のグラフを読み込む．
+  UdGraph
+  read_anna()
+  {
+    string filename = string(TESTDATA_DIR) + string("/anna.col");
+    return UdGraph::read_dimacs(filename);
+  }
+
+  /// @brief order が置換になっているか調べる．
+  void
+  check_order(int n,
+	      const vector<int>& order)
+  {
+    ASSERT_EQ( n, order.size() );
+    vector<bool> mark(n, false);
+    for ( auto id: order ) {
+      ASSERT_LE( 0, id );
+      ASSERT_GT( n, id );
+      EXPECT_FALSE( mark[id] );
+      mark[id] = true;
+    }
+  }
+
+};
+
+TEST_P(NodeOrderTest, relabel)
+{
+  auto graph = read_anna();
+  auto order = graph.node_order(GetParam());
+  check_order(graph.node_num(), order);
+
+  auto graph1 = graph.relabel(order);
+  ASSERT_EQ( graph.node_num(), graph1.node_num() );
+  ASSERT_EQ( graph.edge_num(), graph1.edge_num() );
+  for ( int i = 0; i < graph.edge_num(); ++ i ) {
+    // 枝番号は変わらない．
+    const auto& edge = graph.edge(i);
+    const auto& edge1 = graph1.edge(i);
+    EXPECT_LE( edge1.id1, edge1.id2 );
+    int id1 = order[edge1.id1];
+    int id2 = order[edge1.id2];
+    EXPECT_EQ( edge.id1, std::min(id1, id2) );
+    EXPECT_EQ( edge.id2, std::max(id1, id2) );
+    EXPECT_EQ( edge.weight, edge1.weight );
+  }
+}
+
+TEST_P(NodeOrderTest, coloring)
+{
+  auto graph = read_anna();
+
+  UdGraph::ColoringOptions options;
+  options.reorder = GetParam();
+  int ncall = 0;
+  options.callback = [&](int k, const vector<int>& color_map) {
+    ++ ncall;
+    ASSERT_EQ( graph.node_num(), color_map.size() );
+  };
+  auto ans = graph.coloring("dsatur", options);
+  EXPECT_LT( 0, ncall );
+  ASSERT_EQ( graph.node_num(), ans.second.size() );
+  for ( const auto& edge: graph.edge_list() ) {
+    if ( edge.id1 != edge.id2 ) {
+      EXPECT_NE( ans.second[edge.id1], ans.second[edge.id2] );
+    }
+  }
+}
+
+TEST_P(NodeOrderTest, max_clique)
+{
+  auto graph = read_anna();
+
+  auto clique = graph.max_clique("exact", GetParam());
+  EXPECT_EQ( 11, clique.size() );
+  vector<vector<bool>> adj(graph.node_num(),
+			   vector<bool>(graph.node_num(), false));
+  for ( const auto& edge: graph.edge_list() ) {
+    adj[edge.id1][edge.id2] = true;
+    adj[edge.id2][edge.id1] = true;
+  }
+  for ( int i = 0; i < clique.size(); ++ i ) {
+    for ( int j = i + 1; j < clique.size(); ++ j ) {
+      EXPECT_TRUE( adj[clique[i]][clique[j]] );
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(UdGraphTest,
+			 NodeOrderTest,
+			 ::testing::Values("degree", "rcm", "gorder", "degeneracy"));
+
+TEST(UdGraphTest, node_order_rcm)
+{
+  // ノード番号をばらばらにしたサイクルは RCM で帯域幅が 2 になる．
+  const int n = 100;
+  UdGraph graph(n);
+  // n と 11 は互いに素なので id() は置換になる．
+  auto id = [=](int k) { return (k * 11) % n; };
+  for ( int i = 0; i < n; ++ i ) {
+    graph.add_edge(id(i), id((i + 1) % n));
+  }
+
+  auto graph1 = graph.relabel(graph.node_order("rcm"));
+  int bw = 0;
+  for ( const auto& edge: graph1.edge_list() ) {
+    bw = std::max(bw, edge.id2 - edge.id1);
+  }
+  EXPECT_EQ( 2, bw );
+}
+
+TEST(UdGraphTest, core_decomposition)
+{
+  // 5 ノードの完全グラフに長さ 3 のパスをつなげる．
+  UdGraph graph(8);
+  for ( int i = 0; i < 5; ++ i ) {
+    for ( int j = i + 1; j < 5; ++ j ) {
+      graph.add_edge(i, j);
+    }
+  }
+  graph.add_edge(4, 5);
+  graph.add_edge(5, 6);
+  graph.add_edge(6, 7);
+
+  vector<int> core_num;
+  int d = graph.core_decomposition(core_num);
+  EXPECT_EQ( 4, d );
+  vector<int> exp_core_num{4, 4, 4, 4, 4, 1, 1, 1};
+  EXPECT_EQ( exp_core_num, core_num );
+}
+
+TEST(UdGraphTest, node_order_degeneracy)
+{
+  // 各ノードの後ろにある隣接ノード数は縮退度以下となる．
+  // anna.col は同じ枝を2回ずつ含むので正規形にしてから数える．
+  string filename = string(TESTDATA_DIR) + string("/anna.col");
+  auto graph = UdGraph::read_dimacs(filename);
+  graph.canonicalize();
+  auto order = graph.node_order("degeneracy");
+  vector<int> pos(graph.node_num());
+  for ( int i = 0; i < order.size(); ++ i ) {
+    pos[order[i]] = i;
+  }
+  vector<int> later_num(graph.node_num(), 0);
+  for ( const auto& edge: graph.edge_list() ) {
+    if ( pos[edge.id1] < pos[edge.id2] ) {
+      ++ later_num[edge.id1];
+    }
+    else {
+      ++ later_num[edge.id2];
+    }
+  }
+  vector<int> core_num;
+  int d = graph.core_decomposition(core_num);
+  for ( auto id: order ) {
+    EXPECT_GE( d, later_num[id] );
+    EXPECT_GE( core_num[id], later_num[id] );
+  }
+  // anna.col の最大クリークは 11 で縮退度は 10 となる．
+  EXPECT_EQ( 10, d );
+}
+
+END_NAMESPACE_YM
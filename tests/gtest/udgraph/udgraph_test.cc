@@ -9,6 +9,9 @@
 
 #include "gtest/gtest.h"
 #include "ym/UdGraph.h"
+#include "ym/GraphGen.h"
+#include "GraphDecomp.h"
+#include <algorithm>
 
 
 BEGIN_NAMESPACE_YM
@@ -43,6 +46,281 @@ TEST(UdGraphTest, constructor2)
   ASSERT_EQ( 3, edge1.id2 );
 }
 
+TEST(UdGraphTest, constructor_move)
+{
+  // 枝のリストをムーブするコンストラクタのテスト
+  vector<UdGraph::Edge> edge_list{{1, 0, 2}, {2, 3}};
+  auto ptr = edge_list.data();
+  UdGraph graph(4, std::move(edge_list));
+
+  ASSERT_EQ( 2, graph.edge_num() );
+  // 領域がそのまま引き継がれている．
+  EXPECT_EQ( ptr, graph.edge_list().data() );
+
+  // 正規化されている．
+  EXPECT_EQ( 0, graph.edge(0).id1 );
+  EXPECT_EQ( 1, graph.edge(0).id2 );
+  EXPECT_EQ( 2, graph.edge(0).weight );
+  EXPECT_EQ( 2, graph.edge(1).id1 );
+  EXPECT_EQ( 3, graph.edge(1).id2 );
+}
+
+TEST(UdGraphTest, add_edges)
+{
+  UdGraph graph(5);
+  graph.reserve(4);
+  graph.add_edge(4, 0);
+  vector<UdGraph::Edge> edge_list{{3, 1}, {2, 2}, {1, 4, 7}};
+  graph.add_edges(edge_list);
+
+  ASSERT_EQ( 4, graph.edge_num() );
+  EXPECT_EQ( 0, graph.edge(0).id1 );
+  EXPECT_EQ( 4, graph.edge(0).id2 );
+  EXPECT_EQ( 1, graph.edge(1).id1 );
+  EXPECT_EQ( 3, graph.edge(1).id2 );
+  EXPECT_EQ( 2, graph.edge(2).id1 );
+  EXPECT_EQ( 2, graph.edge(2).id2 );
+  EXPECT_EQ( 1, graph.edge(3).id1 );
+  EXPECT_EQ( 4, graph.edge(3).id2 );
+  EXPECT_EQ( 7, graph.edge(3).weight );
+
+  // 空の追加
+  graph.add_edges(nullptr, 0);
+  graph.shrink_to_fit();
+  EXPECT_EQ( 4, graph.edge_num() );
+}
+
+TEST(UdGraphTest, pack)
+{
+  // 圧縮形式では重みが全て 1 の間は重みの配列を持たない．
+  EXPECT_EQ( 8, sizeof(UdGraph::NodePair) );
+  UdGraph graph(4);
+  EXPECT_FALSE( graph.is_packed() );
+  graph.pack();
+  ASSERT_TRUE( graph.is_packed() );
+  graph.add_edge(0, 1);
+  graph.add_edges({{2, 1}, {3, 2, 1}});
+  EXPECT_FALSE( graph.is_weighted() );
+  EXPECT_TRUE( graph.weight_list().empty() );
+  EXPECT_EQ( 2, graph.node_pair_list()[1].id2 );
+  EXPECT_EQ( 1, graph.edge_weight(1) );
+
+  // 1 以外の重みが現れた時に作られる．
+  graph.add_edge(0, 3, 5);
+  ASSERT_TRUE( graph.is_weighted() );
+  ASSERT_EQ( 4, graph.weight_list().size() );
+  EXPECT_EQ( 1, graph.weight_list()[0] );
+  EXPECT_EQ( 5, graph.weight_list()[3] );
+  EXPECT_EQ( 5, graph.edge_weight(3) );
+
+  int w = 0;
+  for ( const auto& edge: graph.edge_view() ) {
+    w += edge.weight;
+  }
+  EXPECT_EQ( 8, w );
+
+  // 非圧縮形式に戻しても内容は変わらない．
+  graph.unpack();
+  ASSERT_FALSE( graph.is_packed() );
+  ASSERT_EQ( 4, graph.edge_num() );
+  EXPECT_TRUE( graph.is_weighted() );
+  EXPECT_EQ( 1, graph.edge(1).id1 );
+  EXPECT_EQ( 2, graph.edge(1).id2 );
+  EXPECT_EQ( 5, graph.edge(3).weight );
+
+  // 圧縮形式の枝のリストをそのまま設定する．
+  vector<UdGraph::NodePair> pair_list{{1, 0}, {2, 3}};
+  auto ptr = pair_list.data();
+  graph.assign(std::move(pair_list));
+  ASSERT_TRUE( graph.is_packed() );
+  ASSERT_EQ( 2, graph.edge_num() );
+  EXPECT_FALSE( graph.is_weighted() );
+  EXPECT_EQ( ptr, graph.node_pair_list().data() );
+  EXPECT_EQ( 0, graph.edge_id1(0) );
+  EXPECT_EQ( 1, graph.edge_id2(0) );
+
+  // relabel() でも格納形式と重みは保たれる．
+  graph.assign({{0, 1}, {2, 3}}, {4, 6});
+  auto graph2 = graph.relabel({3, 2, 1, 0});
+  EXPECT_TRUE( graph2.is_packed() );
+  EXPECT_EQ( 2, graph2.edge_id1(0) );
+  EXPECT_EQ( 3, graph2.edge_id2(0) );
+  EXPECT_EQ( 4, graph2.edge_weight(0) );
+  EXPECT_EQ( 6, graph2.edge_weight(1) );
+
+  // canonicalize() も圧縮形式のまま行われる．
+  graph2.add_edge(3, 2, 1);
+  UdGraph::CanonicalizeOptions options;
+  options.combine = UdGraph::CanonicalizeOptions::Combine::Sum;
+  auto stats = graph2.canonicalize(options);
+  EXPECT_EQ( 1, stats.duplicate_num );
+  ASSERT_EQ( 2, graph2.edge_num() );
+  EXPECT_TRUE( graph2.is_packed() );
+  EXPECT_EQ( 6, graph2.edge_weight(0) );
+  EXPECT_EQ( 5, graph2.edge_weight(1) );
+}
+
+TEST(UdGraphTest, edge_view)
+{
+  using iterator = UdGraph::EdgeView::const_iterator;
+  using traits = std::iterator_traits<iterator>;
+  static_assert( std::is_same<traits::iterator_category,
+		 std::random_access_iterator_tag>::value, "" );
+  static_assert( std::is_same<traits::value_type, UdGraph::Edge>::value, "" );
+  static_assert( std::is_same<traits::difference_type, std::ptrdiff_t>::value, "" );
+
+  UdGraph graph(5, {{0, 1}, {1, 2, 3}, {2, 3}, {3, 4, 2}, {4, 4}});
+  for ( int i = 0; i < 2; ++ i ) {
+    if ( i == 1 ) {
+      graph.pack();
+    }
+    auto edge_view = graph.edge_view();
+    ASSERT_EQ( 5, edge_view.size() );
+    EXPECT_EQ( 5, std::distance(edge_view.begin(), edge_view.end()) );
+    auto n = std::count_if(edge_view.begin(), edge_view.end(),
+			   [](const UdGraph::Edge& edge) {
+			     return edge.weight > 1;
+			   });
+    EXPECT_EQ( 2, n );
+    auto p = std::find_if(edge_view.begin(), edge_view.end(),
+			  [](const UdGraph::Edge& edge) {
+			    return edge.id1 == edge.id2;
+			  });
+    EXPECT_EQ( 4, p - edge_view.begin() );
+    EXPECT_EQ( 3, (*(edge_view.begin() + 3)).id1 );
+    EXPECT_EQ( 3, edge_view.begin()[1].weight );
+    EXPECT_EQ( 2, (*(edge_view.end() - 2)).weight );
+  }
+}
+
+TEST(UdGraphTest, node_weight)
+{
+  // 重みが全て 1 の間は重みの配列を持たない．
+  UdGraph graph(4);
+  graph.add_edges({{0, 1}, {1, 2}, {2, 3}});
+  EXPECT_FALSE( graph.is_node_weighted() );
+  EXPECT_TRUE( graph.node_weight_list().empty() );
+  graph.set_node_weight(2, 1);
+  EXPECT_FALSE( graph.is_node_weighted() );
+  EXPECT_EQ( 1, graph.node_weight(3) );
+
+  graph.set_node_weight(3, 7);
+  ASSERT_TRUE( graph.is_node_weighted() );
+  ASSERT_EQ( 4, graph.node_weight_list().size() );
+  EXPECT_EQ( 1, graph.node_weight(0) );
+  EXPECT_EQ( 7, graph.node_weight(3) );
+
+  // relabel() ではノードと一緒に並べ替えられる．
+  graph.set_node_weight_list({2, 3, 5, 7});
+  auto graph2 = graph.relabel({3, 2, 1, 0});
+  EXPECT_EQ( 7, graph2.node_weight(0) );
+  EXPECT_EQ( 2, graph2.node_weight(3) );
+
+  // dump()/restore() と write_dimacs()/read_dimacs() で保たれる．
+  ostringstream obuf;
+  graph.dump(obuf);
+  istringstream s(obuf.str());
+  auto graph3 = UdGraph::restore(s);
+  EXPECT_EQ( graph.node_weight_list(), graph3.node_weight_list() );
+
+  ostringstream obuf2;
+  graph.write_dimacs(obuf2);
+  istringstream s2(obuf2.str());
+  auto graph4 = UdGraph::read_dimacs(s2);
+  EXPECT_EQ( graph.node_weight_list(), graph4.node_weight_list() );
+  EXPECT_EQ( 3, graph4.edge_num() );
+
+  // 空のリストで重みを持たない状態に戻る．
+  graph.set_node_weight_list({});
+  EXPECT_FALSE( graph.is_node_weighted() );
+}
+
+TEST(UdGraphTest, canonicalize)
+{
+  UdGraph graph(4);
+  graph.add_edge(2, 3, 4);
+  graph.add_edge(1, 0, 2);
+  graph.add_edge(3, 2, 5);
+  graph.add_edge(1, 1);
+  graph.add_edge(0, 1, 3);
+  graph.add_edge(1, 1);
+  EXPECT_FALSE( graph.is_canonical() );
+
+  auto graph2 = graph;
+  auto stats = graph.canonicalize();
+  EXPECT_TRUE( graph.is_canonical() );
+  EXPECT_EQ( 3, stats.duplicate_num );
+  EXPECT_EQ( 1, stats.self_loop_num );
+  ASSERT_EQ( 3, graph.edge_num() );
+  EXPECT_EQ( 0, graph.edge_id1(0) );
+  EXPECT_EQ( 1, graph.edge_id2(0) );
+  EXPECT_EQ( 3, graph.edge_weight(0) );
+  EXPECT_EQ( 1, graph.edge_id1(1) );
+  EXPECT_EQ( 1, graph.edge_id2(1) );
+  EXPECT_EQ( 1, graph.edge_weight(1) );
+  EXPECT_EQ( 2, graph.edge_id1(2) );
+  EXPECT_EQ( 3, graph.edge_id2(2) );
+  EXPECT_EQ( 5, graph.edge_weight(2) );
+
+  UdGraph::CanonicalizeOptions options;
+  options.combine = UdGraph::CanonicalizeOptions::Combine::First;
+  options.remove_self_loop = true;
+  stats = graph2.canonicalize(options);
+  EXPECT_EQ( 1, stats.self_loop_num );
+  ASSERT_EQ( 2, graph2.edge_num() );
+  EXPECT_EQ( 2, graph2.edge_weight(0) );
+  EXPECT_EQ( 4, graph2.edge_weight(1) );
+
+  // 重みを持たないグラフで重みの和をとると多重度になる．
+  UdGraph graph3(3);
+  graph3.add_edges({{0, 1}, {1, 0}, {1, 2}});
+  options.combine = UdGraph::CanonicalizeOptions::Combine::Sum;
+  graph3.canonicalize(options);
+  ASSERT_EQ( 2, graph3.edge_num() );
+  EXPECT_TRUE( graph3.is_weighted() );
+  EXPECT_EQ( 2, graph3.edge_weight(0) );
+  EXPECT_EQ( 1, graph3.edge_weight(1) );
+
+  graph3.add_edge(0, 2);
+  EXPECT_FALSE( graph3.is_canonical() );
+}
+
+TEST(UdGraphTest, canonicalize_large)
+{
+  // 複数のスレッドで基数ソートが行われる大きさ
+  GraphGen gen(1);
+  int n = 5000;
+  auto graph = gen.gnm(n, 300000);
+  // 向きを逆にした枝を加えて全て重複させる．
+  vector<UdGraph::Edge> edge_list;
+  for ( const auto& edge: graph.edge_list() ) {
+    edge_list.push_back({edge.id2, edge.id1});
+  }
+  graph.add_edges(edge_list);
+
+  auto expected = graph.edge_list();
+  std::sort(expected.begin(), expected.end(),
+	    [](const UdGraph::Edge& a, const UdGraph::Edge& b) {
+	      return a.id1 < b.id1 || (a.id1 == b.id1 && a.id2 < b.id2);
+	    });
+  auto last = std::unique(expected.begin(), expected.end(),
+			  [](const UdGraph::Edge& a, const UdGraph::Edge& b) {
+			    return a.id1 == b.id1 && a.id2 == b.id2;
+			  });
+  expected.erase(last, expected.end());
+
+  UdGraph::CanonicalizeOptions options;
+  options.thread_num = 4;
+  auto stats = graph.canonicalize(options);
+  ASSERT_EQ( expected.size(), graph.edge_num() );
+  EXPECT_EQ( expected.size(), stats.duplicate_num );
+  EXPECT_FALSE( graph.is_weighted() );
+  for ( SizeType i = 0; i < expected.size(); ++ i ) {
+    ASSERT_EQ( expected[i].id1, graph.edge_id1(i) );
+    ASSERT_EQ( expected[i].id2, graph.edge_id2(i) );
+  }
+}
+
 TEST(UdGraphTest, read_dimacs)
 {
   string filename = string(TESTDATA_DIR) + string("/anna.col");
@@ -67,6 +345,29 @@ TEST(UdGraphTest, read_dimacs)
   EXPECT_EQ( obuf2.str(), obuf.str() );
 }
 
+TEST(UdGraphTest, dump_restore)
+{
+  UdGraph graph(5);
+  graph.add_edge(0, 1, 3);
+  graph.add_edge(4, 2, 5);
+  graph.add_edge(1, 3);
+
+  ostringstream obuf;
+  graph.dump(obuf);
+
+  istringstream s(obuf.str());
+  UdGraph graph2 = UdGraph::restore(s);
+  ASSERT_EQ( 5, graph2.node_num() );
+  ASSERT_EQ( 3, graph2.edge_num() );
+  for ( int i = 0; i < 3; ++ i ) {
+    auto& edge1 = graph.edge(i);
+    auto& edge2 = graph2.edge(i);
+    EXPECT_EQ( edge1.id1, edge2.id1 );
+    EXPECT_EQ( edge1.id2, edge2.id2 );
+    EXPECT_EQ( edge1.weight, edge2.weight );
+  }
+}
+
 TEST(UdGraphTest, max_matching1)
 {
   vector<UdGraph::Edge> edge_list{{0, 2, 1},
@@ -109,4 +410,707 @@ TEST(UdGraphTest, max_matching2)
   EXPECT_EQ( 7, w );
 }
 
+TEST(UdGraphTest, max_matching3)
+{
+  // 完全マッチングが存在しない場合
+  // (増加路はないが交互閉路がある)
+  vector<UdGraph::Edge> edge_list{{0, 3}, {0, 4},
+				  {1, 3}, {1, 4},
+				  {2, 3}, {2, 4}};
+  UdGraph graph(5, edge_list);
+
+  vector<int> match = graph.max_matching();
+
+  EXPECT_EQ( 2, match.size() );
+}
+
+TEST(UdGraphTest, max_matching_repeat)
+{
+  // 作業領域を使い回しても結果が変わらないことを確かめる．
+  GraphGen gen(1);
+  auto graph1 = gen.gnm(200, 1000);
+  auto graph2 = gen.gnm(50, 100);
+
+  auto match1 = graph1.max_matching();
+  auto match2 = graph2.max_matching();
+  EXPECT_EQ( match1, graph1.max_matching() );
+  EXPECT_EQ( match2, graph2.max_matching() );
+  EXPECT_EQ( match1, graph1.max_matching() );
+
+  // 呼び出し側の作業領域を使い回す．
+  // 連結成分の数が変わっても結果は変わらない．
+  UdGraph::MatchingWork work;
+  UdGraph::MatchingOptions options;
+  UdGraph::MatchingStats stats;
+  EXPECT_EQ( match1, graph1.max_matching(string(), options, stats, work) );
+  EXPECT_EQ( match2, graph2.max_matching(string(), options, stats, work) );
+  EXPECT_EQ( match1, graph1.max_matching(string(), options, stats, work) );
+
+  vector<bool> used(graph1.node_num(), false);
+  for ( auto pos: match1 ) {
+    const auto& edge = graph1.edge(pos);
+    EXPECT_FALSE( used[edge.id1] );
+    EXPECT_FALSE( used[edge.id2] );
+    used[edge.id1] = true;
+    used[edge.id2] = true;
+  }
+}
+
+BEGIN_NONAMESPACE
+
+// 複数の連結成分からなるグラフを作る．
+//
+// - 1500 ノードのサイクル
+// - 50 個の 3 ノードのパス
+// - clique_num ノードの完全グラフ
+// ノード番号は成分ごとにまとまらないように並べ替える．
+UdGraph
+make_multi_component_graph(int clique_num)
+{
+  const int n = 1500 + 50 * 3 + clique_num;
+  // n と 11 は互いに素なので id() は置換になる．
+  auto id = [=](int k) { return (k * 11) % n; };
+  UdGraph graph(n);
+  int base = 0;
+  for ( int i = 0; i < 1500; ++ i ) {
+    graph.add_edge(id(base + i), id(base + (i + 1) % 1500));
+  }
+  base += 1500;
+  for ( int t = 0; t < 50; ++ t ) {
+    graph.add_edge(id(base + 0), id(base + 1));
+    graph.add_edge(id(base + 1), id(base + 2));
+    base += 3;
+  }
+  for ( int i = 0; i < clique_num; ++ i ) {
+    for ( int j = i + 1; j < clique_num; ++ j ) {
+      graph.add_edge(id(base + i), id(base + j));
+    }
+  }
+  return graph;
+}
+
+END_NONAMESPACE
+
+TEST(UdGraphTest, graph_decomp_thread_num)
+{
+  // 巨大な連結成分と孤立ノードからなるグラフでは
+  // ほぼ全てのスレッドを巨大な連結成分に割り当てる．
+  const int n = 5000;
+  UdGraph graph1(n + 1);
+  for ( int i = 0; i + 1 < n; ++ i ) {
+    graph1.add_edge(i, i + 1);
+  }
+  nsUdGraph::GraphDecomp decomp1(graph1);
+  ASSERT_EQ( 2, decomp1.part_num() );
+  EXPECT_EQ( 8, decomp1.part_thread_num(0, 8) );
+  EXPECT_EQ( 1, decomp1.part_thread_num(1, 8) );
+
+  // 同じ大きさの連結成分には等分する．
+  UdGraph graph2(n * 2);
+  for ( int i = 0; i + 1 < n; ++ i ) {
+    graph2.add_edge(i, i + 1);
+    graph2.add_edge(n + i, n + i + 1);
+  }
+  nsUdGraph::GraphDecomp decomp2(graph2);
+  ASSERT_EQ( 2, decomp2.part_num() );
+  EXPECT_EQ( 4, decomp2.part_thread_num(0, 8) );
+  EXPECT_EQ( 4, decomp2.part_thread_num(1, 8) );
+}
+
+TEST(UdGraphTest, max_clique_components)
+{
+  auto graph = make_multi_component_graph(5);
+
+  auto clique = graph.max_clique("exact");
+  ASSERT_EQ( 5, clique.size() );
+  for ( int i = 0; i < 5; ++ i ) {
+    for ( int j = i + 1; j < 5; ++ j ) {
+      bool found = false;
+      for ( const auto& edge: graph.edge_list() ) {
+	if ( (edge.id1 == clique[i] && edge.id2 == clique[j]) ||
+	     (edge.id1 == clique[j] && edge.id2 == clique[i]) ) {
+	  found = true;
+	  break;
+	}
+      }
+      EXPECT_TRUE( found );
+    }
+  }
+}
+
+TEST(UdGraphTest, max_clique_components_parallel)
+{
+  // "exact" は分枝数の上限で打ち切られるほど大きな連結成分を複数作る．
+  // 分枝数は呼び出しごとに数えるのでスレッド数によらず結果は同じになる．
+  const int np = 6;
+  const int n1 = 60;
+  UdGraph graph(np * n1);
+  for ( int i = 0; i < np; ++ i ) {
+    GraphGen gen(i);
+    auto graph1 = gen.gnp(n1, 0.5);
+    for ( const auto& edge: graph1.edge_list() ) {
+      graph.add_edge(edge.id1 + i * n1, edge.id2 + i * n1);
+    }
+  }
+
+  UdGraph::NodeSetOptions options;
+  options.thread_num = 1;
+  auto clique1 = graph.max_clique("exact", options);
+  options.thread_num = 4;
+  auto clique4 = graph.max_clique("exact", options);
+  EXPECT_EQ( clique1, clique4 );
+
+  // 制限時間は全ての連結成分で共有する．
+  options.time_limit = 0.5;
+  UdGraph::NodeSetStats stats;
+  auto clique = graph.max_clique("weighted", options, stats);
+  EXPECT_EQ( clique.size(), stats.weight );
+  EXPECT_LE( clique1.size(), clique.size() );
+}
+
+TEST(UdGraphTest, max_matching_components)
+{
+  // 奇数長の閉路を含まないように完全グラフは 2 ノードとする．
+  auto graph = make_multi_component_graph(2);
+
+  auto match = graph.max_matching();
+
+  // サイクルから 750 本，パスから 1 本ずつ，完全グラフから 1 本
+  EXPECT_EQ( 750 + 50 + 1, match.size() );
+  vector<bool> used(graph.node_num(), false);
+  for ( auto pos: match ) {
+    const auto& edge = graph.edge(pos);
+    EXPECT_FALSE( used[edge.id1] );
+    EXPECT_FALSE( used[edge.id2] );
+    used[edge.id1] = true;
+    used[edge.id2] = true;
+  }
+}
+
+TEST(UdGraphTest, max_matching_init)
+{
+  // 初期解の求め方によらず要素数は変わらない．
+  auto graph1 = make_multi_component_graph(2);
+
+  // 奇閉路を含まないように2部グラフとする．
+  int n = 300;
+  GraphGen gen(1);
+  auto src_graph = gen.gnm(n, n * 4);
+  UdGraph graph2(n * 2);
+  for ( const auto& edge: src_graph.edge_list() ) {
+    graph2.add_edge(edge.id1, edge.id2 + n);
+  }
+  auto size2 = graph2.max_matching().size();
+
+  for ( auto algorithm: {"greedy", "karp-sipser", "local-dominant", "suitor",
+			  "foo"} ) {
+    auto match1 = graph1.max_matching(algorithm);
+    EXPECT_EQ( 750 + 50 + 1, match1.size() ) << algorithm;
+
+    auto match2 = graph2.max_matching(algorithm);
+    EXPECT_EQ( size2, match2.size() ) << algorithm;
+    vector<bool> used(graph2.node_num(), false);
+    for ( auto pos: match2 ) {
+      const auto& edge = graph2.edge(pos);
+      EXPECT_FALSE( used[edge.id1] );
+      EXPECT_FALSE( used[edge.id2] );
+      used[edge.id1] = true;
+      used[edge.id2] = true;
+    }
+  }
+}
+
+TEST(UdGraphTest, max_matching_self_loop)
+{
+  // 自己ループは重くても選ばれない．
+  vector<UdGraph::Edge> edge_list{{0, 0, 100},
+				  {0, 1, 1},
+				  {1, 1, 50},
+				  {2, 3, 2},
+				  {3, 3, 9},
+				  {4, 4, 5}};
+  UdGraph graph(5, edge_list);
+
+  for ( auto algorithm: {"greedy", "karp-sipser", "local-dominant", "suitor",
+			  "foo"} ) {
+    UdGraph::MatchingStats stats;
+    auto match = graph.max_matching(algorithm, UdGraph::MatchingOptions{},
+				    stats);
+    sort(match.begin(), match.end());
+    EXPECT_EQ( (vector<int>{1, 3}), match ) << algorithm;
+    EXPECT_EQ( 3, stats.weight ) << algorithm;
+  }
+}
+
+TEST(UdGraphTest, max_matching_approx)
+{
+  // 重み付きのランダムグラフ
+  int n = 2000;
+  GraphGen gen(1);
+  auto src_graph = gen.gnm(n, n * 5);
+  UdGraph graph(n);
+  int k = 0;
+  for ( const auto& edge: src_graph.edge_list() ) {
+    graph.add_edge(edge.id1, edge.id2, (k * 7) % 10 + 1);
+    ++ k;
+  }
+
+  UdGraph::MatchingOptions options;
+  UdGraph::MatchingStats stats;
+  auto match = graph.max_matching("approx-parallel", options, stats);
+
+  vector<bool> used(n, false);
+  std::int64_t w = 0;
+  for ( auto pos: match ) {
+    const auto& edge = graph.edge(pos);
+    EXPECT_FALSE( used[edge.id1] );
+    EXPECT_FALSE( used[edge.id2] );
+    used[edge.id1] = true;
+    used[edge.id2] = true;
+    w += edge.weight;
+  }
+  EXPECT_EQ( w, stats.weight );
+  // 1/2 近似なので上界の半分以上となる．
+  EXPECT_LE( stats.weight, stats.upper_bound );
+  EXPECT_LE( stats.upper_bound, stats.weight * 2 );
+
+  // 両端がともに選ばれていない正の重みの枝はない(極大)．
+  for ( const auto& edge: graph.edge_list() ) {
+    EXPECT_TRUE( used[edge.id1] || used[edge.id2] );
+  }
+
+  // 増加路で改善すると重みは増えるが上界は変わらない．
+  options.augment_limit = 10;
+  UdGraph::MatchingStats stats2;
+  graph.max_matching("approx-parallel", options, stats2);
+  EXPECT_LE( stats.weight, stats2.weight );
+  EXPECT_EQ( stats.upper_bound, stats2.upper_bound );
+  EXPECT_LE( stats2.weight, stats2.upper_bound );
+
+  // 他のアルゴリズムでは上界を求めない．
+  UdGraph::MatchingStats stats3;
+  graph.max_matching("greedy", UdGraph::MatchingOptions{}, stats3);
+  EXPECT_EQ( 0, stats3.upper_bound );
+}
+
+TEST(UdGraphTest, max_matching_approx_self_loop)
+{
+  // 近似解でオープンなまま残るノードに自己ループがあっても
+  // 増加路で改善した時に選ばれない．
+  vector<UdGraph::Edge> edge_list{{0, 1, 2},
+				  {1, 2, 3},
+				  {2, 3, 2},
+				  {0, 0, 100},
+				  {3, 3, 100}};
+  UdGraph graph(4, edge_list);
+
+  UdGraph::MatchingOptions options;
+  UdGraph::MatchingStats stats;
+  auto match = graph.max_matching("approx-parallel", options, stats);
+  EXPECT_EQ( (vector<int>{1}), match );
+  EXPECT_EQ( 3, stats.weight );
+  EXPECT_EQ( 5, stats.upper_bound );
+
+  for ( auto limit: {1, -1} ) {
+    options.augment_limit = limit;
+    UdGraph::MatchingStats stats1;
+    auto match1 = graph.max_matching("approx-parallel", options, stats1);
+    sort(match1.begin(), match1.end());
+    EXPECT_EQ( (vector<int>{0, 2}), match1 ) << limit;
+    EXPECT_EQ( 4, stats1.weight ) << limit;
+    EXPECT_LE( stats1.weight, stats1.upper_bound ) << limit;
+  }
+}
+
+TEST(UdGraphTest, perf_stats)
+{
+  auto graph = make_multi_component_graph(2);
+
+  UdGraph::PerfStats clique_stats;
+  auto clique = graph.max_clique("exact", string(), clique_stats);
+  EXPECT_EQ( graph.max_clique("exact").size(), clique.size() );
+
+  UdGraph::PerfStats match_stats;
+  auto match = graph.max_matching(string(), string(), match_stats);
+  EXPECT_EQ( graph.max_matching().size(), match.size() );
+
+#if defined(YM_GRAPH_STATS)
+  EXPECT_LT( 0, clique_stats.branch_nodes );
+  EXPECT_EQ( match.size(), match_stats.augmentations );
+  EXPECT_LT( 0, match_stats.peak_memory );
+#else
+  EXPECT_EQ( 0, clique_stats.branch_nodes );
+  EXPECT_EQ( 0, match_stats.augmentations );
+#endif
+}
+
+TEST(UdGraphTest, independent_set)
+{
+  // 星グラフでは中心以外の全てのノードが選ばれる．
+  const int n = 10;
+  UdGraph graph(n);
+  for ( int i = 1; i < n; ++ i ) {
+    graph.add_edge(0, i);
+  }
+  auto node_set = graph.independent_set();
+  ASSERT_EQ( n - 1, node_set.size() );
+  for ( int i = 1; i < n; ++ i ) {
+    EXPECT_EQ( i, node_set[i - 1] );
+  }
+
+  // anna.col では独立集合かつ極大となる．
+  string filename = string(TESTDATA_DIR) + string("/anna.col");
+  auto graph2 = UdGraph::read_dimacs(filename);
+  auto node_set2 = graph2.independent_set();
+  vector<bool> mark(graph2.node_num(), false);
+  for ( auto id: node_set2 ) {
+    mark[id] = true;
+  }
+  vector<bool> covered = mark;
+  for ( const auto& edge: graph2.edge_list() ) {
+    if ( edge.id1 != edge.id2 ) {
+      EXPECT_FALSE( mark[edge.id1] && mark[edge.id2] );
+    }
+    if ( mark[edge.id1] ) {
+      covered[edge.id2] = true;
+    }
+    if ( mark[edge.id2] ) {
+      covered[edge.id1] = true;
+    }
+  }
+  for ( int i = 0; i < graph2.node_num(); ++ i ) {
+    EXPECT_TRUE( covered[i] );
+  }
+}
+
+BEGIN_NONAMESPACE
+
+// 全ての部分集合を調べてクリーク(complement が true の時は独立集合)の
+// 重みの最大値を求める．
+std::int64_t
+brute_force_max_weight(const UdGraph& graph,
+		       bool complement)
+{
+  int n = graph.node_num();
+  vector<std::uint32_t> adj(n, 0);
+  for ( const auto& edge: graph.edge_list() ) {
+    if ( edge.id1 != edge.id2 ) {
+      adj[edge.id1] |= 1U << edge.id2;
+      adj[edge.id2] |= 1U << edge.id1;
+    }
+  }
+  std::int64_t max_weight = 0;
+  for ( std::uint32_t set = 1; set < (1U << n); ++ set ) {
+    bool ok = true;
+    std::int64_t weight = 0;
+    for ( int i = 0; i < n && ok; ++ i ) {
+      if ( set & (1U << i) ) {
+	auto others = set & ~(1U << i);
+	ok = complement ? (others & adj[i]) == 0 : (others & ~adj[i]) == 0;
+	weight += std::max(graph.node_weight(i), 0);
+      }
+    }
+    if ( ok ) {
+      max_weight = std::max(max_weight, weight);
+    }
+  }
+  return max_weight;
+}
+
+// node_set の重みの和を返す．
+// complement が false の時はクリーク，true の時は独立集合であることを調べる．
+std::int64_t
+check_node_set(const UdGraph& graph,
+	       const vector<int>& node_set,
+	       bool complement)
+{
+  EXPECT_TRUE( std::is_sorted(node_set.begin(), node_set.end()) );
+  vector<bool> mark(graph.node_num(), false);
+  std::int64_t weight = 0;
+  for ( auto id: node_set ) {
+    mark[id] = true;
+    weight += graph.node_weight(id);
+  }
+  auto graph1 = graph;
+  graph1.canonicalize();
+  SizeType n_edges = 0;
+  for ( const auto& edge: graph1.edge_list() ) {
+    if ( edge.id1 != edge.id2 && mark[edge.id1] && mark[edge.id2] ) {
+      ++ n_edges;
+    }
+  }
+  auto k = node_set.size();
+  if ( complement ) {
+    EXPECT_EQ( 0, n_edges );
+  }
+  else {
+    EXPECT_EQ( k * (k - 1) / 2, n_edges );
+  }
+  return weight;
+}
+
+END_NONAMESPACE
+
+TEST(UdGraphTest, max_clique_weighted)
+{
+  // 小さなグラフで全ての部分集合を調べた結果と比べる．
+  for ( int seed = 0; seed < 10; ++ seed ) {
+    GraphGen gen(seed);
+    auto graph = gen.gnp(16, 0.3 + seed * 0.05);
+    // 重複した枝，セルフループ，重み 0 と負の重みを含める．
+    graph.add_edge(0, 1);
+    graph.add_edge(0, 1);
+    graph.add_edge(2, 2);
+    for ( int i = 0; i < 16; ++ i ) {
+      graph.set_node_weight(i, (i * 7 + seed) % 11 - 1);
+    }
+    UdGraph::NodeSetOptions options;
+    UdGraph::NodeSetStats stats;
+    auto clique = graph.max_clique("weighted", options, stats);
+    EXPECT_TRUE( stats.optimal );
+    EXPECT_EQ( brute_force_max_weight(graph, false), stats.weight );
+    EXPECT_EQ( stats.weight, check_node_set(graph, clique, false) );
+  }
+
+  // 複数の連結成分からなる場合は最も重いものが選ばれる．
+  // サイクル上で隣接する 0 と 11 を重くすると完全グラフより重くなる．
+  auto graph = make_multi_component_graph(5);
+  graph.set_node_weight(0, 100);
+  graph.set_node_weight(11, 100);
+  UdGraph::NodeSetOptions options;
+  UdGraph::NodeSetStats stats;
+  auto clique = graph.max_clique("weighted", options, stats);
+  EXPECT_TRUE( stats.optimal );
+  EXPECT_EQ( 200, stats.weight );
+  EXPECT_EQ( (vector<int>{0, 11}), clique );
+
+  // 重みがなければ最大クリークと同じ大きさになる．
+  string filename = string(TESTDATA_DIR) + string("/anna.col");
+  auto graph2 = UdGraph::read_dimacs(filename);
+  auto clique2 = graph2.max_clique("weighted");
+  EXPECT_EQ( graph2.max_clique("exact").size(), clique2.size() );
+  check_node_set(graph2, clique2, false);
+}
+
+TEST(UdGraphTest, independent_set_weighted)
+{
+  // 小さなグラフで全ての部分集合を調べた結果と比べる．
+  for ( int seed = 0; seed < 10; ++ seed ) {
+    GraphGen gen(seed);
+    auto graph = gen.gnp(16, 0.1 + seed * 0.03);
+    graph.add_edge(0, 1);
+    graph.add_edge(0, 1);
+    graph.add_edge(2, 2);
+    for ( int i = 0; i < 16; ++ i ) {
+      graph.set_node_weight(i, (i * 7 + seed) % 11 - 1);
+    }
+    UdGraph::NodeSetOptions options;
+    options.seed = seed;
+    UdGraph::NodeSetStats stats;
+    auto node_set = graph.independent_set("weighted", options, stats);
+    EXPECT_EQ( brute_force_max_weight(graph, true), stats.weight );
+    EXPECT_EQ( stats.weight, check_node_set(graph, node_set, true) );
+  }
+
+  // 星グラフで中心だけが重い場合は中心が選ばれる．
+  UdGraph star(10);
+  for ( int i = 1; i < 10; ++ i ) {
+    star.add_edge(0, i);
+  }
+  star.set_node_weight(0, 20);
+  auto node_set = star.independent_set("weighted");
+  ASSERT_EQ( 1, node_set.size() );
+  EXPECT_EQ( 0, node_set[0] );
+
+  // 大きめのグラフでは独立集合で，重みが貪欲法以上となる．
+  GraphGen gen(1);
+  auto graph = gen.gnp(300, 0.05);
+  for ( int i = 0; i < graph.node_num(); ++ i ) {
+    graph.set_node_weight(i, (i * 37) % 100 + 1);
+  }
+  UdGraph::NodeSetOptions options;
+  options.time_limit = 5.0;
+  options.reorder = "degeneracy";
+  UdGraph::NodeSetStats stats;
+  auto node_set2 = graph.independent_set("weighted", options, stats);
+  EXPECT_EQ( stats.weight, check_node_set(graph, node_set2, true) );
+  UdGraph::NodeSetStats stats0;
+  auto node_set0 = graph.independent_set("greedy", options, stats0);
+  EXPECT_EQ( stats0.weight, check_node_set(graph, node_set0, true) );
+  EXPECT_LE( stats0.weight, stats.weight );
+}
+
+BEGIN_NONAMESPACE
+
+// 極大クリークを列挙して昇順に並べたリストを返す．
+vector<vector<int>>
+collect_cliques(const UdGraph& graph,
+		const UdGraph::CliqueEnumOptions& options)
+{
+  vector<vector<int>> clique_list;
+  auto n = graph.enum_maximal_cliques(options,
+				      [&](const vector<int>& clique) {
+					clique_list.push_back(clique);
+					return true;
+				      });
+  EXPECT_EQ( clique_list.size(), n );
+  sort(clique_list.begin(), clique_list.end());
+  return clique_list;
+}
+
+// 全ての部分集合を調べて極大クリークを求める．
+vector<vector<int>>
+brute_force_cliques(const UdGraph& graph,
+		    int min_size)
+{
+  int n = graph.node_num();
+  vector<std::uint32_t> adj(n, 0);
+  for ( const auto& edge: graph.edge_list() ) {
+    if ( edge.id1 != edge.id2 ) {
+      adj[edge.id1] |= 1U << edge.id2;
+      adj[edge.id2] |= 1U << edge.id1;
+    }
+  }
+  auto is_clique = [&](std::uint32_t set) {
+    for ( int i = 0; i < n; ++ i ) {
+      if ( (set & (1U << i)) && (set & ~adj[i] & ~(1U << i)) ) {
+	return false;
+      }
+    }
+    return true;
+  };
+  vector<vector<int>> clique_list;
+  for ( std::uint32_t set = 1; set < (1U << n); ++ set ) {
+    if ( !is_clique(set) ) {
+      continue;
+    }
+    bool maximal = true;
+    for ( int i = 0; i < n && maximal; ++ i ) {
+      if ( !(set & (1U << i)) && is_clique(set | (1U << i)) ) {
+	maximal = false;
+      }
+    }
+    if ( maximal ) {
+      vector<int> clique;
+      for ( int i = 0; i < n; ++ i ) {
+	if ( set & (1U << i) ) {
+	  clique.push_back(i);
+	}
+      }
+      if ( clique.size() >= min_size ) {
+	clique_list.push_back(clique);
+      }
+    }
+  }
+  sort(clique_list.begin(), clique_list.end());
+  return clique_list;
+}
+
+END_NONAMESPACE
+
+TEST(UdGraphTest, enum_maximal_cliques)
+{
+  // 小さなグラフで全ての部分集合を調べた結果と比べる．
+  for ( int seed = 0; seed < 10; ++ seed ) {
+    GraphGen gen(seed);
+    auto graph = gen.gnp(14, 0.3 + seed * 0.05);
+    // 孤立ノード，重複した枝，セルフループを含める．
+    graph.add_edge(0, 1);
+    graph.add_edge(0, 1);
+    graph.add_edge(2, 2);
+    for ( int min_size: {1, 3} ) {
+      UdGraph::CliqueEnumOptions options;
+      options.min_size = min_size;
+      options.thread_num = 1;
+      EXPECT_EQ( brute_force_cliques(graph, min_size),
+		 collect_cliques(graph, options) );
+    }
+  }
+}
+
+TEST(UdGraphTest, enum_maximal_cliques_large)
+{
+  // ノード 0 に 1 と 2 が隣接し，1 と 2 はそれぞれ 5 ノードの完全グラフと
+  // 合わせて K6 をなす．残りのノードは 0 と，1 か 2 の一方に隣接する．
+  // 縮退度の順では 0 が 1, 2 より先になるので，0 を根とする探索では
+  // X が大きくなり配列による探索を経由する．
+  const int nl = 1100;
+  const int n = 13 + nl;
+  UdGraph graph(n);
+  graph.add_edge(0, 1);
+  graph.add_edge(0, 2);
+  for ( int k = 0; k < 2; ++ k ) {
+    int base = 3 + k * 5;
+    for ( int i = 0; i < 5; ++ i ) {
+      graph.add_edge(k + 1, base + i);
+      for ( int j = i + 1; j < 5; ++ j ) {
+	graph.add_edge(base + i, base + j);
+      }
+    }
+  }
+  for ( int i = 0; i < nl; ++ i ) {
+    graph.add_edge(0, 13 + i);
+    graph.add_edge(i % 2 + 1, 13 + i);
+  }
+  UdGraph::CliqueEnumOptions options;
+  options.thread_num = 1;
+  auto clique_list = collect_cliques(graph, options);
+  ASSERT_EQ( nl + 2, clique_list.size() );
+  for ( const auto& clique: clique_list ) {
+    if ( clique.size() == 3 ) {
+      EXPECT_EQ( 0, clique[0] );
+      EXPECT_EQ( (clique[2] - 13) % 2 + 1, clique[1] );
+    }
+    else {
+      EXPECT_EQ( 6, clique.size() );
+    }
+  }
+}
+
+TEST(UdGraphTest, enum_maximal_cliques_parallel)
+{
+  // 根のノードごとに並列に列挙しても結果は同じになる．
+  GraphGen gen(1);
+  auto graph = gen.gnp(1000, 0.05);
+  UdGraph::CliqueEnumOptions options1;
+  options1.thread_num = 1;
+  auto clique_list1 = collect_cliques(graph, options1);
+  UdGraph::CliqueEnumOptions options4;
+  options4.thread_num = 4;
+  auto clique_list4 = collect_cliques(graph, options4);
+  EXPECT_EQ( clique_list1, clique_list4 );
+
+  // min_size 以上のものだけが報告される．
+  UdGraph::CliqueEnumOptions options3;
+  options3.min_size = 3;
+  options3.thread_num = 4;
+  UdGraph::CliqueEnumStats stats;
+  auto n3 = graph.enum_maximal_cliques(options3, nullptr, stats);
+  SizeType expected = 0;
+  int max_size = 0;
+  for ( const auto& clique: clique_list1 ) {
+    if ( clique.size() >= 3 ) {
+      ++ expected;
+    }
+    max_size = std::max(max_size, static_cast<int>(clique.size()));
+  }
+  EXPECT_EQ( expected, n3 );
+  EXPECT_EQ( expected, stats.clique_num );
+  EXPECT_EQ( max_size, stats.max_size );
+  EXPECT_TRUE( stats.completed );
+
+  // callback が false を返すと打ち切られる．
+  int count = 0;
+  UdGraph::CliqueEnumStats stats2;
+  auto n2 = graph.enum_maximal_cliques(options4,
+				       [&](const vector<int>& clique) {
+					 ++ count;
+					 return count < 5;
+				       },
+				       stats2);
+  EXPECT_EQ( 5, n2 );
+  EXPECT_EQ( 5, count );
+  EXPECT_FALSE( stats2.completed );
+}
+
 END_NAMESPACE_YM
@@ -0,0 +1,65 @@
+#! /usr/bin/env python3
+
+### @file async_test.py
+### @brief UdGraph/BiGraph の非同期 API のテスト
+### @author Yusuke Matsunaga (松永 裕介)
+###
+### Copyright (C) 2022 Yusuke Matsunaga
+### All rights reserved.
+
+import threading
+import unittest
+from pym_graph import UdGraph, BiGraph, set_async_thread_num, async_thread_num
+
+# テスト用のグラフを作る．
+# n ノードのサイクル
+def make_cycle(n) :
+    return UdGraph(n, [ (i, (i + 1) % n) for i in range(n) ])
+
+# 非同期 API のテスト用クラス
+class AsyncTest(unittest.TestCase) :
+
+    def test_coloring_async(self) :
+        graph = make_cycle(101)
+        future = graph.coloring_async("dsatur")
+        nc, color_map = future.result()
+        assert future.done()
+        assert (nc, color_map) == graph.coloring("dsatur")
+        for id1, id2, w in graph.edge_list() :
+            assert color_map[id1] != color_map[id2]
+
+    def test_list_async(self) :
+        graph = make_cycle(100)
+        future_list = [ graph.max_clique_async("greedy"),
+                        graph.independent_set_async(),
+                        graph.max_matching_async() ]
+        assert future_list[0].result() == graph.max_clique("greedy")
+        assert future_list[1].result() == graph.independent_set()
+        assert len(future_list[2].result(timeout = 60.0)) == 50
+
+    def test_bigraph_async(self) :
+        graph = BiGraph(3, 3, [ (0, 0), (0, 1), (1, 1), (2, 2) ])
+        future = graph.max_matching_async()
+        assert future.wait(60.0)
+        assert sorted(future.result()) == sorted(graph.max_matching())
+
+    def test_threads(self) :
+        # GIL を解放しているので Python のスレッドから同時に解ける．
+        set_async_thread_num(2)
+        assert async_thread_num() == 2
+        graph = make_cycle(1001)
+        result_list = [ None ] * 4
+        def solve(i) :
+            result_list[i] = graph.coloring("isx")[0]
+        thread_list = [ threading.Thread(target = solve, args = (i,)) for i in range(4) ]
+        for th in thread_list :
+            th.start()
+        for th in thread_list :
+            th.join()
+        for nc in result_list :
+            assert nc == 3
+        set_async_thread_num(0)
+
+
+if __name__ == '__main__' :
+    unittest.main()
@@ -0,0 +1,100 @@
+#! /usr/bin/env python3
+
+### @file numpy_test.py
+### @brief numpy の配列を用いた UdGraph/BiGraph のインターフェイスのテスト
+### @author Yusuke Matsunaga (松永 裕介)
+###
+### Copyright (C) 2022 Yusuke Matsunaga
+### All rights reserved.
+
+import unittest
+from pym_graph import UdGraph, BiGraph
+
+try :
+    import numpy
+except ImportError :
+    numpy = None
+
+# numpy の配列を用いたインターフェイスのテスト用クラス
+@unittest.skipIf(numpy is None, "numpy is not available")
+class NumpyTest(unittest.TestCase) :
+
+    def test_udgraph_array(self) :
+        edge_list = [ (0, 1), (2, 1), (2, 3), (3, 0) ]
+        graph1 = UdGraph(4, edge_list)
+        graph2 = UdGraph(4, numpy.array(edge_list, dtype = numpy.int32))
+        assert list(graph1.edge_list()) == list(graph2.edge_list())
+
+        # 枝の配列は正規化されている．
+        edge_array = numpy.asarray(graph2.edge_array())
+        assert edge_array.shape == (4, 3)
+        assert not edge_array.flags.writeable
+        assert edge_array.tolist() == [ [0, 1, 1], [1, 2, 1], [2, 3, 1], [0, 3, 1] ]
+
+        # 重み付き
+        weighted = numpy.array([ (0, 1, 3), (1, 2, 5) ], dtype = numpy.int32)
+        graph3 = UdGraph(3, weighted)
+        assert numpy.asarray(graph3.edge_array())[:, 2].tolist() == [ 3, 5 ]
+
+        with self.assertRaises(ValueError) :
+            UdGraph(3, numpy.array(edge_list, dtype = numpy.int32))
+        with self.assertRaises(ValueError) :
+            UdGraph(4, numpy.zeros((2, 4), dtype = numpy.int32))
+
+    def test_udgraph_pack(self) :
+        edge_list = [ (0, 1), (2, 1), (2, 3), (3, 0) ]
+        graph2 = UdGraph(4, numpy.array(edge_list, dtype = numpy.int32))
+        weighted = numpy.array([ (0, 1, 3), (1, 2, 5) ], dtype = numpy.int32)
+        graph3 = UdGraph(3, weighted)
+
+        # C++ のメモリを共有する配列が生きている間は圧縮形式にできない．
+        edge_array = numpy.asarray(graph2.edge_array())
+        with self.assertRaises(BufferError) :
+            graph2.pack()
+        assert not graph2.is_packed
+        assert edge_array.tolist() == [ [0, 1, 1], [1, 2, 1], [2, 3, 1], [0, 3, 1] ]
+        del edge_array
+
+        # 圧縮形式でも同じ配列が得られる．
+        assert not graph2.is_weighted
+        graph2.pack()
+        assert graph2.is_packed
+        assert numpy.asarray(graph2.edge_array()).tolist() == [ [0, 1, 1], [1, 2, 1], [2, 3, 1], [0, 3, 1] ]
+        assert numpy.asarray(graph2.weight_array()).tolist() == [ 1, 1, 1, 1 ]
+        assert graph3.is_weighted
+        graph3.pack()
+        weight_array = numpy.asarray(graph3.weight_array())
+        assert not weight_array.flags.writeable
+        assert weight_array.tolist() == [ 3, 5 ]
+
+        # 重みの配列が生きている間は非圧縮形式に戻せない．
+        with self.assertRaises(BufferError) :
+            graph3.unpack()
+        assert graph3.is_packed
+        assert weight_array.tolist() == [ 3, 5 ]
+        del weight_array
+        graph3.unpack()
+        assert not graph3.is_packed
+        assert numpy.asarray(graph3.edge_array())[:, 2].tolist() == [ 3, 5 ]
+
+    def test_udgraph_result(self) :
+        n = 10
+        edge_list = numpy.array([ (i, (i + 1) % n) for i in range(n) ], dtype = numpy.int32)
+        graph = UdGraph(n, edge_list)
+        nc, color_map = graph.coloring("dsatur", as_array = True)
+        assert isinstance(color_map, numpy.ndarray)
+        assert color_map.tolist() == graph.coloring("dsatur")[1]
+        assert graph.max_clique(as_array = True).tolist() == graph.max_clique()
+        assert graph.max_matching(as_array = True).tolist() == graph.max_matching()
+
+    def test_bigraph_array(self) :
+        edge_list = [ (0, 0), (0, 1), (1, 1), (2, 2) ]
+        graph = BiGraph(3, 3, numpy.array(edge_list, dtype = numpy.int32))
+        assert [ (id1, id2) for id1, id2, w in graph.edge_list() ] == edge_list
+        match = graph.max_matching(as_array = True)
+        assert match.shape == (3, 2)
+        assert sorted(map(tuple, match.tolist())) == sorted(graph.max_matching())
+
+
+if __name__ == '__main__' :
+    unittest.main()
@@ -6,5 +6,7 @@
 ### Copyright (C) 2018 Yusuke Matsunaga
 ### All rights reserved.
 
+include "int_array.pxi"
+include "executor.pxi"
 include "udgraph.pxi"
 include "bigraph.pxi"